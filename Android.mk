@@ -171,6 +171,7 @@ LOCAL_SRC_FILES := \
 	src/core/SkRasterClip.cpp \
 	src/core/SkRasterizer.cpp \
 	src/core/SkReadBuffer.cpp \
+	src/core/SkRecordCompact.cpp \
 	src/core/SkRecordDraw.cpp \
 	src/core/SkRecordOpts.cpp \
 	src/core/SkRecorder.cpp \
@@ -238,6 +239,7 @@ LOCAL_SRC_FILES := \
 	src/pathops/SkPathOpsCubic.cpp \
 	src/pathops/SkPathOpsDebug.cpp \
 	src/pathops/SkPathOpsLine.cpp \
+	src/pathops/SkPathOpsMany.cpp \
 	src/pathops/SkPathOpsOp.cpp \
 	src/pathops/SkPathOpsPoint.cpp \
 	src/pathops/SkPathOpsQuad.cpp \
@@ -595,7 +597,16 @@ LOCAL_SRC_FILES_arm += \
 	src/opts/SkBlitMask_opts_arm.cpp \
 	src/opts/SkBlitRow_opts_arm.cpp \
 	src/opts/SkBlurImage_opts_arm.cpp \
+	src/opts/SkColorMatrix_opts_none.cpp \
+	src/opts/SkGeometry_opts_none.cpp \
+	src/opts/SkGradient_opts_none.cpp \
+	src/opts/SkLighting_opts_none.cpp \
+	src/opts/SkMatrixConvolution_opts_none.cpp \
+	src/opts/SkMatrix_opts_none.cpp \
 	src/opts/SkMorphology_opts_arm.cpp \
+	src/opts/SkPerlinNoise_opts_none.cpp \
+	src/opts/SkRect_opts_none.cpp \
+	src/opts/SkScan_Antihair_opts_none.cpp \
 	src/opts/SkUtils_opts_arm.cpp \
 	src/opts/SkXfermode_opts_arm.cpp
 
@@ -629,7 +640,16 @@ LOCAL_SRC_FILES_x86 += \
 	src/opts/SkBlitRow_opts_SSE2.cpp \
 	src/opts/SkBlitRect_opts_SSE2.cpp \
 	src/opts/SkBlurImage_opts_SSE2.cpp \
+	src/opts/SkColorMatrix_opts_SSE2.cpp \
+	src/opts/SkGeometry_opts_SSE2.cpp \
+	src/opts/SkGradient_opts_SSE2.cpp \
+	src/opts/SkLighting_opts_SSE2.cpp \
+	src/opts/SkMatrixConvolution_opts_SSE2.cpp \
+	src/opts/SkMatrix_opts_SSE2.cpp \
 	src/opts/SkMorphology_opts_SSE2.cpp \
+	src/opts/SkPerlinNoise_opts_SSE2.cpp \
+	src/opts/SkRect_opts_SSE2.cpp \
+	src/opts/SkScan_Antihair_opts_SSE2.cpp \
 	src/opts/SkUtils_opts_SSE2.cpp \
 	src/opts/SkXfermode_opts_SSE2.cpp \
 	src/opts/SkBitmapProcState_opts_SSSE3.cpp
@@ -645,7 +665,16 @@ LOCAL_SRC_FILES_x86_64 += \
 	src/opts/SkBlitRow_opts_SSE2.cpp \
 	src/opts/SkBlitRect_opts_SSE2.cpp \
 	src/opts/SkBlurImage_opts_SSE2.cpp \
+	src/opts/SkColorMatrix_opts_SSE2.cpp \
+	src/opts/SkGeometry_opts_SSE2.cpp \
+	src/opts/SkGradient_opts_SSE2.cpp \
+	src/opts/SkLighting_opts_SSE2.cpp \
+	src/opts/SkMatrixConvolution_opts_SSE2.cpp \
+	src/opts/SkMatrix_opts_SSE2.cpp \
 	src/opts/SkMorphology_opts_SSE2.cpp \
+	src/opts/SkPerlinNoise_opts_SSE2.cpp \
+	src/opts/SkRect_opts_SSE2.cpp \
+	src/opts/SkScan_Antihair_opts_SSE2.cpp \
 	src/opts/SkUtils_opts_SSE2.cpp \
 	src/opts/SkXfermode_opts_SSE2.cpp \
 	src/opts/SkBitmapProcState_opts_SSSE3.cpp
@@ -657,7 +686,16 @@ LOCAL_SRC_FILES_mips += \
 	src/opts/SkBitmapProcState_opts_none.cpp \
 	src/opts/SkBlitMask_opts_none.cpp \
 	src/opts/SkBlurImage_opts_none.cpp \
+	src/opts/SkColorMatrix_opts_none.cpp \
+	src/opts/SkGeometry_opts_none.cpp \
+	src/opts/SkGradient_opts_none.cpp \
+	src/opts/SkLighting_opts_none.cpp \
+	src/opts/SkMatrixConvolution_opts_none.cpp \
+	src/opts/SkMatrix_opts_none.cpp \
 	src/opts/SkMorphology_opts_none.cpp \
+	src/opts/SkPerlinNoise_opts_none.cpp \
+	src/opts/SkRect_opts_none.cpp \
+	src/opts/SkScan_Antihair_opts_none.cpp \
 	src/opts/SkUtils_opts_none.cpp \
 	src/opts/SkXfermode_opts_none.cpp \
 	src/opts/SkBlitRow_opts_none.cpp
@@ -667,7 +705,16 @@ LOCAL_SRC_FILES_mips64 += \
 	src/opts/SkBlitMask_opts_none.cpp \
 	src/opts/SkBlitRow_opts_none.cpp \
 	src/opts/SkBlurImage_opts_none.cpp \
+	src/opts/SkColorMatrix_opts_none.cpp \
+	src/opts/SkGeometry_opts_none.cpp \
+	src/opts/SkGradient_opts_none.cpp \
+	src/opts/SkLighting_opts_none.cpp \
+	src/opts/SkMatrixConvolution_opts_none.cpp \
+	src/opts/SkMatrix_opts_none.cpp \
 	src/opts/SkMorphology_opts_none.cpp \
+	src/opts/SkPerlinNoise_opts_none.cpp \
+	src/opts/SkRect_opts_none.cpp \
+	src/opts/SkScan_Antihair_opts_none.cpp \
 	src/opts/SkUtils_opts_none.cpp \
 	src/opts/SkXfermode_opts_none.cpp
 
@@ -681,8 +728,17 @@ LOCAL_SRC_FILES_arm64 += \
 	src/opts/SkBlitRow_opts_arm_neon.cpp \
 	src/opts/SkBlurImage_opts_arm.cpp \
 	src/opts/SkBlurImage_opts_neon.cpp \
+	src/opts/SkColorMatrix_opts_none.cpp \
+	src/opts/SkGeometry_opts_none.cpp \
+	src/opts/SkGradient_opts_none.cpp \
+	src/opts/SkLighting_opts_none.cpp \
+	src/opts/SkMatrixConvolution_opts_none.cpp \
+	src/opts/SkMatrix_opts_none.cpp \
 	src/opts/SkMorphology_opts_arm.cpp \
 	src/opts/SkMorphology_opts_neon.cpp \
+	src/opts/SkPerlinNoise_opts_none.cpp \
+	src/opts/SkRect_opts_none.cpp \
+	src/opts/SkScan_Antihair_opts_none.cpp \
 	src/opts/SkUtils_opts_none.cpp \
 	src/opts/SkXfermode_opts_arm.cpp \
 	src/opts/SkXfermode_opts_arm_neon.cpp
@@ -5,8 +5,10 @@
  * found in the LICENSE file.
  */
 #include "Benchmark.h"
+#include "SamplePipeControllers.h"
 #include "SkDeferredCanvas.h"
 #include "SkDevice.h"
+#include "SkGPipe.h"
 #include "SkString.h"
 
 class DeferredCanvasBench : public Benchmark {
@@ -101,6 +103,93 @@ private:
 };
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+// Records the same simple draws into an SkGPipeWriter and plays them back into a raster canvas,
+// either inline on the recording thread or on a ThreadedPipeController's reader thread.
+// The ring is kept small so that the threaded variants exercise their backpressure policy.
+class PipePlaybackBench : public Benchmark {
+public:
+    enum Mode {
+        kInline_Mode,
+        kThreaded_Mode,
+    };
+
+    PipePlaybackBench(Mode mode,
+                      ThreadedPipeController::Backpressure backpressure,
+                      const char name[])
+        : fMode(mode)
+        , fBackpressure(backpressure) {
+        fName.printf("deferred_canvas_pipe_%s", name);
+    }
+
+    enum {
+        CANVAS_WIDTH = 200,
+        CANVAS_HEIGHT = 200,
+        RING_BYTES = 64 * 1024,
+    };
+
+protected:
+    virtual bool isSuitableFor(Backend backend) SK_OVERRIDE {
+        return backend == kNonRendering_Backend;
+    }
+
+    virtual const char* onGetName() SK_OVERRIDE {
+        return fName.c_str();
+    }
+
+    virtual void onDraw(const int loops, SkCanvas*) SK_OVERRIDE {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(CANVAS_WIDTH, CANVAS_HEIGHT);
+        SkCanvas target(bitmap);
+
+        if (kInline_Mode == fMode) {
+            PipeController controller(&target);
+            this->record(loops, &controller);
+        } else {
+            ThreadedPipeController controller(&target, RING_BYTES, fBackpressure);
+            this->record(loops, &controller);
+            controller.drain();
+        }
+    }
+
+private:
+    void record(const int loops, SkGPipeController* controller) {
+        SkGPipeWriter writer;
+        SkCanvas* canvas = writer.startRecording(controller, 0, CANVAS_WIDTH, CANVAS_HEIGHT);
+
+        SkRect rect;
+        rect.setXYWH(0, 0, 10, 10);
+        SkPaint paint;
+        for (int i = 0; i < loops; i++) {
+            canvas->save();
+            canvas->translate(SkIntToScalar(i * 27 % CANVAS_WIDTH), SkIntToScalar(i * 13 % CANVAS_HEIGHT));
+            paint.setColor(0xFF000000 | ((i & 0xFF) * 0x10101));
+            canvas->drawRect(rect, paint);
+            canvas->restore();
+        }
+        writer.endRecording();
+    }
+
+    Mode fMode;
+    ThreadedPipeController::Backpressure fBackpressure;
+    SkString fName;
+
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new DeferredRecordBench(); )
+DEF_BENCH( return new PipePlaybackBench(PipePlaybackBench::kInline_Mode,
+                                        ThreadedPipeController::kBlock_Backpressure,
+                                        "inline"); )
+DEF_BENCH( return new PipePlaybackBench(PipePlaybackBench::kThreaded_Mode,
+                                        ThreadedPipeController::kBlock_Backpressure,
+                                        "threaded_block"); )
+DEF_BENCH( return new PipePlaybackBench(PipePlaybackBench::kThreaded_Mode,
+                                        ThreadedPipeController::kGrow_Backpressure,
+                                        "threaded_grow"); )
+DEF_BENCH( return new PipePlaybackBench(PipePlaybackBench::kThreaded_Mode,
+                                        ThreadedPipeController::kDropToFlush_Backpressure,
+                                        "threaded_drop"); )
@@ -7,6 +7,7 @@
 
 #include "Benchmark.h"
 #include "SkCanvas.h"
+#include "SkGlyphCache.h"
 #include "SkGraphics.h"
 #include "SkPaint.h"
 #include "SkRandom.h"
@@ -46,7 +47,72 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Times first paint of a text-heavy page: every glyph of every strike is a cache miss.
+class ColdTextBench : public Benchmark {
+public:
+    enum Mode {
+        kLazy_Mode,     // rasterize each glyph as drawText reaches it
+        kPreload_Mode,  // rasterize each run's glyphs in one batch first
+        kThreaded_Mode, // ... and split the batch across threads
+    };
+
+    ColdTextBench(Mode mode) : fMode(mode) {
+        static const char* gNames[] = { "lazy", "preload", "threaded" };
+        fName.printf("fontscaler_cold_text_%s", gNames[mode]);
+        fText.set("The quick brown fox jumps over the lazy dog. "
+                  "SPHINX OF BLACK QUARTZ, JUDGE MY VOW! 0123456789 "
+                  "()[]{}<>/\\|@#$%^&*+=-_~;:,.?!'\"`");
+    }
+
+protected:
+    virtual const char* onGetName() SK_OVERRIDE { return fName.c_str(); }
+
+    virtual void onDraw(const int loops, SkCanvas* canvas) SK_OVERRIDE {
+        SkPaint paint;
+        this->setupPaint(&paint);
+        paint.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+
+        SkPaint utf8;
+        const int count = utf8.textToGlyphs(fText.c_str(), fText.size(), NULL);
+        SkAutoTMalloc<uint16_t> glyphs(count);
+        utf8.textToGlyphs(fText.c_str(), fText.size(), glyphs.get());
+
+        for (int i = 0; i < loops; i++) {
+            SkGraphics::PurgeFontCache();
+
+            for (int ps = 9; ps <= 36; ps++) {
+                paint.setTextSize(SkIntToScalar(ps));
+                if (kLazy_Mode != fMode) {
+                    SkAutoGlyphCache autoCache(paint, NULL, NULL);
+                    autoCache.getCache()->preloadImages(glyphs.get(), count,
+                                                        kThreaded_Mode == fMode ? 4 : 1);
+                }
+                // Break the run into lines that fit, so every glyph really gets drawn.
+                for (int start = 0; start < count; start += kGlyphsPerLine) {
+                    const int n = SkTMin<int>(kGlyphsPerLine, count - start);
+                    canvas->drawText(glyphs.get() + start, n * sizeof(uint16_t),
+                                     0, SkIntToScalar(ps * (1 + start / kGlyphsPerLine)), paint);
+                }
+            }
+        }
+    }
+
+private:
+    enum {
+        kGlyphsPerLine = 24
+    };
+
+    SkString fName;
+    SkString fText;
+    Mode     fMode;
+
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return SkNEW_ARGS(FontScalerBench, (false)); )
 DEF_BENCH( return SkNEW_ARGS(FontScalerBench, (true)); )
+DEF_BENCH( return SkNEW_ARGS(ColdTextBench, (ColdTextBench::kLazy_Mode)); )
+DEF_BENCH( return SkNEW_ARGS(ColdTextBench, (ColdTextBench::kPreload_Mode)); )
+DEF_BENCH( return SkNEW_ARGS(ColdTextBench, (ColdTextBench::kThreaded_Mode)); )
@@ -29,12 +29,13 @@ public:
 
     GameBench(Type type, Clear clear,
               bool aligned = false, bool useAtlas = false,
-              bool useDrawVertices = false)
+              bool useDrawVertices = false, bool useDrawAtlas = false)
         : fType(type)
         , fClear(clear)
         , fAligned(aligned)
         , fUseAtlas(useAtlas)
         , fUseDrawVertices(useDrawVertices)
+        , fUseDrawAtlas(useDrawAtlas)
         , fName("game")
         , fNumSaved(0)
         , fInitialized(false) {
@@ -69,6 +70,10 @@ public:
             fName.append("_drawVerts");
         }
 
+        if (useDrawAtlas) {
+            fName.append("_drawAtlas");
+        }
+
         // It's HTML 5 canvas, so always AA
         fName.append("_aa");
     }
@@ -131,6 +136,7 @@ protected:
             { SkIntToScalar(width), 0 }
         };
         uint16_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+        int numPending = 0; // sprites waiting in fXforms/fTex for the drawAtlas path
 
         SkPaint p;
         p.setColor(0xFF000000);
@@ -145,6 +151,7 @@ protected:
 
         for (int i = 0; i < loops; ++i, ++fNumSaved) {
             if (0 == i % kNumBeforeClear) {
+                this->flushAtlas(canvas, &numPending, p);
                 if (kPartial_Clear == fClear) {
                     for (int j = 0; j < fNumSaved; ++j) {
                         canvas->setMatrix(SkMatrix::I());
@@ -193,7 +200,12 @@ protected:
                 const int curCell = i % (kNumAtlasedX * kNumAtlasedY);
                 SkIRect src = fAtlasRects[curCell % (kNumAtlasedX)][curCell / (kNumAtlasedX)];
 
-                if (fUseDrawVertices) {
+                if (fUseDrawAtlas) {
+                    // like a game's sprite batch: draw them all at the next clear
+                    fXforms[numPending] = mat;
+                    fTex[numPending] = src;
+                    ++numPending;
+                } else if (fUseDrawVertices) {
                     SkPoint uvs[4] = {
                         { SkIntToScalar(src.fLeft),  SkIntToScalar(src.fBottom) },
                         { SkIntToScalar(src.fLeft),  SkIntToScalar(src.fTop) },
@@ -211,6 +223,7 @@ protected:
                 canvas->drawBitmapRect(fCheckerboard, NULL, dst, &p);
             }
         }
+        this->flushAtlas(canvas, &numPending, p);
     }
 
 private:
@@ -233,6 +246,7 @@ private:
     bool     fAligned;
     bool     fUseAtlas;
     bool     fUseDrawVertices;
+    bool     fUseDrawAtlas;
     SkString fName;
     int      fNumSaved; // num draws stored in 'fSaved'
     bool     fInitialized;
@@ -244,6 +258,18 @@ private:
     SkBitmap fAtlas;
     SkIRect  fAtlasRects[kNumAtlasedX][kNumAtlasedY];
 
+    // The sprites not yet drawn by the drawAtlas path.
+    SkMatrix fXforms[kNumBeforeClear];
+    SkIRect  fTex[kNumBeforeClear];
+
+    void flushAtlas(SkCanvas* canvas, int* numPending, const SkPaint& paint) {
+        if (*numPending > 0) {
+            canvas->setMatrix(SkMatrix::I());
+            canvas->drawAtlas(fAtlas, fXforms, fTex, NULL, *numPending, &paint);
+            *numPending = 0;
+        }
+    }
+
     // Note: the resulting checker board has transparency
     void makeCheckerboard() {
         static int kCheckSize = 16;
@@ -332,3 +358,13 @@ DEF_BENCH( return SkNEW_ARGS(GameBench, (GameBench::kTranslate_Type,
                                             GameBench::kFull_Clear, false, true)); )
 DEF_BENCH( return SkNEW_ARGS(GameBench, (GameBench::kTranslate_Type,
                                             GameBench::kFull_Clear, false, true, true)); )
+DEF_BENCH( return SkNEW_ARGS(GameBench, (GameBench::kTranslate_Type,
+                                            GameBench::kFull_Clear, false, true, false, true)); )
+DEF_BENCH( return SkNEW_ARGS(GameBench, (GameBench::kTranslate_Type,
+                                            GameBench::kFull_Clear, true, true)); )
+DEF_BENCH( return SkNEW_ARGS(GameBench, (GameBench::kTranslate_Type,
+                                            GameBench::kFull_Clear, true, true, false, true)); )
+DEF_BENCH( return SkNEW_ARGS(GameBench, (GameBench::kScale_Type,
+                                            GameBench::kFull_Clear, false, true)); )
+DEF_BENCH( return SkNEW_ARGS(GameBench, (GameBench::kScale_Type,
+                                            GameBench::kFull_Clear, false, true, false, true)); )
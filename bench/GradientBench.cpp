@@ -36,6 +36,10 @@ static const SkColor gColors[] = {
 
 static const SkColor gShallowColors[] = { 0xFF555555, 0xFF444444 };
 
+// Two-stop gradients are shaded directly instead of through the color table, with a faster
+// path when they're opaque, so also try one that isn't.
+static const SkColor gAlphaColors[] = { 0x80FF0000, 0xFF0000FF };
+
 // We have several special-cases depending on the number (and spacing) of colors, so
 // try to exercise those here.
 static const GradData gGradData[] = {
@@ -43,6 +47,7 @@ static const GradData gGradData[] = {
     { 50, gColors, NULL, "_hicolor" }, // many color gradient
     { 3, gColors, NULL, "_3color" },
     { 2, gShallowColors, NULL, "_shallow" },
+    { 2, gAlphaColors, NULL, "_alpha" },
 };
 
 /// Ignores scale
@@ -340,16 +345,28 @@ DEF_BENCH( return new GradientBench(kSweep_GradType, gGradData[3], false); )
 DEF_BENCH( return new GradientBench(kConical_GradType, gGradData[3], true); )
 DEF_BENCH( return new GradientBench(kConical_GradType, gGradData[3], false); )
 
+// Translucent
+DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[4]); )
+DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[4]); )
+DEF_BENCH( return new GradientBench(kConical_GradType, gGradData[4]); )
+
 ///////////////////////////////////////////////////////////////////////////////
 
 class Gradient2Bench : public Benchmark {
     SkString fName;
     bool     fHasAlpha;
+    bool     fIdentical;
 
 public:
-    Gradient2Bench(bool hasAlpha)  {
+    // If identical, every shader we create has the same colors, as when a document repeats one
+    // gradient many times.
+    Gradient2Bench(bool hasAlpha, bool identical = false)  {
         fName.printf("gradient_create_%s", hasAlpha ? "alpha" : "opaque");
+        if (identical) {
+            fName.append("_identical");
+        }
         fHasAlpha = hasAlpha;
+        fIdentical = identical;
     }
 
 protected:
@@ -368,7 +385,7 @@ protected:
         };
 
         for (int i = 0; i < loops; i++) {
-            const int gray = i % 256;
+            const int gray = fIdentical ? 0x80 : i % 256;
             const int alpha = fHasAlpha ? gray : 0xFF;
             SkColor colors[] = {
                 SK_ColorBLACK,
@@ -388,3 +405,5 @@ private:
 
 DEF_BENCH( return new Gradient2Bench(false); )
 DEF_BENCH( return new Gradient2Bench(true); )
+DEF_BENCH( return new Gradient2Bench(false, true); )
+DEF_BENCH( return new Gradient2Bench(true, true); )
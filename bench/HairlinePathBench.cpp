@@ -231,6 +231,27 @@ private:
     typedef HairlinePathBench INHERITED;
 };
 
+class ChartPathBench : public HairlinePathBench {
+public:
+    ChartPathBench(Flags flags) : INHERITED(flags) {}
+
+    virtual void appendName(SkString* name) SK_OVERRIDE {
+        name->append("chart");
+    }
+    virtual void makePath(SkPath* path) SK_OVERRIDE {
+        // one long polyline, wandering up and down as it goes across
+        SkRandom rand;
+        SkScalar y = SkIntToScalar(50);
+        path->moveTo(0, y);
+        for (int i = 1; i <= 200; ++i) {
+            y = SkScalarPin(y + rand.nextSScalar1() * 8, 0, SkIntToScalar(100));
+            path->lineTo(SkIntToScalar(i), y);
+        }
+    }
+private:
+    typedef HairlinePathBench INHERITED;
+};
+
 // FLAG00 - no AA, small
 // FLAG01 - no AA, small
 // FLAG10 - AA, big
@@ -256,3 +277,8 @@ DEF_BENCH( return new CubicPathBench(FLAGS00); )
 DEF_BENCH( return new CubicPathBench(FLAGS01); )
 DEF_BENCH( return new CubicPathBench(FLAGS10); )
 DEF_BENCH( return new CubicPathBench(FLAGS11); )
+
+DEF_BENCH( return new ChartPathBench(FLAGS00); )
+DEF_BENCH( return new ChartPathBench(FLAGS01); )
+DEF_BENCH( return new ChartPathBench(FLAGS10); )
+DEF_BENCH( return new ChartPathBench(FLAGS11); )
@@ -36,11 +36,59 @@ protected:
         SkPaint paint;
         paint.setImageFilter(merge);
         SkRect rect = SkRect::Make(SkIRect::MakeWH(400, 400));
-        canvas->drawRect(rect, paint);
+        for (int i = 0; i < loops; ++i) {
+            canvas->drawRect(rect, paint);
+        }
     }
 
 private:
     typedef Benchmark INHERITED;
 };
 
+// Draw the same bitmap through the same DAG every frame.  Since neither changes, the result can
+// be kept from one frame to the next, if we turn that on.
+
+class ImageFilterDAGRepeatBench : public Benchmark {
+public:
+    explicit ImageFilterDAGRepeatBench(bool persistent) : fPersistent(persistent) {
+    }
+
+protected:
+    virtual const char* onGetName() SK_OVERRIDE {
+        return fPersistent ? "image_filter_dag_repeat" : "image_filter_dag_repeat_uncached";
+    }
+
+    virtual void onPreDraw() SK_OVERRIDE {
+        fBitmap.allocN32Pixels(400, 400);
+        fBitmap.eraseColor(SK_ColorBLUE);
+
+        SkAutoTUnref<SkImageFilter> blur(SkBlurImageFilter::Create(20.0f, 20.0f));
+        SkImageFilter* inputs[kNumInputs];
+        for (int i = 0; i < kNumInputs; ++i) {
+            inputs[i] = blur.get();
+        }
+        fFilter.reset(SkMergeImageFilter::Create(inputs, kNumInputs));
+    }
+
+    virtual void onDraw(const int loops, SkCanvas* canvas) SK_OVERRIDE {
+        const size_t oldLimit =
+                SkImageFilter::Cache::SetTotalByteLimit(fPersistent ? 4 * 1024 * 1024 : 0);
+        SkPaint paint;
+        paint.setImageFilter(fFilter);
+        for (int i = 0; i < loops; ++i) {
+            canvas->drawSprite(fBitmap, 0, 0, &paint);
+        }
+        SkImageFilter::Cache::SetTotalByteLimit(oldLimit);
+    }
+
+private:
+    bool fPersistent;
+    SkBitmap fBitmap;
+    SkAutoTUnref<SkImageFilter> fFilter;
+
+    typedef Benchmark INHERITED;
+};
+
 DEF_BENCH(return new ImageFilterDAGBench;)
+DEF_BENCH(return new ImageFilterDAGRepeatBench(true);)
+DEF_BENCH(return new ImageFilterDAGRepeatBench(false);)
@@ -19,6 +19,7 @@
 class LineBench : public Benchmark {
     SkScalar    fStrokeWidth;
     bool        fDoAA;
+    SkCanvas::PointMode fMode;
     SkString    fName;
     enum {
         PTS = 500,
@@ -26,14 +27,26 @@ class LineBench : public Benchmark {
     SkPoint fPts[PTS];
 
 public:
-    LineBench(SkScalar width, bool doAA)  {
+    LineBench(SkScalar width, bool doAA,
+              SkCanvas::PointMode mode = SkCanvas::kLines_PointMode)  {
         fStrokeWidth = width;
         fDoAA = doAA;
-        fName.printf("lines_%g_%s", width, doAA ? "AA" : "BW");
+        fMode = mode;
 
         SkRandom rand;
-        for (int i = 0; i < PTS; ++i) {
-            fPts[i].set(rand.nextUScalar1() * 640, rand.nextUScalar1() * 480);
+        if (SkCanvas::kPolygon_PointMode == mode) {
+            // like a chart: one line across, wandering up and down
+            fName.printf("polyline_%g_%s", width, doAA ? "AA" : "BW");
+            SkScalar y = 240;
+            for (int i = 0; i < PTS; ++i) {
+                y = SkScalarPin(y + rand.nextSScalar1() * 16, 0, 480);
+                fPts[i].set(SkIntToScalar(640 * i) / PTS, y);
+            }
+        } else {
+            fName.printf("lines_%g_%s", width, doAA ? "AA" : "BW");
+            for (int i = 0; i < PTS; ++i) {
+                fPts[i].set(rand.nextUScalar1() * 640, rand.nextUScalar1() * 480);
+            }
         }
     }
 
@@ -51,7 +64,7 @@ protected:
         paint.setStrokeWidth(fStrokeWidth);
 
         for (int i = 0; i < loops; i++) {
-            canvas->drawPoints(SkCanvas::kLines_PointMode, PTS, fPts, paint);
+            canvas->drawPoints(fMode, PTS, fPts, paint);
         }
     }
 
@@ -64,3 +77,5 @@ DEF_BENCH(return new LineBench(SK_Scalar1,   false);)
 DEF_BENCH(return new LineBench(0,            true);)
 DEF_BENCH(return new LineBench(SK_Scalar1/2, true);)
 DEF_BENCH(return new LineBench(SK_Scalar1,   true);)
+DEF_BENCH(return new LineBench(0,            false, SkCanvas::kPolygon_PointMode);)
+DEF_BENCH(return new LineBench(0,            true,  SkCanvas::kPolygon_PointMode);)
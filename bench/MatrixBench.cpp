@@ -424,6 +424,63 @@ private:
     typedef MatrixBench INHERITED;
 };
 
+// Maps kCount points (or rects) per loop, so the time per point is the time per loop / kCount.
+class MapPointsMatrixBench : public MatrixBench {
+public:
+    enum Flag {
+        kScale_Flag         = 0x01,
+        kTranslate_Flag     = 0x02,
+        kRotate_Flag        = 0x04,
+        kPerspective_Flag   = 0x08,
+        kRects_Flag         = 0x10,
+    };
+
+    MapPointsMatrixBench(const char* name, int flags)
+        : INHERITED(name)
+        , fFlags(flags) {
+        fMatrix.reset();
+        if (flags & kScale_Flag) {
+            fMatrix.postScale(1.5f, 2.5f);
+        }
+        if (flags & kTranslate_Flag) {
+            fMatrix.postTranslate(1.5f, 2.5f);
+        }
+        if (flags & kRotate_Flag) {
+            fMatrix.postRotate(45.0f);
+        }
+        if (flags & kPerspective_Flag) {
+            fMatrix.setPerspX(0.0015f);
+            fMatrix.setPerspY(0.0025f);
+        }
+        SkRandom rand;
+        for (int i = 0; i < kCount; ++i) {
+            const SkScalar x = rand.nextRangeScalar(0, 1000);
+            const SkScalar y = rand.nextRangeScalar(0, 1000);
+            fSrc[i].setXYWH(x, y, rand.nextRangeScalar(1, 50), rand.nextRangeScalar(1, 50));
+        }
+    }
+
+protected:
+    virtual void performTest() {
+        if (fFlags & kRects_Flag) {
+            fMatrix.mapRects(fDst, fSrc, kCount);
+        } else {
+            fMatrix.mapPoints((SkPoint*)fDst, (const SkPoint*)fSrc, kCount);
+        }
+    }
+
+private:
+    enum {
+        kCount = 1024
+    };
+    SkMatrix fMatrix;
+    int fFlags;
+    // Rects, which mapPoints() treats as two points each (only the first kCount are mapped).
+    SkRect fSrc[kCount];
+    SkRect fDst[kCount];
+    typedef MatrixBench INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new EqualsMatrixBench(); )
@@ -470,3 +527,26 @@ DEF_BENCH( return new InvertMapRectMatrixBench(
 
 DEF_BENCH( return new ScaleTransMixedMatrixBench(); )
 DEF_BENCH( return new ScaleTransDoubleMatrixBench(); )
+
+DEF_BENCH( return new MapPointsMatrixBench("mappoints_translate",
+                                           MapPointsMatrixBench::kTranslate_Flag); )
+DEF_BENCH( return new MapPointsMatrixBench("mappoints_scale",
+                                           MapPointsMatrixBench::kScale_Flag); )
+DEF_BENCH( return new MapPointsMatrixBench("mappoints_scaletrans",
+                                           MapPointsMatrixBench::kScale_Flag |
+                                           MapPointsMatrixBench::kTranslate_Flag); )
+DEF_BENCH( return new MapPointsMatrixBench("mappoints_rotate",
+                                           MapPointsMatrixBench::kRotate_Flag); )
+DEF_BENCH( return new MapPointsMatrixBench("mappoints_rottrans",
+                                           MapPointsMatrixBench::kRotate_Flag |
+                                           MapPointsMatrixBench::kTranslate_Flag); )
+DEF_BENCH( return new MapPointsMatrixBench("mappoints_persp",
+                                           MapPointsMatrixBench::kPerspective_Flag); )
+DEF_BENCH( return new MapPointsMatrixBench("maprects_scaletrans",
+                                           MapPointsMatrixBench::kRects_Flag |
+                                           MapPointsMatrixBench::kScale_Flag |
+                                           MapPointsMatrixBench::kTranslate_Flag); )
+DEF_BENCH( return new MapPointsMatrixBench("maprects_rottrans",
+                                           MapPointsMatrixBench::kRects_Flag |
+                                           MapPointsMatrixBench::kRotate_Flag |
+                                           MapPointsMatrixBench::kTranslate_Flag); )
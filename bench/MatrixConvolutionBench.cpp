@@ -10,20 +10,32 @@
 #include "SkPaint.h"
 #include "SkRandom.h"
 #include "SkString.h"
+#include "SkTemplates.h"
 
 class MatrixConvolutionBench : public Benchmark {
 public:
-    MatrixConvolutionBench(SkMatrixConvolutionImageFilter::TileMode tileMode, bool convolveAlpha)
+    MatrixConvolutionBench(SkMatrixConvolutionImageFilter::TileMode tileMode, bool convolveAlpha,
+                           int kernelWidth = 3)
         : fName("matrixconvolution") {
-        SkISize kernelSize = SkISize::Make(3, 3);
-        SkScalar kernel[9] = {
-            SkIntToScalar( 1), SkIntToScalar( 1), SkIntToScalar( 1),
-            SkIntToScalar( 1), SkIntToScalar(-7), SkIntToScalar( 1),
-            SkIntToScalar( 1), SkIntToScalar( 1), SkIntToScalar( 1),
-        };
+        static const char* gTileModeName[] = { "clamp", "repeat", "clamptoblack" };
+        fName.appendf("_%s", gTileModeName[tileMode]);
+        if (!convolveAlpha) {
+            fName.append("_noalpha");
+        }
+        if (kernelWidth != 3) {
+            fName.appendf("_%dx%d", kernelWidth, kernelWidth);
+        }
+        // A Laplacian-ish kernel: 1 everywhere but a negative center, summing to 1.
+        SkISize kernelSize = SkISize::Make(kernelWidth, kernelWidth);
+        const int count = kernelWidth * kernelWidth;
+        SkAutoTMalloc<SkScalar> kernel(count);
+        for (int i = 0; i < count; ++i) {
+            kernel[i] = SK_Scalar1;
+        }
+        kernel[count / 2] = SkIntToScalar(2 - count);
         SkScalar gain = 0.3f, bias = SkIntToScalar(100);
-        SkIPoint kernelOffset = SkIPoint::Make(1, 1);
-        fFilter = SkMatrixConvolutionImageFilter::Create(kernelSize, kernel, gain, bias, kernelOffset, tileMode, convolveAlpha);
+        SkIPoint kernelOffset = SkIPoint::Make(kernelWidth / 2, kernelWidth / 2);
+        fFilter = SkMatrixConvolutionImageFilter::Create(kernelSize, kernel.get(), gain, bias, kernelOffset, tileMode, convolveAlpha);
     }
 
     ~MatrixConvolutionBench() {
@@ -58,3 +70,4 @@ DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kCl
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kRepeat_TileMode, true); )
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClampToBlack_TileMode, true); )
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClampToBlack_TileMode, false); )
+DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClamp_TileMode, true, 7); )
@@ -16,6 +16,7 @@
 #define SMALL   SkIntToScalar(2)
 #define REAL    1.5f
 #define BIG     SkIntToScalar(10)
+#define HUGE    SkIntToScalar(40)
 
 enum MorphologyType {
     kErode_MT,
@@ -30,19 +31,24 @@ static const char* gStyleName[] = {
 class MorphologyBench : public Benchmark {
     SkScalar       fRadius;
     MorphologyType fStyle;
+    int            fThreadCount;
     SkString       fName;
 
 public:
-    MorphologyBench(SkScalar rad, MorphologyType style)
+    MorphologyBench(SkScalar rad, MorphologyType style, int threadCount = 1)
          {
         fRadius = rad;
         fStyle = style;
+        fThreadCount = threadCount;
         const char* name = rad > 0 ? gStyleName[style] : "none";
         if (SkScalarFraction(rad) != 0) {
             fName.printf("morph_%.2f_%s", SkScalarToFloat(rad), name);
         } else {
             fName.printf("morph_%d_%s", SkScalarRoundToInt(rad), name);
         }
+        if (threadCount > 1) {
+            fName.appendf("_%dthreads", threadCount);
+        }
     }
 
 protected:
@@ -56,6 +62,8 @@ protected:
 
         paint.setAntiAlias(true);
 
+        const int oldThreadCount = SkImageFilter::GetThreadCount();
+        SkImageFilter::SetThreadCount(fThreadCount);
         SkRandom rand;
         for (int i = 0; i < loops; i++) {
             SkRect r = SkRect::MakeWH(rand.nextUScalar1() * 400,
@@ -78,6 +86,7 @@ protected:
             }
             canvas->drawOval(r, paint);
         }
+        SkImageFilter::SetThreadCount(oldThreadCount);
     }
 
 private:
@@ -90,6 +99,10 @@ DEF_BENCH( return new MorphologyBench(SMALL, kDilate_MT); )
 DEF_BENCH( return new MorphologyBench(BIG, kErode_MT); )
 DEF_BENCH( return new MorphologyBench(BIG, kDilate_MT); )
 
+DEF_BENCH( return new MorphologyBench(HUGE, kErode_MT); )
+DEF_BENCH( return new MorphologyBench(HUGE, kDilate_MT); )
+DEF_BENCH( return new MorphologyBench(HUGE, kDilate_MT, 4); )
+
 DEF_BENCH( return new MorphologyBench(REAL, kErode_MT); )
 DEF_BENCH( return new MorphologyBench(REAL, kDilate_MT); )
 
@@ -10,6 +10,7 @@
 #include "SkCanvas.h"
 #include "SkColorPriv.h"
 #include "SkPaint.h"
+#include "SkPathMeasure.h"
 #include "SkRandom.h"
 #include "SkShader.h"
 #include "SkString.h"
@@ -195,6 +196,27 @@ private:
     typedef PathBench INHERITED;
 };
 
+class LongCubicPathBench : public PathBench {
+public:
+    LongCubicPathBench(Flags flags) : INHERITED(flags) {}
+
+    virtual void appendName(SkString* name) SK_OVERRIDE {
+        name->append("long_cubic");
+    }
+    virtual void makePath(SkPath* path) SK_OVERRIDE {
+        SkRandom rand (12);
+        for (int i = 0; i < 100; i++) {
+            path->cubicTo(rand.nextUScalar1() * 640, rand.nextUScalar1() * 480,
+                          rand.nextUScalar1() * 640, rand.nextUScalar1() * 480,
+                          rand.nextUScalar1() * 640, rand.nextUScalar1() * 480);
+        }
+        path->close();
+    }
+    virtual int complexity() SK_OVERRIDE { return 2; }
+private:
+    typedef PathBench INHERITED;
+};
+
 class LongLinePathBench : public PathBench {
 public:
     LongLinePathBench(Flags flags) : INHERITED(flags) {}
@@ -224,6 +246,7 @@ protected:
     void createData(int minVerbs,
                     int maxVerbs,
                     bool allowMoves = true,
+                    bool allowCloses = true,
                     SkRect* bounds = NULL) {
         SkRect tempBounds;
         if (NULL == bounds) {
@@ -238,7 +261,8 @@ protected:
         for (int i = 0; i < kNumVerbs; ++i) {
             do {
                 fVerbs[i] = static_cast<SkPath::Verb>(fRandom.nextULessThan(SkPath::kDone_Verb));
-            } while (!allowMoves && SkPath::kMove_Verb == fVerbs[i]);
+            } while ((!allowMoves && SkPath::kMove_Verb == fVerbs[i]) ||
+                     (!allowCloses && SkPath::kClose_Verb == fVerbs[i]));
         }
         fPoints.reset(kNumPoints);
         for (int i = 0; i < kNumPoints; ++i) {
@@ -257,38 +281,42 @@ protected:
     void makePath(SkPath* path) {
         int vCount = fVerbCnts[(fCurrPath++) & (kNumVerbCnts - 1)];
         for (int v = 0; v < vCount; ++v) {
-            int verb = fVerbs[(fCurrVerb++) & (kNumVerbs - 1)];
-            switch (verb) {
-                case SkPath::kMove_Verb:
-                    path->moveTo(fPoints[(fCurrPoint++) & (kNumPoints - 1)]);
-                    break;
-                case SkPath::kLine_Verb:
-                    path->lineTo(fPoints[(fCurrPoint++) & (kNumPoints - 1)]);
-                    break;
-                case SkPath::kQuad_Verb:
-                    path->quadTo(fPoints[(fCurrPoint + 0) & (kNumPoints - 1)],
-                                 fPoints[(fCurrPoint + 1) & (kNumPoints - 1)]);
-                    fCurrPoint += 2;
-                    break;
-                case SkPath::kConic_Verb:
-                    path->conicTo(fPoints[(fCurrPoint + 0) & (kNumPoints - 1)],
-                                  fPoints[(fCurrPoint + 1) & (kNumPoints - 1)],
-                                  SK_ScalarHalf);
-                    fCurrPoint += 2;
-                    break;
-                case SkPath::kCubic_Verb:
-                    path->cubicTo(fPoints[(fCurrPoint + 0) & (kNumPoints - 1)],
-                                  fPoints[(fCurrPoint + 1) & (kNumPoints - 1)],
-                                  fPoints[(fCurrPoint + 2) & (kNumPoints - 1)]);
-                    fCurrPoint += 3;
-                    break;
-                case SkPath::kClose_Verb:
-                    path->close();
-                    break;
-                default:
-                    SkDEBUGFAIL("Unexpected path verb");
-                    break;
-            }
+            this->addVerb(path);
+        }
+    }
+
+    void addVerb(SkPath* path) {
+        int verb = fVerbs[(fCurrVerb++) & (kNumVerbs - 1)];
+        switch (verb) {
+            case SkPath::kMove_Verb:
+                path->moveTo(fPoints[(fCurrPoint++) & (kNumPoints - 1)]);
+                break;
+            case SkPath::kLine_Verb:
+                path->lineTo(fPoints[(fCurrPoint++) & (kNumPoints - 1)]);
+                break;
+            case SkPath::kQuad_Verb:
+                path->quadTo(fPoints[(fCurrPoint + 0) & (kNumPoints - 1)],
+                             fPoints[(fCurrPoint + 1) & (kNumPoints - 1)]);
+                fCurrPoint += 2;
+                break;
+            case SkPath::kConic_Verb:
+                path->conicTo(fPoints[(fCurrPoint + 0) & (kNumPoints - 1)],
+                              fPoints[(fCurrPoint + 1) & (kNumPoints - 1)],
+                              SK_ScalarHalf);
+                fCurrPoint += 2;
+                break;
+            case SkPath::kCubic_Verb:
+                path->cubicTo(fPoints[(fCurrPoint + 0) & (kNumPoints - 1)],
+                              fPoints[(fCurrPoint + 1) & (kNumPoints - 1)],
+                              fPoints[(fCurrPoint + 2) & (kNumPoints - 1)]);
+                fCurrPoint += 3;
+                break;
+            case SkPath::kClose_Verb:
+                path->close();
+                break;
+            default:
+                SkDEBUGFAIL("Unexpected path verb");
+                break;
         }
     }
 
@@ -345,6 +373,55 @@ private:
     typedef RandomPathBench INHERITED;
 };
 
+// Appends one segment at a time to a long path and queries the path after each one, the way an
+// interactive editor does.
+class PathAppendQueryBench : public RandomPathBench {
+public:
+    enum Query {
+        kBounds_Query,
+        kConvexity_Query,
+    };
+
+    PathAppendQueryBench(Query query) : fQuery(query) {}
+
+protected:
+    virtual const char* onGetName() SK_OVERRIDE {
+        return kBounds_Query == fQuery ? "path_append_query_bounds"
+                                       : "path_append_query_convexity";
+    }
+
+    virtual void onPreDraw() SK_OVERRIDE {
+        fParity = false;
+        // One open contour, as an editor would draw it.
+        this->createData(10, 100, false, false);
+    }
+
+    virtual void onDraw(const int loops, SkCanvas*) SK_OVERRIDE {
+        for (int i = 0; i < loops; ++i) {
+            if (i % kMaxVerbs == 0) {
+                fPath.rewind();
+            }
+            this->addVerb(&fPath);
+            if (kBounds_Query == fQuery) {
+                fParity ^= fPath.getBounds().isEmpty();
+            } else {
+                fParity ^= fPath.isConvex();
+            }
+        }
+        this->restartMakingPaths();
+    }
+
+private:
+    enum {
+        kMaxVerbs = 1000,
+    };
+    Query  fQuery;
+    bool   fParity; // attempt to keep compiler from optimizing out the queries
+    SkPath fPath;
+
+    typedef RandomPathBench INHERITED;
+};
+
 class PathCopyBench : public RandomPathBench {
 public:
     PathCopyBench()  {
@@ -566,6 +643,115 @@ private:
     typedef RandomPathBench INHERITED;
 };
 
+// Measures building an SkPathMeasure's segment table for a path of curves, which is dominated by
+// how many lines each curve is broken into.
+class PathMeasureBench : public Benchmark {
+public:
+    PathMeasureBench(bool cubics, SkScalar scale) {
+        fName.printf("path_measure_%s_%g", cubics ? "cubics" : "quads", scale);
+        SkRandom rand;
+        for (int i = 0; i < 100; i++) {
+            SkPoint pts[3];
+            for (int j = 0; j < 3; j++) {
+                pts[j].set(rand.nextUScalar1() * 640 * scale, rand.nextUScalar1() * 480 * scale);
+            }
+            if (cubics) {
+                fPath.cubicTo(pts[0], pts[1], pts[2]);
+            } else {
+                fPath.quadTo(pts[0], pts[1]);
+            }
+        }
+    }
+
+protected:
+    virtual const char* onGetName() SK_OVERRIDE {
+        return fName.c_str();
+    }
+
+    virtual bool isSuitableFor(Backend backend) SK_OVERRIDE {
+        return backend == kNonRendering_Backend;
+    }
+
+    virtual void onDraw(const int loops, SkCanvas*) SK_OVERRIDE {
+        for (int i = 0; i < loops; ++i) {
+            SkPathMeasure meas(fPath, false);
+            meas.getLength();
+        }
+    }
+
+private:
+    SkString fName;
+    SkPath   fPath;
+
+    typedef Benchmark INHERITED;
+};
+
+// Measures looking up many evenly spaced points along a curvy path, as a path effect or text on a
+// path would: one getPosTan() per point (with or without the index), or one getPosTanBatch().
+class PathMeasurePosTanBench : public Benchmark {
+public:
+    enum Mode {
+        kSearch_Mode,
+        kIndex_Mode,
+        kBatch_Mode,
+    };
+
+    PathMeasurePosTanBench(Mode mode) : fMode(mode) {
+        static const char* gNames[] = { "search", "index", "batch" };
+        fName.printf("path_measure_postan_%s", gNames[mode]);
+    }
+
+protected:
+    virtual const char* onGetName() SK_OVERRIDE {
+        return fName.c_str();
+    }
+
+    virtual bool isSuitableFor(Backend backend) SK_OVERRIDE {
+        return backend == kNonRendering_Backend;
+    }
+
+    virtual void onPreDraw() SK_OVERRIDE {
+        SkRandom rand;
+        fPath.reset();
+        for (int i = 0; i < 100; i++) {
+            fPath.cubicTo(rand.nextUScalar1() * 640, rand.nextUScalar1() * 480,
+                          rand.nextUScalar1() * 640, rand.nextUScalar1() * 480,
+                          rand.nextUScalar1() * 640, rand.nextUScalar1() * 480);
+        }
+        fMeasure.setPath(&fPath, false);
+        fMeasure.setUseIndex(kIndex_Mode == fMode);
+        const SkScalar length = fMeasure.getLength();
+        for (int i = 0; i < kCount; i++) {
+            fDistances[i] = length * i / kCount;
+        }
+    }
+
+    virtual void onDraw(const int loops, SkCanvas*) SK_OVERRIDE {
+        for (int i = 0; i < loops; ++i) {
+            if (kBatch_Mode == fMode) {
+                (void)fMeasure.getPosTanBatch(fDistances, kCount, fPos, fTan);
+            } else {
+                for (int j = 0; j < kCount; ++j) {
+                    (void)fMeasure.getPosTan(fDistances[j], &fPos[j], &fTan[j]);
+                }
+            }
+        }
+    }
+
+private:
+    enum {
+        kCount = 1000
+    };
+    Mode          fMode;
+    SkString      fName;
+    SkPath        fPath;
+    SkPathMeasure fMeasure;
+    SkScalar      fDistances[kCount];
+    SkPoint       fPos[kCount];
+    SkVector      fTan[kCount];
+
+    typedef Benchmark INHERITED;
+};
 
 class CirclesBench : public Benchmark {
 protected:
@@ -989,10 +1175,14 @@ DEF_BENCH( return new SawToothPathBench(FLAGS01); )
 
 DEF_BENCH( return new LongCurvedPathBench(FLAGS00); )
 DEF_BENCH( return new LongCurvedPathBench(FLAGS01); )
+DEF_BENCH( return new LongCubicPathBench(FLAGS00); )
+DEF_BENCH( return new LongCubicPathBench(FLAGS01); )
 DEF_BENCH( return new LongLinePathBench(FLAGS00); )
 DEF_BENCH( return new LongLinePathBench(FLAGS01); )
 
 DEF_BENCH( return new PathCreateBench(); )
+DEF_BENCH( return new PathAppendQueryBench(PathAppendQueryBench::kBounds_Query); )
+DEF_BENCH( return new PathAppendQueryBench(PathAppendQueryBench::kConvexity_Query); )
 DEF_BENCH( return new PathCopyBench(); )
 DEF_BENCH( return new PathTransformBench(true); )
 DEF_BENCH( return new PathTransformBench(false); )
@@ -1004,6 +1194,13 @@ DEF_BENCH( return new SkBench_AddPathTest(SkBench_AddPathTest::kAddMatrix_AddTyp
 DEF_BENCH( return new SkBench_AddPathTest(SkBench_AddPathTest::kReverseAdd_AddType); )
 DEF_BENCH( return new SkBench_AddPathTest(SkBench_AddPathTest::kReversePathTo_AddType); )
 
+DEF_BENCH( return new PathMeasureBench(false, SK_Scalar1); )
+DEF_BENCH( return new PathMeasureBench(true, SK_Scalar1); )
+DEF_BENCH( return new PathMeasureBench(true, SK_Scalar1 / 10); )
+DEF_BENCH( return new PathMeasurePosTanBench(PathMeasurePosTanBench::kSearch_Mode); )
+DEF_BENCH( return new PathMeasurePosTanBench(PathMeasurePosTanBench::kIndex_Mode); )
+DEF_BENCH( return new PathMeasurePosTanBench(PathMeasurePosTanBench::kBatch_Mode); )
+
 DEF_BENCH( return new CirclesBench(FLAGS00); )
 DEF_BENCH( return new CirclesBench(FLAGS01); )
 DEF_BENCH( return new ArbRoundRectBench(false); )
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#include "Benchmark.h"
+#include "SkPaint.h"
+#include "SkPath.h"
+#include "SkPathOps.h"
+#include "SkRandom.h"
+#include "SkString.h"
+#include "SkTArray.h"
+
+// Measures Simplify() on overlapping glyph outlines, as a font cleanup pass would see them.
+class PathOpsSimplifyBench : public Benchmark {
+public:
+    PathOpsSimplifyBench(const char* text, const char* name, int threadCount = 1)
+        : fText(text)
+        , fThreadCount(threadCount) {
+        fName.printf("pathops_simplify_%s", name);
+        if (threadCount > 1) {
+            fName.appendf("_%dthreads", threadCount);
+        }
+    }
+
+protected:
+    virtual const char* onGetName() SK_OVERRIDE {
+        return fName.c_str();
+    }
+
+    virtual bool isSuitableFor(Backend backend) SK_OVERRIDE {
+        return backend == kNonRendering_Backend;
+    }
+
+    virtual void onPreDraw() SK_OVERRIDE {
+        SkPaint paint;
+        paint.setTextSize(SkIntToScalar(48));
+        // Negative spacing makes neighboring glyphs overlap, so there is work to simplify.
+        SkTDArray<SkPoint> pos;
+        const size_t len = strlen(fText);
+        SkScalar x = 0;
+        for (size_t i = 0; i < len; ++i) {
+            pos.append()->set(x, SkIntToScalar(48 + (i & 1) * 5));
+            x += SkIntToScalar(20);
+        }
+        paint.getPosTextPath(fText, len, pos.begin(), &fPath);
+    }
+
+    virtual void onDraw(const int loops, SkCanvas*) SK_OVERRIDE {
+        SkPath result;
+        for (int i = 0; i < loops; ++i) {
+            Simplify(fPath, &result, fThreadCount);
+        }
+    }
+
+private:
+    const char* fText;
+    int         fThreadCount;
+    SkString    fName;
+    SkPath      fPath;
+
+    typedef Benchmark INHERITED;
+};
+
+// Measures Op() between two paths of many overlapping rounded rects and circles.
+class PathOpsOpBench : public Benchmark {
+public:
+    PathOpsOpBench(SkPathOp op, int count, const char* name, int threadCount = 1)
+        : fOp(op)
+        , fCount(count)
+        , fThreadCount(threadCount) {
+        fName.printf("pathops_op_%s_%d", name, count);
+        if (threadCount > 1) {
+            fName.appendf("_%dthreads", threadCount);
+        }
+    }
+
+protected:
+    virtual const char* onGetName() SK_OVERRIDE {
+        return fName.c_str();
+    }
+
+    virtual bool isSuitableFor(Backend backend) SK_OVERRIDE {
+        return backend == kNonRendering_Backend;
+    }
+
+    virtual void onPreDraw() SK_OVERRIDE {
+        SkRandom rand;
+        for (int i = 0; i < 2; ++i) {
+            fPaths[i].reset();
+            for (int j = 0; j < fCount; ++j) {
+                const SkScalar x = SkIntToScalar(rand.nextULessThan(200));
+                const SkScalar y = SkIntToScalar(rand.nextULessThan(200));
+                const SkScalar size = SkIntToScalar(10 + rand.nextULessThan(40));
+                if (rand.nextBool()) {
+                    fPaths[i].addCircle(x, y, size / 2);
+                } else {
+                    fPaths[i].addRoundRect(SkRect::MakeXYWH(x, y, size, size),
+                                           size / 4, size / 4);
+                }
+            }
+        }
+    }
+
+    virtual void onDraw(const int loops, SkCanvas*) SK_OVERRIDE {
+        SkPath result;
+        for (int i = 0; i < loops; ++i) {
+            Op(fPaths[0], fPaths[1], fOp, &result, fThreadCount);
+        }
+    }
+
+private:
+    SkPathOp fOp;
+    int      fCount;
+    int      fThreadCount;
+    SkString fName;
+    SkPath   fPaths[2];
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new PathOpsSimplifyBench("Hamburgefons", "text"); )
+DEF_BENCH( return new PathOpsSimplifyBench("WWMMWWMMWWMMWWMM", "wide_text"); )
+DEF_BENCH( return new PathOpsSimplifyBench("WWMMWWMMWWMMWWMM", "wide_text", 4); )
+DEF_BENCH( return new PathOpsOpBench(kUnion_PathOp, 4, "union"); )
+DEF_BENCH( return new PathOpsOpBench(kIntersect_PathOp, 4, "intersect"); )
+DEF_BENCH( return new PathOpsOpBench(kDifference_PathOp, 4, "difference"); )
+DEF_BENCH( return new PathOpsOpBench(kUnion_PathOp, 16, "union"); )
+DEF_BENCH( return new PathOpsOpBench(kUnion_PathOp, 16, "union", 4); )
+DEF_BENCH( return new PathOpsOpBench(kUnion_PathOp, 64, "union"); )
+DEF_BENCH( return new PathOpsOpBench(kUnion_PathOp, 64, "union", 4); )
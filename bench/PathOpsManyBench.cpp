@@ -0,0 +1,84 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#include "Benchmark.h"
+#include "SkPath.h"
+#include "SkPathOps.h"
+#include "SkRandom.h"
+#include "SkString.h"
+#include "SkTArray.h"
+
+// Unions count building footprints laid out on a grid, each overlapping some of its neighbors,
+// either with OpMany() or by folding Op() over them one at a time.
+class PathOpsManyBench : public Benchmark {
+public:
+    PathOpsManyBench(int count, bool fold)
+        : fCount(count)
+        , fFold(fold) {
+        fName.printf("pathops_%s_union_%d", fold ? "opfold" : "opmany", count);
+    }
+
+protected:
+    virtual const char* onGetName() SK_OVERRIDE {
+        return fName.c_str();
+    }
+
+    virtual bool isSuitableFor(Backend backend) SK_OVERRIDE {
+        return backend == kNonRendering_Backend;
+    }
+
+    virtual void onPreDraw() SK_OVERRIDE {
+        SkRandom rand;
+        const int columns = SkScalarCeilToInt(SkScalarSqrt(SkIntToScalar(fCount)));
+        fPaths.reset();
+        for (int i = 0; i < fCount; ++i) {
+            const SkScalar x = SkIntToScalar(i % columns * 10 + rand.nextULessThan(3));
+            const SkScalar y = SkIntToScalar(i / columns * 10 + rand.nextULessThan(3));
+            const SkScalar w = SkIntToScalar(4 + 2 * rand.nextULessThan(5));
+            const SkScalar h = SkIntToScalar(4 + 2 * rand.nextULessThan(5));
+            SkPath& path = fPaths.push_back();
+            if (rand.nextBool()) {
+                path.addRect(x, y, x + w, y + h);
+            } else {
+                // An L-shaped footprint.
+                path.moveTo(x, y);
+                path.lineTo(x + w, y);
+                path.lineTo(x + w, y + h / 2);
+                path.lineTo(x + w / 2, y + h / 2);
+                path.lineTo(x + w / 2, y + h);
+                path.lineTo(x, y + h);
+                path.close();
+            }
+        }
+    }
+
+    virtual void onDraw(const int loops, SkCanvas*) SK_OVERRIDE {
+        SkPath result;
+        for (int i = 0; i < loops; ++i) {
+            if (fFold) {
+                result = fPaths[0];
+                for (int j = 1; j < fCount; ++j) {
+                    Op(result, fPaths[j], kUnion_PathOp, &result);
+                }
+            } else {
+                OpMany(fPaths.begin(), fCount, kUnion_PathOp, &result);
+            }
+        }
+    }
+
+private:
+    int              fCount;
+    bool             fFold;
+    SkString         fName;
+    SkTArray<SkPath> fPaths;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new PathOpsManyBench(1000, true); )
+DEF_BENCH( return new PathOpsManyBench(1000, false); )
+DEF_BENCH( return new PathOpsManyBench(10000, false); )
+DEF_BENCH( return new PathOpsManyBench(100000, false); )
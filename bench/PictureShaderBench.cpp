@@ -0,0 +1,73 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#include "Benchmark.h"
+#include "SkCanvas.h"
+#include "SkPicture.h"
+#include "SkPictureRecorder.h"
+#include "SkShader.h"
+#include "SkString.h"
+
+// Fills a rect with a picture pattern, either with one shader for every draw, or with a new
+// shader each time, as a pattern fill that creates its shader per draw would.
+class PictureShaderBench : public Benchmark {
+public:
+    PictureShaderBench(bool newShaderPerDraw)
+        : fNewShaderPerDraw(newShaderPerDraw) {
+        fName.printf("pictureshader_%s", newShaderPerDraw ? "newshader" : "sameshader");
+    }
+
+protected:
+    virtual const char* onGetName() SK_OVERRIDE {
+        return fName.c_str();
+    }
+
+    virtual void onPreDraw() SK_OVERRIDE {
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(kTileSize, kTileSize, NULL, 0);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int i = 0; i < 16; ++i) {
+            paint.setColor(0xFF000000 | (i * 0x100F0D));
+            canvas->drawCircle(SkIntToScalar(i * 3), SkIntToScalar(i * 5 % kTileSize),
+                               SkIntToScalar(i + 4), paint);
+        }
+        fPicture.reset(recorder.endRecording());
+    }
+
+    virtual void onDraw(const int loops, SkCanvas* canvas) SK_OVERRIDE {
+        SkPaint paint;
+        const SkRect rect = SkRect::MakeWH(256, 256);
+        SkMatrix localMatrix;
+        localMatrix.setScale(1.5f, 1.5f);
+        if (!fNewShaderPerDraw) {
+            paint.setShader(SkShader::CreatePictureShader(fPicture, SkShader::kRepeat_TileMode,
+                                                          SkShader::kRepeat_TileMode,
+                                                          &localMatrix))->unref();
+        }
+        for (int i = 0; i < loops; ++i) {
+            if (fNewShaderPerDraw) {
+                paint.setShader(SkShader::CreatePictureShader(fPicture,
+                                                              SkShader::kRepeat_TileMode,
+                                                              SkShader::kRepeat_TileMode,
+                                                              &localMatrix))->unref();
+            }
+            canvas->drawRect(rect, paint);
+        }
+    }
+
+private:
+    enum { kTileSize = 64 };
+
+    bool                    fNewShaderPerDraw;
+    SkString                fName;
+    SkAutoTUnref<SkPicture> fPicture;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new PictureShaderBench(false); )
+DEF_BENCH( return new PictureShaderBench(true); )
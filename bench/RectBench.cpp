@@ -10,6 +10,7 @@
 #include "SkCommandLineFlags.h"
 #include "SkPaint.h"
 #include "SkRandom.h"
+#include "SkRRect.h"
 #include "SkShader.h"
 #include "SkString.h"
 
@@ -18,6 +19,7 @@ DEFINE_double(strokeWidth, -1.0, "If set, use this stroke width in RectBench.");
 class RectBench : public Benchmark {
 public:
     int fShift, fStroke;
+    bool fBatch;
     enum {
         W = 640,
         H = 480,
@@ -26,9 +28,11 @@ public:
     SkRect  fRects[N];
     SkColor fColors[N];
 
-    RectBench(int shift, int stroke = 0)
+    // If batch, the same rects are drawn N at a time, with drawRects() and the like.
+    RectBench(int shift, int stroke = 0, bool batch = false)
         : fShift(shift)
-        , fStroke(stroke) {}
+        , fStroke(stroke)
+        , fBatch(batch) {}
 
     SkString fName;
     const char* computeName(const char root[]) {
@@ -36,6 +40,9 @@ public:
         if (fStroke > 0) {
             fName.appendf("_stroke_%d", fStroke);
         }
+        if (fBatch) {
+            fName.append("_batch");
+        }
         return fName.c_str();
     }
 
@@ -44,6 +51,10 @@ protected:
         c->drawRect(r, p);
     }
 
+    virtual void drawTheseRects(SkCanvas* c, int count, const SkPaint& p) {
+        c->drawRects(fRects, fColors, count, p);
+    }
+
     virtual const char* onGetName() { return computeName("rects"); }
 
     virtual void onPreDraw() {
@@ -71,6 +82,13 @@ protected:
             paint.setStyle(SkPaint::kStroke_Style);
             paint.setStrokeWidth(SkIntToScalar(fStroke));
         }
+        if (fBatch) {
+            this->setupPaint(&paint);
+            for (int i = 0; i < loops; i += N) {
+                this->drawTheseRects(canvas, SkTMin<int>(N, loops - i), paint);
+            }
+            return;
+        }
         for (int i = 0; i < loops; i++) {
             paint.setColor(fColors[i % N]);
             this->setupPaint(&paint);
@@ -114,22 +132,39 @@ private:
 
 class OvalBench : public RectBench {
 public:
-    OvalBench(int shift, int stroke = 0) : RectBench(shift, stroke) {}
+    OvalBench(int shift, int stroke = 0, bool batch = false) : RectBench(shift, stroke, batch) {}
 protected:
     virtual void drawThisRect(SkCanvas* c, const SkRect& r, const SkPaint& p) {
         c->drawOval(r, p);
     }
+    virtual void drawTheseRects(SkCanvas* c, int count, const SkPaint& p) {
+        c->drawOvals(fRects, fColors, count, p);
+    }
     virtual const char* onGetName() { return computeName("ovals"); }
 };
 
 class RRectBench : public RectBench {
 public:
-    RRectBench(int shift, int stroke = 0) : RectBench(shift, stroke) {}
+    RRectBench(int shift, int stroke = 0, bool batch = false) : RectBench(shift, stroke, batch) {}
 protected:
+    virtual void onPreDraw() {
+        this->INHERITED::onPreDraw();
+        for (int i = 0; i < N; i++) {
+            fRRects[i].setRectXY(fRects[i], fRects[i].width() / 4, fRects[i].height() / 4);
+        }
+    }
     virtual void drawThisRect(SkCanvas* c, const SkRect& r, const SkPaint& p) {
         c->drawRoundRect(r, r.width() / 4, r.height() / 4, p);
     }
+    virtual void drawTheseRects(SkCanvas* c, int count, const SkPaint& p) {
+        c->drawRRects(fRRects, fColors, count, p);
+    }
     virtual const char* onGetName() { return computeName("rrects"); }
+
+private:
+    SkRRect fRRects[N];
+
+    typedef RectBench INHERITED;
 };
 
 class PointsBench : public RectBench {
@@ -316,6 +351,14 @@ DEF_BENCH( return SkNEW_ARGS(RRectBench, (1)); )
 DEF_BENCH( return SkNEW_ARGS(RRectBench, (1, 4)); )
 DEF_BENCH( return SkNEW_ARGS(RRectBench, (3)); )
 DEF_BENCH( return SkNEW_ARGS(RRectBench, (3, 4)); )
+DEF_BENCH( return SkNEW_ARGS(RectBench, (6)); )
+DEF_BENCH( return SkNEW_ARGS(RectBench, (6, 0, true)); )
+DEF_BENCH( return SkNEW_ARGS(OvalBench, (6)); )
+DEF_BENCH( return SkNEW_ARGS(OvalBench, (6, 0, true)); )
+DEF_BENCH( return SkNEW_ARGS(RectBench, (3, 0, true)); )
+DEF_BENCH( return SkNEW_ARGS(RectBench, (3, 4, true)); )
+DEF_BENCH( return SkNEW_ARGS(OvalBench, (3, 0, true)); )
+DEF_BENCH( return SkNEW_ARGS(RRectBench, (3, 0, true)); )
 DEF_BENCH( return SkNEW_ARGS(PointsBench, (SkCanvas::kPoints_PointMode, "points")); )
 DEF_BENCH( return SkNEW_ARGS(PointsBench, (SkCanvas::kLines_PointMode, "lines")); )
 DEF_BENCH( return SkNEW_ARGS(PointsBench, (SkCanvas::kPolygon_PointMode, "polygon")); )
@@ -101,4 +101,71 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Small rects with blurred drop shadows, like the bars of a chart. Rather than a looper, the
+// shadows are drawn with a blurred paint first, and then the rects over them, either one call per
+// rect, or (if batch) one drawRects() call for each pass.
+class RectShadowBench : public Benchmark {
+public:
+    RectShadowBench(bool batch) : fBatch(batch) {}
+
+protected:
+    virtual const char* onGetName() SK_OVERRIDE {
+        return fBatch ? "rect_shadows_batch" : "rect_shadows";
+    }
+
+    virtual void onPreDraw() SK_OVERRIDE {
+        SkRandom rand;
+        for (int i = 0; i < N; i++) {
+            SkScalar x = rand.nextRangeScalar(0, W - 20);
+            SkScalar y = rand.nextRangeScalar(0, H - 20);
+            fRects[i].setXYWH(x, y, rand.nextRangeScalar(4, 20), rand.nextRangeScalar(4, 20));
+            fShadows[i] = fRects[i];
+            fShadows[i].offset(2, 2);
+            fColors[i] = 0xFF000000 | rand.nextU();
+        }
+    }
+
+    virtual void onDraw(const int loops, SkCanvas* canvas) SK_OVERRIDE {
+        SkPaint shadowPaint;
+        shadowPaint.setAntiAlias(true);
+        shadowPaint.setColor(0x80000000);
+        shadowPaint.setMaskFilter(SkBlurMaskFilter::Create(kNormal_SkBlurStyle, 1.5f))->unref();
+
+        SkPaint paint;
+        paint.setAntiAlias(true);
+
+        for (int i = 0; i < loops; i += N) {
+            const int count = SkTMin<int>(N, loops - i);
+            if (fBatch) {
+                canvas->drawRects(fShadows, NULL, count, shadowPaint);
+                canvas->drawRects(fRects, fColors, count, paint);
+            } else {
+                for (int j = 0; j < count; j++) {
+                    canvas->drawRect(fShadows[j], shadowPaint);
+                }
+                for (int j = 0; j < count; j++) {
+                    paint.setColor(fColors[j]);
+                    canvas->drawRect(fRects[j], paint);
+                }
+            }
+        }
+    }
+
+private:
+    enum {
+        W = 640,
+        H = 480,
+        N = 100,
+    };
+
+    bool    fBatch;
+    SkRect  fRects[N];
+    SkRect  fShadows[N];
+    SkColor fColors[N];
+
+    typedef Benchmark INHERITED;
+};
+
 DEF_BENCH( return SkNEW_ARGS(RectoriBench, ()); )
+DEF_BENCH( return SkNEW_ARGS(RectShadowBench, (false)); )
+DEF_BENCH( return SkNEW_ARGS(RectShadowBench, (true)); )
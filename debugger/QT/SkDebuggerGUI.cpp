@@ -271,7 +271,7 @@ public:
         }
 
         // Check to see if there is a playback to recreate.
-        if (stream->readBool()) {
+        if (InternalOnly_StreamHasPlayback(stream, info)) {
             SkTimedPicturePlayback* playback = SkTimedPicturePlayback::CreateFromStream(
                                                                 stream,
                                                                 info, proc,
@@ -84,6 +84,27 @@ protected:
         after();
     }
 
+    virtual void drawRects(const SkDraw& dummy1, const SkRect rects[], const SkColor colors[],
+                           int count, const SkPaint& paint) {
+        before();
+        INHERITED::drawRects(dummy1, rects, colors, count, paint);
+        after();
+    }
+
+    virtual void drawOvals(const SkDraw& dummy1, const SkRect ovals[], const SkColor colors[],
+                           int count, const SkPaint& paint) {
+        before();
+        INHERITED::drawOvals(dummy1, ovals, colors, count, paint);
+        after();
+    }
+
+    virtual void drawRRects(const SkDraw& dummy1, const SkRRect rrects[], const SkColor colors[],
+                            int count, const SkPaint& paint) {
+        before();
+        INHERITED::drawRRects(dummy1, rrects, colors, count, paint);
+        after();
+    }
+
     virtual void drawPath(const SkDraw& dummy1, const SkPath& path,
                           const SkPaint& paint,
                           const SkMatrix* prePathMatrix = NULL,
@@ -116,6 +137,14 @@ protected:
         after();
     }
 
+    virtual void drawAtlas(const SkDraw& dummy1, const SkBitmap& atlas, const SkMatrix xforms[],
+                           const SkIRect tex[], const SkColor colors[], int count,
+                           const SkPaint& paint) {
+        before();
+        INHERITED::drawAtlas(dummy1, atlas, xforms, tex, colors, count, paint);
+        after();
+    }
+
     virtual void drawText(const SkDraw& dummy1, const void* text, size_t len,
                           SkScalar x, SkScalar y, const SkPaint& paint) {
         before();
@@ -18,6 +18,7 @@
         '../gm',       # needed to pull gm.h
         '../samplecode', # To pull SampleApp.h and SampleCode.h
         '../src/pipe/utils', # For TiledPipeController
+        '../src/utils', # For SkThreadUtils.h, needed by SamplePipeControllers.cpp
         '../src/utils/debugger',
       ],
       'includes': [
@@ -24,8 +24,14 @@
         '../bench/GMBench.h',
         '../bench/ResultsWriter.cpp',
         '../bench/benchmain.cpp',
+        '../src/pipe/utils/SamplePipeControllers.cpp',
+        '../src/pipe/utils/SamplePipeControllers.h',
         '../tools/sk_tool_utils.cpp',
       ],
+      'include_dirs': [
+        '../src/pipe/utils',
+        '../src/utils',
+      ],
       'conditions': [
         ['skia_gpu == 1',
           {
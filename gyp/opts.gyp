@@ -54,7 +54,16 @@
             '../src/opts/SkBlitRow_opts_SSE2.cpp',
             '../src/opts/SkBlitRect_opts_SSE2.cpp',
             '../src/opts/SkBlurImage_opts_SSE2.cpp',
+            '../src/opts/SkColorMatrix_opts_SSE2.cpp',
+            '../src/opts/SkGeometry_opts_SSE2.cpp',
+            '../src/opts/SkGradient_opts_SSE2.cpp',
+            '../src/opts/SkLighting_opts_SSE2.cpp',
+            '../src/opts/SkMatrixConvolution_opts_SSE2.cpp',
+            '../src/opts/SkMatrix_opts_SSE2.cpp',
             '../src/opts/SkMorphology_opts_SSE2.cpp',
+            '../src/opts/SkPerlinNoise_opts_SSE2.cpp',
+            '../src/opts/SkRect_opts_SSE2.cpp',
+            '../src/opts/SkScan_Antihair_opts_SSE2.cpp',
             '../src/opts/SkUtils_opts_SSE2.cpp',
             '../src/opts/SkXfermode_opts_SSE2.cpp',
           ],
@@ -80,7 +89,16 @@
             '../src/opts/SkBlitMask_opts_arm.cpp',
             '../src/opts/SkBlitRow_opts_arm.cpp',
             '../src/opts/SkBlurImage_opts_arm.cpp',
+            '../src/opts/SkColorMatrix_opts_none.cpp',
+            '../src/opts/SkGeometry_opts_none.cpp',
+            '../src/opts/SkGradient_opts_none.cpp',
+            '../src/opts/SkLighting_opts_none.cpp',
+            '../src/opts/SkMatrixConvolution_opts_none.cpp',
+            '../src/opts/SkMatrix_opts_none.cpp',
             '../src/opts/SkMorphology_opts_arm.cpp',
+            '../src/opts/SkPerlinNoise_opts_none.cpp',
+            '../src/opts/SkRect_opts_none.cpp',
+            '../src/opts/SkScan_Antihair_opts_none.cpp',
             '../src/opts/SkUtils_opts_arm.cpp',
             '../src/opts/SkXfermode_opts_arm.cpp',
           ],
@@ -105,7 +123,16 @@
             '../src/opts/SkBitmapProcState_opts_none.cpp',
             '../src/opts/SkBlitMask_opts_none.cpp',
             '../src/opts/SkBlurImage_opts_none.cpp',
+            '../src/opts/SkColorMatrix_opts_none.cpp',
+            '../src/opts/SkGeometry_opts_none.cpp',
+            '../src/opts/SkGradient_opts_none.cpp',
+            '../src/opts/SkLighting_opts_none.cpp',
+            '../src/opts/SkMatrixConvolution_opts_none.cpp',
+            '../src/opts/SkMatrix_opts_none.cpp',
             '../src/opts/SkMorphology_opts_none.cpp',
+            '../src/opts/SkPerlinNoise_opts_none.cpp',
+            '../src/opts/SkRect_opts_none.cpp',
+            '../src/opts/SkScan_Antihair_opts_none.cpp',
             '../src/opts/SkUtils_opts_none.cpp',
             '../src/opts/SkXfermode_opts_none.cpp',
           ],
@@ -130,7 +157,16 @@
             '../src/opts/SkBlitMask_opts_none.cpp',
             '../src/opts/SkBlitRow_opts_none.cpp',
             '../src/opts/SkBlurImage_opts_none.cpp',
+            '../src/opts/SkColorMatrix_opts_none.cpp',
+            '../src/opts/SkGeometry_opts_none.cpp',
+            '../src/opts/SkGradient_opts_none.cpp',
+            '../src/opts/SkLighting_opts_none.cpp',
+            '../src/opts/SkMatrixConvolution_opts_none.cpp',
+            '../src/opts/SkMatrix_opts_none.cpp',
             '../src/opts/SkMorphology_opts_none.cpp',
+            '../src/opts/SkPerlinNoise_opts_none.cpp',
+            '../src/opts/SkRect_opts_none.cpp',
+            '../src/opts/SkScan_Antihair_opts_none.cpp',
             '../src/opts/SkUtils_opts_none.cpp',
             '../src/opts/SkXfermode_opts_none.cpp',
           ],
@@ -154,8 +190,17 @@
             '../src/opts/SkBlitRow_opts_arm_neon.cpp',
             '../src/opts/SkBlurImage_opts_arm.cpp',
             '../src/opts/SkBlurImage_opts_neon.cpp',
+            '../src/opts/SkColorMatrix_opts_none.cpp',
+            '../src/opts/SkGeometry_opts_none.cpp',
+            '../src/opts/SkGradient_opts_none.cpp',
+            '../src/opts/SkLighting_opts_none.cpp',
+            '../src/opts/SkMatrixConvolution_opts_none.cpp',
+            '../src/opts/SkMatrix_opts_none.cpp',
             '../src/opts/SkMorphology_opts_arm.cpp',
             '../src/opts/SkMorphology_opts_neon.cpp',
+            '../src/opts/SkPerlinNoise_opts_none.cpp',
+            '../src/opts/SkRect_opts_none.cpp',
+            '../src/opts/SkScan_Antihair_opts_none.cpp',
             '../src/opts/SkUtils_opts_none.cpp',
             '../src/opts/SkXfermode_opts_arm.cpp',
             '../src/opts/SkXfermode_opts_arm_neon.cpp',
@@ -268,6 +268,7 @@
       'target_name': 'skpinfo',
       'type': 'executable',
       'sources': [
+        '../tools/ProcStats.cpp',
         '../tools/skpinfo.cpp',
       ],
       'include_dirs': [
@@ -275,6 +276,7 @@
         '../src/core/',
       ],
       'dependencies': [
+        'timer',
         'flags.gyp:flags',
         'skia_lib.gyp:skia_lib',
       ],
@@ -410,6 +412,7 @@
       'target_name': 'bench_playback',
       'type': 'executable',
       'sources': [
+        '../tools/ProcStats.cpp',
         '../tools/bench_playback.cpp',
       ],
       'include_dirs': [
@@ -70,6 +70,12 @@ protected:
                           const SkPaint& paint) SK_OVERRIDE;
     virtual void drawRRect(const SkDraw&, const SkRRect& rr,
                            const SkPaint& paint) SK_OVERRIDE;
+    virtual void drawRects(const SkDraw&, const SkRect rects[], const SkColor colors[],
+                           int count, const SkPaint&) SK_OVERRIDE;
+    virtual void drawOvals(const SkDraw&, const SkRect ovals[], const SkColor colors[],
+                           int count, const SkPaint&) SK_OVERRIDE;
+    virtual void drawRRects(const SkDraw&, const SkRRect rrects[], const SkColor colors[],
+                            int count, const SkPaint&) SK_OVERRIDE;
 
     /**
      *  If pathIsMutable, then the implementation is allowed to cast path to a
@@ -99,6 +105,9 @@ protected:
                                 const SkRect* srcOrNull, const SkRect& dst,
                                 const SkPaint& paint,
                                 SkCanvas::DrawBitmapRectFlags flags) SK_OVERRIDE;
+    virtual void drawAtlas(const SkDraw&, const SkBitmap& atlas, const SkMatrix xforms[],
+                           const SkIRect tex[], const SkColor colors[], int count,
+                           const SkPaint&) SK_OVERRIDE;
 
     /**
      *  Does not handle text decoration.
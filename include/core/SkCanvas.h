@@ -765,6 +765,36 @@ public:
      */
     void drawDRRect(const SkRRect& outer, const SkRRect& inner, const SkPaint&);
 
+    /**
+     *  Draw count rectangles with the one paint, as if drawRect() were called
+     *  for each of them. If colors is not NULL, colors[i] replaces the paint's
+     *  color for rects[i]. Drawing many small shapes this way is much cheaper
+     *  than one call per shape, as the paint is only set up once.
+     *
+     *  @param rects    The rectangles to draw
+     *  @param colors   If not NULL, the color of each rectangle
+     *  @param count    The number of rectangles (and colors)
+     *  @param paint    The paint used to draw the rectangles
+     */
+    void drawRects(const SkRect rects[], const SkColor colors[], int count,
+                   const SkPaint& paint);
+
+    /**
+     *  Draw count ovals with the one paint, as if drawOval() were called for
+     *  each of them. If colors is not NULL, colors[i] replaces the paint's
+     *  color for ovals[i].
+     */
+    void drawOvals(const SkRect ovals[], const SkColor colors[], int count,
+                   const SkPaint& paint);
+
+    /**
+     *  Draw count round-rects with the one paint, as if drawRRect() were called
+     *  for each of them. If colors is not NULL, colors[i] replaces the paint's
+     *  color for rrects[i].
+     */
+    void drawRRects(const SkRRect rrects[], const SkColor colors[], int count,
+                    const SkPaint& paint);
+
     /** Draw the specified circle using the specified paint. If radius is <= 0,
         then nothing will be drawn. The circle will be filled
         or framed based on the Style in the paint.
@@ -900,6 +930,25 @@ public:
     virtual void drawSprite(const SkBitmap& bitmap, int left, int top,
                             const SkPaint* paint = NULL);
 
+    /**
+     *  Draw count sprites from one atlas bitmap. Sprite i is the tex[i] part of
+     *  the atlas, placed with its top/left corner at the origin and then
+     *  transformed by xforms[i] (before the current matrix). This draws the
+     *  same as calling drawBitmapRectToRect(atlas, tex[i], its size) inside a
+     *  save()/concat(xforms[i])/restore() for each sprite, but lets the device
+     *  set up the paint and the bitmap once for all of them.
+     *
+     *  @param atlas    The bitmap holding all the sprites
+     *  @param xforms   Where to draw each sprite
+     *  @param tex      The part of the atlas to draw for each sprite
+     *  @param colors   If not NULL, colors[i] replaces the paint's color (and
+     *                  so its alpha) for sprite i
+     *  @param count    The number of sprites
+     *  @param paint    The paint used to draw the sprites, or NULL
+     */
+    void drawAtlas(const SkBitmap& atlas, const SkMatrix xforms[], const SkIRect tex[],
+                   const SkColor colors[], int count, const SkPaint* paint = NULL);
+
     /** Draw the text, with origin at (x,y), using the specified paint.
         The origin is interpreted based on the Align setting in the paint.
         @param text The text to be drawn
@@ -1213,6 +1262,24 @@ protected:
 
     virtual void onDrawDRRect(const SkRRect&, const SkRRect&, const SkPaint&);
 
+    virtual void onDrawRects(const SkRect[], const SkColor[], int count, const SkPaint&);
+    virtual void onDrawOvals(const SkRect[], const SkColor[], int count, const SkPaint&);
+    virtual void onDrawRRects(const SkRRect[], const SkColor[], int count, const SkPaint&);
+
+    // For subclasses that want a drawRects(), drawOvals() or drawRRects() batch
+    // to arrive as one drawRect(), drawOval() or drawRRect() call per shape.
+    void drawEachRect(const SkRect[], const SkColor[], int count, const SkPaint&);
+    void drawEachOval(const SkRect[], const SkColor[], int count, const SkPaint&);
+    void drawEachRRect(const SkRRect[], const SkColor[], int count, const SkPaint&);
+
+    virtual void onDrawAtlas(const SkBitmap&, const SkMatrix[], const SkIRect[],
+                             const SkColor[], int count, const SkPaint*);
+
+    // For subclasses that want a drawAtlas() batch to arrive as one
+    // drawBitmapRectToRect() call per sprite.
+    void drawEachSprite(const SkBitmap&, const SkMatrix[], const SkIRect[],
+                        const SkColor[], int count, const SkPaint*);
+
     virtual void onDrawText(const void* text, size_t byteLength, SkScalar x,
                             SkScalar y, const SkPaint& paint);
 
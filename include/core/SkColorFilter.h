@@ -123,6 +123,15 @@ public:
     */
     static SkColorFilter* CreateLightingFilter(SkColor mul, SkColor add);
 
+    /** Create a colorfilter that applies inner, and then outer to the result.
+        When the pair can be expressed as a single color matrix (e.g. two
+        matrices, where inner's never needs clamping, or a matrix and a
+        modulate/src-in/dst-in mode filter), or as a single per-component table,
+        that one filter is returned instead, so the colors are only visited
+        once. If either argument is NULL, the other is returned (with a ref).
+    */
+    static SkColorFilter* CreateComposeFilter(SkColorFilter* outer, SkColorFilter* inner);
+
     /** A subclass may implement this factory function to work with the GPU backend. If the return
         is non-NULL then the caller owns a ref on the returned object.
      */
@@ -208,6 +208,15 @@ protected:
     virtual void drawDRRect(const SkDraw&, const SkRRect& outer,
                             const SkRRect& inner, const SkPaint&);
 
+    // Default impls call drawRect(), drawOval() or drawRRect() for each shape,
+    // with colors[i] (if colors is not NULL) as the paint's color.
+    virtual void drawRects(const SkDraw&, const SkRect rects[], const SkColor colors[],
+                           int count, const SkPaint&);
+    virtual void drawOvals(const SkDraw&, const SkRect ovals[], const SkColor colors[],
+                           int count, const SkPaint&);
+    virtual void drawRRects(const SkDraw&, const SkRRect rrects[], const SkColor colors[],
+                            int count, const SkPaint&);
+
     /**
      *  If pathIsMutable, then the implementation is allowed to cast path to a
      *  non-const pointer and modify it in place (as an optimization). Canvas
@@ -237,6 +246,13 @@ protected:
                                 const SkPaint& paint,
                                 SkCanvas::DrawBitmapRectFlags flags) = 0;
 
+    // Default impl calls drawBitmapRect() for each sprite, with xforms[i]
+    // concatenated onto the draw's matrix, and colors[i] (if colors is not
+    // NULL) as the paint's color.
+    virtual void drawAtlas(const SkDraw&, const SkBitmap& atlas, const SkMatrix xforms[],
+                           const SkIRect tex[], const SkColor colors[], int count,
+                           const SkPaint&);
+
     /**
      *  Does not handle text decoration.
      *  Decorations (underline and stike-thru) will be handled by SkCanvas.
@@ -372,6 +388,7 @@ private:
     friend class SkDrawIter;
     friend class SkDeviceFilteredPaint;
     friend class SkDeviceImageFilterProxy;
+    friend class SkDeviceTileSink;      // for drawSprite
     friend class SkDeferredDevice;    // for newSurface
 
     friend class SkSurface_Raster;
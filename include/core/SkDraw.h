@@ -35,6 +35,17 @@ public:
                        const SkPaint&, bool forceUseDevice = false) const;
     void    drawRect(const SkRect&, const SkPaint&) const;
     void    drawRRect(const SkRRect&, const SkPaint&) const;
+    /**
+     *  Draw count shapes with the one paint, except that if colors is not null,
+     *  colors[i] replaces the paint's color for the i-th shape. The blitter is
+     *  only chosen again when the color changes from one shape to the next.
+     */
+    void    drawRects(const SkRect[], const SkColor colors[], int count,
+                      const SkPaint&) const;
+    void    drawOvals(const SkRect[], const SkColor colors[], int count,
+                      const SkPaint&) const;
+    void    drawRRects(const SkRRect[], const SkColor colors[], int count,
+                       const SkPaint&) const;
     /**
      *  To save on mallocs, we allow a flag that tells us that srcPath is
      *  mutable, so that we don't have to make copies of it as we transform it.
@@ -55,6 +66,14 @@ public:
 
     void    drawBitmap(const SkBitmap&, const SkMatrix&, const SkPaint&) const;
     void    drawSprite(const SkBitmap&, int x, int y, const SkPaint&) const;
+    /**
+     *  Draw the tex[i] part of the atlas at xforms[i] (before fMatrix), with
+     *  colors[i] (if colors is not null) as the paint's color. Sprites that
+     *  land on whole device pixels share one sprite blitter; the rest are
+     *  drawn through a bitmap shader, as drawBitmapRect() would.
+     */
+    void    drawAtlas(const SkBitmap& atlas, const SkMatrix xforms[], const SkIRect tex[],
+                      const SkColor colors[], int count, const SkPaint&) const;
     void    drawText(const char text[], size_t byteLength, SkScalar x,
                      SkScalar y, const SkPaint& paint) const;
     void    drawPosText(const char text[], size_t byteLength,
@@ -50,6 +50,27 @@ public:
 
     class SK_API Cache : public SkRefCnt {
     public:
+        /**
+         *  Everything a filter's result depends on: the filter itself, the
+         *  context's CTM and clip bounds, and the source pixels.
+         */
+        struct Key {
+            Key(uint32_t uniqueID, const SkMatrix& matrix, const SkIRect& clipBounds,
+                uint32_t srcGenID, const SkIRect& srcSubset)
+                : fUniqueID(uniqueID), fMatrix(matrix), fClipBounds(clipBounds)
+                , fSrcGenID(srcGenID), fSrcSubset(srcSubset) {}
+            bool operator==(const Key& other) const {
+                return fUniqueID == other.fUniqueID && fMatrix == other.fMatrix &&
+                       fClipBounds == other.fClipBounds && fSrcGenID == other.fSrcGenID &&
+                       fSrcSubset == other.fSrcSubset;
+            }
+            uint32_t fUniqueID;
+            SkMatrix fMatrix;
+            SkIRect  fClipBounds;
+            uint32_t fSrcGenID;
+            SkIRect  fSrcSubset;    // Of the source's pixel ref.
+        };
+
         // By default, we cache only image filters with 2 or more children.
         static Cache* Create(int minChildren = 2);
         virtual ~Cache() {}
@@ -57,6 +78,26 @@ public:
         virtual void set(const SkImageFilter* key,
                          const SkBitmap& result, const SkIPoint& offset) = 0;
         virtual void remove(const SkImageFilter* key) = 0;
+
+        /**
+         *  Like get() and set(), but for raster results which stay valid from
+         *  one draw to the next.  By default these use a process-wide cache
+         *  which keeps the most recently used results, up to a byte limit.
+         *  That limit is 0, turning it off, unless set with SetTotalByteLimit()
+         *  or SK_DEFAULT_IMAGE_FILTER_CACHE_LIMIT.  An external cache can
+         *  override them to keep results elsewhere, or to keep none.
+         */
+        virtual bool getPersistent(const Key& key, SkBitmap* result, SkIPoint* offset);
+        virtual void setPersistent(const Key& key, const SkBitmap& result, const SkIPoint& offset);
+
+        /**
+         *  The byte limit and usage of the process-wide cache.  Setting the
+         *  limit purges results as needed to fit, and returns the old limit.
+         *  A limit of 0 disables it.
+         */
+        static size_t GetTotalByteLimit();
+        static size_t SetTotalByteLimit(size_t newLimit);
+        static size_t GetTotalBytesUsed();
     };
 
     class Context {
@@ -87,6 +128,16 @@ public:
                                  SkBitmap* result, SkIPoint* offset) = 0;
     };
 
+    /**
+     *  Receives the result of filterImageTiled() one tile at a time.
+     */
+    class TileSink {
+    public:
+        virtual ~TileSink() {}
+        // tile goes at (x, y), relative to the src passed to filterImageTiled().
+        virtual void drawTile(const SkBitmap& tile, int x, int y) = 0;
+    };
+
     /**
      *  Request a new (result) image to be created from the src image.
      *  If the src has no pixels (isNull()) then the request just wants to
@@ -103,6 +154,32 @@ public:
     bool filterImage(Proxy*, const SkBitmap& src, const Context&,
                      SkBitmap* result, SkIPoint* offset) const;
 
+    /**
+     *  Like filterImage(), but finds the result one tileSize x tileSize tile
+     *  of the context's (finite) clip bounds at a time, and hands each tile
+     *  to sink.  Each tile filters only the part of src it depends on, and
+     *  intermediate results are reused from tile to tile, so memory use is
+     *  about the size of a tile (plus the margins the filter reads around it)
+     *  times the depth of the filter DAG, instead of the size of src.
+     *
+     *  Unlike filterImage(), the clip bounds only decide which tiles to find;
+     *  intermediate results aren't clipped to them.  The context's cache is
+     *  not used, and neither results nor intermediates are kept from one draw
+     *  to the next.  Returns false if no tile could be found.
+     *
+     *  If !canFilterTiled(), this just hands all of filterImage()'s result to
+     *  sink as one tile.
+     */
+    bool filterImageTiled(Proxy*, const SkBitmap& src, const Context&, int tileSize,
+                          TileSink*) const;
+
+    /**
+     *  Returns true if filterImageTiled() can find this filter's result a tile
+     *  at a time: that is, if this filter and all its inputs say which source
+     *  pixels each tile depends on with onFilterBounds().
+     */
+    bool canFilterTiled() const;
+
     /**
      *  Given the src bounds of an image, this returns the bounds of the result
      *  image after the filter has been applied.
@@ -167,6 +244,12 @@ public:
      */
     bool cropRectIsSet() const { return fCropRect.flags() != 0x0; }
 
+    /**
+     *  Returns an ID unique to this filter in this process.  Since filters are
+     *  immutable, this identifies the filter's behavior for caching.
+     */
+    uint32_t uniqueID() const { return fUniqueID; }
+
     // Default impl returns union of all input bounds.
     virtual void computeFastBounds(const SkRect&, SkRect*) const;
 
@@ -195,6 +278,31 @@ public:
      */
     static Cache* GetExternalCache();
 
+    /**
+     *  Set the tile size SkCanvas uses to filter images bigger than a tile
+     *  with filterImageTiled().  0, the default, means never tile.
+     */
+    static void SetTileSize(int tileSize);
+    static int GetTileSize();
+
+    /**
+     *  Set how many threads filters that work on independent bands of pixels
+     *  (e.g. morphology and matrix convolution) may split a large image across.
+     *  1, the default, means filtering always happens on the calling thread.
+     */
+    static void SetThreadCount(int threadCount);
+    static int GetThreadCount();
+
+    typedef void (*BandProc)(void* context, int start, int stop);
+
+    /**
+     *  For filter implementations: calls proc on consecutive bands [start, stop)
+     *  that together cover [0, count), and returns once all of them are done.
+     *  Bands run on up to GetThreadCount() threads, but each is at least
+     *  minBandSize long, so small jobs stay on the calling thread.
+     */
+    static void RunInBands(BandProc proc, void* context, int count, int minBandSize);
+
     SK_DEFINE_FLATTENABLE_TYPE(SkImageFilter)
 
 protected:
@@ -246,6 +354,12 @@ protected:
     // no inputs.
     virtual bool onFilterBounds(const SkIRect&, const SkMatrix&, SkIRect*) const;
 
+    // Return true if onFilterBounds() covers every pixel of its inputs' results
+    // this filter reads, not just the ones under the destination rect.  The
+    // default returns false, so filterImageTiled() won't tile filters which
+    // read a margin around each pixel but don't report it.
+    virtual bool onCanFilterTiled() const;
+
     /** Computes source bounds as the src bitmap bounds offset by srcOffset.
      *  Apply the transformed crop rect to the bounds if any of the
      *  corresponding edge flags are set. Intersects the result against the
@@ -291,6 +405,7 @@ private:
     int fInputCount;
     SkImageFilter** fInputs;
     CropRect fCropRect;
+    uint32_t fUniqueID;
 };
 
 #endif
@@ -478,6 +478,16 @@ public:
         return this->mapRect(rect, *rect);
     }
 
+    /** Apply this matrix to each of the count rectangles in src, and write the
+        transformed rectangles into dst, as mapRect() does for one. Mapping
+        them all at once is faster than calling mapRect() on each.
+        @param dst  Where the transformed rectangles are written.
+        @param src  The original rectangles to be transformed. May be dst.
+        @param count The number of rectangles.
+        @return the result of calling rectStaysRect()
+    */
+    bool mapRects(SkRect dst[], const SkRect src[], int count) const;
+
     /** Apply this matrix to the src rectangle, and write the four transformed
         points into dst. The points written to dst will be the original top-left, top-right,
         bottom-right, and bottom-left points transformed by the matrix.
@@ -982,6 +982,9 @@ private:
     uint8_t             fFillType;
     mutable uint8_t     fConvexity;
     mutable uint8_t     fDirection;
+    // Set when fConvexity is kConcave_Convexity because of points that were followed by more of
+    // the path, so no amount of appending to the path can make it convex.
+    mutable uint8_t     fStaysConcave;
 #ifdef SK_BUILD_FOR_ANDROID
     const SkPath*       fSourcePath;
 #endif
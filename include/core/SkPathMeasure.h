@@ -26,9 +26,21 @@ public:
         for the lifetime of the measure object, or until setPath() is called with
         a different path (or null), since the measure object keeps a pointer to the
         path object (does not copy its data).
+        If this is the path already being measured, with the same forceClosed and
+        generation ID, and the measure has not moved past its first contour, what
+        has been computed for that contour is kept. So a measure object can be
+        held on to, and reset with the same path, without measuring it again.
     */
     void setPath(const SkPath*, bool forceClosed);
 
+    /** If true, getPosTan(), getMatrix() and getSegment() find their place along
+        each contour through a table (one int per segment, built along with the
+        contour's segments), rather than by a binary search over the segments.
+        This is worth it when a contour will be queried many times. Defaults to
+        false.
+    */
+    void setUseIndex(bool useIndex);
+
     /** Return the total length of the current contour, or 0 if no path
         is associated (e.g. resetPath(null))
     */
@@ -42,6 +54,17 @@ public:
     bool SK_WARN_UNUSED_RESULT getPosTan(SkScalar distance, SkPoint* position,
                                          SkVector* tangent);
 
+    /** Same as calling getPosTan() for each of the count distances, which should
+        be in increasing order: the segments are then found in one walk along the
+        contour, from wherever the first distance falls (out of order distances
+        are still handled, just more slowly).
+        positions and tangents may each be null.
+        Returns false if there is no path, or a zero-length path was specified, in
+        which case positions and tangents are unchanged.
+    */
+    bool SK_WARN_UNUSED_RESULT getPosTanBatch(const SkScalar distances[], int count,
+                                              SkPoint positions[], SkVector tangents[]);
+
     enum MatrixFlags {
         kGetPosition_MatrixFlag     = 0x01,
         kGetTangent_MatrixFlag      = 0x02,
@@ -84,6 +107,9 @@ private:
     int             fFirstPtIndex;      // relative to the current contour
     bool            fIsClosed;          // relative to the current contour
     bool            fForceClosed;
+    bool            fUseIndex;
+    bool            fOnFirstContour;
+    uint32_t        fGenerationID;      // of fPath, when setPath() was called
 
     struct Segment {
         SkScalar    fDistance;  // total distance up to this point
@@ -95,14 +121,18 @@ private:
     };
     SkTDArray<Segment>  fSegments;
     SkTDArray<SkPoint>  fPts; // Points used to define the segments
+    // fIndex[i] is the first segment that reaches i / fIndexScale along the contour
+    SkTDArray<int>      fIndex;
+    SkScalar            fIndexScale;
 
     static const Segment* NextSegment(const Segment*);
 
     void     buildSegments();
-    SkScalar compute_quad_segs(const SkPoint pts[3], SkScalar distance,
-                                int mint, int maxt, int ptIndex);
-    SkScalar compute_cubic_segs(const SkPoint pts[3], SkScalar distance,
-                                int mint, int maxt, int ptIndex);
+    SkScalar compute_curve_segs(const SkPoint flat[], int count, int segType,
+                                SkScalar distance, int ptIndex);
+    void     buildIndex();
+    int      findSegment(SkScalar distance) const;
+    const Segment* segmentT(int index, SkScalar distance, SkScalar* t) const;
     const Segment* distanceToSegment(SkScalar distance, SkScalar* t);
 };
 
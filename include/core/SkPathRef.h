@@ -262,6 +262,7 @@ private:
 
     SkPathRef() {
         fBoundsIsDirty = true;    // this also invalidates fIsFinite
+        fBoundsPointCnt = 0;
         fPointCnt = 0;
         fVerbCnt = 0;
         fVerbs = NULL;
@@ -287,19 +288,36 @@ private:
         }
     }
 
+    // Grows bounds (the finite bounds of 2 or more points) to also hold pts[0..count-1].
+    // Returns false, and sets bounds to empty, if any of those points is not finite.
+    static bool ExtendPtBounds(SkRect* bounds, const SkPoint pts[], int count);
+
     // called, if dirty, by getBounds()
     void computeBounds() const {
         SkDEBUGCODE(this->validate();)
         SkASSERT(fBoundsIsDirty);
 
-        fIsFinite = ComputePtBounds(&fBounds, *this);
+        // If the path has only been appended to since the bounds were last computed, only the
+        // new points need to be looked at. Bounds that ignored a lone moveTo are recomputed, and
+        // a non-finite point stays non-finite.
+        if (fBoundsPointCnt > 1) {
+            if (fIsFinite) {
+                fIsFinite = ExtendPtBounds(&fBounds, fPoints + fBoundsPointCnt,
+                                           fPointCnt - fBoundsPointCnt);
+            }
+        } else {
+            fIsFinite = ComputePtBounds(&fBounds, *this);
+        }
+        fBoundsPointCnt = fPointCnt;
         fBoundsIsDirty = false;
     }
 
+    // rect must hold every point, since later appends just extend it.
     void setBounds(const SkRect& rect) {
         SkASSERT(rect.fLeft <= rect.fRight && rect.fTop <= rect.fBottom);
         fBounds = rect;
         fBoundsIsDirty = false;
+        fBoundsPointCnt = fPointCnt;
         fIsFinite = fBounds.isFinite();
     }
 
@@ -317,6 +335,7 @@ private:
                      int reserveVerbs = 0, int reservePoints = 0) {
         SkDEBUGCODE(this->validate();)
         fBoundsIsDirty = true;      // this also invalidates fIsFinite
+        fBoundsPointCnt = 0;
         fGenerationID = 0;
 
         fSegmentMask = 0;
@@ -422,9 +441,14 @@ private:
 
     void setIsOval(bool isOval) { fIsOval = isOval; }
 
+    /**
+     * The caller may change any of the points, so the bounds must be recomputed from scratch.
+     */
     SkPoint* getPoints() {
         SkDEBUGCODE(this->validate();)
         fIsOval = false;
+        fBoundsIsDirty = true;      // this also invalidates fIsFinite
+        fBoundsPointCnt = 0;
         return fPoints;
     }
 
@@ -437,6 +461,10 @@ private:
     mutable uint8_t     fBoundsIsDirty;
     mutable SkBool8     fIsFinite;    // only meaningful if bounds are valid
     mutable SkBool8     fIsOval;
+    // How many of the leading points fBounds and fIsFinite were computed from. While only
+    // growForVerb() and growForRepeatedVerb() have changed the path since, they stay true of
+    // those points, even though fBoundsIsDirty is set.
+    mutable int         fBoundsPointCnt;
 
     SkPoint*            fPoints; // points to begining of the allocation
     uint8_t*            fVerbs; // points just past the end of the allocation (verbs grow backwards)
@@ -102,6 +102,20 @@ public:
     static SkPicture* CreateFromStream(SkStream*,
                                        InstallPixelRefProc proc = &SkImageDecoder::DecodeMemory);
 
+    /**
+     *  Recreate a picture that was serialized into an SkData (e.g. one returned by
+     *  SkData::NewFromFD or SkData::NewFromFileName, which mmap the file when possible).
+     *  Unlike CreateFromStream, the returned picture may reference the op data in place
+     *  rather than copying it, in which case it holds a ref on the SkData.
+     *  @param SkData Serialized picture data.
+     *  @param proc Function pointer for installing pixelrefs on SkBitmaps representing the
+     *              encoded bitmap data from the stream.
+     *  @return A new SkPicture representing the serialized data, or NULL if the data is
+     *          invalid.
+     */
+    static SkPicture* CreateFromData(SkData*,
+                                     InstallPixelRefProc proc = &SkImageDecoder::DecodeMemory);
+
     /**
      *  Recreate a picture that was serialized into a buffer. If the creation requires bitmap
      *  decoding, the decoder must be set on the SkReadBuffer parameter by calling
@@ -208,6 +222,12 @@ public:
     static bool InternalOnly_StreamIsSKP(SkStream*, SkPictInfo*);
     static bool InternalOnly_BufferIsSKP(SkReadBuffer&, SkPictInfo*);
 
+    /** Read the flag that follows the SkPictInfo in a serialized stream, returning
+        true if a flattened playback follows it. Call after InternalOnly_StreamIsSKP,
+        passing the SkPictInfo it filled out.
+    */
+    static bool InternalOnly_StreamHasPlayback(SkStream*, const SkPictInfo&);
+
     /** Return true if the picture is suitable for rendering on the GPU.
      */
 
@@ -245,13 +265,15 @@ protected:
     // V26: Removed boolean from SkColorShader for inheriting color from SkPaint.
     // V27: Remove SkUnitMapper from gradients (and skia).
     // V28: No longer call bitmap::flatten inside SkWriteBuffer::writeBitmap.
+    // V29: The has-playback flag in streams is a 32-bit word, keeping the chunks that
+    //      follow 4-byte aligned so memory-backed SKPs can be read in place.
 
     // Note: If the picture version needs to be increased then please follow the
     // steps to generate new SKPs in (only accessible to Googlers): http://goo.gl/qATVcw
 
     // Only SKPs within the min/current picture version range (inclusive) can be read.
     static const uint32_t MIN_PICTURE_VERSION = 19;
-    static const uint32_t CURRENT_PICTURE_VERSION = 28;
+    static const uint32_t CURRENT_PICTURE_VERSION = 29;
 
     mutable uint32_t      fUniqueID;
 
@@ -309,6 +331,10 @@ private:
     void createHeader(SkPictInfo* info) const;
     static bool IsValidPictInfo(const SkPictInfo& info);
 
+    // If backing is non-NULL, the stream must be a view of it; op data may then be
+    // referenced from backing rather than copied.
+    static SkPicture* CreateFromStream(SkStream*, InstallPixelRefProc, const SkData* backing);
+
     friend class SkFlatPicture;
     friend class SkPicturePlayback;
     friend class SkPictureRecorder; // just for SkPicture-based constructor
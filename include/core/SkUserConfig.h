@@ -117,6 +117,14 @@
  */
 //#define SK_DEFAULT_IMAGE_CACHE_LIMIT (1024 * 1024)
 
+/*
+ *  To specify the default size of the cache which keeps image filter results
+ *  from one draw to the next, define this (in bytes). SkImageFilter::Cache
+ *  has a runtime API to set this value as well. If this is undefined, the
+ *  cache is off until that API turns it on.
+ */
+//#define SK_DEFAULT_IMAGE_FILTER_CACHE_LIMIT (4 * 1024 * 1024)
+
 /*  If zlib is available and you want to support the flate compression
     algorithm (used in PDF generation), define SK_ZLIB_INCLUDE to be the
     include path. Alternatively, define SK_SYSTEM_ZLIB to use the system zlib
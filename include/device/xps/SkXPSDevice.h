@@ -88,6 +88,36 @@ protected:
         const SkRRect&,
         const SkPaint& paint) SK_OVERRIDE;
 
+    virtual void drawRects(
+        const SkDraw&,
+        const SkRect rects[],
+        const SkColor colors[],
+        int count,
+        const SkPaint& paint) SK_OVERRIDE;
+
+    virtual void drawOvals(
+        const SkDraw&,
+        const SkRect ovals[],
+        const SkColor colors[],
+        int count,
+        const SkPaint& paint) SK_OVERRIDE;
+
+    virtual void drawRRects(
+        const SkDraw&,
+        const SkRRect rrects[],
+        const SkColor colors[],
+        int count,
+        const SkPaint& paint) SK_OVERRIDE;
+
+    virtual void drawAtlas(
+        const SkDraw&,
+        const SkBitmap& atlas,
+        const SkMatrix xforms[],
+        const SkIRect tex[],
+        const SkColor colors[],
+        int count,
+        const SkPaint& paint) SK_OVERRIDE;
+
     virtual void drawPath(
         const SkDraw&,
         const SkPath& platonicPath,
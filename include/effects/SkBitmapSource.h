@@ -33,6 +33,7 @@ protected:
     virtual bool onFilterImage(Proxy*, const SkBitmap& src, const Context&,
                                SkBitmap* result, SkIPoint* offset) const SK_OVERRIDE;
     virtual bool onFilterBounds(const SkIRect& src, const SkMatrix& ctm, SkIRect* dst) const SK_OVERRIDE;
+    virtual bool onCanFilterTiled() const SK_OVERRIDE { return true; }
 
 private:
     SkBitmap fBitmap;
@@ -50,7 +50,12 @@ private:
     typedef void (*Proc)(const State&, unsigned r, unsigned g, unsigned b,
                          unsigned a, int32_t result[4]);
 
+    // The platform's faster span proc, looked up once, or NULL to use fProc.
+    typedef void (*SpanProc)(const int32_t matrix[20], int shift, const SkPMColor src[],
+                             int count, SkPMColor dst[]);
+
     Proc        fProc;
+    SpanProc    fSpanProc;
     State       fState;
     uint32_t    fFlags;
 
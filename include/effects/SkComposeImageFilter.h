@@ -27,6 +27,7 @@ protected:
     virtual bool onFilterImage(Proxy*, const SkBitmap& src, const Context&,
                                SkBitmap* result, SkIPoint* loc) const SK_OVERRIDE;
     virtual bool onFilterBounds(const SkIRect&, const SkMatrix&, SkIRect*) const SK_OVERRIDE;
+    virtual bool onCanFilterTiled() const SK_OVERRIDE { return true; }
 
 private:
     typedef SkImageFilter INHERITED;
@@ -35,6 +35,7 @@ protected:
     virtual bool onFilterImage(Proxy*, const SkBitmap& source, const Context&, SkBitmap* result, SkIPoint* loc) const SK_OVERRIDE;
     virtual bool onFilterBounds(const SkIRect& src, const SkMatrix&,
                                 SkIRect* dst) const SK_OVERRIDE;
+    virtual bool onCanFilterTiled() const SK_OVERRIDE { return true; }
 
 private:
     SkScalar fDx, fDy, fSigmaX, fSigmaY;
@@ -83,6 +83,7 @@ protected:
     virtual bool onFilterImage(Proxy*, const SkBitmap& src, const Context&,
                                SkBitmap* result, SkIPoint* loc) const SK_OVERRIDE;
     virtual bool onFilterBounds(const SkIRect&, const SkMatrix&, SkIRect*) const SK_OVERRIDE;
+    virtual bool onCanFilterTiled() const SK_OVERRIDE { return true; }
 
 
 #if SK_SUPPORT_GPU
@@ -120,6 +121,8 @@ private:
                             SkBitmap* result,
                             const SkIRect& rect,
                             const SkIRect& bounds) const;
+    // SkImageFilter::BandProc filtering the rows [start, stop) of the result.
+    static void FilterRows(void* context, int start, int stop);
 };
 
 #endif
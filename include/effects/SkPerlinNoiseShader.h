@@ -83,14 +83,15 @@ public:
         virtual void shadeSpan16(int x, int y, uint16_t[], int count) SK_OVERRIDE;
 
     private:
-        SkPMColor shade(const SkPoint& point, StitchData& stitchData) const;
-        SkScalar calculateTurbulenceValueForPoint(
-            int channel, const PaintingData& paintingData,
-            StitchData& stitchData, const SkPoint& point) const;
-        SkScalar noise2D(int channel, const PaintingData& paintingData,
-                         const StitchData& stitchData, const SkPoint& noiseVector) const;
+        // Maps the count pixels starting at (x, y) to noise space, rounding as the spec requires.
+        void mapPoints(int x, int y, SkPoint points[], int count) const;
+        // Shades points already in noise space, reading the stitched tile where it covers them.
+        void shadePoints(const SkPoint points[], int count, SkPMColor result[]) const;
+        void shadeNoisePoints(const SkPoint points[], int count, SkPMColor result[]) const;
+        static void BuildTile(const PerlinNoiseShaderContext* context);
 
         SkMatrix fMatrix;
+        bool     fUseTile;
 
         typedef SkShader::Context INHERITED;
     };
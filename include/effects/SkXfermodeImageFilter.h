@@ -47,6 +47,7 @@ protected:
                           SkImageFilter* foreground, const CropRect* cropRect);
     explicit SkXfermodeImageFilter(SkReadBuffer& buffer);
     virtual void flatten(SkWriteBuffer&) const SK_OVERRIDE;
+    virtual bool onCanFilterTiled() const SK_OVERRIDE { return true; }
 
 private:
     SkXfermode* fMode;
@@ -87,6 +87,15 @@ public:
                             const SkRRect& inner, const SkPaint& paint) SK_OVERRIDE;
     virtual void drawOval(const SkDraw&, const SkRect& oval,
                           const SkPaint& paint) SK_OVERRIDE;
+    virtual void drawRects(const SkDraw&, const SkRect rects[], const SkColor colors[],
+                           int count, const SkPaint&) SK_OVERRIDE;
+    virtual void drawOvals(const SkDraw&, const SkRect ovals[], const SkColor colors[],
+                           int count, const SkPaint&) SK_OVERRIDE;
+    virtual void drawRRects(const SkDraw&, const SkRRect rrects[], const SkColor colors[],
+                            int count, const SkPaint&) SK_OVERRIDE;
+    virtual void drawAtlas(const SkDraw&, const SkBitmap& atlas, const SkMatrix xforms[],
+                           const SkIRect tex[], const SkColor colors[], int count,
+                           const SkPaint&) SK_OVERRIDE;
     virtual void drawPath(const SkDraw&, const SkPath& path,
                           const SkPaint& paint, const SkMatrix* prePathMatrix,
                           bool pathIsMutable) SK_OVERRIDE;
@@ -40,6 +40,33 @@ enum SkPathOp {
   */
 bool SK_API Op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result);
 
+/** Same as Op(), but when the operands have many segments, the search for
+    where they intersect (usually most of the work) is split across up to
+    threadCount threads. The result is exactly the same as Op()'s.
+  */
+bool SK_API Op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result,
+               int threadCount);
+
+/** Combine count paths as if by calling Op() on each in turn:
+    result = (((paths[0] op paths[1]) op paths[2]) ... op paths[count - 1]).
+    Union, intersect and XOR don't depend on the order, so the paths are
+    grouped into clusters whose bounds overlap, each cluster is reduced by
+    combining pairs of neighbors, and the clusters are then joined. This is
+    much faster than folding Op() over many mostly separate paths.
+    Difference subtracts the union of the paths overlapping paths[0].
+
+    Returns true if operation was able to produce a result;
+    otherwise, result is unmodified.
+
+    @param paths The operands.
+    @param count The number of operands. If zero, result is set to empty.
+    @param op The operation to apply between successive operands.
+    @param result The product of the operands. The result may be one of the
+                  inputs.
+    @return True if operation succeeded.
+  */
+bool SK_API OpMany(const SkPath paths[], int count, SkPathOp op, SkPath* result);
+
 /** Set this path to a set of non-overlapping contours that describe the
     same area as the original path.
     The curve order is reduced where possible so that cubics may
@@ -54,4 +81,10 @@ bool SK_API Op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
   */
 bool SK_API Simplify(const SkPath& path, SkPath* result);
 
+/** Same as Simplify(), but when the path has many segments, the search for
+    where they intersect (usually most of the work) is split across up to
+    threadCount threads. The result is exactly the same as Simplify()'s.
+  */
+bool SK_API Simplify(const SkPath& path, SkPath* result, int threadCount);
+
 #endif
@@ -84,6 +84,15 @@ public:
     virtual void drawRect(const SkDraw&, const SkRect& r, const SkPaint& paint);
     virtual void drawRRect(const SkDraw&, const SkRRect& rr,
                            const SkPaint& paint) SK_OVERRIDE;
+    virtual void drawRects(const SkDraw&, const SkRect rects[], const SkColor colors[],
+                           int count, const SkPaint&) SK_OVERRIDE;
+    virtual void drawOvals(const SkDraw&, const SkRect ovals[], const SkColor colors[],
+                           int count, const SkPaint&) SK_OVERRIDE;
+    virtual void drawRRects(const SkDraw&, const SkRRect rrects[], const SkColor colors[],
+                            int count, const SkPaint&) SK_OVERRIDE;
+    virtual void drawAtlas(const SkDraw&, const SkBitmap& atlas, const SkMatrix xforms[],
+                           const SkIRect tex[], const SkColor colors[], int count,
+                           const SkPaint&) SK_OVERRIDE;
     virtual void drawPath(const SkDraw&, const SkPath& origpath,
                           const SkPaint& paint, const SkMatrix* prePathMatrix,
                           bool pathIsMutable) SK_OVERRIDE;
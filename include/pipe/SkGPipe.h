@@ -120,6 +120,16 @@ public:
          *  simultaneously.
          */
         kSimultaneousReaders_Flag       = 1 << 2,
+
+        /**
+         *  Tells the writer that each startRecording()/endRecording() pair is
+         *  one frame of a longer stream, played back by the same reader(s).
+         *  Flattenables, typefaces, factory names and bitmaps sent in earlier
+         *  frames stay in the writer's and reader's dictionaries, so later
+         *  frames only send what is new. Each frame is bracketed by a
+         *  save()/restore(), so it starts with the identity matrix and no clip.
+         */
+        kPersistentResources_Flag       = 1 << 3,
     };
 
     SkCanvas* startRecording(SkGPipeController*, uint32_t flags = 0,
@@ -128,6 +138,8 @@ public:
 
     // called in destructor, but can be called sooner once you know there
     // should be no more drawing calls made into the recording canvas.
+    // With kPersistentResources_Flag this only ends the current frame; a later
+    // startRecording() with the same flags and size starts the next one.
     void endRecording();
 
     /**
@@ -161,6 +173,8 @@ private:
         kDefaultRecordingCanvasSize = 32767,
     };
 
+    void releaseCanvas();
+
     SkGPipeCanvas* fCanvas;
     SkWriter32     fWriter;
 };
@@ -52,6 +52,14 @@ protected:
     virtual void didSetMatrix(const SkMatrix&) SK_OVERRIDE;
 
     virtual void onDrawDRRect(const SkRRect&, const SkRRect&, const SkPaint&) SK_OVERRIDE;
+    virtual void onDrawRects(const SkRect[], const SkColor[], int count,
+                             const SkPaint&) SK_OVERRIDE;
+    virtual void onDrawOvals(const SkRect[], const SkColor[], int count,
+                             const SkPaint&) SK_OVERRIDE;
+    virtual void onDrawRRects(const SkRRect[], const SkColor[], int count,
+                              const SkPaint&) SK_OVERRIDE;
+    virtual void onDrawAtlas(const SkBitmap&, const SkMatrix[], const SkIRect[],
+                             const SkColor[], int count, const SkPaint*) SK_OVERRIDE;
     virtual void onDrawText(const void* text, size_t byteLength, SkScalar x, SkScalar y,
                             const SkPaint&) SK_OVERRIDE;
     virtual void onDrawPosText(const void* text, size_t byteLength, const SkPoint pos[],
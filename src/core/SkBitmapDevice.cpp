@@ -297,6 +297,28 @@ void SkBitmapDevice::drawRRect(const SkDraw& draw, const SkRRect& rrect, const S
 #endif
 }
 
+void SkBitmapDevice::drawRects(const SkDraw& draw, const SkRect rects[], const SkColor colors[],
+                               int count, const SkPaint& paint) {
+    CHECK_FOR_ANNOTATION(paint);
+    draw.drawRects(rects, colors, count, paint);
+}
+
+void SkBitmapDevice::drawOvals(const SkDraw& draw, const SkRect ovals[], const SkColor colors[],
+                               int count, const SkPaint& paint) {
+    CHECK_FOR_ANNOTATION(paint);
+    draw.drawOvals(ovals, colors, count, paint);
+}
+
+void SkBitmapDevice::drawRRects(const SkDraw& draw, const SkRRect rrects[],
+                                const SkColor colors[], int count, const SkPaint& paint) {
+    CHECK_FOR_ANNOTATION(paint);
+#ifdef SK_IGNORE_BLURRED_RRECT_OPT
+    this->INHERITED::drawRRects(draw, rrects, colors, count, paint);
+#else
+    draw.drawRRects(rrects, colors, count, paint);
+#endif
+}
+
 void SkBitmapDevice::drawPath(const SkDraw& draw, const SkPath& path,
                               const SkPaint& paint, const SkMatrix* prePathMatrix,
                               bool pathIsMutable) {
@@ -396,6 +418,12 @@ void SkBitmapDevice::drawBitmapRect(const SkDraw& draw, const SkBitmap& bitmap,
     this->drawRect(draw, *dstPtr, paintWithShader);
 }
 
+void SkBitmapDevice::drawAtlas(const SkDraw& draw, const SkBitmap& atlas, const SkMatrix xforms[],
+                               const SkIRect tex[], const SkColor colors[], int count,
+                               const SkPaint& paint) {
+    draw.drawAtlas(atlas, xforms, tex, colors, count, paint);
+}
+
 void SkBitmapDevice::drawSprite(const SkDraw& draw, const SkBitmap& bitmap,
                                 int x, int y, const SkPaint& paint) {
     draw.drawSprite(bitmap, x, y, paint);
@@ -1184,6 +1184,57 @@ void SkCanvas::internalDrawBitmap(const SkBitmap& bitmap,
     LOOPER_END
 }
 
+// Draws each tile of a filtered image as a sprite on a device.
+class SkDeviceTileSink : public SkImageFilter::TileSink {
+public:
+    SkDeviceTileSink(SkBaseDevice* device, const SkDraw& draw, const SkIPoint& pos,
+                     const SkPaint& paint)
+        : fDevice(device), fDraw(draw), fPos(pos), fPaint(paint) {}
+
+    virtual void drawTile(const SkBitmap& tile, int x, int y) SK_OVERRIDE {
+        fDevice->drawSprite(fDraw, tile, fPos.x() + x, fPos.y() + y, fPaint);
+    }
+
+private:
+    SkBaseDevice*  fDevice;
+    const SkDraw&  fDraw;
+    const SkIPoint fPos;
+    const SkPaint& fPaint;
+};
+
+// Draws src, filtered by the paint's image filter, as a sprite at pos on device.  Results
+// bigger than SkImageFilter::GetTileSize() are found and drawn a tile at a time.
+static void draw_filtered_sprite(SkBaseDevice* device, const SkDraw& draw, const SkBitmap& src,
+                                 const SkIPoint& pos, const SkPaint& paint) {
+    SkImageFilter* filter = paint.getImageFilter();
+    SkDeviceImageFilterProxy proxy(device);
+    SkMatrix matrix = *draw.fMatrix;
+    matrix.postTranslate(SkIntToScalar(-pos.x()), SkIntToScalar(-pos.y()));
+    SkIRect clipBounds = SkIRect::MakeWH(src.width(), src.height());
+    SkImageFilter::Cache* cache = SkImageFilter::GetExternalCache();
+    SkAutoUnref aur(NULL);
+    if (!cache) {
+        cache = SkImageFilter::Cache::Create();
+        aur.reset(cache);
+    }
+    SkImageFilter::Context ctx(matrix, clipBounds, cache);
+    SkPaint tmpUnfiltered(paint);
+    tmpUnfiltered.setImageFilter(NULL);
+    SkDeviceTileSink sink(device, draw, pos, tmpUnfiltered);
+
+    const int tileSize = SkImageFilter::GetTileSize();
+    if (tileSize > 0 && (clipBounds.width() > tileSize || clipBounds.height() > tileSize)) {
+        filter->filterImageTiled(&proxy, src, ctx, tileSize, &sink);
+        return;
+    }
+
+    SkBitmap dst;
+    SkIPoint offset = SkIPoint::Make(0, 0);
+    if (filter->filterImage(&proxy, src, ctx, &dst, &offset)) {
+        sink.drawTile(dst, offset.x(), offset.y());
+    }
+}
+
 void SkCanvas::internalDrawDevice(SkBaseDevice* srcDev, int x, int y,
                                   const SkPaint* paint) {
     SkPaint tmp;
@@ -1199,26 +1250,7 @@ void SkCanvas::internalDrawDevice(SkBaseDevice* srcDev, int x, int y,
         SkImageFilter* filter = paint->getImageFilter();
         SkIPoint pos = { x - iter.getX(), y - iter.getY() };
         if (filter && !dstDev->canHandleImageFilter(filter)) {
-            SkDeviceImageFilterProxy proxy(dstDev);
-            SkBitmap dst;
-            SkIPoint offset = SkIPoint::Make(0, 0);
-            const SkBitmap& src = srcDev->accessBitmap(false);
-            SkMatrix matrix = *iter.fMatrix;
-            matrix.postTranslate(SkIntToScalar(-pos.x()), SkIntToScalar(-pos.y()));
-            SkIRect clipBounds = SkIRect::MakeWH(srcDev->width(), srcDev->height());
-            SkImageFilter::Cache* cache = SkImageFilter::GetExternalCache();
-            SkAutoUnref aur(NULL);
-            if (!cache) {
-                cache = SkImageFilter::Cache::Create();
-                aur.reset(cache);
-            }
-            SkImageFilter::Context ctx(matrix, clipBounds, cache);
-            if (filter->filterImage(&proxy, src, ctx, &dst, &offset)) {
-                SkPaint tmpUnfiltered(*paint);
-                tmpUnfiltered.setImageFilter(NULL);
-                dstDev->drawSprite(iter, dst, pos.x() + offset.x(), pos.y() + offset.y(),
-                                   tmpUnfiltered);
-            }
+            draw_filtered_sprite(dstDev, iter, srcDev->accessBitmap(false), pos, *paint);
         } else {
             dstDev->drawDevice(iter, srcDev, pos.x(), pos.y(), *paint);
         }
@@ -1246,25 +1278,7 @@ void SkCanvas::drawSprite(const SkBitmap& bitmap, int x, int y,
         SkImageFilter* filter = paint->getImageFilter();
         SkIPoint pos = { x - iter.getX(), y - iter.getY() };
         if (filter && !iter.fDevice->canHandleImageFilter(filter)) {
-            SkDeviceImageFilterProxy proxy(iter.fDevice);
-            SkBitmap dst;
-            SkIPoint offset = SkIPoint::Make(0, 0);
-            SkMatrix matrix = *iter.fMatrix;
-            matrix.postTranslate(SkIntToScalar(-pos.x()), SkIntToScalar(-pos.y()));
-            SkIRect clipBounds = SkIRect::MakeWH(bitmap.width(), bitmap.height());
-            SkImageFilter::Cache* cache = SkImageFilter::GetExternalCache();
-            SkAutoUnref aur(NULL);
-            if (!cache) {
-                cache = SkImageFilter::Cache::Create();
-                aur.reset(cache);
-            }
-            SkImageFilter::Context ctx(matrix, clipBounds, cache);
-            if (filter->filterImage(&proxy, bitmap, ctx, &dst, &offset)) {
-                SkPaint tmpUnfiltered(*paint);
-                tmpUnfiltered.setImageFilter(NULL);
-                iter.fDevice->drawSprite(iter, dst, pos.x() + offset.x(), pos.y() + offset.y(),
-                                         tmpUnfiltered);
-            }
+            draw_filtered_sprite(iter.fDevice, iter, bitmap, pos, *paint);
         } else {
             iter.fDevice->drawSprite(iter, bitmap, pos.x(), pos.y(), *paint);
         }
@@ -1838,6 +1852,76 @@ void SkCanvas::drawDRRect(const SkRRect& outer, const SkRRect& inner,
     this->onDrawDRRect(outer, inner, paint);
 }
 
+void SkCanvas::drawRects(const SkRect rects[], const SkColor colors[], int count,
+                         const SkPaint& paint) {
+    if (count <= 0) {
+        return;
+    }
+    SkASSERT(rects);
+    this->onDrawRects(rects, colors, count, paint);
+}
+
+void SkCanvas::drawOvals(const SkRect ovals[], const SkColor colors[], int count,
+                         const SkPaint& paint) {
+    if (count <= 0) {
+        return;
+    }
+    SkASSERT(ovals);
+    this->onDrawOvals(ovals, colors, count, paint);
+}
+
+void SkCanvas::drawRRects(const SkRRect rrects[], const SkColor colors[], int count,
+                          const SkPaint& paint) {
+    if (count <= 0) {
+        return;
+    }
+    SkASSERT(rrects);
+    this->onDrawRRects(rrects, colors, count, paint);
+}
+
+void SkCanvas::drawAtlas(const SkBitmap& atlas, const SkMatrix xforms[], const SkIRect tex[],
+                         const SkColor colors[], int count, const SkPaint* paint) {
+    SkDEBUGCODE(atlas.validate();)
+    if (count <= 0 || atlas.drawsNothing()) {
+        return;
+    }
+    SkASSERT(xforms && tex);
+    this->onDrawAtlas(atlas, xforms, tex, colors, count, paint);
+}
+
+void SkCanvas::drawEachRect(const SkRect rects[], const SkColor colors[], int count,
+                            const SkPaint& paint) {
+    SkPaint p(paint);
+    for (int i = 0; i < count; ++i) {
+        if (colors) {
+            p.setColor(colors[i]);
+        }
+        this->drawRect(rects[i], p);
+    }
+}
+
+void SkCanvas::drawEachOval(const SkRect ovals[], const SkColor colors[], int count,
+                            const SkPaint& paint) {
+    SkPaint p(paint);
+    for (int i = 0; i < count; ++i) {
+        if (colors) {
+            p.setColor(colors[i]);
+        }
+        this->drawOval(ovals[i], p);
+    }
+}
+
+void SkCanvas::drawEachRRect(const SkRRect rrects[], const SkColor colors[], int count,
+                             const SkPaint& paint) {
+    SkPaint p(paint);
+    for (int i = 0; i < count; ++i) {
+        if (colors) {
+            p.setColor(colors[i]);
+        }
+        this->drawRRect(rrects[i], p);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //  These are the virtual drawing methods
 //////////////////////////////////////////////////////////////////////////////
@@ -1989,6 +2073,158 @@ void SkCanvas::onDrawDRRect(const SkRRect& outer, const SkRRect& inner,
     LOOPER_END
 }
 
+void SkCanvas::drawEachSprite(const SkBitmap& atlas, const SkMatrix xforms[],
+                              const SkIRect tex[], const SkColor colors[], int count,
+                              const SkPaint* paint) {
+    SkLazyPaint lazy;
+    if (colors) {
+        paint = paint ? lazy.set(*paint) : lazy.init();
+    }
+    for (int i = 0; i < count; ++i) {
+        if (colors) {
+            lazy.get()->setColor(colors[i]);
+        }
+        SkRect src, dst;
+        src.set(tex[i]);
+        dst.iset(0, 0, tex[i].width(), tex[i].height());
+
+        this->save();
+        this->concat(xforms[i]);
+        this->drawBitmapRectToRect(atlas, &src, dst, paint);
+        this->restore();
+    }
+}
+
+// A looper, an image filter or a draw filter applies to each shape on its own
+// (a draw filter also sees each shape's color), so a batch that has any of them
+// is drawn one shape at a time.
+static bool can_draw_batch(const SkCanvas& canvas, const SkPaint* paint) {
+    return NULL == canvas.getDrawFilter() &&
+           (NULL == paint || (NULL == paint->getLooper() && NULL == paint->getImageFilter()));
+}
+
+void SkCanvas::onDrawRects(const SkRect rects[], const SkColor colors[], int count,
+                           const SkPaint& paint) {
+    if (!can_draw_batch(*this, &paint)) {
+        this->drawEachRect(rects, colors, count, paint);
+        return;
+    }
+
+    SkRect r, storage;
+    const SkRect* bounds = NULL;
+    // the rects need not be sorted, so take the bounds of all their corners
+    if (paint.canComputeFastBounds() &&
+            r.setBoundsCheck(SkTCast<const SkPoint*>(rects), 2 * count)) {
+        bounds = &paint.computeFastBounds(r, &storage);
+        if (this->quickReject(*bounds)) {
+            return;
+        }
+    }
+
+    LOOPER_BEGIN(paint, SkDrawFilter::kRect_Type, bounds)
+
+    while (iter.next()) {
+        iter.fDevice->drawRects(iter, rects, colors, count, looper.paint());
+    }
+
+    LOOPER_END
+}
+
+void SkCanvas::onDrawOvals(const SkRect ovals[], const SkColor colors[], int count,
+                           const SkPaint& paint) {
+    if (!can_draw_batch(*this, &paint)) {
+        this->drawEachOval(ovals, colors, count, paint);
+        return;
+    }
+
+    SkRect r, storage;
+    const SkRect* bounds = NULL;
+    if (paint.canComputeFastBounds() &&
+            r.setBoundsCheck(SkTCast<const SkPoint*>(ovals), 2 * count)) {
+        bounds = &paint.computeFastBounds(r, &storage);
+        if (this->quickReject(*bounds)) {
+            return;
+        }
+    }
+
+    LOOPER_BEGIN(paint, SkDrawFilter::kOval_Type, bounds)
+
+    while (iter.next()) {
+        iter.fDevice->drawOvals(iter, ovals, colors, count, looper.paint());
+    }
+
+    LOOPER_END
+}
+
+void SkCanvas::onDrawRRects(const SkRRect rrects[], const SkColor colors[], int count,
+                            const SkPaint& paint) {
+    if (!can_draw_batch(*this, &paint)) {
+        this->drawEachRRect(rrects, colors, count, paint);
+        return;
+    }
+
+    SkRect storage;
+    const SkRect* bounds = NULL;
+    if (paint.canComputeFastBounds()) {
+        SkRect r = rrects[0].getBounds();
+        for (int i = 1; i < count; ++i) {
+            r.join(rrects[i].getBounds());
+        }
+        bounds = &paint.computeFastBounds(r, &storage);
+        if (this->quickReject(*bounds)) {
+            return;
+        }
+    }
+
+    LOOPER_BEGIN(paint, SkDrawFilter::kRRect_Type, bounds)
+
+    while (iter.next()) {
+        iter.fDevice->drawRRects(iter, rrects, colors, count, looper.paint());
+    }
+
+    LOOPER_END
+}
+
+void SkCanvas::onDrawAtlas(const SkBitmap& atlas, const SkMatrix xforms[],
+                           const SkIRect tex[], const SkColor colors[], int count,
+                           const SkPaint* paint) {
+    if (!can_draw_batch(*this, paint)) {
+        this->drawEachSprite(atlas, xforms, tex, colors, count, paint);
+        return;
+    }
+
+    CHECK_LOCKCOUNT_BALANCE(atlas);
+
+    SkRect r, storage;
+    const SkRect* bounds = NULL;
+    if (NULL == paint || paint->canComputeFastBounds()) {
+        r.setEmpty();
+        for (int i = 0; i < count; ++i) {
+            SkRect dst;
+            xforms[i].mapRect(&dst, SkRect::MakeWH(SkIntToScalar(tex[i].width()),
+                                                   SkIntToScalar(tex[i].height())));
+            r.join(dst);
+        }
+        bounds = paint ? &paint->computeFastBounds(r, &storage) : &r;
+        if (this->quickReject(*bounds)) {
+            return;
+        }
+    }
+
+    SkLazyPaint lazy;
+    if (NULL == paint) {
+        paint = lazy.init();
+    }
+
+    LOOPER_BEGIN(*paint, SkDrawFilter::kBitmap_Type, bounds)
+
+    while (iter.next()) {
+        iter.fDevice->drawAtlas(iter, atlas, xforms, tex, colors, count, looper.paint());
+    }
+
+    LOOPER_END
+}
+
 void SkCanvas::drawPath(const SkPath& path, const SkPaint& paint) {
     if (!path.isFinite()) {
         return;
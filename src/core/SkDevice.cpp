@@ -6,6 +6,7 @@
  */
 
 #include "SkDevice.h"
+#include "SkDraw.h"
 #include "SkMetaData.h"
 
 SkBaseDevice::SkBaseDevice()
@@ -77,6 +78,58 @@ void SkBaseDevice::drawDRRect(const SkDraw& draw, const SkRRect& outer,
     this->drawPath(draw, path, paint, preMatrix, pathIsMutable);
 }
 
+void SkBaseDevice::drawRects(const SkDraw& draw, const SkRect rects[], const SkColor colors[],
+                             int count, const SkPaint& paint) {
+    SkPaint p(paint);
+    for (int i = 0; i < count; ++i) {
+        if (colors) {
+            p.setColor(colors[i]);
+        }
+        this->drawRect(draw, rects[i], p);
+    }
+}
+
+void SkBaseDevice::drawOvals(const SkDraw& draw, const SkRect ovals[], const SkColor colors[],
+                             int count, const SkPaint& paint) {
+    SkPaint p(paint);
+    for (int i = 0; i < count; ++i) {
+        if (colors) {
+            p.setColor(colors[i]);
+        }
+        this->drawOval(draw, ovals[i], p);
+    }
+}
+
+void SkBaseDevice::drawRRects(const SkDraw& draw, const SkRRect rrects[], const SkColor colors[],
+                              int count, const SkPaint& paint) {
+    SkPaint p(paint);
+    for (int i = 0; i < count; ++i) {
+        if (colors) {
+            p.setColor(colors[i]);
+        }
+        this->drawRRect(draw, rrects[i], p);
+    }
+}
+
+void SkBaseDevice::drawAtlas(const SkDraw& draw, const SkBitmap& atlas, const SkMatrix xforms[],
+                             const SkIRect tex[], const SkColor colors[], int count,
+                             const SkPaint& paint) {
+    SkPaint p(paint);
+    SkMatrix matrix;
+    SkDraw spriteDraw(draw);
+    spriteDraw.fMatrix = &matrix;
+    for (int i = 0; i < count; ++i) {
+        if (colors) {
+            p.setColor(colors[i]);
+        }
+        SkRect src, dst;
+        src.set(tex[i]);
+        dst.iset(0, 0, tex[i].width(), tex[i].height());
+        matrix.setConcat(*draw.fMatrix, xforms[i]);
+        this->drawBitmapRect(spriteDraw, atlas, &src, dst, p, SkCanvas::kNone_DrawBitmapRectFlag);
+    }
+}
+
 bool SkBaseDevice::readPixels(const SkImageInfo& info, void* dstP, size_t rowBytes, int x, int y) {
 #ifdef SK_DEBUG
     SkASSERT(info.width() > 0 && info.height() > 0);
@@ -21,6 +21,7 @@
 #include "SkScan.h"
 #include "SkShader.h"
 #include "SkSmallAllocator.h"
+#include "SkSpriteBlitter.h"
 #include "SkString.h"
 #include "SkStroke.h"
 #include "SkTextMapStateProc.h"
@@ -66,6 +67,40 @@ private:
 };
 #define SkAutoBlitterChoose(...) SK_REQUIRE_LOCAL_VAR(SkAutoBlitterChoose)
 
+/** Helper for a batch of shapes that share a paint, but not always its color.
+    The blitter is only chosen again when the color changes.
+ */
+class SkBatchBlitterChoose : SkNoncopyable {
+public:
+    SkBatchBlitterChoose(const SkBitmap& device, const SkMatrix& matrix,
+                         const SkPaint& paint, const SkColor colors[])
+        : fDevice(device), fMatrix(matrix), fPaint(paint), fColors(colors) {}
+
+    // Returns the paint for the index'th shape.
+    const SkPaint& paint(int index) {
+        if (fColors && fColors[index] != fPaint.getColor()) {
+            fPaint.setColor(fColors[index]);
+            fChooser.reset();
+        }
+        return fPaint;
+    }
+
+    // Returns the blitter for the paint last returned by paint().
+    SkBlitter* blitter() {
+        if (!fChooser.isValid()) {
+            fChooser.init()->choose(fDevice, fMatrix, fPaint);
+        }
+        return fChooser.get()->get();
+    }
+
+private:
+    const SkBitmap&                 fDevice;
+    const SkMatrix&                 fMatrix;
+    SkPaint                         fPaint;
+    const SkColor*                  fColors;
+    SkTLazy<SkAutoBlitterChoose>    fChooser;
+};
+
 /**
  *  Since we are providing the storage for the shader (to avoid the perf cost
  *  of calling new) we insist that in our destructor we can account for all
@@ -402,9 +437,7 @@ static void aa_line_hair_proc(const PtProcRec& rec, const SkPoint devPts[],
 
 static void aa_poly_hair_proc(const PtProcRec& rec, const SkPoint devPts[],
                               int count, SkBlitter* blitter) {
-    for (int i = 0; i < count - 1; i++) {
-        SkScan::AntiHairLine(devPts[i], devPts[i+1], *rec.fRC, blitter);
-    }
+    SkScan::AntiHairLine(devPts, count, *rec.fRC, blitter);
 }
 
 // square procs (strokeWidth > 0 but matrix is square-scale (sx == sy)
@@ -785,6 +818,39 @@ static SkPoint* rect_points(SkRect& r) {
     return SkTCast<SkPoint*>(&r);
 }
 
+// we want to "fill" if we are kFill or kStrokeAndFill, since in the latter
+// case we are also hairline (if we've gotten to here), which devolves to
+// effectively just kFill
+static void scan_dev_rect(SkDraw::RectType rtype, bool doAA, const SkRect& devRect,
+                          const SkPoint& strokeSize, const SkRasterClip& clip,
+                          SkBlitter* blitter) {
+    switch (rtype) {
+        case SkDraw::kFill_RectType:
+            if (doAA) {
+                SkScan::AntiFillRect(devRect, clip, blitter);
+            } else {
+                SkScan::FillRect(devRect, clip, blitter);
+            }
+            break;
+        case SkDraw::kStroke_RectType:
+            if (doAA) {
+                SkScan::AntiFrameRect(devRect, strokeSize, clip, blitter);
+            } else {
+                SkScan::FrameRect(devRect, strokeSize, clip, blitter);
+            }
+            break;
+        case SkDraw::kHair_RectType:
+            if (doAA) {
+                SkScan::AntiHairRect(devRect, clip, blitter);
+            } else {
+                SkScan::HairRect(devRect, clip, blitter);
+            }
+            break;
+        default:
+            SkDEBUGFAIL("bad rtype");
+    }
+}
+
 void SkDraw::drawRect(const SkRect& rect, const SkPaint& paint) const {
     SkDEBUGCODE(this->validate();)
 
@@ -829,34 +895,8 @@ void SkDraw::drawRect(const SkRect& rect, const SkPaint& paint) const {
          //On success, fState=kSimple_State so no change in rect bounds and use of SkDeviceLooper class
          //Same is true for fState=kDone_State. This conidtional check is not implemented now.
          SkAutoBlitterChoose blitterStorage(*fBitmap, matrix, paint);
-         const SkRasterClip& clip = *fRC;
-         SkBlitter*          blitter = blitterStorage.get();
-
-         switch (rtype) {
-           case kFill_RectType:
-               if (paint.isAntiAlias()) {
-                   SkScan::AntiFillRect(devRect, clip, blitter);
-               } else {
-                   SkScan::FillRect(devRect, clip, blitter);
-               }
-               break;
-           case kStroke_RectType:
-               if (paint.isAntiAlias()) {
-                   SkScan::AntiFrameRect(devRect, strokeSize, clip, blitter);
-               } else {
-                   SkScan::FrameRect(devRect, strokeSize, clip, blitter);
-               }
-               break;
-           case kHair_RectType:
-               if (paint.isAntiAlias()) {
-                   SkScan::AntiHairRect(devRect, clip, blitter);
-               } else {
-                   SkScan::HairRect(devRect, clip, blitter);
-               }
-               break;
-           default:
-               SkDEBUGFAIL("bad rtype");
-         }
+         scan_dev_rect(rtype, paint.isAntiAlias(), devRect, strokeSize, *fRC,
+                       blitterStorage.get());
     }else{
         SkDeviceLooper looper(*fBitmap, *fRC, ir, paint.isAntiAlias());
         while (looper.next()) {
@@ -867,37 +907,56 @@ void SkDraw::drawRect(const SkRect& rect, const SkPaint& paint) const {
 
             SkAutoBlitterChoose blitterStorage(looper.getBitmap(), localMatrix,
                                                paint);
-            const SkRasterClip& clip = looper.getRC();
-            SkBlitter*          blitter = blitterStorage.get();
-
-            // we want to "fill" if we are kFill or kStrokeAndFill, since in the latter
-            // case we are also hairline (if we've gotten to here), which devolves to
-            // effectively just kFill
-            switch (rtype) {
-                case kFill_RectType:
-                    if (paint.isAntiAlias()) {
-                        SkScan::AntiFillRect(localDevRect, clip, blitter);
-                    } else {
-                        SkScan::FillRect(localDevRect, clip, blitter);
-                    }
-                    break;
-                case kStroke_RectType:
-                    if (paint.isAntiAlias()) {
-                        SkScan::AntiFrameRect(localDevRect, strokeSize, clip, blitter);
-                    } else {
-                        SkScan::FrameRect(localDevRect, strokeSize, clip, blitter);
-                    }
-                    break;
-                case kHair_RectType:
-                    if (paint.isAntiAlias()) {
-                        SkScan::AntiHairRect(localDevRect, clip, blitter);
-                    } else {
-                        SkScan::HairRect(localDevRect, clip, blitter);
-                    }
-                    break;
-                default:
-                    SkDEBUGFAIL("bad rtype");
-            }
+            scan_dev_rect(rtype, paint.isAntiAlias(), localDevRect, strokeSize,
+                          looper.getRC(), blitterStorage.get());
+        }
+    }
+}
+
+void SkDraw::drawRects(const SkRect rects[], const SkColor colors[], int count,
+                       const SkPaint& paint) const {
+    SkDEBUGCODE(this->validate();)
+
+    // nothing to draw
+    if (fRC->isEmpty()) {
+        return;
+    }
+
+    SkBatchBlitterChoose batch(*fBitmap, *fMatrix, paint, colors);
+    SkPoint strokeSize;
+    RectType rtype = ComputeRectType(paint, *fMatrix, &strokeSize);
+
+    if (kPath_RectType == rtype) {
+        for (int i = 0; i < count; ++i) {
+            this->drawRect(rects[i], batch.paint(i));
+        }
+        return;
+    }
+
+    // bigger than this, and drawRect() goes through an SkDeviceLooper
+    const int delta = (paint.isAntiAlias() ? 4096 : 16384);
+
+    for (int i = 0; i < count; ++i) {
+        SkRect devRect;
+        fMatrix->mapPoints(rect_points(devRect), rect_points(rects[i]), 2);
+        devRect.sort();
+
+        SkIRect ir;
+        devRect.roundOut(&ir);
+        if (paint.getStyle() != SkPaint::kFill_Style) {
+            // extra space for hairlines
+            ir.inset(-1, -1);
+        }
+        if (fRC->quickReject(ir)) {
+            continue;
+        }
+
+        const SkPaint& itemPaint = batch.paint(i);
+        if (SkLikely(ir.right() < delta && ir.bottom() < delta)) {
+            scan_dev_rect(rtype, paint.isAntiAlias(), devRect, strokeSize, *fRC,
+                          batch.blitter());
+        } else {
+            this->drawRect(rects[i], itemPaint);
         }
     }
 }
@@ -1027,6 +1086,82 @@ DRAW_PATH:
     this->drawPath(path, paint, NULL, true);
 }
 
+static void add_to_path(SkPath* path, const SkRect& oval) {
+    path->addOval(oval);
+}
+
+static void add_to_path(SkPath* path, const SkRRect& rrect) {
+    path->addRRect(rrect);
+}
+
+static void draw_one(const SkDraw& draw, const SkRect& oval, const SkPaint& paint) {
+    SkPath path;
+    path.addOval(oval);
+    draw.drawPath(path, paint, NULL, true);
+}
+
+static void draw_one(const SkDraw& draw, const SkRRect& rrect, const SkPaint& paint) {
+    draw.drawRRect(rrect, paint);
+}
+
+template <typename Shape>
+static void draw_shapes(const SkDraw& draw, const Shape shapes[], const SkColor colors[],
+                        int count, const SkPaint& paint) {
+    SkBatchBlitterChoose batch(*draw.fBitmap, *draw.fMatrix, paint, colors);
+
+    // Anything but a plain fill is left to drawPath() (or drawRRect()).
+    if (paint.getStyle() != SkPaint::kFill_Style || paint.getPathEffect() ||
+            paint.getMaskFilter() || paint.getRasterizer()) {
+        for (int i = 0; i < count; ++i) {
+            draw_one(draw, shapes[i], batch.paint(i));
+        }
+        return;
+    }
+
+    void (*proc)(const SkPath&, const SkRasterClip&, SkBlitter*);
+    if (paint.isAntiAlias()) {
+        proc = SkScan::AntiFillPath;
+    } else {
+        proc = SkScan::FillPath;
+    }
+
+    // one path, rewound for each shape, so its storage is only allocated once
+    SkPath devPath;
+    for (int i = 0; i < count; ++i) {
+        devPath.rewind();
+        add_to_path(&devPath, shapes[i]);
+        devPath.transform(*draw.fMatrix);
+
+        SkIRect ir;
+        devPath.getBounds().roundOut(&ir);
+        if (draw.fRC->quickReject(ir)) {
+            continue;
+        }
+        batch.paint(i);
+        proc(devPath, *draw.fRC, batch.blitter());
+    }
+}
+
+void SkDraw::drawOvals(const SkRect ovals[], const SkColor colors[], int count,
+                       const SkPaint& paint) const {
+    SkDEBUGCODE(this->validate();)
+
+    if (fRC->isEmpty()) {
+        return;
+    }
+    draw_shapes(*this, ovals, colors, count, paint);
+}
+
+void SkDraw::drawRRects(const SkRRect rrects[], const SkColor colors[], int count,
+                        const SkPaint& paint) const {
+    SkDEBUGCODE(this->validate();)
+
+    if (fRC->isEmpty()) {
+        return;
+    }
+    draw_shapes(*this, rrects, colors, count, paint);
+}
+
 void SkDraw::drawPath(const SkPath& origSrcPath, const SkPaint& origPaint,
                       const SkMatrix* prePathMatrix, bool pathIsMutable,
                       bool drawCoverage) const {
@@ -1370,6 +1505,119 @@ void SkDraw::drawSprite(const SkBitmap& bitmap, int x, int y,
     draw.drawRect(r, shaderPaint);
 }
 
+// Blits sprites from one atlas, choosing the sprite blitter (which has the
+// paint's alpha baked into it) again only when that alpha changes.
+class SkAtlasSpriteBlitter : SkNoncopyable {
+public:
+    SkAtlasSpriteBlitter(const SkBitmap& device, const SkBitmap& atlas)
+        : fDevice(device), fAtlas(atlas), fBlitter(NULL), fAlpha(0) {}
+
+    // Returns NULL if there is no sprite blitter for this device, atlas and paint.
+    SkSpriteBlitter* get(const SkPaint& paint) {
+        if (!fAllocator.isValid() || paint.getAlpha() != fAlpha) {
+            fAllocator.reset();
+            fAlpha = paint.getAlpha();
+            // the blitter is owned by the allocator
+            fBlitter = static_cast<SkSpriteBlitter*>(
+                    SkBlitter::ChooseSprite(fDevice, paint, fAtlas, 0, 0, fAllocator.init()));
+        }
+        return fBlitter;
+    }
+
+private:
+    const SkBitmap&                 fDevice;
+    const SkBitmap&                 fAtlas;
+    SkTLazy<SkTBlitterAllocator>    fAllocator;
+    SkSpriteBlitter*                fBlitter;
+    U8CPU                           fAlpha;
+};
+
+void SkDraw::drawAtlas(const SkBitmap& atlas, const SkMatrix xforms[], const SkIRect tex[],
+                       const SkColor colors[], int count, const SkPaint& origPaint) const {
+    SkDEBUGCODE(this->validate();)
+
+    // nothing to draw
+    if (fRC->isEmpty() ||
+            atlas.width() == 0 || atlas.height() == 0 ||
+            atlas.colorType() == kUnknown_SkColorType) {
+        return;
+    }
+
+    // Lock once for the whole batch; the subsets and shaders below share the lock.
+    SkAutoLockPixels alp(atlas);
+    if (!atlas.readyToDraw()) {
+        return;
+    }
+
+    SkPaint paint(origPaint);
+    paint.setStyle(SkPaint::kFill_Style);
+
+    const bool canSprite = atlas.colorType() != kAlpha_8_SkColorType;
+    SkAtlasSpriteBlitter sprites(*fBitmap, atlas);
+    const SkIRect atlasBounds = SkIRect::MakeWH(atlas.width(), atlas.height());
+
+    SkMatrix matrix;
+    SkDraw draw(*this);
+    draw.fMatrix = &matrix;
+
+    for (int i = 0; i < count; ++i) {
+        if (colors) {
+            paint.setColor(colors[i]);
+        }
+        SkIRect src = tex[i];
+        if (!src.intersect(atlasBounds)) {
+            continue;
+        }
+        // where src sits in the sprite, if it was clamped to the atlas
+        const int dx = src.fLeft - tex[i].fLeft;
+        const int dy = src.fTop - tex[i].fTop;
+        const SkRect dst = SkRect::MakeXYWH(SkIntToScalar(dx), SkIntToScalar(dy),
+                                            SkIntToScalar(src.width()),
+                                            SkIntToScalar(src.height()));
+
+        matrix.setConcat(*fMatrix, xforms[i]);
+        if (canSprite && !(matrix.getType() & ~SkMatrix::kTranslate_Mask) &&
+                SkScalarIsInt(matrix.getTranslateX()) && SkScalarIsInt(matrix.getTranslateY())) {
+            const SkIRect devRect = SkIRect::MakeXYWH(
+                    SkScalarRoundToInt(matrix.getTranslateX()) + dx,
+                    SkScalarRoundToInt(matrix.getTranslateY()) + dy,
+                    src.width(), src.height());
+            if (fRC->quickReject(devRect)) {
+                continue;
+            }
+            if (fRC->isBW() || fRC->quickContains(devRect)) {
+                SkSpriteBlitter* blitter = sprites.get(paint);
+                if (blitter) {
+                    blitter->setup(*fBitmap, devRect.fLeft - src.fLeft,
+                                   devRect.fTop - src.fTop, paint);
+                    SkScan::FillIRect(devRect, *fRC, blitter);
+                    continue;
+                }
+            }
+        } else if (clipped_out(matrix, *fRC, dst)) {
+            continue;
+        }
+
+        // Sample the sprite's own pixels, clamped to its edges, exactly as
+        // SkBitmapDevice::drawBitmapRect() does for an integer src rect.
+        SkBitmap subset;
+        if (!atlas.extractSubset(&subset, src)) {
+            continue;
+        }
+        if (kAlpha_8_SkColorType == atlas.colorType() && 0 == src.fLeft && 0 == src.fTop) {
+            // At the atlas's corner drawBitmapRect() hands the subset to
+            // drawBitmap(), so an A8 sprite masks the paint, shader and all.
+            matrix.preTranslate(dst.fLeft, dst.fTop);
+            draw.drawBitmapAsMask(subset, paint);
+            continue;
+        }
+        SkMatrix localMatrix;
+        localMatrix.setTranslate(dst.fLeft, dst.fTop);
+        SkAutoBitmapShaderInstall install(subset, paint, &localMatrix);
+        draw.drawRect(dst, install.paintWithShader());
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "SkScalerContext.h"
@@ -1968,6 +2216,9 @@ void SkDraw::drawTextOnPath(const char text[], size_t byteLength,
     SkPathMeasure       meas(follow, false);
     SkScalar            hOffset = 0;
 
+    // every point of every glyph is looked up along follow
+    meas.setUseIndex(true);
+
     // need to measure first
     if (paint.getTextAlign() != SkPaint::kLeft_Align) {
         SkScalar pathLen = meas.getLength();
@@ -2009,7 +2260,10 @@ typedef void (*HairProc)(const SkPoint&, const SkPoint&, const SkRasterClip&,
                          SkBlitter*);
 
 static HairProc ChooseHairProc(bool doAntiAlias) {
-    return doAntiAlias ? SkScan::AntiHairLine : SkScan::HairLine;
+    if (doAntiAlias) {
+        return SkScan::AntiHairLine;
+    }
+    return SkScan::HairLine;
 }
 
 static bool texture_to_matrix(const VertState& state, const SkPoint verts[],
@@ -6,6 +6,8 @@
  */
 
 #include "SkGeometry.h"
+#include "SkGeometry_opts.h"
+#include "SkLazyFnPtr.h"
 #include "SkMatrix.h"
 
 bool SkXRayCrossesLine(const SkXRay& pt,
@@ -1006,6 +1008,122 @@ int SkNumXRayCrossingsForCubic(const SkXRay& pt,
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// The smallest n (at least 1) with |dd| / n^2 <= tol, where lenSqd is |dd|^2.
+static int flatten_count(SkScalar lenSqd, SkScalar tol, int maxCount) {
+    SkASSERT(tol > 0 && maxCount > 0);
+    SkScalar n = SkScalarSqrt(SkScalarSqrt(lenSqd) / tol);
+    // also catches NaN
+    if (!(n < maxCount)) {
+        return maxCount;
+    }
+    return SkMax32(SkScalarCeilToInt(n), 1);
+}
+
+int SkQuadFlattenCount(const SkPoint src[3], SkScalar tol, int maxCount) {
+    // error <= |2 * (src[0] - 2 * src[1] + src[2])| * h^2 / 8
+    SkVector dd = src[0] - src[1] - src[1] + src[2];
+    return flatten_count(dd.lengthSqd(), 4 * tol, maxCount);
+}
+
+int SkCubicFlattenCount(const SkPoint src[4], SkScalar tol, int maxCount) {
+    // error <= |6 * max(src[0] - 2 * src[1] + src[2], src[1] - 2 * src[2] + src[3])| * h^2 / 8
+    SkVector dd0 = src[0] - src[1] - src[1] + src[2];
+    SkVector dd1 = src[1] - src[2] - src[2] + src[3];
+    SkScalar lenSqd = SkMaxScalar(dd0.lengthSqd(), dd1.lengthSqd());
+    return flatten_count(lenSqd, SkScalarDiv(4 * tol, 3), maxCount);
+}
+
+static void quad_flatten_portable(const SkPoint src[3], int count, SkPoint dst[]) {
+    const SkScalar h = SK_Scalar1 / count;
+    const SkScalar ddx = 2 * h * h * (src[0].fX - 2 * src[1].fX + src[2].fX);
+    const SkScalar ddy = 2 * h * h * (src[0].fY - 2 * src[1].fY + src[2].fY);
+    SkScalar dx = 2 * h * (src[1].fX - src[0].fX) + SkScalarHalf(ddx);
+    SkScalar dy = 2 * h * (src[1].fY - src[0].fY) + SkScalarHalf(ddy);
+    SkScalar x = src[0].fX;
+    SkScalar y = src[0].fY;
+
+    for (int i = 0; i < count; ++i) {
+        dst[i].set(x, y);
+        x += dx;
+        y += dy;
+        dx += ddx;
+        dy += ddy;
+    }
+    dst[count] = src[2];
+}
+
+static void cubic_flatten_portable(const SkPoint src[4], int count, SkPoint dst[]) {
+    // P(t) = a t^3 + b t^2 + c t + src[0]
+    const SkScalar h = SK_Scalar1 / count;
+    const SkScalar h2 = h * h;
+    const SkScalar h3 = h2 * h;
+    const SkScalar ax = src[3].fX - src[0].fX + 3 * (src[1].fX - src[2].fX);
+    const SkScalar ay = src[3].fY - src[0].fY + 3 * (src[1].fY - src[2].fY);
+    const SkScalar bx = 3 * (src[0].fX - 2 * src[1].fX + src[2].fX);
+    const SkScalar by = 3 * (src[0].fY - 2 * src[1].fY + src[2].fY);
+    const SkScalar cx = 3 * (src[1].fX - src[0].fX);
+    const SkScalar cy = 3 * (src[1].fY - src[0].fY);
+    const SkScalar d3x = 6 * ax * h3;
+    const SkScalar d3y = 6 * ay * h3;
+    SkScalar d2x = d3x + 2 * bx * h2;
+    SkScalar d2y = d3y + 2 * by * h2;
+    SkScalar d1x = ax * h3 + bx * h2 + cx * h;
+    SkScalar d1y = ay * h3 + by * h2 + cy * h;
+    SkScalar x = src[0].fX;
+    SkScalar y = src[0].fY;
+
+    for (int i = 0; i < count; ++i) {
+        dst[i].set(x, y);
+        x += d1x;
+        y += d1y;
+        d1x += d2x;
+        d1y += d2y;
+        d2x += d3x;
+        d2y += d3y;
+    }
+    dst[count] = src[3];
+}
+
+namespace {
+// Technically needs external linkage to be passed as a template parameter (see SkUtils.cpp).
+SkQuadFlattenProc choose_quad_flatten() {
+    SkQuadFlattenProc proc = SkGeometryGetPlatformQuadFlattenProc();
+    return proc ? proc : quad_flatten_portable;
+}
+
+SkCubicFlattenProc choose_cubic_flatten() {
+    SkCubicFlattenProc proc = SkGeometryGetPlatformCubicFlattenProc();
+    return proc ? proc : cubic_flatten_portable;
+}
+}  // namespace
+
+// Below this many steps, the platform procs don't make up for the extra call.
+#define kMinPlatformFlattenCount  4
+
+void SkQuadFlatten(const SkPoint src[3], int count, SkPoint dst[]) {
+    SkASSERT(count > 0);
+
+    if (count >= kMinPlatformFlattenCount) {
+        SK_DECLARE_STATIC_LAZY_FN_PTR(SkQuadFlattenProc, proc, choose_quad_flatten);
+        proc.get()(src, count, dst);
+    } else {
+        quad_flatten_portable(src, count, dst);
+    }
+}
+
+void SkCubicFlatten(const SkPoint src[4], int count, SkPoint dst[]) {
+    SkASSERT(count > 0);
+
+    if (count >= kMinPlatformFlattenCount) {
+        SK_DECLARE_STATIC_LAZY_FN_PTR(SkCubicFlattenProc, proc, choose_cubic_flatten);
+        proc.get()(src, count, dst);
+    } else {
+        cubic_flatten_portable(src, count, dst);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 /*  Find t value for quadratic [a, b, c] = d.
     Return 0 if there is no solution within [0, 1)
 */
@@ -193,6 +193,35 @@ int SkNumXRayCrossingsForCubic(const SkXRay& pt, const SkPoint cubic[4],
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/** Return the number of equal t steps, N, such that the lines joining the
+    points at t = 0, 1/N, 2/N, ... 1 stay within tol of the quad. This is
+    Wang's bound: a curve's chord over a step h strays from it by at most
+    1/8 of its largest second derivative times h^2, and a quad is a parabola
+    whose second derivative is the constant 2 * (src[0] - 2 * src[1] + src[2]).
+    The result is at least 1, and is pinned to maxCount (as it is if the
+    points are not finite).
+*/
+int SkQuadFlattenCount(const SkPoint src[3], SkScalar tol, int maxCount);
+
+/** Same as SkQuadFlattenCount(), for a cubic. The cubic's second derivative
+    blends from 6 * (src[0] - 2 * src[1] + src[2]) to
+    6 * (src[1] - 2 * src[2] + src[3]), so the larger of those bounds it.
+*/
+int SkCubicFlattenCount(const SkPoint src[4], SkScalar tol, int maxCount);
+
+/** Write count + 1 points to dst[]: the quad at t = 0, 1/count, 2/count, ...
+    1, found by forward differencing. dst[0] and dst[count] are exactly
+    src[0] and src[2], but the points between may be off (by float rounding)
+    from what SkEvalQuadAt() would return. count must be > 0.
+*/
+void SkQuadFlatten(const SkPoint src[3], int count, SkPoint dst[]);
+
+/** Same as SkQuadFlatten(), for a cubic, with dst[count] == src[3].
+*/
+void SkCubicFlatten(const SkPoint src[4], int count, SkPoint dst[]);
+
+///////////////////////////////////////////////////////////////////////////////
+
 enum SkRotationDirection {
     kCW_SkRotationDirection,
     kCCW_SkRotationDirection
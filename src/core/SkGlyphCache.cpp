@@ -14,7 +14,9 @@
 #include "SkLazyPtr.h"
 #include "SkPaint.h"
 #include "SkPath.h"
+#include "SkRunnable.h"
 #include "SkTemplates.h"
+#include "SkThreadPool.h"
 #include "SkTLS.h"
 #include "SkTypeface.h"
 
@@ -352,6 +354,78 @@ const void* SkGlyphCache::findImage(const SkGlyph& glyph) {
     return glyph.fImage;
 }
 
+namespace {
+
+// Rasterizes part of a preloadImages() batch on a pool thread. Scaler contexts
+// aren't thread safe, so each task makes its own from the strike's descriptor.
+class PreloadImagesTask : public SkRunnable {
+public:
+    PreloadImagesTask() : fTypeface(NULL), fDesc(NULL), fGlyphs(NULL), fCount(0) {}
+
+    void init(SkTypeface* typeface, const SkDescriptor* desc,
+              const SkGlyph* const glyphs[], int count) {
+        fTypeface = typeface;
+        fDesc = desc;
+        fGlyphs = glyphs;
+        fCount = count;
+    }
+
+    virtual void run() SK_OVERRIDE {
+        SkAutoTDelete<SkScalerContext> ctx(fTypeface->createScalerContext(fDesc));
+        ctx->getImages(fGlyphs, fCount);
+    }
+
+private:
+    SkTypeface*             fTypeface;
+    const SkDescriptor*     fDesc;
+    const SkGlyph* const*   fGlyphs;
+    int                     fCount;
+};
+
+}  // namespace
+
+// Below this, making another scaler context costs more than it saves.
+#define kMinPreloadGlyphsPerThread  16
+
+void SkGlyphCache::preloadImages(const uint16_t glyphIDs[], int count, int threadCount) {
+    // Compute the metrics and allocate the images here, since neither the
+    // hash nor fGlyphAlloc is thread safe. Only the rasterizing is batched.
+    SkTDArray<const SkGlyph*> missing;
+    for (int i = 0; i < count; i++) {
+        const SkGlyph& glyph = this->getGlyphIDMetrics(glyphIDs[i]);
+        if (glyph.fWidth > 0 && glyph.fWidth < kMaxGlyphWidth && NULL == glyph.fImage) {
+            size_t size = glyph.computeImageSize();
+            const_cast<SkGlyph&>(glyph).fImage = fGlyphAlloc.alloc(size,
+                                        SkChunkAlloc::kReturnNil_AllocFailType);
+            // If this fails findImage will try again later.
+            if (NULL != glyph.fImage) {
+                fMemoryUsed += size;
+                *missing.append() = &glyph;
+            }
+        }
+    }
+
+    threadCount = SkTMin(threadCount, missing.count() / kMinPreloadGlyphsPerThread);
+    if (threadCount <= 1) {
+        fScalerContext->getImages(missing.begin(), missing.count());
+        return;
+    }
+
+    // We do the first slice ourselves, with our own scaler context.
+    const int perThread = missing.count() / threadCount;
+    SkAutoTArray<PreloadImagesTask> tasks(threadCount - 1);
+    SkThreadPool pool(threadCount - 1);
+    for (int i = 1; i < threadCount; i++) {
+        const int start = i * perThread;
+        const int stop = (i == threadCount - 1) ? missing.count() : start + perThread;
+        tasks[i - 1].init(fScalerContext->getTypeface(), fDesc,
+                          missing.begin() + start, stop - start);
+        pool.add(&tasks[i - 1]);
+    }
+    fScalerContext->getImages(missing.begin(), perThread);
+    pool.wait();
+}
+
 const SkPath* SkGlyphCache::findPath(const SkGlyph& glyph) {
     if (glyph.fWidth) {
         if (glyph.fPath == NULL) {
@@ -88,6 +88,13 @@ public:
         this will trigger that.
     */
     const void* findImage(const SkGlyph&);
+    /** Generate the images for all of the glyphs in glyphIDs that don't have
+        one yet, in one batch, rather than one at a time as findImage does.
+        If threadCount > 1, large batches are split across that many threads,
+        each rasterizing with its own scaler context for this strike.
+        Only the images at subpixel position (0, 0) are generated.
+    */
+    void preloadImages(const uint16_t glyphIDs[], int count, int threadCount = 1);
     /** Return the Path associated with the glyph. If it has not been generated
         this will trigger that.
     */
@@ -8,11 +8,20 @@
 #include "SkImageFilter.h"
 
 #include "SkBitmap.h"
+#include "SkChecksum.h"
+#include "SkCountdown.h"
 #include "SkDevice.h"
+#include "SkFloatBits.h"
+#include "SkLazyPtr.h"
 #include "SkReadBuffer.h"
 #include "SkWriteBuffer.h"
 #include "SkRect.h"
+#include "SkRunnable.h"
+#include "SkTDArray.h"
 #include "SkTDynamicHash.h"
+#include "SkTInternalLList.h"
+#include "SkThread.h"
+#include "SkThreadPool.h"
 #include "SkValidationUtils.h"
 #if SK_SUPPORT_GPU
 #include "GrContext.h"
@@ -20,12 +29,31 @@
 #include "SkGr.h"
 #endif
 
+// Off by default: a layer filtered every frame has new pixels every frame, so keeping its
+// results only costs memory.  Clients that redraw unchanged bitmaps can turn it on.
+#ifndef SK_DEFAULT_IMAGE_FILTER_CACHE_LIMIT
+    #define SK_DEFAULT_IMAGE_FILTER_CACHE_LIMIT     0
+#endif
+
 SkImageFilter::Cache* gExternalCache;
+static int gTileSize;
+static int gThreadCount = 1;
+
+static uint32_t next_image_filter_unique_id() {
+    static int32_t gImageFilterUniqueID = 0;
+    // Loop in case our global wraps around, as we never want to return 0.
+    int32_t id;
+    do {
+        id = sk_atomic_inc(&gImageFilterUniqueID) + 1;
+    } while (0 == id);
+    return id;
+}
 
 SkImageFilter::SkImageFilter(int inputCount, SkImageFilter** inputs, const CropRect* cropRect)
   : fInputCount(inputCount),
     fInputs(new SkImageFilter*[inputCount]),
-    fCropRect(cropRect ? *cropRect : CropRect(SkRect(), 0x0)) {
+    fCropRect(cropRect ? *cropRect : CropRect(SkRect(), 0x0)),
+    fUniqueID(next_image_filter_unique_id()) {
     for (int i = 0; i < inputCount; ++i) {
         fInputs[i] = inputs[i];
         SkSafeRef(fInputs[i]);
@@ -35,14 +63,16 @@ SkImageFilter::SkImageFilter(int inputCount, SkImageFilter** inputs, const CropR
 SkImageFilter::SkImageFilter(SkImageFilter* input, const CropRect* cropRect)
   : fInputCount(1),
     fInputs(new SkImageFilter*[1]),
-    fCropRect(cropRect ? *cropRect : CropRect(SkRect(), 0x0)) {
+    fCropRect(cropRect ? *cropRect : CropRect(SkRect(), 0x0)),
+    fUniqueID(next_image_filter_unique_id()) {
     fInputs[0] = input;
     SkSafeRef(fInputs[0]);
 }
 
 SkImageFilter::SkImageFilter(SkImageFilter* input1, SkImageFilter* input2, const CropRect* cropRect)
   : fInputCount(2), fInputs(new SkImageFilter*[2]),
-    fCropRect(cropRect ? *cropRect : CropRect(SkRect(), 0x0)) {
+    fCropRect(cropRect ? *cropRect : CropRect(SkRect(), 0x0)),
+    fUniqueID(next_image_filter_unique_id()) {
     fInputs[0] = input1;
     fInputs[1] = input2;
     SkSafeRef(fInputs[0]);
@@ -56,7 +86,8 @@ SkImageFilter::~SkImageFilter() {
     delete[] fInputs;
 }
 
-SkImageFilter::SkImageFilter(int inputCount, SkReadBuffer& buffer) {
+SkImageFilter::SkImageFilter(int inputCount, SkReadBuffer& buffer)
+  : fUniqueID(next_image_filter_unique_id()) {
     fInputCount = buffer.readInt();
     if (buffer.validate((fInputCount >= 0) && ((inputCount < 0) || (fInputCount == inputCount)))) {
         fInputs = new SkImageFilter*[fInputCount];
@@ -106,6 +137,15 @@ bool SkImageFilter::filterImage(Proxy* proxy, const SkBitmap& src,
     if (cache->get(this, result, offset)) {
         return true;
     }
+    // Results from raster sources can also be kept from one draw to the next.
+    const bool persistent = NULL != src.pixelRef() && NULL == src.getTexture();
+    const SkIPoint srcOrigin = src.pixelRefOrigin();
+    const Cache::Key key(fUniqueID, context.ctm(), context.clipBounds(), src.getGenerationID(),
+                         SkIRect::MakeXYWH(srcOrigin.x(), srcOrigin.y(), src.width(), src.height()));
+    if (persistent && cache->getPersistent(key, result, offset)) {
+        cache->set(this, *result, *offset);
+        return true;
+    }
     /*
      *  Give the proxy first shot at the filter. If it returns false, ask
      *  the filter to do it.
@@ -113,11 +153,130 @@ bool SkImageFilter::filterImage(Proxy* proxy, const SkBitmap& src,
     if ((proxy && proxy->filterImage(this, src, context, result, offset)) ||
         this->onFilterImage(proxy, src, context, result, offset)) {
         cache->set(this, *result, *offset);
+        if (persistent && NULL != result->pixelRef() && NULL == result->getTexture()) {
+            cache->setPersistent(key, *result, *offset);
+        }
         return true;
     }
     return false;
 }
 
+namespace {
+
+// Creates devices with another proxy, but hands out old ones again once nothing else refers to
+// them or their pixels.  Filters expect new devices to be clear, so old ones are erased first.
+class ScratchProxy : public SkImageFilter::Proxy {
+public:
+    explicit ScratchProxy(SkImageFilter::Proxy* proxy) : fProxy(proxy) {}
+    virtual ~ScratchProxy() { fDevices.unrefAll(); }
+
+    virtual SkBaseDevice* createDevice(int width, int height) SK_OVERRIDE {
+        for (int i = 0; i < fDevices.count(); ++i) {
+            SkBaseDevice* device = fDevices[i];
+            if (device->width() != width || device->height() != height || !device->unique()) {
+                continue;
+            }
+            const SkBitmap& bitmap = device->accessBitmap(false);
+            if (NULL != bitmap.pixelRef() && bitmap.pixelRef()->unique()) {
+                bitmap.eraseColor(SK_ColorTRANSPARENT);
+                return SkRef(device);
+            }
+        }
+        SkBaseDevice* device = fProxy->createDevice(width, height);
+        if (NULL != device) {
+            *fDevices.append() = SkRef(device);
+        }
+        return device;
+    }
+    virtual bool canHandleImageFilter(const SkImageFilter* filter) SK_OVERRIDE {
+        return fProxy->canHandleImageFilter(filter);
+    }
+    virtual bool filterImage(const SkImageFilter* filter, const SkBitmap& src,
+                             const SkImageFilter::Context& ctx,
+                             SkBitmap* result, SkIPoint* offset) SK_OVERRIDE {
+        return fProxy->filterImage(filter, src, ctx, result, offset);
+    }
+
+private:
+    SkImageFilter::Proxy*    fProxy;
+    SkTDArray<SkBaseDevice*> fDevices;
+};
+
+}  // namespace
+
+static SkImageFilter::Cache* create_tile_cache();
+
+bool SkImageFilter::filterImageTiled(Proxy* proxy, const SkBitmap& src, const Context& context,
+                                     int tileSize, TileSink* sink) const {
+    SkASSERT(proxy);
+    SkASSERT(sink);
+    SkASSERT(tileSize > 0);
+    if (!this->canFilterTiled()) {
+        SkBitmap result;
+        SkIPoint offset = SkIPoint::Make(0, 0);
+        if (!this->filterImage(proxy, src, context, &result, &offset)) {
+            return false;
+        }
+        sink->drawTile(result, offset.x(), offset.y());
+        return true;
+    }
+    SkIRect srcBounds;
+    src.getBounds(&srcBounds);
+    const SkIRect& clip = context.clipBounds();
+    ScratchProxy scratch(proxy);
+    bool foundAny = false;
+    for (int y = clip.fTop; y < clip.fBottom; y += tileSize) {
+        for (int x = clip.fLeft; x < clip.fRight; x += tileSize) {
+            const SkIRect tile = SkIRect::MakeLTRB(x, y, SkTMin(x + tileSize, clip.fRight),
+                                                         SkTMin(y + tileSize, clip.fBottom));
+            // The part of src this tile depends on.  Any more of src would be fine, just slower.
+            SkIRect needed;
+            if (!this->onFilterBounds(tile, context.ctm(), &needed)) {
+                needed = srcBounds;
+            }
+            // Nothing in the graph has to make pixels outside the tile and what it reads.
+            SkIRect tileClip = needed;
+            tileClip.join(tile);
+            if (!needed.intersect(srcBounds)) {
+                needed = tile;
+                if (!needed.intersect(srcBounds)) {
+                    continue;
+                }
+            }
+            SkBitmap subset;
+            if (!src.extractSubset(&subset, needed)) {
+                continue;
+            }
+
+            // Filter subset as if it were still where it is in src.  The intra-tile cache must
+            // be a new one, since results keyed by filter alone differ from tile to tile.
+            SkMatrix ctm(context.ctm());
+            ctm.postTranslate(-SkIntToScalar(needed.fLeft), -SkIntToScalar(needed.fTop));
+            SkAutoTUnref<Cache> cache(create_tile_cache());
+            tileClip.offset(-needed.fLeft, -needed.fTop);
+            const Context tileContext(ctm, tileClip, cache);
+            SkBitmap result;
+            SkIPoint offset = SkIPoint::Make(0, 0);
+            if (!this->filterImage(&scratch, subset, tileContext, &result, &offset)) {
+                continue;
+            }
+
+            SkIRect resultBounds = SkIRect::MakeXYWH(needed.fLeft + offset.fX,
+                                                     needed.fTop + offset.fY,
+                                                     result.width(), result.height());
+            SkBitmap part;
+            if (!resultBounds.intersect(tile) ||
+                !result.extractSubset(&part, resultBounds.makeOffset(-needed.fLeft - offset.fX,
+                                                                     -needed.fTop - offset.fY))) {
+                continue;
+            }
+            sink->drawTile(part, resultBounds.fLeft, resultBounds.fTop);
+            foundAny = true;
+        }
+    }
+    return foundAny;
+}
+
 bool SkImageFilter::filterBounds(const SkIRect& src, const SkMatrix& ctm,
                                  SkIRect* dst) const {
     SkASSERT(&src);
@@ -162,6 +321,22 @@ bool SkImageFilter::onFilterImage(Proxy*, const SkBitmap&, const Context&,
     return false;
 }
 
+bool SkImageFilter::canFilterTiled() const {
+    if (!this->onCanFilterTiled()) {
+        return false;
+    }
+    for (int i = 0; i < fInputCount; ++i) {
+        if (NULL != fInputs[i] && !fInputs[i]->canFilterTiled()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SkImageFilter::onCanFilterTiled() const {
+    return false;
+}
+
 bool SkImageFilter::canFilterImageGPU() const {
     return this->asNewEffect(NULL, NULL, SkMatrix::I(), SkIRect());
 }
@@ -315,6 +490,82 @@ SkImageFilter::Cache* SkImageFilter::GetExternalCache() {
     return gExternalCache;
 }
 
+void SkImageFilter::SetTileSize(int tileSize) {
+    SkASSERT(tileSize >= 0);
+    gTileSize = tileSize;
+}
+
+int SkImageFilter::GetTileSize() {
+    return gTileSize;
+}
+
+void SkImageFilter::SetThreadCount(int threadCount) {
+    SkASSERT(threadCount >= 1);
+    gThreadCount = threadCount;
+}
+
+int SkImageFilter::GetThreadCount() {
+    return gThreadCount;
+}
+
+namespace {
+
+class BandTask : public SkRunnable {
+public:
+    void init(SkImageFilter::BandProc proc, void* context, int start, int stop,
+              SkCountdown* done) {
+        fProc = proc;
+        fContext = context;
+        fStart = start;
+        fStop = stop;
+        fDone = done;
+    }
+
+    virtual void run() SK_OVERRIDE {
+        fProc(fContext, fStart, fStop);
+        fDone->run();
+    }
+
+private:
+    SkImageFilter::BandProc fProc;
+    void*                   fContext;
+    int                     fStart;
+    int                     fStop;
+    SkCountdown*            fDone;
+};
+
+SkThreadPool* create_band_pool() {
+    return SkNEW_ARGS(SkThreadPool, (SkThreadPool::kThreadPerCore));
+}
+
+}  // namespace
+
+void SkImageFilter::RunInBands(BandProc proc, void* context, int count, int minBandSize) {
+    const int threadCount = SkTMin(gThreadCount, count / SkTMax(minBandSize, 1));
+    if (threadCount <= 1) {
+        proc(context, 0, count);
+        return;
+    }
+
+    // Starting threads costs about as much as filtering a small band, so all callers share one
+    // pool that lives as long as the process.  We can't wait() on a shared pool, so each call
+    // counts down its own bands instead.
+    SK_DECLARE_STATIC_LAZY_PTR(SkThreadPool, pool, create_band_pool);
+
+    // We do the first band ourselves.
+    const int perThread = count / threadCount;
+    SkAutoTArray<BandTask> tasks(threadCount - 1);
+    SkCountdown done(threadCount - 1);
+    for (int i = 1; i < threadCount; i++) {
+        const int start = i * perThread;
+        const int stop = (i == threadCount - 1) ? count : start + perThread;
+        tasks[i - 1].init(proc, context, start, stop, &done);
+        pool.get()->add(&tasks[i - 1]);
+    }
+    proc(context, 0, perThread);
+    done.wait();
+}
+
 #if SK_SUPPORT_GPU
 
 void SkImageFilter::WrapTexture(GrTexture* texture, int width, int height, SkBitmap* result) {
@@ -431,6 +682,23 @@ SkImageFilter::Cache* SkImageFilter::Cache::Create(int minChildren) {
     return new CacheImpl(minChildren);
 }
 
+// The intra-tile cache for filterImageTiled().  Results from a subset of the source are only
+// good for one tile, so it keeps them out of the persistent cache.
+class TileCacheImpl : public CacheImpl {
+public:
+    TileCacheImpl() : CacheImpl(2) {}
+    virtual bool getPersistent(const SkImageFilter::Cache::Key&, SkBitmap*,
+                               SkIPoint*) SK_OVERRIDE {
+        return false;
+    }
+    virtual void setPersistent(const SkImageFilter::Cache::Key&, const SkBitmap&,
+                               const SkIPoint&) SK_OVERRIDE {}
+};
+
+static SkImageFilter::Cache* create_tile_cache() {
+    return new TileCacheImpl;
+}
+
 CacheImpl::~CacheImpl() {
     SkTDynamicHash<Value, Key>::Iter iter(&fData);
 
@@ -440,3 +708,142 @@ CacheImpl::~CacheImpl() {
         delete v;
     }
 }
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// The process-wide cache behind Cache::getPersistent() and setPersistent().  Entries are kept in
+// least recently used order, and the oldest are purged once the results add up to over the limit.
+class SharedCache : SkNoncopyable {
+public:
+    typedef SkImageFilter::Cache::Key Key;
+
+    explicit SharedCache(size_t byteLimit) : fBytesUsed(0), fByteLimit(byteLimit) {}
+
+    ~SharedCache() {
+        while (Entry* entry = fLRU.tail()) {
+            this->remove(entry);
+        }
+    }
+
+    size_t bytesUsed() const { return fBytesUsed; }
+    size_t byteLimit() const { return fByteLimit; }
+
+    size_t setByteLimit(size_t newLimit) {
+        const size_t oldLimit = fByteLimit;
+        fByteLimit = newLimit;
+        this->purgeAsNeeded();
+        return oldLimit;
+    }
+
+    bool find(const Key& key, SkBitmap* result, SkIPoint* offset) {
+        Entry* entry = fHash.find(key);
+        if (NULL == entry) {
+            return false;
+        }
+        fLRU.remove(entry);
+        fLRU.addToHead(entry);
+        *result = entry->fBitmap;
+        *offset = entry->fOffset;
+        return true;
+    }
+
+    void add(const Key& key, const SkBitmap& result, const SkIPoint& offset) {
+        const size_t bytes = result.getSize();
+        if (bytes > fByteLimit) {
+            return;
+        }
+        if (Entry* existing = fHash.find(key)) {
+            this->remove(existing);
+        }
+        Entry* entry = SkNEW_ARGS(Entry, (key, result, offset));
+        fHash.add(entry);
+        fLRU.addToHead(entry);
+        fBytesUsed += bytes;
+        this->purgeAsNeeded();
+    }
+
+private:
+    struct Entry {
+        Entry(const Key& key, const SkBitmap& bitmap, const SkIPoint& offset)
+            : fKey(key), fBitmap(bitmap), fOffset(offset) {}
+
+        static const Key& GetKey(const Entry& entry) { return entry.fKey; }
+        static uint32_t Hash(const Key& key) {
+            // The unique ID, matrix, clip bounds, generation ID and subset, in that order.
+            uint32_t data[1 + 9 + 4 + 1 + 4];
+            data[0] = key.fUniqueID;
+            for (int i = 0; i < 9; i++) {
+                data[1 + i] = SkFloat2Bits(SkScalarToFloat(key.fMatrix[i]));
+            }
+            memcpy(&data[10], &key.fClipBounds, sizeof(SkIRect));
+            data[14] = key.fSrcGenID;
+            memcpy(&data[15], &key.fSrcSubset, sizeof(SkIRect));
+            return SkChecksum::Murmur3(data, sizeof(data));
+        }
+
+        const Key fKey;
+        SkBitmap  fBitmap;
+        SkIPoint  fOffset;
+
+        SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
+    };
+
+    void remove(Entry* entry) {
+        fBytesUsed -= entry->fBitmap.getSize();
+        fHash.remove(entry->fKey);
+        fLRU.remove(entry);
+        SkDELETE(entry);
+    }
+
+    void purgeAsNeeded() {
+        while (fBytesUsed > fByteLimit) {
+            this->remove(fLRU.tail());
+        }
+    }
+
+    SkTDynamicHash<Entry, Key> fHash;
+    SkTInternalLList<Entry>    fLRU;
+    size_t                     fBytesUsed;
+    size_t                     fByteLimit;
+};
+
+}  // namespace
+
+SK_DECLARE_STATIC_MUTEX(gSharedCacheMutex);
+static SharedCache* gSharedCache;
+
+// Call with gSharedCacheMutex held.
+static SharedCache* shared_cache() {
+    if (NULL == gSharedCache) {
+        gSharedCache = SkNEW_ARGS(SharedCache, (SK_DEFAULT_IMAGE_FILTER_CACHE_LIMIT));
+    }
+    return gSharedCache;
+}
+
+bool SkImageFilter::Cache::getPersistent(const Key& key, SkBitmap* result, SkIPoint* offset) {
+    SkAutoMutexAcquire am(gSharedCacheMutex);
+    return shared_cache()->find(key, result, offset);
+}
+
+void SkImageFilter::Cache::setPersistent(const Key& key, const SkBitmap& result,
+                                         const SkIPoint& offset) {
+    SkAutoMutexAcquire am(gSharedCacheMutex);
+    shared_cache()->add(key, result, offset);
+}
+
+size_t SkImageFilter::Cache::GetTotalByteLimit() {
+    SkAutoMutexAcquire am(gSharedCacheMutex);
+    return shared_cache()->byteLimit();
+}
+
+size_t SkImageFilter::Cache::SetTotalByteLimit(size_t newLimit) {
+    SkAutoMutexAcquire am(gSharedCacheMutex);
+    return shared_cache()->setByteLimit(newLimit);
+}
+
+size_t SkImageFilter::Cache::GetTotalBytesUsed() {
+    SkAutoMutexAcquire am(gSharedCacheMutex);
+    return shared_cache()->bytesUsed();
+}
@@ -7,24 +7,14 @@
 
 #include "SkMatrix.h"
 #include "SkFloatBits.h"
+#include "SkLazyFnPtr.h"
+#include "SkMatrix_opts.h"
 #include "SkString.h"
 
 #include <stddef.h>
 
-// In a few places, we performed the following
-//      a * b + c * d + e
-// as
-//      a * b + (c * d + e)
-//
-// sdot and scross are indended to capture these compound operations into a
-// function, with an eye toward considering upscaling the intermediates to
-// doubles for more precision (as we do in concat and invert).
-//
-// However, these few lines that performed the last add before the "dot", cause
-// tiny image differences, so we guard that change until we see the impact on
-// chrome's layouttests.
-//
-#define SK_LEGACY_MATRIX_MATH_ORDER
+// SK_LEGACY_MATRIX_MATH_ORDER is defined in SkMatrix_opts.h, so that the platform procs
+// match the math order here.
 
 static inline float SkDoubleToFloat(double x) {
     return static_cast<float>(x);
@@ -1004,11 +994,31 @@ const SkMatrix::MapPtsProc SkMatrix::gMapPtsProcs[] = {
     SkMatrix::Persp_pts,    SkMatrix::Persp_pts
 };
 
+static void map_pts_portable(const SkMatrix& m, SkPoint dst[], const SkPoint src[], int count) {
+    m.getMapPtsProc()(m, dst, src, count);
+}
+
+namespace {
+// Technically needs external linkage to be passed as a template parameter (see SkUtils.cpp).
+SkMatrix::MapPtsProc choose_map_pts_batch() {
+    SkMatrix::MapPtsProc proc = SkMatrixGetPlatformMapPtsProc();
+    return proc ? proc : map_pts_portable;
+}
+}  // namespace
+
+// Below this many points, the platform proc doesn't make up for the extra call.
+#define kMinPlatformMapPtsCount  4
+
 void SkMatrix::mapPoints(SkPoint dst[], const SkPoint src[], int count) const {
     SkASSERT((dst && src && count > 0) || 0 == count);
     // no partial overlap
     SkASSERT(src == dst || &dst[count] <= &src[0] || &src[count] <= &dst[0]);
 
+    if (count >= kMinPlatformMapPtsCount) {
+        SK_DECLARE_STATIC_LAZY_FN_PTR(MapPtsProc, proc, choose_map_pts_batch);
+        proc.get()(*this, dst, src, count);
+        return;
+    }
     this->getMapPtsProc()(*this, dst, src, count);
 }
 
@@ -1083,6 +1093,39 @@ bool SkMatrix::mapRect(SkRect* dst, const SkRect& src) const {
     }
 }
 
+// The corners of this many rects are mapped in one call to mapPoints().
+#define kMapRectsBatchCount  16
+
+bool SkMatrix::mapRects(SkRect dst[], const SkRect src[], int count) const {
+    SkASSERT((dst && src && count > 0) || 0 == count);
+    // no partial overlap
+    SkASSERT(src == dst || &dst[count] <= &src[0] || &src[count] <= &dst[0]);
+
+    if (this->rectStaysRect()) {
+        // Each rect is just two points, so they can all be mapped together.
+        this->mapPoints((SkPoint*)dst, (const SkPoint*)src, count * 2);
+        for (int i = 0; i < count; ++i) {
+            dst[i].sort();
+        }
+        return true;
+    }
+    SkPoint quads[kMapRectsBatchCount * 4];
+    while (count > 0) {
+        const int batch = SkMin32(count, kMapRectsBatchCount);
+        for (int i = 0; i < batch; ++i) {
+            src[i].toQuad(&quads[i * 4]);
+        }
+        this->mapPoints(quads, batch * 4);
+        for (int i = 0; i < batch; ++i) {
+            dst[i].set(&quads[i * 4], 4);
+        }
+        src += batch;
+        dst += batch;
+        count -= batch;
+    }
+    return false;
+}
+
 SkScalar SkMatrix::mapRadius(SkScalar radius) const {
     SkVector    vec[2];
 
@@ -94,9 +94,11 @@ private:
         // Cannot use fRect for our bounds unless we know it is sorted
         fRect.sort();
         fPath = path;
-        // Mark the path's bounds as dirty if (1) they are, or (2) the path
-        // is non-finite, and therefore its bounds are not meaningful
-        fHasValidBounds = path->hasComputedBounds() && path->isFinite();
+        // Mark the path's bounds as dirty if (1) they are, (2) the path
+        // is non-finite, and therefore its bounds are not meaningful, or
+        // (3) they leave out the path's only point, a lone moveTo
+        fHasValidBounds = path->hasComputedBounds() && path->isFinite() &&
+                          path->countPoints() != 1;
         fEmpty = path->isEmpty();
         if (fHasValidBounds && !fEmpty) {
             joinNoEmptyChecks(&fRect, fPath->getBounds());
@@ -140,6 +142,7 @@ void SkPath::resetFields() {
     fFillType = kWinding_FillType;
     fConvexity = kUnknown_Convexity;
     fDirection = kUnknown_Direction;
+    fStaysConcave = false;
 
     // We don't touch Android's fSourcePath.  It's used to track texture garbage collection, so we
     // don't want to muck with it if it's been set to something non-NULL.
@@ -178,6 +181,7 @@ void SkPath::copyFields(const SkPath& that) {
     fFillType        = that.fFillType;
     fConvexity       = that.fConvexity;
     fDirection       = that.fDirection;
+    fStaysConcave    = that.fStaysConcave;
 }
 
 bool operator==(const SkPath& a, const SkPath& b) {
@@ -196,6 +200,7 @@ void SkPath::swap(SkPath& that) {
         SkTSwap<uint8_t>(fFillType, that.fFillType);
         SkTSwap<uint8_t>(fConvexity, that.fConvexity);
         SkTSwap<uint8_t>(fDirection, that.fDirection);
+        SkTSwap<uint8_t>(fStaysConcave, that.fStaysConcave);
 #ifdef SK_BUILD_FOR_ANDROID
         SkTSwap<const SkPath*>(fSourcePath, that.fSourcePath);
 #endif
@@ -645,15 +650,19 @@ void SkPath::setConvexity(Convexity c) {
     if (fConvexity != c) {
         fConvexity = c;
     }
+    fStaysConcave = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////
 //  Construction methods
 
-#define DIRTY_AFTER_EDIT                 \
-    do {                                 \
-        fConvexity = kUnknown_Convexity; \
-        fDirection = kUnknown_Direction; \
+// Only appends use this, so a path that fStaysConcave can keep its convexity.
+#define DIRTY_AFTER_EDIT                     \
+    do {                                     \
+        if (!fStaysConcave) {                \
+            fConvexity = kUnknown_Convexity; \
+        }                                    \
+        fDirection = kUnknown_Direction;     \
     } while (0)
 
 void SkPath::incReserve(U16CPU inc) {
@@ -1701,6 +1710,7 @@ void SkPath::transform(const SkMatrix& matrix, SkPath* dst) const {
             dst->fFillType = fFillType;
             dst->fConvexity = fConvexity;
         }
+        dst->fStaysConcave = false;
 
         if (kUnknown_Direction == fDirection) {
             dst->fDirection = kUnknown_Direction;
@@ -2093,6 +2103,7 @@ size_t SkPath::readFromMemory(const void* storage, size_t length) {
     fConvexity = (packed >> kConvexity_SerializationShift) & 0xFF;
     fFillType = (packed >> kFillType_SerializationShift) & 0xFF;
     fDirection = (packed >> kDirection_SerializationShift) & 0x3;
+    fStaysConcave = false;
     SkPathRef* pathRef = SkPathRef::CreateFromBuffer(&buffer);
 
     size_t sizeRead = 0;
@@ -2346,6 +2357,7 @@ SkPath::Convexity SkPath::internalGetConvexity() const {
             case kMove_Verb:
                 if (++contourCount > 1) {
                     fConvexity = kConcave_Convexity;
+                    fStaysConcave = true;
                     return kConcave_Convexity;
                 }
                 pts[1] = pts[0];
@@ -2371,6 +2383,9 @@ SkPath::Convexity SkPath::internalGetConvexity() const {
         // early exit
         if (kConcave_Convexity == state.getConvexity()) {
             fConvexity = kConcave_Convexity;
+            // Appending to the path changes how its last contour is closed, but not the
+            // segments that were already in it.
+            fStaysConcave = kClose_Verb != verb && !iter.isCloseLine();
             return kConcave_Convexity;
         }
     }
@@ -41,88 +41,28 @@ const SkPathMeasure::Segment* SkPathMeasure::NextSegment(const Segment* seg) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static inline int tspan_big_enough(int tspan) {
-    SkASSERT((unsigned)tspan <= kMaxTValue);
-    return tspan >> 10;
-}
+// How far a curve's segments may stray from it, in the units of its points
+#define FLATTEN_TOLERANCE   (SK_Scalar1/2)
 
-// can't use tangents, since we need [0..1..................2] to be seen
-// as definitely not a line (it is when drawn, but not parametrically)
-// so we compare midpoints
-#define CHEAP_DIST_LIMIT    (SK_Scalar1/2)  // just made this value up
-
-static bool quad_too_curvy(const SkPoint pts[3]) {
-    // diff = (a/4 + b/2 + c/4) - (a/2 + c/2)
-    // diff = -a/4 + b/2 - c/4
-    SkScalar dx = SkScalarHalf(pts[1].fX) -
-                        SkScalarHalf(SkScalarHalf(pts[0].fX + pts[2].fX));
-    SkScalar dy = SkScalarHalf(pts[1].fY) -
-                        SkScalarHalf(SkScalarHalf(pts[0].fY + pts[2].fY));
-
-    SkScalar dist = SkMaxScalar(SkScalarAbs(dx), SkScalarAbs(dy));
-    return dist > CHEAP_DIST_LIMIT;
-}
+// Curves are broken into at most this many segments, of equal t spans.
+#define kMaxCurveSegs       32
 
-static bool cheap_dist_exceeds_limit(const SkPoint& pt,
-                                     SkScalar x, SkScalar y) {
-    SkScalar dist = SkMaxScalar(SkScalarAbs(x - pt.fX), SkScalarAbs(y - pt.fY));
-    // just made up the 1/2
-    return dist > CHEAP_DIST_LIMIT;
-}
-
-static bool cubic_too_curvy(const SkPoint pts[4]) {
-    return  cheap_dist_exceeds_limit(pts[1],
-                         SkScalarInterp(pts[0].fX, pts[3].fX, SK_Scalar1/3),
-                         SkScalarInterp(pts[0].fY, pts[3].fY, SK_Scalar1/3))
-                         ||
-            cheap_dist_exceeds_limit(pts[2],
-                         SkScalarInterp(pts[0].fX, pts[3].fX, SK_Scalar1*2/3),
-                         SkScalarInterp(pts[0].fY, pts[3].fY, SK_Scalar1*2/3));
-}
+// flat[] holds count + 1 points on the curve, at evenly spaced t
+SkScalar SkPathMeasure::compute_curve_segs(const SkPoint flat[], int count,
+                                           int segType, SkScalar distance,
+                                           int ptIndex) {
+    SkASSERT(count > 0 && count <= kMaxCurveSegs);
 
-SkScalar SkPathMeasure::compute_quad_segs(const SkPoint pts[3],
-                          SkScalar distance, int mint, int maxt, int ptIndex) {
-    if (tspan_big_enough(maxt - mint) && quad_too_curvy(pts)) {
-        SkPoint tmp[5];
-        int     halft = (mint + maxt) >> 1;
-
-        SkChopQuadAtHalf(pts, tmp);
-        distance = this->compute_quad_segs(tmp, distance, mint, halft, ptIndex);
-        distance = this->compute_quad_segs(&tmp[2], distance, halft, maxt, ptIndex);
-    } else {
-        SkScalar d = SkPoint::Distance(pts[0], pts[2]);
+    for (int i = 1; i <= count; i++) {
+        SkScalar d = SkPoint::Distance(flat[i - 1], flat[i]);
         SkScalar prevD = distance;
         distance += d;
         if (distance > prevD) {
             Segment* seg = fSegments.append();
             seg->fDistance = distance;
             seg->fPtIndex = ptIndex;
-            seg->fType = kQuad_SegType;
-            seg->fTValue = maxt;
-        }
-    }
-    return distance;
-}
-
-SkScalar SkPathMeasure::compute_cubic_segs(const SkPoint pts[4],
-                           SkScalar distance, int mint, int maxt, int ptIndex) {
-    if (tspan_big_enough(maxt - mint) && cubic_too_curvy(pts)) {
-        SkPoint tmp[7];
-        int     halft = (mint + maxt) >> 1;
-
-        SkChopCubicAtHalf(pts, tmp);
-        distance = this->compute_cubic_segs(tmp, distance, mint, halft, ptIndex);
-        distance = this->compute_cubic_segs(&tmp[3], distance, halft, maxt, ptIndex);
-    } else {
-        SkScalar d = SkPoint::Distance(pts[0], pts[3]);
-        SkScalar prevD = distance;
-        distance += d;
-        if (distance > prevD) {
-            Segment* seg = fSegments.append();
-            seg->fDistance = distance;
-            seg->fPtIndex = ptIndex;
-            seg->fType = kCubic_SegType;
-            seg->fTValue = maxt;
+            seg->fType = segType;
+            seg->fTValue = kMaxTValue * i / count;
         }
     }
     return distance;
@@ -135,13 +75,14 @@ void SkPathMeasure::buildSegments() {
     bool            isClosed = fForceClosed;
     bool            firstMoveTo = ptIndex < 0;
     Segment*        seg;
+    SkPoint         flat[kMaxCurveSegs + 1];
 
     /*  Note:
      *  as we accumulate distance, we have to check that the result of +=
      *  actually made it larger, since a very small delta might be > 0, but
      *  still have no effect on distance (if distance >>> delta).
      *
-     *  We do this check below, and in compute_quad_segs and compute_cubic_segs
+     *  We do this check below, and in compute_curve_segs
      */
     fSegments.reset();
     bool done = false;
@@ -178,8 +119,11 @@ void SkPathMeasure::buildSegments() {
 
             case SkPath::kQuad_Verb: {
                 SkScalar prevD = distance;
-                distance = this->compute_quad_segs(pts, distance, 0,
-                                                   kMaxTValue, ptIndex);
+                int count = SkQuadFlattenCount(pts, FLATTEN_TOLERANCE,
+                                               kMaxCurveSegs);
+                SkQuadFlatten(pts, count, flat);
+                distance = this->compute_curve_segs(flat, count, kQuad_SegType,
+                                                    distance, ptIndex);
                 if (distance > prevD) {
                     fPts.append(2, pts + 1);
                     ptIndex += 2;
@@ -188,8 +132,11 @@ void SkPathMeasure::buildSegments() {
 
             case SkPath::kCubic_Verb: {
                 SkScalar prevD = distance;
-                distance = this->compute_cubic_segs(pts, distance, 0,
-                                                    kMaxTValue, ptIndex);
+                int count = SkCubicFlattenCount(pts, FLATTEN_TOLERANCE,
+                                                kMaxCurveSegs);
+                SkCubicFlatten(pts, count, flat);
+                distance = this->compute_curve_segs(flat, count, kCubic_SegType,
+                                                    distance, ptIndex);
                 if (distance > prevD) {
                     fPts.append(3, pts + 1);
                     ptIndex += 3;
@@ -209,6 +156,7 @@ void SkPathMeasure::buildSegments() {
     fLength = distance;
     fIsClosed = isClosed;
     fFirstPtIndex = ptIndex;
+    this->buildIndex();
 
 #ifdef SK_DEBUG
     {
@@ -340,6 +288,9 @@ SkPathMeasure::SkPathMeasure() {
     fLength = -1;   // signal we need to compute it
     fForceClosed = false;
     fFirstPtIndex = -1;
+    fUseIndex = false;
+    fOnFirstContour = true;
+    fGenerationID = 0;
 }
 
 SkPathMeasure::SkPathMeasure(const SkPath& path, bool forceClosed) {
@@ -347,6 +298,9 @@ SkPathMeasure::SkPathMeasure(const SkPath& path, bool forceClosed) {
     fLength = -1;   // signal we need to compute it
     fForceClosed = forceClosed;
     fFirstPtIndex = -1;
+    fUseIndex = false;
+    fOnFirstContour = true;
+    fGenerationID = path.getGenerationID();
 
     fIter.setPath(path, forceClosed);
 }
@@ -356,16 +310,32 @@ SkPathMeasure::~SkPathMeasure() {}
 /** Assign a new path, or null to have none.
 */
 void SkPathMeasure::setPath(const SkPath* path, bool forceClosed) {
+    if (path && path == fPath && forceClosed == fForceClosed && fOnFirstContour &&
+            path->getGenerationID() == fGenerationID) {
+        // Same path, unchanged, and we're still on its first contour: nothing to redo.
+        return;
+    }
+
     fPath = path;
     fLength = -1;   // signal we need to compute it
     fForceClosed = forceClosed;
     fFirstPtIndex = -1;
+    fOnFirstContour = true;
+    fGenerationID = path ? path->getGenerationID() : 0;
 
     if (path) {
         fIter.setPath(*path, forceClosed);
     }
     fSegments.reset();
     fPts.reset();
+    fIndex.reset();
+}
+
+void SkPathMeasure::setUseIndex(bool useIndex) {
+    fUseIndex = useIndex;
+    if (fLength >= 0) {
+        this->buildIndex();
+    }
 }
 
 SkScalar SkPathMeasure::getLength() {
@@ -379,18 +349,54 @@ SkScalar SkPathMeasure::getLength() {
     return fLength;
 }
 
-const SkPathMeasure::Segment* SkPathMeasure::distanceToSegment(
-                                            SkScalar distance, SkScalar* t) {
-    SkDEBUGCODE(SkScalar length = ) this->getLength();
-    SkASSERT(distance >= 0 && distance <= length);
+void SkPathMeasure::buildIndex() {
+    int count = fSegments.count();
+    if (!fUseIndex || 0 == count || !(fLength > 0)) {
+        fIndex.reset();
+        return;
+    }
+
+    // One bucket per segment, so on average each bucket starts within a segment or two of
+    // any distance that lands in it.
+    fIndex.setCount(count);
+    fIndexScale = count / fLength;
+    const Segment* segs = fSegments.begin();
+    int index = 0;
+    for (int i = 0; i < count; i++) {
+        SkScalar start = i / fIndexScale;
+        while (index < count - 1 && segs[index].fDistance < start) {
+            index++;
+        }
+        fIndex[i] = index;
+    }
+}
 
-    const Segment*  seg = fSegments.begin();
+// Returns the index of the first segment that reaches distance.
+int SkPathMeasure::findSegment(SkScalar distance) const {
+    const Segment*  segs = fSegments.begin();
     int             count = fSegments.count();
 
-    int index = SkTSearch<SkScalar>(&seg->fDistance, count, distance, sizeof(Segment));
+    if (fIndex.count()) {
+        int index = fIndex[SkPin32(SkScalarFloorToInt(distance * fIndexScale),
+                                   0, fIndex.count() - 1)];
+        // the bucket's start was rounded, so we may be a segment off either way
+        while (index > 0 && segs[index - 1].fDistance >= distance) {
+            index--;
+        }
+        while (index < count - 1 && segs[index].fDistance < distance) {
+            index++;
+        }
+        return index;
+    }
+
+    int index = SkTSearch<SkScalar>(&segs->fDistance, count, distance, sizeof(Segment));
     // don't care if we hit an exact match or not, so we xor index if it is negative
-    index ^= (index >> 31);
-    seg = &seg[index];
+    return index ^ (index >> 31);
+}
+
+const SkPathMeasure::Segment* SkPathMeasure::segmentT(int index, SkScalar distance,
+                                                      SkScalar* t) const {
+    const Segment* seg = &fSegments[index];
 
     // now interpolate t-values with the prev segment (if possible)
     SkScalar    startT = 0, startD = 0;
@@ -413,6 +419,14 @@ const SkPathMeasure::Segment* SkPathMeasure::distanceToSegment(
     return seg;
 }
 
+const SkPathMeasure::Segment* SkPathMeasure::distanceToSegment(
+                                            SkScalar distance, SkScalar* t) {
+    SkDEBUGCODE(SkScalar length = ) this->getLength();
+    SkASSERT(distance >= 0 && distance <= length);
+
+    return this->segmentT(this->findSegment(distance), distance, t);
+}
+
 bool SkPathMeasure::getPosTan(SkScalar distance, SkPoint* pos,
                               SkVector* tangent) {
     if (NULL == fPath) {
@@ -440,6 +454,53 @@ bool SkPathMeasure::getPosTan(SkScalar distance, SkPoint* pos,
     return true;
 }
 
+bool SkPathMeasure::getPosTanBatch(const SkScalar distances[], int count,
+                                   SkPoint positions[], SkVector tangents[]) {
+    if (NULL == fPath) {
+        return false;
+    }
+
+    SkScalar    length = this->getLength(); // call this to force computing it
+    int         segCount = fSegments.count();
+
+    if (segCount == 0 || length == 0) {
+        return false;
+    }
+
+    const Segment*  segs = fSegments.begin();
+    int             index = 0;
+    // so the first distance is looked up, rather than walked to from the start
+    SkScalar        prevDistance = SK_ScalarMax;
+
+    for (int i = 0; i < count; i++) {
+        // pin the distance to a legal range
+        SkScalar distance = distances[i];
+        if (distance < 0) {
+            distance = 0;
+        } else if (distance > length) {
+            distance = length;
+        }
+
+        if (distance < prevDistance) {
+            // out of order, so we can't just walk forward
+            index = this->findSegment(distance);
+        } else {
+            while (index < segCount - 1 && segs[index].fDistance < distance) {
+                index++;
+            }
+        }
+        prevDistance = distance;
+
+        SkScalar        t;
+        const Segment*  seg = this->segmentT(index, distance, &t);
+
+        compute_pos_tan(&fPts[seg->fPtIndex], seg->fType, t,
+                        positions ? &positions[i] : NULL,
+                        tangents ? &tangents[i] : NULL);
+    }
+    return true;
+}
+
 bool SkPathMeasure::getMatrix(SkScalar distance, SkMatrix* matrix,
                               MatrixFlags flags) {
     if (NULL == fPath) {
@@ -515,6 +576,7 @@ bool SkPathMeasure::isClosed() {
 */
 bool SkPathMeasure::nextContour() {
     fLength = -1;
+    fOnFirstContour = false;
     return this->getLength() > 0;
 }
 
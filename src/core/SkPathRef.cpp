@@ -84,6 +84,7 @@ void SkPathRef::CreateTransformedCopy(SkAutoTUnref<SkPathRef>* dst,
         */
     if (canXformBounds) {
         (*dst)->fBoundsIsDirty = false;
+        (*dst)->fBoundsPointCnt = (*dst)->fPointCnt;
         if (src.fIsFinite) {
             matrix.mapRect(&(*dst)->fBounds, src.fBounds);
             if (!((*dst)->fIsFinite = (*dst)->fBounds.isFinite())) {
@@ -95,6 +96,7 @@ void SkPathRef::CreateTransformedCopy(SkAutoTUnref<SkPathRef>* dst,
         }
     } else {
         (*dst)->fBoundsIsDirty = true;
+        (*dst)->fBoundsPointCnt = 0;
     }
 
     (*dst)->fSegmentMask = src.fSegmentMask;
@@ -142,6 +144,7 @@ SkPathRef* SkPathRef::CreateFromBuffer(SkRBuffer* buffer) {
         return NULL;
     }
     ref->fBoundsIsDirty = false;
+    ref->fBoundsPointCnt = pointCount;
 
     // resetToSize clears fSegmentMask and fIsOval
     ref->fSegmentMask = segmentMask;
@@ -153,6 +156,7 @@ void SkPathRef::Rewind(SkAutoTUnref<SkPathRef>* pathRef) {
     if ((*pathRef)->unique()) {
         SkDEBUGCODE((*pathRef)->validate();)
         (*pathRef)->fBoundsIsDirty = true;  // this also invalidates fIsFinite
+        (*pathRef)->fBoundsPointCnt = 0;
         (*pathRef)->fVerbCnt = 0;
         (*pathRef)->fPointCnt = 0;
         (*pathRef)->fFreeSpace = (*pathRef)->currSize();
@@ -265,7 +269,8 @@ void SkPathRef::copy(const SkPathRef& ref,
     // a copy then presumably we intend to make a modification immediately afterwards.
     fGenerationID = ref.fGenerationID;
     fBoundsIsDirty = ref.fBoundsIsDirty;
-    if (!fBoundsIsDirty) {
+    fBoundsPointCnt = ref.fBoundsPointCnt;
+    if (!fBoundsIsDirty || fBoundsPointCnt) {
         fBounds = ref.fBounds;
         fIsFinite = ref.fIsFinite;
     }
@@ -274,6 +279,23 @@ void SkPathRef::copy(const SkPathRef& ref,
     SkDEBUGCODE(this->validate();)
 }
 
+bool SkPathRef::ExtendPtBounds(SkRect* bounds, const SkPoint pts[], int count) {
+    SkASSERT(count >= 0);
+    if (0 == count) {
+        return true;
+    }
+    SkRect added;
+    if (!added.setBoundsCheck(pts, count)) {
+        bounds->setEmpty();
+        return false;
+    }
+    // Not join(), which would skip a zero-width or zero-height rect.
+    bounds->set(SkMinScalar(bounds->fLeft, added.fLeft), SkMinScalar(bounds->fTop, added.fTop),
+                SkMaxScalar(bounds->fRight, added.fRight),
+                SkMaxScalar(bounds->fBottom, added.fBottom));
+    return true;
+}
+
 SkPoint* SkPathRef::growForRepeatedVerb(int /*SkPath::Verb*/ verb,
                                         int numVbs,
                                         SkScalar** weights) {
@@ -339,7 +361,7 @@ SkPoint* SkPathRef::growForRepeatedVerb(int /*SkPath::Verb*/ verb,
     fVerbCnt += numVbs;
     fPointCnt += pCnt;
     fFreeSpace -= space;
-    fBoundsIsDirty = true;  // this also invalidates fIsFinite
+    fBoundsIsDirty = true;  // the bounds of the old points are kept in fBounds
     if (dirtyAfterEdit) {
         fIsOval = false;
     }
@@ -397,7 +419,7 @@ SkPoint* SkPathRef::growForVerb(int /* SkPath::Verb*/ verb, SkScalar weight) {
     fVerbCnt += 1;
     fPointCnt += pCnt;
     fFreeSpace -= space;
-    fBoundsIsDirty = true;  // this also invalidates fIsFinite
+    fBoundsIsDirty = true;  // the bounds of the old points are kept in fBounds
     if (dirtyAfterEdit) {
         fIsOval = false;
     }
@@ -440,6 +462,8 @@ void SkPathRef::validate() const {
     SkASSERT(!(NULL == fVerbs && fVerbCnt));
     SkASSERT(this->currSize() ==
                 fFreeSpace + sizeof(SkPoint) * fPointCnt + sizeof(uint8_t) * fVerbCnt);
+    SkASSERT(fBoundsPointCnt >= 0 && fBoundsPointCnt <= fPointCnt);
+    SkASSERT(fBoundsIsDirty || fBoundsPointCnt == fPointCnt);
 
     if (!fBoundsIsDirty && !fBounds.isEmpty()) {
         bool isFinite = true;
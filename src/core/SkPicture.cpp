@@ -342,7 +342,28 @@ SkPicture::SkPicture(SkPicturePlayback* playback, int width, int height)
     this->needsNewGenID();
 }
 
+bool SkPicture::InternalOnly_StreamHasPlayback(SkStream* stream, const SkPictInfo& info) {
+    // Prior to v29 the flag was a single byte, which left every chunk after it unaligned.
+    if (info.fVersion < 29) {
+        return stream->readBool();
+    }
+    return SkToBool(stream->readU32());
+}
+
 SkPicture* SkPicture::CreateFromStream(SkStream* stream, InstallPixelRefProc proc) {
+    return CreateFromStream(stream, proc, NULL);
+}
+
+SkPicture* SkPicture::CreateFromData(SkData* data, InstallPixelRefProc proc) {
+    if (NULL == data) {
+        return NULL;
+    }
+    SkMemoryStream stream(data);
+    return CreateFromStream(&stream, proc, data);
+}
+
+SkPicture* SkPicture::CreateFromStream(SkStream* stream, InstallPixelRefProc proc,
+                                       const SkData* backing) {
     SkPictInfo info;
 
     if (!InternalOnly_StreamIsSKP(stream, &info)) {
@@ -350,8 +371,9 @@ SkPicture* SkPicture::CreateFromStream(SkStream* stream, InstallPixelRefProc pro
     }
 
     // Check to see if there is a playback to recreate.
-    if (stream->readBool()) {
-        SkPicturePlayback* playback = SkPicturePlayback::CreateFromStream(stream, info, proc);
+    if (InternalOnly_StreamHasPlayback(stream, info)) {
+        SkPicturePlayback* playback = SkPicturePlayback::CreateFromStream(stream, info, proc,
+                                                                          backing);
         if (NULL == playback) {
             return NULL;
         }
@@ -408,14 +430,14 @@ void SkPicture::serialize(SkWStream* stream, EncodeBitmap encoder) const {
     this->createHeader(&info);
     stream->write(&info, sizeof(info));
     if (playback) {
-        stream->writeBool(true);
+        stream->write32(true);
         playback->serialize(stream, encoder);
         // delete playback if it is a local version (i.e. cons'd up just now)
         if (playback != fPlayback) {
             SkDELETE(playback);
         }
     } else {
-        stream->writeBool(false);
+        stream->write32(false);
     }
 }
 
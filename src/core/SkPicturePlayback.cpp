@@ -446,10 +446,27 @@ static uint32_t pictInfoFlagsToReadBufferFlags(uint32_t pictInfoFlags) {
     return rbMask;
 }
 
+// Returns a pointer to the next 'size' bytes of a memory-backed stream, or NULL if the
+// stream has no memory base or those bytes are not 4-byte aligned (as SkReader32 needs).
+static const void* peek_aligned(SkStream* stream, size_t size) {
+    const void* base = stream->getMemoryBase();
+    if (NULL == base || !stream->hasPosition() || !stream->hasLength()) {
+        return NULL;
+    }
+    const size_t offset = stream->getPosition();
+    const size_t length = stream->getLength();
+    if (offset > length || size > length - offset) {
+        return NULL;
+    }
+    const char* ptr = (const char*)base + offset;
+    return SkIsAlign4((intptr_t)ptr) ? ptr : NULL;
+}
+
 bool SkPicturePlayback::parseStreamTag(SkStream* stream,
                                        uint32_t tag,
                                        uint32_t size,
-                                       SkPicture::InstallPixelRefProc proc) {
+                                       SkPicture::InstallPixelRefProc proc,
+                                       const SkData* backing) {
     /*
      *  By the time we encounter BUFFER_SIZE_TAG, we need to have already seen
      *  its dependents: FACTORY_TAG and TYPEFACE_TAG. These two are not required
@@ -463,11 +480,24 @@ bool SkPicturePlayback::parseStreamTag(SkStream* stream,
 
     switch (tag) {
         case SK_PICT_READER_TAG: {
+            SkASSERT(NULL == fOpData);
+            // If the stream is a view of 'backing' (e.g. an mmap'd file), reference the
+            // ops in place. Pages that playback never touches are then never read in.
+            const char* inPlace = NULL != backing ?
+                    (const char*)peek_aligned(stream, size) : NULL;
+            if (NULL != inPlace && inPlace >= (const char*)backing->data() &&
+                inPlace + size <= (const char*)backing->data() + backing->size()) {
+                if (stream->skip(size) != size) {
+                    return false;
+                }
+                fOpData = SkData::NewSubset(backing, inPlace - (const char*)backing->data(),
+                                            size);
+                break;
+            }
             SkAutoMalloc storage(size);
             if (stream->read(storage.get(), size) != size) {
                 return false;
             }
-            SkASSERT(NULL == fOpData);
             fOpData = SkData::NewFromMalloc(storage.detach(), size);
         } break;
         case SK_PICT_FACTORY_TAG: {
@@ -514,7 +544,7 @@ bool SkPicturePlayback::parseStreamTag(SkStream* stream,
             bool success = true;
             int i = 0;
             for ( ; i < fPictureCount; i++) {
-                fPictureRefs[i] = SkPicture::CreateFromStream(stream, proc);
+                fPictureRefs[i] = SkPicture::CreateFromStream(stream, proc, backing);
                 if (NULL == fPictureRefs[i]) {
                     success = false;
                     break;
@@ -532,12 +562,22 @@ bool SkPicturePlayback::parseStreamTag(SkStream* stream,
             }
         } break;
         case SK_PICT_BUFFER_SIZE_TAG: {
-            SkAutoMalloc storage(size);
-            if (stream->read(storage.get(), size) != size) {
-                return false;
+            // Everything in this chunk is deserialized below, so memory-backed streams
+            // can be parsed in place without a temporary copy.
+            SkAutoMalloc storage;
+            const void* data = peek_aligned(stream, size);
+            if (NULL != data) {
+                if (stream->skip(size) != size) {
+                    return false;
+                }
+            } else {
+                data = storage.reset(size);
+                if (stream->read(storage.get(), size) != size) {
+                    return false;
+                }
             }
 
-            SkReadBuffer buffer(storage.get(), size);
+            SkReadBuffer buffer(data, size);
             buffer.setFlags(pictInfoFlagsToReadBufferFlags(fInfo.fFlags));
             buffer.setVersion(fInfo.fVersion);
 
@@ -626,10 +666,11 @@ bool SkPicturePlayback::parseBufferTag(SkReadBuffer& buffer,
 
 SkPicturePlayback* SkPicturePlayback::CreateFromStream(SkStream* stream,
                                                        const SkPictInfo& info,
-                                                       SkPicture::InstallPixelRefProc proc) {
+                                                       SkPicture::InstallPixelRefProc proc,
+                                                       const SkData* backing) {
     SkAutoTDelete<SkPicturePlayback> playback(SkNEW_ARGS(SkPicturePlayback, (info)));
 
-    if (!playback->parseStream(stream, proc)) {
+    if (!playback->parseStream(stream, proc, backing)) {
         return NULL;
     }
     return playback.detach();
@@ -647,7 +688,8 @@ SkPicturePlayback* SkPicturePlayback::CreateFromBuffer(SkReadBuffer& buffer,
 }
 
 bool SkPicturePlayback::parseStream(SkStream* stream,
-                                    SkPicture::InstallPixelRefProc proc) {
+                                    SkPicture::InstallPixelRefProc proc,
+                                    const SkData* backing) {
     for (;;) {
         uint32_t tag = stream->readU32();
         if (SK_PICT_EOF_TAG == tag) {
@@ -655,7 +697,7 @@ bool SkPicturePlayback::parseStream(SkStream* stream,
         }
 
         uint32_t size = stream->readU32();
-        if (!this->parseStreamTag(stream, tag, size, proc)) {
+        if (!this->parseStreamTag(stream, tag, size, proc, backing)) {
             return false; // we're invalid
         }
     }
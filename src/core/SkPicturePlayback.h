@@ -136,9 +136,12 @@ public:
     SkPicturePlayback(const SkPicturePlayback& src,
                       SkPictCopyInfo* deepCopyInfo = NULL);
     SkPicturePlayback(const SkPictureRecord& record, const SkPictInfo&, bool deepCopyOps);
+    // If backing is non-NULL the stream must be a view of it, and the op data may be
+    // referenced from it in place rather than copied.
     static SkPicturePlayback* CreateFromStream(SkStream*,
                                                const SkPictInfo&,
-                                               SkPicture::InstallPixelRefProc);
+                                               SkPicture::InstallPixelRefProc,
+                                               const SkData* backing = NULL);
     static SkPicturePlayback* CreateFromBuffer(SkReadBuffer&,
                                                const SkPictInfo&);
 
@@ -169,7 +172,7 @@ public:
 protected:
     explicit SkPicturePlayback(const SkPictInfo& info);
 
-    bool parseStream(SkStream*, SkPicture::InstallPixelRefProc);
+    bool parseStream(SkStream*, SkPicture::InstallPixelRefProc, const SkData* backing = NULL);
     bool parseBuffer(SkReadBuffer& buffer);
 #ifdef SK_DEVELOPER
     virtual bool preDraw(int opIndex, int type);
@@ -294,7 +297,8 @@ public:
 #endif
 
 private:    // these help us with reading/writing
-    bool parseStreamTag(SkStream*, uint32_t tag, uint32_t size, SkPicture::InstallPixelRefProc);
+    bool parseStreamTag(SkStream*, uint32_t tag, uint32_t size, SkPicture::InstallPixelRefProc,
+                        const SkData* backing);
     bool parseBufferTag(SkReadBuffer&, uint32_t tag, uint32_t size);
     void flattenToBuffer(SkWriteBuffer&) const;
 
@@ -1070,6 +1070,28 @@ void SkPictureRecord::onDrawDRRect(const SkRRect& outer, const SkRRect& inner,
     this->validate(initialOffset, size);
 }
 
+// Batches are recorded one shape at a time, so there is nothing new to play back.
+void SkPictureRecord::onDrawRects(const SkRect rects[], const SkColor colors[], int count,
+                                  const SkPaint& paint) {
+    this->drawEachRect(rects, colors, count, paint);
+}
+
+void SkPictureRecord::onDrawOvals(const SkRect ovals[], const SkColor colors[], int count,
+                                  const SkPaint& paint) {
+    this->drawEachOval(ovals, colors, count, paint);
+}
+
+void SkPictureRecord::onDrawRRects(const SkRRect rrects[], const SkColor colors[], int count,
+                                   const SkPaint& paint) {
+    this->drawEachRRect(rrects, colors, count, paint);
+}
+
+void SkPictureRecord::onDrawAtlas(const SkBitmap& atlas, const SkMatrix xforms[],
+                                  const SkIRect tex[], const SkColor colors[], int count,
+                                  const SkPaint* paint) {
+    this->drawEachSprite(atlas, xforms, tex, colors, count, paint);
+}
+
 void SkPictureRecord::drawPath(const SkPath& path, const SkPaint& paint) {
 
     if (paint.isAntiAlias() && !path.isConvex()) {
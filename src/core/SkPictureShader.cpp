@@ -13,11 +13,21 @@
 #include "SkMatrixUtils.h"
 #include "SkPicture.h"
 #include "SkReadBuffer.h"
+#include "SkScaledImageCache.h"
+#include "SkThread.h"
 
 #if SK_SUPPORT_GPU
 #include "GrContext.h"
 #endif
 
+static int32_t gTileCacheHits;
+static int32_t gTileCacheMisses;
+
+void SkPictureShader::GetTileCacheStats(int32_t* hits, int32_t* misses) {
+    *hits = sk_acquire_load(&gTileCacheHits);
+    *misses = sk_acquire_load(&gTileCacheMisses);
+}
+
 SkPictureShader::SkPictureShader(SkPicture* picture, TileMode tmx, TileMode tmy,
                                  const SkMatrix* localMatrix)
     : INHERITED(localMatrix)
@@ -84,15 +94,34 @@ SkShader* SkPictureShader::refBitmapShader(const SkMatrix& matrix, const SkMatri
     // TODO(fmalita): remove fCachedLocalMatrix from this key after getLocalMatrix is removed.
     if (!fCachedBitmapShader || tileScale != fCachedTileScale ||
         this->getLocalMatrix() != fCachedLocalMatrix) {
+        // The tile only depends on the picture and its scale, so other shaders (and other
+        // instances of this one) drawing the same picture at the same size share it.
         SkBitmap bm;
-        if (!bm.allocN32Pixels(tileSize.width(), tileSize.height())) {
-            return NULL;
+        SkScaledImageCache::ID* id = SkScaledImageCache::FindAndLockPicture(
+            fPicture->uniqueID(), tileScale.width(), tileScale.height(),
+            tileSize.width(), tileSize.height(), &bm);
+        if (id) {
+            sk_atomic_inc(&gTileCacheHits);
+        } else {
+            sk_atomic_inc(&gTileCacheMisses);
+            if (!bm.allocN32Pixels(tileSize.width(), tileSize.height())) {
+                return NULL;
+            }
+            bm.eraseColor(SK_ColorTRANSPARENT);
+
+            SkCanvas canvas(bm);
+            canvas.scale(tileScale.width(), tileScale.height());
+            canvas.drawPicture(fPicture);
+            bm.setImmutable();
+
+            id = SkScaledImageCache::AddAndLockPicture(
+                fPicture->uniqueID(), tileScale.width(), tileScale.height(),
+                tileSize.width(), tileSize.height(), bm);
+        }
+        // bm holds its own ref on the pixels, so the cache is free to purge them from here on.
+        if (id) {
+            SkScaledImageCache::Unlock(id);
         }
-        bm.eraseColor(SK_ColorTRANSPARENT);
-
-        SkCanvas canvas(bm);
-        canvas.scale(tileScale.width(), tileScale.height());
-        canvas.drawPicture(fPicture);
 
         fCachedTileScale = tileScale;
         fCachedLocalMatrix = this->getLocalMatrix();
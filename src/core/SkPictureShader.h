@@ -26,6 +26,12 @@ public:
 
     virtual size_t contextSize() const SK_OVERRIDE;
 
+    /**
+     *  The number of times, across all picture shaders, that a rasterized tile was found in
+     *  SkScaledImageCache, and that one had to be drawn.
+     */
+    static void GetTileCacheStats(int32_t* hits, int32_t* misses);
+
     SK_TO_STRING_OVERRIDE()
     SK_DECLARE_PUBLIC_FLATTENABLE_DESERIALIZATION_PROCS(SkPictureShader)
 
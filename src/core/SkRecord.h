@@ -40,6 +40,12 @@ public:
     // Returns the number of canvas commands in this SkRecord.
     unsigned count() const { return fCount; }
 
+    // Returns the number of bytes used to store the canvas commands and their inline data.
+    // Memory shared through refs (pixels, path data, effects) is not counted.
+    size_t bytesUsed() const {
+        return fAlloc.totalUsed() + fReserved * (sizeof(Record) + sizeof(Type8));
+    }
+
     // Visit the i-th canvas command with a functor matching this interface:
     //   template <typename T>
     //   R operator()(const T& record) { ... }
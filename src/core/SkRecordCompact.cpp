@@ -0,0 +1,238 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkRecordCompact.h"
+
+#include "SkChecksum.h"
+#include "SkFloatBits.h"
+#include "SkRecordDraw.h"
+#include "SkRecordOpts.h"
+#include "SkRecorder.h"
+#include "SkTDynamicHash.h"
+
+using namespace SkRecords;
+
+namespace {
+
+// An entry in the dictionary of unique paints.
+struct UniquePaint {
+    const SkPaint* paint;  // Points into src.
+    unsigned index;        // Index into dst's PaintTable.
+
+    static const SkPaint& GetKey(const UniquePaint& u) { return *u.paint; }
+    static uint32_t Hash(const SkPaint& paint) {
+        // Just a few cheap fields that tend to differ.  SkPaint::operator== sorts out the rest.
+        const uint32_t fields[] = {
+            paint.getColor(),
+            paint.getFlags(),
+            static_cast<uint32_t>(SkFloat2Bits(SkScalarToFloat(paint.getTextSize()))),
+            static_cast<uint32_t>(SkFloat2Bits(SkScalarToFloat(paint.getStrokeWidth()))),
+            static_cast<uint32_t>(reinterpret_cast<uintptr_t>(paint.getShader())),
+            static_cast<uint32_t>(reinterpret_cast<uintptr_t>(paint.getTypeface())),
+        };
+        return SkChecksum::Murmur3(fields, sizeof(fields));
+    }
+};
+
+// First pass: find the unique paints among the commands we know how to compact.
+class PaintCollector : SkNoncopyable {
+public:
+    explicit PaintCollector(unsigned maxPaints) : fEntries(maxPaints), fCount(0) {}
+
+    unsigned count() const { return fCount; }
+    const SkPaint& paint(unsigned i) const { return *fEntries[i].paint; }
+
+    // Returns the index of a paint equal to this one.  It must have been collected.
+    unsigned find(const SkPaint& paint) const {
+        const UniquePaint* entry = fUnique.find(paint);
+        SkASSERT(NULL != entry);
+        return entry->index;
+    }
+
+    template <typename T> void operator()(const T&) {}
+
+    void operator()(const DrawOval& r)    { this->collect(r.paint); }
+    void operator()(const DrawPath& r)    { this->collect(r.paint); }
+    void operator()(const DrawPoints& r)  { this->collect(r.paint); }
+    void operator()(const DrawPosText& r) { this->collect(r.paint); }
+    void operator()(const DrawRRect& r)   { this->collect(r.paint); }
+    void operator()(const DrawRect& r)    { this->collect(r.paint); }
+    void operator()(const DrawText& r)    { this->collect(r.paint); }
+
+private:
+    void collect(const SkPaint& paint) {
+        if (NULL != fUnique.find(paint)) {
+            return;
+        }
+        UniquePaint* entry = &fEntries[fCount];
+        entry->paint = &paint;
+        entry->index = fCount++;
+        fUnique.add(entry);
+    }
+
+    SkAutoTMalloc<UniquePaint> fEntries;
+    unsigned fCount;
+    SkTDynamicHash<UniquePaint, SkPaint> fUnique;
+};
+
+// Try to express v as an integer number of 1/kScale pixel units.
+static bool quantize(SkScalar v, int32_t* units) {
+    const SkScalar scaled = v * PackedPoints::kScale;
+    // Past 2^24 a float can't round trip every integer.  This also rejects NaN.
+    if (!(SkScalarAbs(scaled) < SkIntToScalar(1 << 24)) ||
+        scaled != SkScalarFloorToScalar(scaled)) {
+        return false;
+    }
+    // -0 would unpack as +0.
+    if (0 == scaled && SkFloat2Bits(SkScalarToFloat(scaled)) < 0) {
+        return false;
+    }
+    *units = SkScalarFloorToInt(scaled);
+    return true;
+}
+
+static bool fits_in_16_bits(int32_t delta) {
+    return delta >= SK_MinS16 && delta <= SK_MaxS16;
+}
+
+#define APPEND(T, ...) \
+        SkNEW_PLACEMENT_ARGS(fDst->append<SkRecords::T>(), SkRecords::T, (__VA_ARGS__))
+
+// Second pass: append compact versions of the commands we can, and copy the rest as-is.
+class Compactor : SkNoncopyable {
+public:
+    Compactor(SkRecord* dst, SkRecorder* recorder, const PaintCollector& collector,
+              const SkPaint* paints)
+        : fDst(dst)
+        , fRecorder(recorder)
+        , fCopier(recorder)
+        , fCollector(collector)
+        , fPaints(paints) {}
+
+    // Everything we don't compact we copy by replaying into an SkRecorder on dst.
+    template <typename T> void operator()(const T& r) { fCopier(r); }
+
+    // Draw would quick reject these against the recorder's clip, so we unwrap them ourselves.
+    // SkRecordCompact annotates dst again when we're done.
+    void operator()(const PairedPushCull& r) { fRecorder->pushCull(r.base->rect); }
+    void operator()(const BoundedDrawPosTextH& r) { (*this)(*r.base); }
+
+    void operator()(const DrawOval& r)  { APPEND(CompactDrawOval,  this->share(r.paint), r.oval); }
+    void operator()(const DrawPath& r)  { APPEND(CompactDrawPath,  this->share(r.paint), r.path); }
+    void operator()(const DrawRRect& r) { APPEND(CompactDrawRRect, this->share(r.paint), r.rrect); }
+    void operator()(const DrawRect& r)  { APPEND(CompactDrawRect,  this->share(r.paint), r.rect); }
+
+    void operator()(const DrawText& r) {
+        APPEND(CompactDrawText,
+               this->share(r.paint), this->copy(r.text, r.byteLength), r.byteLength, r.x, r.y);
+    }
+
+    void operator()(const DrawPoints& r) {
+        const unsigned count = SkToUInt(r.count);
+        APPEND(CompactDrawPoints, this->share(r.paint), r.mode, count, this->pack(r.pts, count));
+    }
+
+    void operator()(const DrawPosText& r) {
+        const unsigned count = r.paint.countText(r.text, r.byteLength);
+        APPEND(CompactDrawPosText,
+               this->share(r.paint),
+               this->copy(r.text, r.byteLength),
+               r.byteLength,
+               count,
+               this->pack(r.pos, count));
+    }
+
+private:
+    const SkPaint* share(const SkPaint& paint) const {
+        return &fPaints[fCollector.find(paint)];
+    }
+
+    char* copy(const char* src, size_t bytes) {
+        char* dst = fDst->alloc<char>(SkToUInt(bytes));
+        memcpy(dst, src, bytes);
+        return dst;
+    }
+
+    // Delta-code pts if we can do so losslessly, otherwise just copy them.
+    PackedPoints pack(const SkPoint* pts, unsigned count) {
+        int32_t originX = 0, originY = 0;
+        bool packable = count > 0;
+        int32_t lastX = 0, lastY = 0;
+        for (unsigned i = 0; packable && i < count; i++) {
+            int32_t x, y;
+            packable = quantize(pts[i].fX, &x) && quantize(pts[i].fY, &y);
+            if (packable && 0 == i) {
+                originX = lastX = x;
+                originY = lastY = y;
+            }
+            packable = packable && fits_in_16_bits(x - lastX) && fits_in_16_bits(y - lastY);
+            lastX = x;
+            lastY = y;
+        }
+
+        if (!packable) {
+            SkPoint* raw = fDst->alloc<SkPoint>(count);
+            memcpy(raw, pts, count * sizeof(SkPoint));
+            return PackedPoints(raw);
+        }
+
+        int16_t* deltas = fDst->alloc<int16_t>(2 * count);
+        lastX = originX;
+        lastY = originY;
+        for (unsigned i = 0; i < count; i++) {
+            int32_t x, y;
+            SkAssertResult(quantize(pts[i].fX, &x) && quantize(pts[i].fY, &y));
+            deltas[2*i+0] = SkToS16(x - lastX);
+            deltas[2*i+1] = SkToS16(y - lastY);
+            lastX = x;
+            lastY = y;
+        }
+        return PackedPoints(originX, originY, deltas);
+    }
+
+    SkRecord* fDst;
+    SkRecorder* fRecorder;
+    Draw fCopier;
+    const PaintCollector& fCollector;
+    const SkPaint* fPaints;
+};
+
+#undef APPEND
+
+}  // namespace
+
+size_t SkRecordCompact(const SkRecord& src, SkRecord* dst) {
+    SkASSERT(0 == dst->count());
+
+    PaintCollector collector(src.count());
+    for (unsigned i = 0; i < src.count(); i++) {
+        src.visit<void>(i, collector);
+    }
+
+    SkPaint* paints = dst->alloc<SkPaint>(collector.count());
+    for (unsigned i = 0; i < collector.count(); i++) {
+        SkNEW_PLACEMENT_ARGS(paints + i, SkPaint, (collector.paint(i)));
+    }
+    SkNEW_PLACEMENT_ARGS(dst->append<PaintTable>(), PaintTable, (paints, collector.count()));
+
+    {
+        // We only use this recorder to copy commands, so its size and clip don't matter.
+        SkRecorder recorder(dst, 0, 0);
+        Compactor compactor(dst, &recorder, collector, paints);
+        for (unsigned i = 0; i < src.count(); i++) {
+            src.visit<void>(i, compactor);
+        }
+    }
+
+    // Put back the annotations that we unwrapped above.
+    SkRecordAnnotateCullingPairs(dst);
+    SkRecordBoundDrawPosTextH(dst);
+
+    const size_t before = src.bytesUsed(),
+                 after  = dst->bytesUsed();
+    return before > after ? before - after : 0;
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRecordCompact_DEFINED
+#define SkRecordCompact_DEFINED
+
+#include "SkRecord.h"
+
+// Re-encode src into the empty dst using less memory.  dst plays back exactly like src.
+//
+// Identical paints are stored once, in a PaintTable at the front of dst, and the most common
+// draws refer to them by pointer instead of holding their own copy.  Point arrays for DrawPoints
+// and DrawPosText are delta-coded into 16 bits per coordinate when that is lossless.
+//
+// Returns the number of bytes saved, i.e. src.bytesUsed() - dst->bytesUsed(), or 0 if dst ends
+// up no smaller.  Optimizations which edit paints in place (SkRecordOptimize) should be run on src.
+size_t SkRecordCompact(const SkRecord& src, SkRecord* dst);
+
+#endif//SkRecordCompact_DEFINED
@@ -45,27 +45,56 @@ DRAW(ClipRRect, clipRRect(r.rrect, r.op, r.doAA));
 DRAW(ClipRect, clipRect(r.rect, r.op, r.doAA));
 DRAW(ClipRegion, clipRegion(r.region, r.op));
 
+DRAW(DrawAtlas, drawAtlas(r.atlas, r.xforms, r.tex, r.colors, r.count, r.paint));
 DRAW(DrawBitmap, drawBitmap(r.bitmap, r.left, r.top, r.paint));
 DRAW(DrawBitmapMatrix, drawBitmapMatrix(r.bitmap, r.matrix, r.paint));
 DRAW(DrawBitmapNine, drawBitmapNine(r.bitmap, r.center, r.dst, r.paint));
 DRAW(DrawBitmapRectToRect, drawBitmapRectToRect(r.bitmap, r.src, r.dst, r.paint, r.flags));
 DRAW(DrawDRRect, drawDRRect(r.outer, r.inner, r.paint));
 DRAW(DrawOval, drawOval(r.oval, r.paint));
+DRAW(DrawOvals, drawOvals(r.ovals, r.colors, r.count, r.paint));
 DRAW(DrawPaint, drawPaint(r.paint));
 DRAW(DrawPath, drawPath(r.path, r.paint));
 DRAW(DrawPoints, drawPoints(r.mode, r.count, r.pts, r.paint));
 DRAW(DrawPosText, drawPosText(r.text, r.byteLength, r.pos, r.paint));
 DRAW(DrawPosTextH, drawPosTextH(r.text, r.byteLength, r.xpos, r.y, r.paint));
 DRAW(DrawRRect, drawRRect(r.rrect, r.paint));
+DRAW(DrawRRects, drawRRects(r.rrects, r.colors, r.count, r.paint));
 DRAW(DrawRect, drawRect(r.rect, r.paint));
+DRAW(DrawRects, drawRects(r.rects, r.colors, r.count, r.paint));
 DRAW(DrawSprite, drawSprite(r.bitmap, r.left, r.top, r.paint));
 DRAW(DrawText, drawText(r.text, r.byteLength, r.x, r.y, r.paint));
 DRAW(DrawTextOnPath, drawTextOnPath(r.text, r.byteLength, r.path, r.matrix, r.paint));
 DRAW(DrawVertices, drawVertices(r.vmode, r.vertexCount, r.vertices, r.texs, r.colors,
                                 r.xmode.get(), r.indices, r.indexCount, r.paint));
-#undef DRAW
 
 template <> void Draw::draw(const PairedPushCull& r) { this->draw(*r.base); }
 template <> void Draw::draw(const BoundedDrawPosTextH& r) { this->draw(*r.base); }
 
+// The PaintTable just holds paints for the Compact* commands that follow it.
+template <> void Draw::draw(const PaintTable&) {}
+
+DRAW(CompactDrawOval, drawOval(r.oval, r.paint));
+DRAW(CompactDrawPath, drawPath(r.path, r.paint));
+DRAW(CompactDrawRRect, drawRRect(r.rrect, r.paint));
+DRAW(CompactDrawRect, drawRect(r.rect, r.paint));
+DRAW(CompactDrawText, drawText(r.text, r.byteLength, r.x, r.y, r.paint));
+#undef DRAW
+
+// Delta-coded points are unpacked onto the stack just in time for the draw.
+typedef SkAutoSTMalloc<128, SkPoint> PointStorage;
+static const SkPoint* unpack(const PackedPoints& pts, unsigned count, PointStorage* storage) {
+    return pts.isPacked() ? pts.unpack(count, storage->reset(count)) : pts.raw();
+}
+
+template <> void Draw::draw(const CompactDrawPoints& r) {
+    PointStorage storage;
+    fCanvas->drawPoints(r.mode, r.count, unpack(r.pts, r.count, &storage), r.paint);
+}
+
+template <> void Draw::draw(const CompactDrawPosText& r) {
+    PointStorage storage;
+    fCanvas->drawPosText(r.text, r.byteLength, unpack(r.pos, r.count, &storage), r.paint);
+}
+
 }  // namespace SkRecords
@@ -59,10 +59,19 @@ public:
         return false;
     }
 
+    // Batches are draws, but their shapes may overlap or have their own colors,
+    // so their paint can't stand in for a layer's.
+    bool operator()(DrawRects*)  { fPaint = NULL; return true; }
+    bool operator()(DrawOvals*)  { fPaint = NULL; return true; }
+    bool operator()(DrawRRects*) { fPaint = NULL; return true; }
+    bool operator()(DrawAtlas*)  { fPaint = NULL; return true; }
+
 private:
     // Abstracts away whether the paint is always part of the command or optional.
     template <typename T> static T* AsPtr(SkRecords::Optional<T>& x) { return x; }
     template <typename T> static T* AsPtr(T& x) { return &x; }
+    // Shared paints belong to a PaintTable and must not be edited through a single draw.
+    static SkPaint* AsPtr(SkRecords::SharedPaint&) { return NULL; }
 
     type* fPaint;
 };
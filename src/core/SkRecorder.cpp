@@ -112,6 +112,24 @@ void SkRecorder::onDrawDRRect(const SkRRect& outer, const SkRRect& inner, const
     APPEND(DrawDRRect, delay_copy(paint), outer, inner);
 }
 
+void SkRecorder::onDrawRects(const SkRect rects[], const SkColor colors[], int count,
+                             const SkPaint& paint) {
+    APPEND(DrawRects, delay_copy(paint),
+           this->copy(rects, count), this->copy(colors, count), count);
+}
+
+void SkRecorder::onDrawOvals(const SkRect ovals[], const SkColor colors[], int count,
+                             const SkPaint& paint) {
+    APPEND(DrawOvals, delay_copy(paint),
+           this->copy(ovals, count), this->copy(colors, count), count);
+}
+
+void SkRecorder::onDrawRRects(const SkRRect rrects[], const SkColor colors[], int count,
+                              const SkPaint& paint) {
+    APPEND(DrawRRects, delay_copy(paint),
+           this->copy(rrects, count), this->copy(colors, count), count);
+}
+
 void SkRecorder::drawPath(const SkPath& path, const SkPaint& paint) {
     APPEND(DrawPath, delay_copy(paint), delay_copy(path));
 }
@@ -149,6 +167,13 @@ void SkRecorder::drawSprite(const SkBitmap& bitmap, int left, int top, const SkP
     APPEND(DrawSprite, this->copy(paint), delay_copy(bitmap), left, top);
 }
 
+void SkRecorder::onDrawAtlas(const SkBitmap& atlas, const SkMatrix xforms[],
+                             const SkIRect tex[], const SkColor colors[], int count,
+                             const SkPaint* paint) {
+    APPEND(DrawAtlas, this->copy(paint), atlas,
+           this->copy(xforms, count), this->copy(tex, count), this->copy(colors, count), count);
+}
+
 void SkRecorder::onDrawText(const void* text, size_t byteLength,
                             SkScalar x, SkScalar y, const SkPaint& paint) {
     APPEND(DrawText,
@@ -70,6 +70,11 @@ public:
     void didSetMatrix(const SkMatrix&) SK_OVERRIDE;
 
     void onDrawDRRect(const SkRRect&, const SkRRect&, const SkPaint&) SK_OVERRIDE;
+    void onDrawRects(const SkRect[], const SkColor[], int count, const SkPaint&) SK_OVERRIDE;
+    void onDrawOvals(const SkRect[], const SkColor[], int count, const SkPaint&) SK_OVERRIDE;
+    void onDrawRRects(const SkRRect[], const SkColor[], int count, const SkPaint&) SK_OVERRIDE;
+    void onDrawAtlas(const SkBitmap&, const SkMatrix[], const SkIRect[], const SkColor[],
+                     int count, const SkPaint*) SK_OVERRIDE;
     void onDrawText(const void* text,
                     size_t byteLength,
                     SkScalar x,
@@ -37,24 +37,36 @@ namespace SkRecords {
     M(ClipRect)                                                     \
     M(ClipRegion)                                                   \
     M(Clear)                                                        \
+    M(DrawAtlas)                                                    \
     M(DrawBitmap)                                                   \
     M(DrawBitmapMatrix)                                             \
     M(DrawBitmapNine)                                               \
     M(DrawBitmapRectToRect)                                         \
     M(DrawDRRect)                                                   \
     M(DrawOval)                                                     \
+    M(DrawOvals)                                                    \
     M(DrawPaint)                                                    \
     M(DrawPath)                                                     \
     M(DrawPoints)                                                   \
     M(DrawPosText)                                                  \
     M(DrawPosTextH)                                                 \
     M(DrawRRect)                                                    \
+    M(DrawRRects)                                                   \
     M(DrawRect)                                                     \
+    M(DrawRects)                                                    \
     M(DrawSprite)                                                   \
     M(DrawText)                                                     \
     M(DrawTextOnPath)                                               \
     M(DrawVertices)                                                 \
-    M(BoundedDrawPosTextH)    /*From SkRecordBoundDrawPosTextH*/
+    M(BoundedDrawPosTextH)    /*From SkRecordBoundDrawPosTextH*/    \
+    M(PaintTable)             /*From SkRecordCompact*/              \
+    M(CompactDrawOval)        /*From SkRecordCompact*/              \
+    M(CompactDrawPath)        /*From SkRecordCompact*/              \
+    M(CompactDrawPoints)      /*From SkRecordCompact*/              \
+    M(CompactDrawPosText)     /*From SkRecordCompact*/              \
+    M(CompactDrawRRect)       /*From SkRecordCompact*/              \
+    M(CompactDrawRect)        /*From SkRecordCompact*/              \
+    M(CompactDrawText)        /*From SkRecordCompact*/
 
 // Defines SkRecords::Type, an enum of all record types.
 #define ENUM(T) T##_Type,
@@ -161,6 +173,52 @@ private:
 
 #undef ACT_AS_PTR
 
+// A paint owned by the record's PaintTable.  Like PODArray, it doesn't own anything itself.
+class SharedPaint {
+public:
+    SharedPaint(const SkPaint* paint) : fPaint(paint) { SkASSERT(fPaint); }
+    // Default copy and assign.
+
+    operator const SkPaint& () const { return *fPaint; }
+    const SkPaint* get() const { return fPaint; }
+
+private:
+    const SkPaint* fPaint;
+};
+
+// An array of points, either stored raw or delta-coded as 16-bit steps of 1/kScale pixel from a
+// fixed origin.  Delta coding is only used when it's lossless, so unpack() is exact.
+// PackedPoints doesn't own any memory, and like PODArray we assume its data is POD.
+class PackedPoints {
+public:
+    static const int kScale = 64;
+
+    explicit PackedPoints(SkPoint* raw) : fRaw(raw), fDeltas(NULL), fOriginX(0), fOriginY(0) {}
+    PackedPoints(int32_t originX, int32_t originY, int16_t* deltas)
+        : fRaw(NULL), fDeltas(deltas), fOriginX(originX), fOriginY(originY) {}
+    // Default copy and assign.
+
+    bool isPacked() const { return NULL != fDeltas; }
+    const SkPoint* raw() const { SkASSERT(!this->isPacked()); return fRaw; }
+
+    // Unpack count points into dst, which must have room for them.  Returns dst.
+    const SkPoint* unpack(unsigned count, SkPoint* dst) const {
+        SkASSERT(this->isPacked());
+        int32_t x = fOriginX, y = fOriginY;
+        for (unsigned i = 0; i < count; i++) {
+            x += fDeltas[2*i+0];
+            y += fDeltas[2*i+1];
+            dst[i].set(SkIntToScalar(x) / kScale, SkIntToScalar(y) / kScale);
+        }
+        return dst;
+    }
+
+private:
+    SkPoint* fRaw;
+    int16_t* fDeltas;  // 2 per point: dx, dy.  The first is relative to the origin.
+    int32_t fOriginX, fOriginY;
+};
+
 // Like SkBitmap, but deep copies pixels if they're not immutable.
 // Using this, we guarantee the immutability of all bitmaps we record.
 class ImmutableBitmap {
@@ -215,6 +273,10 @@ RECORD5(DrawBitmapRectToRect, Optional<SkPaint>, paint,
                               SkCanvas::DrawBitmapRectFlags, flags);
 RECORD3(DrawDRRect, SkPaint, paint, SkRRect, outer, SkRRect, inner);
 RECORD2(DrawOval, SkPaint, paint, SkRect, oval);
+RECORD4(DrawOvals, SkPaint, paint,
+                   PODArray<SkRect>, ovals,
+                   PODArray<SkColor>, colors,
+                   int, count);
 RECORD1(DrawPaint, SkPaint, paint);
 RECORD2(DrawPath, SkPaint, paint, SkPath, path);
 RECORD4(DrawPoints, SkPaint, paint, SkCanvas::PointMode, mode, size_t, count, SkPoint*, pts);
@@ -228,7 +290,15 @@ RECORD5(DrawPosTextH, SkPaint, paint,
                       PODArray<SkScalar>, xpos,
                       SkScalar, y);
 RECORD2(DrawRRect, SkPaint, paint, SkRRect, rrect);
+RECORD4(DrawRRects, SkPaint, paint,
+                    PODArray<SkRRect>, rrects,
+                    PODArray<SkColor>, colors,
+                    int, count);
 RECORD2(DrawRect, SkPaint, paint, SkRect, rect);
+RECORD4(DrawRects, SkPaint, paint,
+                   PODArray<SkRect>, rects,
+                   PODArray<SkColor>, colors,
+                   int, count);
 RECORD4(DrawSprite, Optional<SkPaint>, paint, ImmutableBitmap, bitmap, int, left, int, top);
 RECORD5(DrawText, SkPaint, paint,
                   PODArray<char>, text,
@@ -275,10 +345,70 @@ struct DrawVertices {
     int indexCount;
 };
 
+// One field too many for RECORD5.
+struct DrawAtlas {
+    static const Type kType = DrawAtlas_Type;
+
+    DrawAtlas(SkPaint* paint,
+              const SkBitmap& atlas,
+              SkMatrix* xforms,
+              SkIRect* tex,
+              SkColor* colors,
+              int count)
+        : paint(paint)
+        , atlas(atlas)
+        , xforms(xforms)
+        , tex(tex)
+        , colors(colors)
+        , count(count) {}
+
+    Optional<SkPaint> paint;
+    ImmutableBitmap atlas;
+    PODArray<SkMatrix> xforms;
+    PODArray<SkIRect> tex;
+    PODArray<SkColor> colors;
+    int count;
+};
+
 // Records added by optimizations.
 RECORD2(PairedPushCull, Adopted<PushCull>, base, unsigned, skip);
 RECORD3(BoundedDrawPosTextH, Adopted<DrawPosTextH>, base, SkScalar, minY, SkScalar, maxY);
 
+// Records added by SkRecordCompact.  The PaintTable is the first command of a compacted record,
+// and owns the unique paints which the Compact* draws point to.
+struct PaintTable : SkNoncopyable {
+    static const Type kType = PaintTable_Type;
+
+    PaintTable(SkPaint* paints, unsigned count) : paints(paints), count(count) {}
+    ~PaintTable() {
+        for (unsigned i = 0; i < count; i++) {
+            paints[i].~SkPaint();
+        }
+    }
+
+    SkPaint* paints;
+    unsigned count;
+};
+
+RECORD2(CompactDrawOval, SharedPaint, paint, SkRect, oval);
+RECORD2(CompactDrawPath, SharedPaint, paint, SkPath, path);
+RECORD4(CompactDrawPoints, SharedPaint, paint,
+                           SkCanvas::PointMode, mode,
+                           unsigned, count,
+                           PackedPoints, pts);
+RECORD5(CompactDrawPosText, SharedPaint, paint,
+                            PODArray<char>, text,
+                            size_t, byteLength,
+                            unsigned, count,
+                            PackedPoints, pos);
+RECORD2(CompactDrawRRect, SharedPaint, paint, SkRRect, rrect);
+RECORD2(CompactDrawRect, SharedPaint, paint, SkRect, rect);
+RECORD5(CompactDrawText, SharedPaint, paint,
+                         PODArray<char>, text,
+                         size_t, byteLength,
+                         SkScalar, x,
+                         SkScalar, y);
+
 #undef RECORD0
 #undef RECORD1
 #undef RECORD2
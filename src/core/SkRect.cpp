@@ -8,6 +8,8 @@
 
 
 #include "SkRect.h"
+#include "SkLazyFnPtr.h"
+#include "SkRect_opts.h"
 
 void SkIRect::join(int32_t left, int32_t top, int32_t right, int32_t bottom) {
     // do nothing if the params are empty
@@ -55,48 +57,70 @@ void SkRect::toQuad(SkPoint quad[4]) const {
     quad[3].set(fLeft, fBottom);
 }
 
-bool SkRect::setBoundsCheck(const SkPoint pts[], int count) {
-    SkASSERT((pts && count > 0) || count == 0);
-
-    bool isFinite = true;
+static bool set_bounds_check_portable(SkRect* bounds, const SkPoint pts[], int count) {
+    SkASSERT(pts && count > 0);
 
-    if (count <= 0) {
-        sk_bzero(this, sizeof(SkRect));
-    } else {
-        SkScalar    l, t, r, b;
+    SkScalar    l, t, r, b;
 
-        l = r = pts[0].fX;
-        t = b = pts[0].fY;
+    l = r = pts[0].fX;
+    t = b = pts[0].fY;
 
-        // If all of the points are finite, accum should stay 0. If we encounter
-        // a NaN or infinity, then accum should become NaN.
-        float accum = 0;
-        accum *= l; accum *= t;
+    // If all of the points are finite, accum should stay 0. If we encounter
+    // a NaN or infinity, then accum should become NaN.
+    float accum = 0;
+    accum *= l; accum *= t;
 
-        for (int i = 1; i < count; i++) {
-            SkScalar x = pts[i].fX;
-            SkScalar y = pts[i].fY;
+    for (int i = 1; i < count; i++) {
+        SkScalar x = pts[i].fX;
+        SkScalar y = pts[i].fY;
 
-            accum *= x; accum *= y;
+        accum *= x; accum *= y;
 
-            // we use if instead of if/else, so we can generate min/max
-            // float instructions (at least on SSE)
-            if (x < l) l = x;
-            if (x > r) r = x;
+        // we use if instead of if/else, so we can generate min/max
+        // float instructions (at least on SSE)
+        if (x < l) l = x;
+        if (x > r) r = x;
 
-            if (y < t) t = y;
-            if (y > b) b = y;
-        }
+        if (y < t) t = y;
+        if (y > b) b = y;
+    }
 
-        SkASSERT(!accum || !SkScalarIsFinite(accum));
-        if (accum) {
-            l = t = r = b = 0;
-            isFinite = false;
-        }
-        this->set(l, t, r, b);
+    SkASSERT(!accum || !SkScalarIsFinite(accum));
+    if (accum) {
+        bounds->setEmpty();
+        return false;
     }
+    bounds->set(l, t, r, b);
+    return true;
+}
+
+SkRectBoundsCheckProc SkRectGetPortableBoundsCheckProc() {
+    return set_bounds_check_portable;
+}
 
-    return isFinite;
+namespace {
+// Technically needs external linkage to be passed as a template parameter (see SkUtils.cpp).
+SkRectBoundsCheckProc choose_bounds_check() {
+    SkRectBoundsCheckProc proc = SkRectGetPlatformBoundsCheckProc();
+    return proc ? proc : set_bounds_check_portable;
+}
+}  // namespace
+
+// Below this many points, the platform proc doesn't make up for the extra call.
+#define kMinPlatformBoundsCheckCount  8
+
+bool SkRect::setBoundsCheck(const SkPoint pts[], int count) {
+    SkASSERT((pts && count > 0) || count == 0);
+
+    if (count <= 0) {
+        sk_bzero(this, sizeof(SkRect));
+        return true;
+    }
+    if (count >= kMinPlatformBoundsCheckCount) {
+        SK_DECLARE_STATIC_LAZY_FN_PTR(SkRectBoundsCheckProc, proc, choose_bounds_check);
+        return proc.get()(this, pts, count);
+    }
+    return set_bounds_check_portable(this, pts, count);
 }
 
 bool SkRect::intersect(SkScalar left, SkScalar top, SkScalar right,
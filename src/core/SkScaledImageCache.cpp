@@ -56,21 +56,30 @@ static uint32_t compute_hash(const uint32_t data[], int count) {
 }
 
 struct SkScaledImageCache::Key {
+    // Pixel ref generation IDs and picture IDs come from different counters, so the kind of ID
+    // is part of the key.
+    enum IDType {
+        kPixelRef_IDType,
+        kPicture_IDType,
+    };
+
     Key(uint32_t genID,
         SkScalar scaleX,
         SkScalar scaleY,
-        SkIRect  bounds)
+        SkIRect  bounds,
+        IDType   idType = kPixelRef_IDType)
         : fGenID(genID)
         , fScaleX(scaleX)
         , fScaleY(scaleY)
-        , fBounds(bounds) {
-        fHash = compute_hash(&fGenID, 7);
+        , fBounds(bounds)
+        , fIDType(idType) {
+        fHash = compute_hash(&fGenID, 8);
     }
 
     bool operator<(const Key& other) const {
         const uint32_t* a = &fGenID;
         const uint32_t* b = &other.fGenID;
-        for (int i = 0; i < 7; ++i) {
+        for (int i = 0; i < 8; ++i) {
             if (a[i] < b[i]) {
                 return true;
             }
@@ -84,7 +93,7 @@ struct SkScaledImageCache::Key {
     bool operator==(const Key& other) const {
         const uint32_t* a = &fHash;
         const uint32_t* b = &other.fHash;
-        for (int i = 0; i < 8; ++i) {
+        for (int i = 0; i < 9; ++i) {
             if (a[i] != b[i]) {
                 return false;
             }
@@ -97,6 +106,7 @@ struct SkScaledImageCache::Key {
     float       fScaleX;
     float       fScaleY;
     SkIRect     fBounds;
+    uint32_t    fIDType;
 };
 
 struct SkScaledImageCache::Rec {
@@ -389,6 +399,23 @@ SkScaledImageCache::ID* SkScaledImageCache::findAndLock(const SkBitmap& orig,
     return rec_to_id(rec);
 }
 
+SkScaledImageCache::ID* SkScaledImageCache::findAndLockPicture(uint32_t pictureID,
+                                                              SkScalar scaleX,
+                                                              SkScalar scaleY,
+                                                              int32_t width,
+                                                              int32_t height,
+                                                              SkBitmap* bitmap) {
+    const Key key(pictureID, scaleX, scaleY, SkIRect::MakeWH(width, height),
+                  Key::kPicture_IDType);
+    Rec* rec = this->findAndLock(key);
+    if (rec) {
+        SkASSERT(NULL == rec->fMip);
+        SkASSERT(rec->fBitmap.pixelRef());
+        *bitmap = rec->fBitmap;
+    }
+    return rec_to_id(rec);
+}
+
 SkScaledImageCache::ID* SkScaledImageCache::findAndLockMip(const SkBitmap& orig,
                                                            SkMipMap const ** mip) {
     Rec* rec = this->findAndLock(orig.getGenerationID(), 0, 0,
@@ -455,6 +482,17 @@ SkScaledImageCache::ID* SkScaledImageCache::addAndLock(const SkBitmap& orig,
     return this->addAndLock(rec);
 }
 
+SkScaledImageCache::ID* SkScaledImageCache::addAndLockPicture(uint32_t pictureID,
+                                                             SkScalar scaleX,
+                                                             SkScalar scaleY,
+                                                             int32_t width,
+                                                             int32_t height,
+                                                             const SkBitmap& bitmap) {
+    Key key(pictureID, scaleX, scaleY, SkIRect::MakeWH(width, height), Key::kPicture_IDType);
+    Rec* rec = SkNEW_ARGS(Rec, (key, bitmap));
+    return this->addAndLock(rec);
+}
+
 SkScaledImageCache::ID* SkScaledImageCache::addAndLockMip(const SkBitmap& orig,
                                                           const SkMipMap* mip) {
     SkIRect bounds = get_bounds_from_bitmap(orig);
@@ -735,6 +773,16 @@ SkScaledImageCache::ID* SkScaledImageCache::FindAndLock(const SkBitmap& orig,
     return get_cache()->findAndLock(orig, scaleX, scaleY, scaled);
 }
 
+SkScaledImageCache::ID* SkScaledImageCache::FindAndLockPicture(uint32_t pictureID,
+                                                              SkScalar scaleX,
+                                                              SkScalar scaleY,
+                                                              int32_t width,
+                                                              int32_t height,
+                                                              SkBitmap* bitmap) {
+    SkAutoMutexAcquire am(gMutex);
+    return get_cache()->findAndLockPicture(pictureID, scaleX, scaleY, width, height, bitmap);
+}
+
 SkScaledImageCache::ID* SkScaledImageCache::FindAndLockMip(const SkBitmap& orig,
                                                        SkMipMap const ** mip) {
     SkAutoMutexAcquire am(gMutex);
@@ -749,6 +797,16 @@ SkScaledImageCache::ID* SkScaledImageCache::AddAndLock(const SkBitmap& orig,
     return get_cache()->addAndLock(orig, scaleX, scaleY, scaled);
 }
 
+SkScaledImageCache::ID* SkScaledImageCache::AddAndLockPicture(uint32_t pictureID,
+                                                             SkScalar scaleX,
+                                                             SkScalar scaleY,
+                                                             int32_t width,
+                                                             int32_t height,
+                                                             const SkBitmap& bitmap) {
+    SkAutoMutexAcquire am(gMutex);
+    return get_cache()->addAndLockPicture(pictureID, scaleX, scaleY, width, height, bitmap);
+}
+
 SkScaledImageCache::ID* SkScaledImageCache::AddAndLockMip(const SkBitmap& orig,
                                                           const SkMipMap* mip) {
     SkAutoMutexAcquire am(gMutex);
@@ -47,6 +47,9 @@ public:
                            SkScalar scaleY, SkBitmap* returnedBitmap);
     static ID* FindAndLockMip(const SkBitmap& original,
                               SkMipMap const** returnedMipMap);
+    static ID* FindAndLockPicture(uint32_t pictureID, SkScalar scaleX,
+                                  SkScalar scaleY, int32_t width,
+                                  int32_t height, SkBitmap* returnedBitmap);
 
 
     static ID* AddAndLock(uint32_t pixelGenerationID,
@@ -57,6 +60,9 @@ public:
     static ID* AddAndLock(const SkBitmap& original, SkScalar scaleX,
                           SkScalar scaleY, const SkBitmap& bitmap);
     static ID* AddAndLockMip(const SkBitmap& original, const SkMipMap* mipMap);
+    static ID* AddAndLockPicture(uint32_t pictureID, SkScalar scaleX,
+                                 SkScalar scaleY, int32_t width,
+                                 int32_t height, const SkBitmap& bitmap);
 
     static void Unlock(ID*);
 
@@ -125,19 +131,31 @@ public:
     ID* findAndLockMip(const SkBitmap& original,
                        SkMipMap const** returnedMipMap);
 
+    /**
+     *  Search the cache for a picture (by SkPicture::uniqueID()) drawn at
+     *  (scaleX, scaleY) into a width x height bitmap. These keys never
+     *  match those of bitmaps, even when the IDs are equal.
+     */
+    ID* findAndLockPicture(uint32_t pictureID, SkScalar scaleX,
+                           SkScalar scaleY, int32_t width, int32_t height,
+                           SkBitmap* returnedBitmap);
+
     /**
      *  To add a new bitmap (or mipMap) to the cache, call
      *  AddAndLock. Use the returned ptr to unlock the cache when you
      *  are done using scaled.
      *
      *  Use (generationID, width, and height) or (original, scaleX,
-     *  scaleY) or (original) as a search key
+     *  scaleY) or (original) or (pictureID, scaleX, scaleY, width, and
+     *  height) as a search key
      */
     ID* addAndLock(uint32_t pixelGenerationID, int32_t width, int32_t height,
                    const SkBitmap& bitmap);
     ID* addAndLock(const SkBitmap& original, SkScalar scaleX,
                    SkScalar scaleY, const SkBitmap& bitmap);
     ID* addAndLockMip(const SkBitmap& original, const SkMipMap* mipMap);
+    ID* addAndLockPicture(uint32_t pictureID, SkScalar scaleX, SkScalar scaleY,
+                          int32_t width, int32_t height, const SkBitmap& bitmap);
 
     /**
      *  Given a non-null ID ptr returned by either findAndLock or addAndLock,
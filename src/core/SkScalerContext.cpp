@@ -794,6 +794,34 @@ void SkScalerContext::getImage(const SkGlyph& origGlyph) {
     }
 }
 
+void SkScalerContext::getImages(const SkGlyph* const glyphs[], int count) {
+    if (fMaskFilter || fGenerateImageFromPath) {
+        // These need per-glyph work on top of generateImage, so there's nothing to batch.
+        for (int i = 0; i < count; i++) {
+            this->getImage(*glyphs[i]);
+        }
+        return;
+    }
+
+    // Hand each run of glyphs that belong to the same context to it in one call.
+    int start = 0;
+    while (start < count) {
+        SkScalerContext* ctx = this->getGlyphContext(*glyphs[start]);
+        int stop = start + 1;
+        while (stop < count && this->getGlyphContext(*glyphs[stop]) == ctx) {
+            stop++;
+        }
+        ctx->generateImages(glyphs + start, stop - start);
+        start = stop;
+    }
+}
+
+void SkScalerContext::generateImages(const SkGlyph* const glyphs[], int count) {
+    for (int i = 0; i < count; i++) {
+        this->generateImage(*glyphs[i]);
+    }
+}
+
 void SkScalerContext::getPath(const SkGlyph& glyph, SkPath* path) {
     this->internalGetPath(glyph, NULL, path, NULL);
 }
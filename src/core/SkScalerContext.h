@@ -181,6 +181,10 @@ public:
     void        getAdvance(SkGlyph*);
     void        getMetrics(SkGlyph*);
     void        getImage(const SkGlyph&);
+    /** Same as calling getImage() on each of the count glyphs, but lets the
+        subclass amortize its per-glyph setup over the whole batch.
+    */
+    void        getImages(const SkGlyph* const glyphs[], int count);
     void        getPath(const SkGlyph&, SkPath*);
     void        getFontMetrics(SkPaint::FontMetrics*);
 
@@ -236,6 +240,15 @@ protected:
      */
     virtual void generateImage(const SkGlyph& glyph) = 0;
 
+    /** Generates the contents of fImage for each of the count glyphs, all of
+     *  which belong to this context. The same preconditions as generateImage
+     *  apply to each glyph.
+     *
+     *  The default implementation calls generateImage on each glyph. Override
+     *  this if there is setup (locking, selecting a size) that can be shared.
+     */
+    virtual void generateImages(const SkGlyph* const glyphs[], int count);
+
     /** Sets the passed path to the glyph outline.
      *  If this cannot be done the path is set to empty;
      *  this is indistinguishable from a glyph with an empty path.
@@ -45,6 +45,9 @@ public:
                          SkBlitter*);
     static void AntiHairLine(const SkPoint&, const SkPoint&, const SkRasterClip&,
                              SkBlitter*);
+    // Draws the count - 1 lines joining pts[], in one call.
+    static void AntiHairLine(const SkPoint pts[], int count, const SkRasterClip&,
+                             SkBlitter*);
     static void HairRect(const SkRect&, const SkRasterClip&, SkBlitter*);
     static void AntiHairRect(const SkRect&, const SkRasterClip&, SkBlitter*);
     static void HairPath(const SkPath&, const SkRasterClip&, SkBlitter*);
@@ -66,10 +69,11 @@ private:
 
     static void AntiFrameRect(const SkRect&, const SkPoint& strokeSize,
                               const SkRegion*, SkBlitter*);
-    static void HairLineRgn(const SkPoint&, const SkPoint&, const SkRegion*,
-                         SkBlitter*);
-    static void AntiHairLineRgn(const SkPoint&, const SkPoint&, const SkRegion*,
-                             SkBlitter*);
+    // These draw the count - 1 lines joining pts[].
+    static void HairLineRgn(const SkPoint pts[], int count, const SkRegion*,
+                            SkBlitter*);
+    static void AntiHairLineRgn(const SkPoint pts[], int count, const SkRegion*,
+                                SkBlitter*);
 };
 
 /** Assign an SkXRect from a SkIRect, by promoting the src rect's coordinates
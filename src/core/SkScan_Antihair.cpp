@@ -10,9 +10,11 @@
 #include "SkScan.h"
 #include "SkBlitter.h"
 #include "SkColorPriv.h"
+#include "SkLazyFnPtr.h"
 #include "SkLineClipper.h"
 #include "SkRasterClip.h"
 #include "SkFDot6.h"
+#include "SkScan_Antihair_opts.h"
 
 /*  Our attempt to compute the worst case "bounds" for the horizontal and
     vertical cases has some numerical bug in it, and we sometimes undervalue
@@ -317,6 +319,181 @@ public:
     }
 };
 
+///////////////////////////////////////////////////////////////////////////////
+
+/*  If the blitter just blends an opaque color into 32-bit pixels, lines that
+    need no clipping are drawn straight into those pixels, rather than through
+    a blitAntiH() call for each pixel they touch.
+ */
+struct AntiHairDevice32 {
+    const SkBitmap* fDevice;
+    SkPMColor       fPMColor;
+    bool            fIsBlack;
+
+    bool init(SkBlitter* blitter) {
+        uint32_t value;
+        fDevice = blitter->justAnOpaqueColor(&value);
+        if (NULL == fDevice || kN32_SkColorType != fDevice->colorType() ||
+            NULL == fDevice->getPixels()) {
+            return false;
+        }
+        fPMColor = value;
+        fIsBlack = (SK_A32_MASK << SK_A32_SHIFT) == value;
+        return true;
+    }
+
+    /*  Blends like SkARGB32_Blitter::blitAntiH() (or SkARGB32_Black_Blitter's,
+        which SkBlitter::Choose() uses for opaque black), so the pixels come out
+        the same as they would through the blitter.
+     */
+    void blend(SkPMColor* dst, U8CPU alpha) const {
+        if (255 == alpha) {
+            *dst = fPMColor;
+        } else if (fIsBlack) {
+            *dst = (alpha << SK_A32_SHIFT) + SkAlphaMulQ(*dst, 256 - alpha);
+        } else if (alpha) {
+            SkPMColor src = SkAlphaMulQ(fPMColor, SkAlpha255To256(alpha));
+            *dst = src + SkAlphaMulQ(*dst, 256 - SkAlpha255To256(SkGetPackedA32(src)));
+        }
+    }
+
+    void blend(int x, int y, U8CPU alpha) const {
+        this->blend(fDevice->getAddr32(x, y), alpha);
+    }
+};
+
+static void anti_hair_ramp_portable(SkFixed f, SkFixed df, int count,
+                                    uint8_t alpha[], uint8_t invAlpha[]) {
+    for (int i = 0; i < count; ++i) {
+        alpha[i] = (uint8_t)(f >> 8);
+        invAlpha[i] = 255 - alpha[i];
+        f += df;
+    }
+}
+
+namespace {
+// Technically needs external linkage to be passed as a template parameter (see SkUtils.cpp).
+SkAntiHairRampProc choose_ramp() {
+    SkAntiHairRampProc proc = SkAntiHairGetPlatformRampProc();
+    return proc ? proc : anti_hair_ramp_portable;
+}
+}  // namespace
+
+// Below this many steps, the platform proc doesn't make up for the extra call.
+#define kMinPlatformRampCount   8
+
+static void anti_hair_ramp(SkFixed f, SkFixed df, int count,
+                           uint8_t alpha[], uint8_t invAlpha[]) {
+    if (count >= kMinPlatformRampCount) {
+        SK_DECLARE_STATIC_LAZY_FN_PTR(SkAntiHairRampProc, proc, choose_ramp);
+        proc.get()(f, df, count, alpha, invAlpha);
+    } else {
+        anti_hair_ramp_portable(f, df, count, alpha, invAlpha);
+    }
+}
+
+// The most columns (or rows) whose coverage we compute at once
+#define ANTIHAIR_RAMP_BUFFER    64
+
+class Horish32_SkAntiHairBlitter : public SkAntiHairBlitter {
+public:
+    Horish32_SkAntiHairBlitter(const AntiHairDevice32* device) : fDevice(device) {}
+
+    virtual SkFixed drawCap(int x, SkFixed fy, SkFixed dy, int mod64) SK_OVERRIDE {
+        fy += SK_Fixed1/2;
+
+        int lower_y = fy >> 16;
+        uint8_t  a = (uint8_t)(fy >> 8);
+        fDevice->blend(x, lower_y, SmallDot6Scale(a, mod64));
+        fDevice->blend(x, lower_y - 1, SmallDot6Scale(255 - a, mod64));
+        fy += dy;
+
+        return fy - SK_Fixed1/2;
+    }
+
+    virtual SkFixed drawLine(int x, int stopx, SkFixed fy, SkFixed dy) SK_OVERRIDE {
+        SkASSERT(x < stopx);
+
+        uint8_t alpha[ANTIHAIR_RAMP_BUFFER];
+        uint8_t invAlpha[ANTIHAIR_RAMP_BUFFER];
+        const size_t rowBytes = fDevice->fDevice->rowBytes();
+
+        fy += SK_Fixed1/2;
+        do {
+            // find how many columns cover the same pair of rows
+            int lower_y = fy >> 16;
+            int n = stopx - x;
+            if (dy > 0) {
+                n = SkMin32(n, (SkIntToFixed(lower_y + 1) - fy + dy - 1) / dy);
+            } else if (dy < 0) {
+                n = SkMin32(n, (fy - SkIntToFixed(lower_y)) / -dy + 1);
+            }
+            n = SkMin32(n, ANTIHAIR_RAMP_BUFFER);
+            SkASSERT(n > 0);
+
+            anti_hair_ramp(fy, dy, n, alpha, invAlpha);
+            SkPMColor* upper = fDevice->fDevice->getAddr32(x, lower_y - 1);
+            SkPMColor* lower = (SkPMColor*)((char*)upper + rowBytes);
+            for (int i = 0; i < n; ++i) {
+                fDevice->blend(&lower[i], alpha[i]);
+                fDevice->blend(&upper[i], invAlpha[i]);
+            }
+            fy += n * dy;
+            x += n;
+        } while (x < stopx);
+
+        return fy - SK_Fixed1/2;
+    }
+
+private:
+    const AntiHairDevice32* fDevice;
+};
+
+class Vertish32_SkAntiHairBlitter : public SkAntiHairBlitter {
+public:
+    Vertish32_SkAntiHairBlitter(const AntiHairDevice32* device) : fDevice(device) {}
+
+    virtual SkFixed drawCap(int y, SkFixed fx, SkFixed dx, int mod64) SK_OVERRIDE {
+        fx += SK_Fixed1/2;
+
+        int x = fx >> 16;
+        uint8_t  a = (uint8_t)(fx >> 8);
+        fDevice->blend(x - 1, y, SmallDot6Scale(255 - a, mod64));
+        fDevice->blend(x, y, SmallDot6Scale(a, mod64));
+        fx += dx;
+
+        return fx - SK_Fixed1/2;
+    }
+
+    virtual SkFixed drawLine(int y, int stopy, SkFixed fx, SkFixed dx) SK_OVERRIDE {
+        SkASSERT(y < stopy);
+
+        uint8_t alpha[ANTIHAIR_RAMP_BUFFER];
+        uint8_t invAlpha[ANTIHAIR_RAMP_BUFFER];
+        const size_t rowBytes = fDevice->fDevice->rowBytes();
+        char* row = (char*)fDevice->fDevice->getAddr32(0, y);
+
+        fx += SK_Fixed1/2;
+        do {
+            int n = SkMin32(stopy - y, ANTIHAIR_RAMP_BUFFER);
+            anti_hair_ramp(fx, dx, n, alpha, invAlpha);
+            for (int i = 0; i < n; ++i) {
+                SkPMColor* dst = (SkPMColor*)row + (fx >> 16) - 1;
+                fDevice->blend(&dst[0], invAlpha[i]);
+                fDevice->blend(&dst[1], alpha[i]);
+                row += rowBytes;
+                fx += dx;
+            }
+            y += n;
+        } while (y < stopy);
+
+        return fx - SK_Fixed1/2;
+    }
+
+private:
+    const AntiHairDevice32* fDevice;
+};
+
 static inline SkFixed fastfixdiv(SkFDot6 a, SkFDot6 b) {
     SkASSERT((a << 16 >> 16) == a);
     SkASSERT(b != 0);
@@ -371,7 +548,8 @@ static int contribution_64(SkFDot6 ordinate) {
 }
 
 static void do_anti_hairline(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1,
-                             const SkIRect* clip, SkBlitter* blitter) {
+                             const SkIRect* clip, SkBlitter* blitter,
+                             const AntiHairDevice32* device) {
     // check for integer NaN (0x80000000) which we can't handle (can't negate it)
     // It appears typically from a huge float (inf or nan) being converted to int.
     // If we see it, just don't draw.
@@ -395,8 +573,8 @@ static void do_anti_hairline(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1,
          */
         int hx = (x0 >> 1) + (x1 >> 1);
         int hy = (y0 >> 1) + (y1 >> 1);
-        do_anti_hairline(x0, y0, hx, hy, clip, blitter);
-        do_anti_hairline(hx, hy, x1, y1, clip, blitter);
+        do_anti_hairline(x0, y0, hx, hy, clip, blitter, device);
+        do_anti_hairline(hx, hy, x1, y1, clip, blitter, device);
         return;
     }
 
@@ -408,6 +586,8 @@ static void do_anti_hairline(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1,
     Horish_SkAntiHairBlitter    horish_blitter;
     VLine_SkAntiHairBlitter     vline_blitter;
     Vertish_SkAntiHairBlitter   vertish_blitter;
+    Horish32_SkAntiHairBlitter  horish32_blitter(device);
+    Vertish32_SkAntiHairBlitter vertish32_blitter(device);
     SkAntiHairBlitter*          hairBlitter = NULL;
 
     if (SkAbs32(x1 - x0) > SkAbs32(y1 - y0)) {   // mostly horizontal
@@ -565,6 +745,12 @@ static void do_anti_hairline(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1,
     if (clip) {
         rectClipper.init(blitter, *clip);
         blitter = &rectClipper;
+    } else if (device) {
+        if (&horish_blitter == hairBlitter) {
+            hairBlitter = &horish32_blitter;
+        } else if (&vertish_blitter == hairBlitter) {
+            hairBlitter = &vertish32_blitter;
+        }
     }
 
     SkASSERT(hairBlitter);
@@ -588,18 +774,9 @@ static void do_anti_hairline(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1,
     }
 }
 
-void SkScan::AntiHairLineRgn(const SkPoint& pt0, const SkPoint& pt1,
-                             const SkRegion* clip, SkBlitter* blitter) {
-    if (clip && clip->isEmpty()) {
-        return;
-    }
-
-    SkASSERT(clip == NULL || !clip->getBounds().isEmpty());
-
-#ifdef TEST_GAMMA
-    build_gamma_table();
-#endif
-
+static void anti_hair_line_rgn(const SkPoint& pt0, const SkPoint& pt1,
+                               const SkRegion* clip, SkBlitter* blitter,
+                               const AntiHairDevice32* device) {
     SkPoint pts[2] = { pt0, pt1 };
 
     // We have to pre-clip the line to fit in a SkFixed, so we just chop
@@ -657,14 +834,34 @@ void SkScan::AntiHairLineRgn(const SkPoint& pt0, const SkPoint& pt1,
             const SkIRect*       r = &iter.rect();
 
             while (!iter.done()) {
-                do_anti_hairline(x0, y0, x1, y1, r, blitter);
+                do_anti_hairline(x0, y0, x1, y1, r, blitter, device);
                 iter.next();
             }
             return;
         }
         // fall through to no-clip case
     }
-    do_anti_hairline(x0, y0, x1, y1, NULL, blitter);
+    do_anti_hairline(x0, y0, x1, y1, NULL, blitter, device);
+}
+
+void SkScan::AntiHairLineRgn(const SkPoint pts[], int count,
+                             const SkRegion* clip, SkBlitter* blitter) {
+    if (clip && clip->isEmpty()) {
+        return;
+    }
+
+    SkASSERT(clip == NULL || !clip->getBounds().isEmpty());
+
+#ifdef TEST_GAMMA
+    build_gamma_table();
+#endif
+
+    AntiHairDevice32 device32;
+    const AntiHairDevice32* device = device32.init(blitter) ? &device32 : NULL;
+
+    for (int i = 0; i < count - 1; ++i) {
+        anti_hair_line_rgn(pts[i], pts[i + 1], clip, blitter, device);
+    }
 }
 
 void SkScan::AntiHairRect(const SkRect& rect, const SkRasterClip& clip,
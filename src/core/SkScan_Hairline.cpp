@@ -40,8 +40,8 @@ static bool canConvertFDot6ToFixed(SkFDot6 x) {
 }
 #endif
 
-void SkScan::HairLineRgn(const SkPoint& pt0, const SkPoint& pt1,
-                         const SkRegion* clip, SkBlitter* blitter) {
+static void hair_line_rgn(const SkPoint& pt0, const SkPoint& pt1,
+                          const SkRegion* clip, SkBlitter* blitter) {
     SkBlitterClipper    clipper;
     SkRect  r;
     SkIRect clipR, ptsR;
@@ -140,6 +140,13 @@ void SkScan::HairLineRgn(const SkPoint& pt0, const SkPoint& pt1,
     }
 }
 
+void SkScan::HairLineRgn(const SkPoint pts[], int count, const SkRegion* clip,
+                         SkBlitter* blitter) {
+    for (int i = 0; i < count - 1; ++i) {
+        hair_line_rgn(pts[i], pts[i + 1], clip, blitter);
+    }
+}
+
 // we don't just draw 4 lines, 'cause that can leave a gap in the bottom-right
 // and double-hit the top-left.
 // TODO: handle huge coordinates on rect (before calling SkScalarToFixed)
@@ -191,70 +198,69 @@ void SkScan::HairRect(const SkRect& rect, const SkRasterClip& clip,
 #include "SkPath.h"
 #include "SkGeometry.h"
 
-static int compute_int_quad_dist(const SkPoint pts[3]) {
-    // compute the vector between the control point ([1]) and the middle of the
-    // line connecting the start and end ([0] and [2])
-    SkScalar dx = SkScalarHalf(pts[0].fX + pts[2].fX) - pts[1].fX;
-    SkScalar dy = SkScalarHalf(pts[0].fY + pts[2].fY) - pts[1].fY;
-    // we want everyone to be positive
-    dx = SkScalarAbs(dx);
-    dy = SkScalarAbs(dy);
-    // convert to whole pixel values (use ceiling to be conservative)
-    int idx = SkScalarCeilToInt(dx);
-    int idy = SkScalarCeilToInt(dy);
-    // use the cheap approx for distance
-    if (idx > idy) {
-        return idx + (idy >> 1);
-    } else {
-        return idy + (idx >> 1);
-    }
-}
-
-typedef void (*LineProc)(const SkPoint&, const SkPoint&, const SkRegion*,
+typedef void (*LineProc)(const SkPoint[], int count, const SkRegion*,
                          SkBlitter*);
 
-static void hairquad(const SkPoint pts[3], const SkRegion* clip,
-                     SkBlitter* blitter, int level, LineProc lineproc) {
-    if (level > 0) {
-        SkPoint tmp[5];
+// How far the lines may stray from the curve, in pixels
+#define kHairFlattenTolerance   (SK_Scalar1 / 3)
+#define kMaxHairFlattenCount    64
+// The most points handed to lineproc at once
+#define kMaxHairPolylineCount   256
 
-        SkChopQuadAtHalf(pts, tmp);
-        hairquad(tmp, clip, blitter, level - 1, lineproc);
-        hairquad(&tmp[2], clip, blitter, level - 1, lineproc);
-    } else {
-        lineproc(pts[0], pts[2], clip, blitter);
+/*  Collects the lines of a path, so that each run of connected lines (whether
+    from lineTos or from flattening curves) goes to lineproc in one call.
+ */
+class HairPolyline {
+public:
+    HairPolyline(const SkRegion* clip, SkBlitter* blitter, LineProc lineproc)
+        : fClip(clip), fBlitter(blitter), fLineProc(lineproc), fCount(0) {}
+
+    // Adds the count lines joining pts[0...count].
+    void addLines(const SkPoint pts[], int count) {
+        if (fCount > 0 && fPts[fCount - 1] != pts[0]) {
+            this->flush();
+        }
+        if (0 == fCount) {
+            fPts[fCount++] = pts[0];
+        }
+        for (int i = 1; i <= count; ++i) {
+            if (kMaxHairPolylineCount == fCount) {
+                this->flush();
+                fPts[fCount++] = pts[i - 1];
+            }
+            fPts[fCount++] = pts[i];
+        }
     }
-}
 
-static void haircubic(const SkPoint pts[4], const SkRegion* clip,
-                      SkBlitter* blitter, int level, LineProc lineproc) {
-    if (level > 0) {
-        SkPoint tmp[7];
-
-        SkChopCubicAt(pts, tmp, SK_Scalar1/2);
-        haircubic(tmp, clip, blitter, level - 1, lineproc);
-        haircubic(&tmp[3], clip, blitter, level - 1, lineproc);
-    } else {
-        lineproc(pts[0], pts[3], clip, blitter);
+    void flush() {
+        if (fCount > 1) {
+            fLineProc(fPts, fCount, fClip, fBlitter);
+        }
+        fCount = 0;
     }
+
+private:
+    const SkRegion* fClip;
+    SkBlitter*      fBlitter;
+    LineProc        fLineProc;
+    int             fCount;
+    SkPoint         fPts[kMaxHairPolylineCount];
+};
+
+static void hairquad(const SkPoint pts[3], HairPolyline* polyline) {
+    SkPoint flat[kMaxHairFlattenCount + 1];
+    int count = SkQuadFlattenCount(pts, kHairFlattenTolerance,
+                                   kMaxHairFlattenCount);
+    SkQuadFlatten(pts, count, flat);
+    polyline->addLines(flat, count);
 }
 
-#define kMaxCubicSubdivideLevel 6
-#define kMaxQuadSubdivideLevel  5
-
-static int compute_quad_level(const SkPoint pts[3]) {
-    int d = compute_int_quad_dist(pts);
-    /*  quadratics approach the line connecting their start and end points
-     4x closer with each subdivision, so we compute the number of
-     subdivisions to be the minimum need to get that distance to be less
-     than a pixel.
-     */
-    int level = (33 - SkCLZ(d)) >> 1;
-    // sanity check on level (from the previous version)
-    if (level > kMaxQuadSubdivideLevel) {
-        level = kMaxQuadSubdivideLevel;
-    }
-    return level;
+static void haircubic(const SkPoint pts[4], HairPolyline* polyline) {
+    SkPoint flat[kMaxHairFlattenCount + 1];
+    int count = SkCubicFlattenCount(pts, kHairFlattenTolerance,
+                                    kMaxHairFlattenCount);
+    SkCubicFlatten(pts, count, flat);
+    polyline->addLines(flat, count);
 }
 
 static void hair_path(const SkPath& path, const SkRasterClip& rclip,
@@ -289,16 +295,17 @@ static void hair_path(const SkPath& path, const SkRasterClip& rclip,
     SkPoint         pts[4];
     SkPath::Verb    verb;
     SkAutoConicToQuads converter;
+    HairPolyline    polyline(clip, blitter, lineproc);
 
     while ((verb = iter.next(pts, false)) != SkPath::kDone_Verb) {
         switch (verb) {
             case SkPath::kMove_Verb:
                 break;
             case SkPath::kLine_Verb:
-                lineproc(pts[0], pts[1], clip, blitter);
+                polyline.addLines(pts, 1);
                 break;
             case SkPath::kQuad_Verb:
-                hairquad(pts, clip, blitter, compute_quad_level(pts), lineproc);
+                hairquad(pts, &polyline);
                 break;
             case SkPath::kConic_Verb: {
                 // how close should the quads be to the original conic?
@@ -306,14 +313,13 @@ static void hair_path(const SkPath& path, const SkRasterClip& rclip,
                 const SkPoint* quadPts = converter.computeQuads(pts,
                                                        iter.conicWeight(), tol);
                 for (int i = 0; i < converter.countQuads(); ++i) {
-                    int level = compute_quad_level(quadPts);
-                    hairquad(quadPts, clip, blitter, level, lineproc);
+                    hairquad(quadPts, &polyline);
                     quadPts += 2;
                 }
                 break;
             }
             case SkPath::kCubic_Verb:
-                haircubic(pts, clip, blitter, kMaxCubicSubdivideLevel, lineproc);
+                haircubic(pts, &polyline);
                 break;
             case SkPath::kClose_Verb:
                 break;
@@ -321,6 +327,7 @@ static void hair_path(const SkPath& path, const SkRasterClip& rclip,
                 break;
         }
     }
+    polyline.flush();
 }
 
 void SkScan::HairPath(const SkPath& path, const SkRasterClip& clip,
@@ -372,8 +379,9 @@ void SkScan::FrameRect(const SkRect& r, const SkPoint& strokeSize,
 
 void SkScan::HairLine(const SkPoint& p0, const SkPoint& p1,
                       const SkRasterClip& clip, SkBlitter* blitter) {
+    SkPoint pts[2] = { p0, p1 };
     if (clip.isBW()) {
-        HairLineRgn(p0, p1, &clip.bwRgn(), blitter);
+        HairLineRgn(pts, 2, &clip.bwRgn(), blitter);
     } else {
         const SkRegion* clipRgn = NULL;
         SkRect r;
@@ -389,29 +397,39 @@ void SkScan::HairLine(const SkPoint& p0, const SkPoint& p1,
             blitter = wrap.getBlitter();
             clipRgn = &wrap.getRgn();
         }
-        HairLineRgn(p0, p1, clipRgn, blitter);
+        HairLineRgn(pts, 2, clipRgn, blitter);
     }
 }
 
 void SkScan::AntiHairLine(const SkPoint& p0, const SkPoint& p1,
                           const SkRasterClip& clip, SkBlitter* blitter) {
+    SkPoint pts[2] = { p0, p1 };
+    AntiHairLine(pts, 2, clip, blitter);
+}
+
+void SkScan::AntiHairLine(const SkPoint pts[], int count,
+                          const SkRasterClip& clip, SkBlitter* blitter) {
+    if (count < 2) {
+        return;
+    }
     if (clip.isBW()) {
-        AntiHairLineRgn(p0, p1, &clip.bwRgn(), blitter);
+        AntiHairLineRgn(pts, count, &clip.bwRgn(), blitter);
     } else {
         const SkRegion* clipRgn = NULL;
         SkRect r;
         SkIRect ir;
-        r.set(p0.fX, p0.fY, p1.fX, p1.fY);
-        r.sort();
+        // A non-finite point leaves r empty, which says nothing about where the
+        // other points are, so then always clip.
+        bool finite = r.setBoundsCheck(pts, count);
         r.roundOut(&ir);
         ir.inset(-1, -1);
 
         SkAAClipBlitterWrapper wrap;
-        if (!clip.quickContains(ir)) {
+        if (!finite || !clip.quickContains(ir)) {
             wrap.init(clip, blitter);
             blitter = wrap.getBlitter();
             clipRgn = &wrap.getRgn();
         }
-        AntiHairLineRgn(p0, p1, clipRgn, blitter);
+        AntiHairLineRgn(pts, count, clipRgn, blitter);
     }
 }
@@ -1208,6 +1208,41 @@ void SkXPSDevice::drawRRect(const SkDraw& d,
     this->drawPath(d, path, paint, NULL, true);
 }
 
+// Batches skip SkBitmapDevice's raster path, and draw each shape as usual.
+void SkXPSDevice::drawRects(const SkDraw& d,
+                            const SkRect rects[],
+                            const SkColor colors[],
+                            int count,
+                            const SkPaint& paint) {
+    this->SkBaseDevice::drawRects(d, rects, colors, count, paint);
+}
+
+void SkXPSDevice::drawOvals(const SkDraw& d,
+                            const SkRect ovals[],
+                            const SkColor colors[],
+                            int count,
+                            const SkPaint& paint) {
+    this->SkBaseDevice::drawOvals(d, ovals, colors, count, paint);
+}
+
+void SkXPSDevice::drawRRects(const SkDraw& d,
+                             const SkRRect rrects[],
+                             const SkColor colors[],
+                             int count,
+                             const SkPaint& paint) {
+    this->SkBaseDevice::drawRRects(d, rrects, colors, count, paint);
+}
+
+void SkXPSDevice::drawAtlas(const SkDraw& d,
+                            const SkBitmap& atlas,
+                            const SkMatrix xforms[],
+                            const SkIRect tex[],
+                            const SkColor colors[],
+                            int count,
+                            const SkPaint& paint) {
+    this->SkBaseDevice::drawAtlas(d, atlas, xforms, tex, colors, count, paint);
+}
+
 void SkXPSDevice::internalDrawRect(const SkDraw& d,
                                    const SkRect& r,
                                    bool transformRect,
@@ -57,6 +57,9 @@ bool SkBitmapSource::onFilterImage(Proxy* proxy, const SkBitmap&, const Context&
     }
     SkIRect dstIRect;
     dstRect.roundOut(&dstIRect);
+    if (!dstIRect.intersect(ctx.clipBounds())) {
+        return false;
+    }
 
     SkAutoTUnref<SkBaseDevice> device(proxy->createDevice(dstIRect.width(), dstIRect.height()));
     if (NULL == device.get()) {
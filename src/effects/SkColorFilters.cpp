@@ -14,6 +14,7 @@
 #include "SkString.h"
 #include "SkValidationUtils.h"
 #include "SkColorMatrixFilter.h"
+#include "SkTableColorFilter.h"
 
 #define ILLEGAL_XFERMODE_MODE   ((SkXfermode::Mode)-1)
 
@@ -560,8 +561,188 @@ SkColorFilter* SkColorFilter::CreateLightingFilter(SkColor mul, SkColor add) {
     return SkColorMatrixFilter::Create(matrix);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+class SkComposeColorFilter : public SkColorFilter {
+public:
+    SkComposeColorFilter(SkColorFilter* outer, SkColorFilter* inner)
+        : fOuter(SkRef(outer))
+        , fInner(SkRef(inner)) {}
+
+    virtual uint32_t getFlags() const SK_OVERRIDE {
+        return fOuter->getFlags() & fInner->getFlags();
+    }
+
+    virtual void filterSpan(const SkPMColor shader[], int count,
+                            SkPMColor result[]) const SK_OVERRIDE {
+        fInner->filterSpan(shader, count, result);
+        fOuter->filterSpan(result, count, result);
+    }
+
+    virtual void filterSpan16(const uint16_t shader[], int count,
+                              uint16_t result[]) const SK_OVERRIDE {
+        SkASSERT(this->getFlags() & kHasFilter16_Flag);
+        fInner->filterSpan16(shader, count, result);
+        fOuter->filterSpan16(result, count, result);
+    }
+
+#ifndef SK_IGNORE_TO_STRING
+    virtual void toString(SkString* str) const SK_OVERRIDE {
+        str->append("SkComposeColorFilter: outer(");
+        fOuter->toString(str);
+        str->append(") inner(");
+        fInner->toString(str);
+        str->append(")");
+    }
+#endif
+
+    SK_DECLARE_PUBLIC_FLATTENABLE_DESERIALIZATION_PROCS(SkComposeColorFilter)
+
+protected:
+    virtual void flatten(SkWriteBuffer& buffer) const SK_OVERRIDE {
+        this->INHERITED::flatten(buffer);
+        buffer.writeFlattenable(fOuter.get());
+        buffer.writeFlattenable(fInner.get());
+    }
+
+    SkComposeColorFilter(SkReadBuffer& buffer) : INHERITED(buffer) {
+        fOuter.reset(buffer.readColorFilter());
+        fInner.reset(buffer.readColorFilter());
+        buffer.validate(NULL != fOuter.get() && NULL != fInner.get());
+    }
+
+private:
+    SkAutoTUnref<SkColorFilter> fOuter;
+    SkAutoTUnref<SkColorFilter> fInner;
+
+    typedef SkColorFilter INHERITED;
+};
+
+// To detect if we need to apply clamping after applying a matrix, we check if
+// any output component might go outside of [0, 255] for any combination of
+// input components in [0..255].
+// Each output component is an affine transformation of the input component, so
+// the minimum and maximum values are for any combination of minimum or maximum
+// values of input components (i.e. 0 or 255).
+// E.g. if R' = x*R + y*G + z*B + w*A + t
+// Then the maximum value will be for R=255 if x>0 or R=0 if x<0, and the
+// minimum value will be for R=0 if x>0 or R=255 if x<0.
+// Same goes for all components.
+static bool component_needs_clamping(const SkScalar row[5]) {
+    SkScalar maxValue = row[4] / 255;
+    SkScalar minValue = row[4] / 255;
+    for (int i = 0; i < 4; ++i) {
+        if (row[i] > 0)
+            maxValue += row[i];
+        else
+            minValue += row[i];
+    }
+    return (maxValue > 1) || (minValue < 0);
+}
+
+static bool matrix_needs_clamping(const SkScalar matrix[20]) {
+    return component_needs_clamping(matrix)
+        || component_needs_clamping(matrix+5)
+        || component_needs_clamping(matrix+10)
+        || component_needs_clamping(matrix+15);
+}
+
+// Like asColorMatrix(), but also recognizes the mode filters that are a matrix
+// on unpremultiplied colors, e.g. modulate scales each component by the color's.
+static bool as_unpremul_matrix(const SkColorFilter* cf, SkColorMatrix* matrix) {
+    if (cf->asColorMatrix(matrix->fMat)) {
+        return true;
+    }
+
+    SkColor color;
+    SkXfermode::Mode mode;
+    if (!cf->asColorMode(&color, &mode)) {
+        return false;
+    }
+    const SkScalar r = SkIntToScalar(SkColorGetR(color)),
+                   g = SkIntToScalar(SkColorGetG(color)),
+                   b = SkIntToScalar(SkColorGetB(color)),
+                   a = SkIntToScalar(SkColorGetA(color));
+    const SkScalar inv255 = SK_Scalar1 / 255;
+
+    switch (mode) {
+        case SkXfermode::kSrc_Mode:
+            matrix->setScale(0, 0, 0, 0);
+            matrix->postTranslate(r, g, b, a);
+            return true;
+        case SkXfermode::kDst_Mode:
+            matrix->setIdentity();
+            return true;
+        case SkXfermode::kModulate_Mode:
+            matrix->setScale(r * inv255, g * inv255, b * inv255, a * inv255);
+            return true;
+        case SkXfermode::kSrcIn_Mode:
+            matrix->setScale(0, 0, 0, a * inv255);
+            matrix->postTranslate(r, g, b, 0);
+            return true;
+        case SkXfermode::kDstIn_Mode:
+            matrix->setScale(1, 1, 1, a * inv255);
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns a single table or matrix filter equivalent to outer(inner(c)), or
+// NULL if the two can't be folded together.
+static SkColorFilter* fuse_color_filters(SkColorFilter* outer, SkColorFilter* inner) {
+    SkColorMatrix outerMatrix, innerMatrix;
+    if (as_unpremul_matrix(outer, &outerMatrix) && as_unpremul_matrix(inner, &innerMatrix)) {
+        // Applying both matrices at once skips the pin in between, so only
+        // fold them when inner's results are always in range anyway.
+        if (matrix_needs_clamping(innerMatrix.fMat)) {
+            return NULL;
+        }
+        SkColorMatrix combined;
+        combined.setConcat(outerMatrix, innerMatrix);
+        return SkColorMatrixFilter::Create(combined);
+    }
+
+    SkBitmap outerTable, innerTable;
+    if (outer->asComponentTable(&outerTable) && inner->asComponentTable(&innerTable)) {
+        SkAutoLockPixels outerLock(outerTable), innerLock(innerTable);
+        // Once inner's alpha is 0 its color premultiplies to 0, whatever its
+        // tables say, so outer must keep that transparent too.
+        if (0 != *outerTable.getAddr8(0, 0)) {
+            return NULL;
+        }
+        uint8_t tables[4][256];
+        for (int y = 0; y < 4; ++y) {
+            const uint8_t* outerRow = outerTable.getAddr8(0, y);
+            const uint8_t* innerRow = innerTable.getAddr8(0, y);
+            for (int x = 0; x < 256; ++x) {
+                tables[y][x] = outerRow[innerRow[x]];
+            }
+        }
+        return SkTableColorFilter::CreateARGB(tables[0], tables[1], tables[2], tables[3]);
+    }
+
+    return NULL;
+}
+
+SkColorFilter* SkColorFilter::CreateComposeFilter(SkColorFilter* outer, SkColorFilter* inner) {
+    if (NULL == outer) {
+        return SkSafeRef(inner);
+    }
+    if (NULL == inner) {
+        return SkRef(outer);
+    }
+
+    SkColorFilter* fused = fuse_color_filters(outer, inner);
+    if (NULL != fused) {
+        return fused;
+    }
+    return SkNEW_ARGS(SkComposeColorFilter, (outer, inner));
+}
+
 SK_DEFINE_FLATTENABLE_REGISTRAR_GROUP_START(SkColorFilter)
     SK_DEFINE_FLATTENABLE_REGISTRAR_ENTRY(SkModeColorFilter)
     SK_DEFINE_FLATTENABLE_REGISTRAR_ENTRY(Src_SkModeColorFilter)
     SK_DEFINE_FLATTENABLE_REGISTRAR_ENTRY(SrcOver_SkModeColorFilter)
+    SK_DEFINE_FLATTENABLE_REGISTRAR_ENTRY(SkComposeColorFilter)
 SK_DEFINE_FLATTENABLE_REGISTRAR_GROUP_END
@@ -7,6 +7,7 @@
  */
 #include "SkColorMatrixFilter.h"
 #include "SkColorMatrix.h"
+#include "SkColorMatrix_opts.h"
 #include "SkColorPriv.h"
 #include "SkReadBuffer.h"
 #include "SkWriteBuffer.h"
@@ -193,6 +194,8 @@ void SkColorMatrixFilter::initState(const SkScalar* SK_RESTRICT src) {
         array[14] += add;
         array[19] += add;
     }
+
+    fSpanProc = SkColorMatrixGetPlatformSpanProc();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -233,6 +236,11 @@ void SkColorMatrixFilter::filterSpan(const SkPMColor src[], int count,
         return;
     }
 
+    if (NULL != fSpanProc) {
+        fSpanProc(state.fArray, state.fShift, src, count, dst);
+        return;
+    }
+
     const SkUnPreMultiply::Scale* table = SkUnPreMultiply::GetScaleTable();
 
     for (int i = 0; i < count; i++) {
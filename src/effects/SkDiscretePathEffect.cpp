@@ -13,6 +13,9 @@
 #include "SkPathMeasure.h"
 #include "SkRandom.h"
 
+// Each contour's points are found and perturbed this many at a time.
+static const int kStackPointCount = 64;
+
 static void Perterb(SkPoint* p, const SkVector& tangent, SkScalar scale) {
     SkVector normal = tangent;
     normal.rotateCCW();
@@ -38,8 +41,6 @@ bool SkDiscretePathEffect::filterPath(SkPath* dst, const SkPath& src,
 
     SkLCGRandom     rand(seed ^ ((seed << 16) | (seed >> 16)));
     SkScalar        scale = fPerterb;
-    SkPoint         p;
-    SkVector        v;
 
     do {
         SkScalar    length = meas.getLength();
@@ -56,15 +57,27 @@ bool SkDiscretePathEffect::filterPath(SkPath* dst, const SkPath& src,
                 distance += delta/2;
             }
 
-            if (meas.getPosTan(distance, &p, &v)) {
-                Perterb(&p, v, SkScalarMul(rand.nextSScalar1(), scale));
-                dst->moveTo(p);
-            }
-            while (--n >= 0) {
-                distance += delta;
-                if (meas.getPosTan(distance, &p, &v)) {
-                    Perterb(&p, v, SkScalarMul(rand.nextSScalar1(), scale));
-                    dst->lineTo(p);
+            // the n + 1 points are in order, so each batch of them is found in one walk along
+            // the contour, starting where the last batch left off
+            SkScalar distances[kStackPointCount];
+            SkPoint  pts[kStackPointCount];
+            SkVector tangents[kStackPointCount];
+            for (int start = 0; start <= n; start += kStackPointCount) {
+                const int count = SkMin32(n + 1 - start, kStackPointCount);
+                for (int i = 0; i < count; i++) {
+                    distances[i] = distance;
+                    distance += delta;
+                }
+                if (!meas.getPosTanBatch(distances, count, pts, tangents)) {
+                    break;
+                }
+                for (int i = 0; i < count; i++) {
+                    Perterb(&pts[i], tangents[i], SkScalarMul(rand.nextSScalar1(), scale));
+                    if (0 == start + i) {
+                        dst->moveTo(pts[i]);
+                    } else {
+                        dst->lineTo(pts[i]);
+                    }
                 }
             }
             if (meas.isClosed()) {
@@ -47,6 +47,31 @@ template<> uint32_t getValue<SkDisplacementMapEffect::kA_ChannelSelectorType>(
     return SkGetPackedA32(l);
 }
 
+// Displaces count pixels of one row, starting at x. Without checkBounds, every displaced pixel
+// must be inside src.
+template<SkDisplacementMapEffect::ChannelSelectorType typeX,
+         SkDisplacementMapEffect::ChannelSelectorType typeY,
+         bool checkBounds>
+inline void displaceSpan(const int displX[256], const int displY[256],
+                         const SkUnPreMultiply::Scale* table, const SkPMColor* displPtr,
+                         const SkBitmap& src, int x, int y, int count, SkPMColor* dstPtr)
+{
+    const SkPMColor* srcPixels = src.getAddr32(0, 0);
+    const int srcStride = src.rowBytesAsPixels();
+    const int srcW = src.width();
+    const int srcH = src.height();
+    for (int i = 0; i < count; ++i, ++x) {
+        const int srcX = x + displX[getValue<typeX>(displPtr[i], table)];
+        const int srcY = y + displY[getValue<typeY>(displPtr[i], table)];
+        if (checkBounds && ((srcX < 0) || (srcX >= srcW) || (srcY < 0) || (srcY >= srcH))) {
+            dstPtr[i] = 0;
+        } else {
+            SkASSERT(srcX >= 0 && srcX < srcW && srcY >= 0 && srcY < srcH);
+            dstPtr[i] = srcPixels[srcY * srcStride + srcX];
+        }
+    }
+}
+
 template<SkDisplacementMapEffect::ChannelSelectorType typeX,
          SkDisplacementMapEffect::ChannelSelectorType typeY>
 void computeDisplacement(const SkVector& scale, SkBitmap* dst,
@@ -62,21 +87,46 @@ void computeDisplacement(const SkVector& scale, SkBitmap* dst,
     const SkVector scaleAdj = SkVector::Make(SK_ScalarHalf - SkScalarMul(scale.fX, SK_ScalarHalf),
                                              SK_ScalarHalf - SkScalarMul(scale.fY, SK_ScalarHalf));
     const SkUnPreMultiply::Scale* table = SkUnPreMultiply::GetScaleTable();
+
+    // A channel only has 256 values, so the truncated displacements are all computed up front,
+    // along with their range.
+    int displX[256], displY[256];
+    int minX = SK_MaxS32, maxX = SK_MinS32, minY = SK_MaxS32, maxY = SK_MinS32;
+    for (int i = 0; i < 256; ++i) {
+        displX[i] = SkScalarTruncToInt(SkScalarMul(scaleForColor.fX, SkIntToScalar(i)) +
+                                       scaleAdj.fX);
+        displY[i] = SkScalarTruncToInt(SkScalarMul(scaleForColor.fY, SkIntToScalar(i)) +
+                                       scaleAdj.fY);
+        minX = SkTMin(minX, displX[i]);
+        maxX = SkTMax(maxX, displX[i]);
+        minY = SkTMin(minY, displY[i]);
+        maxY = SkTMax(maxY, displY[i]);
+    }
+    // Pixels in here can't be displaced outside of src, so they skip the bounds checks.
+    SkIRect interior = SkIRect::MakeLTRB(-minX, -minY, srcW - maxX, srcH - maxY);
+    if (!interior.intersect(bounds)) {
+        interior.setEmpty();
+    }
+
     SkPMColor* dstPtr = dst->getAddr32(0, 0);
     for (int y = bounds.top(); y < bounds.bottom(); ++y) {
         const SkPMColor* displPtr = displ->getAddr32(bounds.left() + offset.fX,
                                                      y + offset.fY);
-        for (int x = bounds.left(); x < bounds.right(); ++x, ++displPtr) {
-            const SkScalar displX = SkScalarMul(scaleForColor.fX,
-                SkIntToScalar(getValue<typeX>(*displPtr, table))) + scaleAdj.fX;
-            const SkScalar displY = SkScalarMul(scaleForColor.fY,
-                SkIntToScalar(getValue<typeY>(*displPtr, table))) + scaleAdj.fY;
-            // Truncate the displacement values
-            const int srcX = x + SkScalarTruncToInt(displX);
-            const int srcY = y + SkScalarTruncToInt(displY);
-            *dstPtr++ = ((srcX < 0) || (srcX >= srcW) || (srcY < 0) || (srcY >= srcH)) ?
-                      0 : *(src->getAddr32(srcX, srcY));
+        if (y < interior.top() || y >= interior.bottom()) {
+            displaceSpan<typeX, typeY, true>(displX, displY, table, displPtr, *src,
+                                             bounds.left(), y, bounds.width(), dstPtr);
+        } else {
+            const int left = interior.left() - bounds.left();
+            const int right = interior.right() - bounds.left();
+            displaceSpan<typeX, typeY, true>(displX, displY, table, displPtr, *src,
+                                             bounds.left(), y, left, dstPtr);
+            displaceSpan<typeX, typeY, false>(displX, displY, table, displPtr + left, *src,
+                                              interior.left(), y, right - left, dstPtr + left);
+            displaceSpan<typeX, typeY, true>(displX, displY, table, displPtr + right, *src,
+                                             interior.right(), y, bounds.width() - right,
+                                             dstPtr + right);
         }
+        dstPtr += bounds.width();
     }
 }
 
@@ -8,10 +8,13 @@
 #include "SkLightingImageFilter.h"
 #include "SkBitmap.h"
 #include "SkColorPriv.h"
+#include "SkLazyPtr.h"
+#include "SkLighting_opts.h"
 #include "SkReadBuffer.h"
 #include "SkWriteBuffer.h"
 #include "SkReadBuffer.h"
 #include "SkWriteBuffer.h"
+#include "SkTemplates.h"
 #include "SkTypes.h"
 
 #if SK_SUPPORT_GPU
@@ -161,6 +164,58 @@ inline SkPoint3 bottomRightNormal(int m[9], SkScalar surfaceScale) {
                          surfaceScale);
 }
 
+// Portable SkLightingProcs, used when there are no faster ones for this CPU.
+void interiorNormalsRow(const SkPMColor* top, const SkPMColor* middle, const SkPMColor* bottom,
+                        int count, SkScalar surfaceScale,
+                        SkScalar nx[], SkScalar ny[], SkScalar nz[]) {
+    for (int i = 0; i < count; ++i) {
+        int m[9];
+        for (int j = 0; j < 3; ++j) {
+            m[j]     = SkGetPackedA32(top[i + j - 1]);
+            m[j + 3] = SkGetPackedA32(middle[i + j - 1]);
+            m[j + 6] = SkGetPackedA32(bottom[i + j - 1]);
+        }
+        SkPoint3 normal = interiorNormal(m, surfaceScale);
+        nx[i] = normal.fX;
+        ny[i] = normal.fY;
+        nz[i] = normal.fZ;
+    }
+}
+
+void surfaceToLightRow(const SkScalar location[3], int x, int y, const SkPMColor* row,
+                       int count, SkScalar surfaceScale,
+                       SkScalar lx[], SkScalar ly[], SkScalar lz[]) {
+    for (int i = 0; i < count; ++i) {
+        SkPoint3 direction(location[0] - SkIntToScalar(x + i),
+                           location[1] - SkIntToScalar(y),
+                           location[2] - SkScalarMul(SkIntToScalar(SkGetPackedA32(row[i])),
+                                                     surfaceScale));
+        direction.normalize();
+        lx[i] = direction.fX;
+        ly[i] = direction.fY;
+        lz[i] = direction.fZ;
+    }
+}
+
+// The point lights pass their location to fSurfaceToLight as an array.
+SK_COMPILE_ASSERT(sizeof(SkPoint3) == 3 * sizeof(SkScalar), SkPoint3_is_three_scalars);
+
+// The platform's procs, or the portable ones if it has none.
+// Technically needs external linkage to be passed as a template parameter (see SkUtils.cpp).
+SkLightingProcs* createLightingProcs() {
+    SkLightingProcs* procs = SkNEW(SkLightingProcs);
+    if (!SkLightingGetPlatformProcs(procs)) {
+        procs->fNormals = interiorNormalsRow;
+        procs->fSurfaceToLight = surfaceToLightRow;
+    }
+    return procs;
+}
+
+const SkLightingProcs& lightingProcs() {
+    SK_DECLARE_STATIC_LAZY_PTR(SkLightingProcs, procs, createLightingProcs);
+    return *procs.get();
+}
+
 template <class LightingType, class LightType> void lightBitmap(const LightingType& lightingType, const SkLight* light, const SkBitmap& src, SkBitmap* dst, SkScalar surfaceScale, const SkIRect& bounds) {
     SkASSERT(dst->width() == bounds.width() && dst->height() == bounds.height());
     const LightType* l = static_cast<const LightType*>(light);
@@ -192,29 +247,44 @@ template <class LightingType, class LightType> void lightBitmap(const LightingTy
         *dptr++ = lightingType.light(topRightNormal(m, surfaceScale), surfaceToLight, l->lightColor(surfaceToLight));
     }
 
+    // The interior normals and light directions are found a row at a time, into these.
+    const SkLightingProcs& procs = lightingProcs();
+    const int count = right - left - 2;
+    SkAutoTMalloc<SkScalar> vectors(6 * count);
+    SkScalar* nx = vectors.get();
+    SkScalar* ny = nx + count;
+    SkScalar* nz = ny + count;
+    SkScalar* lx = nz + count;
+    SkScalar* ly = lx + count;
+    SkScalar* lz = ly + count;
     for (++y; y < bottom - 1; ++y) {
-        int x = left;
-        const SkPMColor* row0 = src.getAddr32(x, y - 1);
-        const SkPMColor* row1 = src.getAddr32(x, y);
-        const SkPMColor* row2 = src.getAddr32(x, y + 1);
+        const SkPMColor* row0 = src.getAddr32(left, y - 1);
+        const SkPMColor* row1 = src.getAddr32(left, y);
+        const SkPMColor* row2 = src.getAddr32(left, y + 1);
         int m[9];
-        m[1] = SkGetPackedA32(*row0++);
-        m[2] = SkGetPackedA32(*row0++);
-        m[4] = SkGetPackedA32(*row1++);
-        m[5] = SkGetPackedA32(*row1++);
-        m[7] = SkGetPackedA32(*row2++);
-        m[8] = SkGetPackedA32(*row2++);
-        SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
+        m[1] = SkGetPackedA32(row0[0]);
+        m[2] = SkGetPackedA32(row0[1]);
+        m[4] = SkGetPackedA32(row1[0]);
+        m[5] = SkGetPackedA32(row1[1]);
+        m[7] = SkGetPackedA32(row2[0]);
+        m[8] = SkGetPackedA32(row2[1]);
+        SkPoint3 surfaceToLight = l->surfaceToLight(left, y, m[4], surfaceScale);
         *dptr++ = lightingType.light(leftNormal(m, surfaceScale), surfaceToLight, l->lightColor(surfaceToLight));
-        for (++x; x < right - 1; ++x) {
-            shiftMatrixLeft(m);
-            m[2] = SkGetPackedA32(*row0++);
-            m[5] = SkGetPackedA32(*row1++);
-            m[8] = SkGetPackedA32(*row2++);
-            surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-            *dptr++ = lightingType.light(interiorNormal(m, surfaceScale), surfaceToLight, l->lightColor(surfaceToLight));
+
+        procs.fNormals(row0 + 1, row1 + 1, row2 + 1, count, surfaceScale, nx, ny, nz);
+        l->surfaceToLightRow(procs, left + 1, y, row1 + 1, count, surfaceScale, lx, ly, lz);
+        for (int i = 0; i < count; ++i) {
+            surfaceToLight = SkPoint3(lx[i], ly[i], lz[i]);
+            *dptr++ = lightingType.light(SkPoint3(nx[i], ny[i], nz[i]), surfaceToLight, l->lightColor(surfaceToLight));
         }
-        shiftMatrixLeft(m);
+
+        const int x = right - 1;
+        m[0] = SkGetPackedA32(row0[x - left - 1]);
+        m[1] = SkGetPackedA32(row0[x - left]);
+        m[3] = SkGetPackedA32(row1[x - left - 1]);
+        m[4] = SkGetPackedA32(row1[x - left]);
+        m[6] = SkGetPackedA32(row2[x - left - 1]);
+        m[7] = SkGetPackedA32(row2[x - left]);
         surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
         *dptr++ = lightingType.light(rightNormal(m, surfaceScale), surfaceToLight, l->lightColor(surfaceToLight));
     }
@@ -561,6 +631,15 @@ public:
     SkPoint3 surfaceToLight(int x, int y, int z, SkScalar surfaceScale) const {
         return fDirection;
     };
+    void surfaceToLightRow(const SkLightingProcs&, int x, int y, const SkPMColor row[], int count,
+                           SkScalar surfaceScale,
+                           SkScalar lx[], SkScalar ly[], SkScalar lz[]) const {
+        for (int i = 0; i < count; ++i) {
+            lx[i] = fDirection.fX;
+            ly[i] = fDirection.fY;
+            lz[i] = fDirection.fZ;
+        }
+    }
     SkPoint3 lightColor(const SkPoint3&) const { return color(); }
     virtual LightType type() const { return kDistant_LightType; }
     const SkPoint3& direction() const { return fDirection; }
@@ -618,6 +697,11 @@ public:
         direction.normalize();
         return direction;
     };
+    void surfaceToLightRow(const SkLightingProcs& procs, int x, int y, const SkPMColor row[],
+                           int count, SkScalar surfaceScale,
+                           SkScalar lx[], SkScalar ly[], SkScalar lz[]) const {
+        procs.fSurfaceToLight(&fLocation.fX, x, y, row, count, surfaceScale, lx, ly, lz);
+    }
     SkPoint3 lightColor(const SkPoint3&) const { return color(); }
     virtual LightType type() const { return kPoint_LightType; }
     const SkPoint3& location() const { return fLocation; }
@@ -706,6 +790,11 @@ public:
         direction.normalize();
         return direction;
     };
+    void surfaceToLightRow(const SkLightingProcs& procs, int x, int y, const SkPMColor row[],
+                           int count, SkScalar surfaceScale,
+                           SkScalar lx[], SkScalar ly[], SkScalar lz[]) const {
+        procs.fSurfaceToLight(&fLocation.fX, x, y, row, count, surfaceScale, lx, ly, lz);
+    }
     SkPoint3 lightColor(const SkPoint3& surfaceToLight) const {
         SkScalar cosAngle = -surfaceToLight.dot(fS);
         if (cosAngle < fCosOuterConeAngle) {
@@ -8,6 +8,7 @@
 #include "SkMatrixConvolutionImageFilter.h"
 #include "SkBitmap.h"
 #include "SkColorPriv.h"
+#include "SkMatrixConvolution_opts.h"
 #include "SkReadBuffer.h"
 #include "SkWriteBuffer.h"
 #include "SkRect.h"
@@ -253,6 +254,77 @@ static SkBitmap unpremultiplyBitmap(const SkBitmap& src)
     return result;
 }
 
+namespace {
+
+struct FilterRowsContext {
+    const SkMatrixConvolutionImageFilter* fFilter;
+    const SkBitmap* fSrc;
+    SkBitmap* fResult;
+    SkIRect fBounds;
+    SkMatrixConvolutionProc fProc;  // looked up before banding, or NULL to stay portable
+};
+
+void convolve_interior(SkMatrixConvolutionProc proc, const SkMatrixConvolutionKernel& kernel,
+                       bool convolveAlpha, const SkIPoint& kernelOffset, const SkBitmap& src,
+                       SkBitmap* result, const SkIRect& rect, const SkIRect& bounds) {
+    proc(kernel, convolveAlpha,
+         src.getAddr32(rect.fLeft - kernelOffset.fX, rect.fTop - kernelOffset.fY),
+         src.getAddr32(rect.fLeft, rect.fTop),
+         src.rowBytesAsPixels(),
+         result->getAddr32(rect.fLeft - bounds.fLeft, rect.fTop - bounds.fTop),
+         result->rowBytesAsPixels(),
+         rect.width(), rect.height());
+}
+
+}  // namespace
+
+// Below this many output pixels per band, it's not worth handing rows to another thread.
+#define kMinConvolutionPixelsPerThread (64 * 1024)
+
+void SkMatrixConvolutionImageFilter::FilterRows(void* context, int start, int stop) {
+    const FilterRowsContext& ctx = *static_cast<const FilterRowsContext*>(context);
+    const SkMatrixConvolutionImageFilter* filter = ctx.fFilter;
+    const SkIRect& bounds = ctx.fBounds;
+    const SkIRect band = SkIRect::MakeLTRB(bounds.left(), bounds.top() + start,
+                                           bounds.right(), bounds.top() + stop);
+    SkIRect interior = SkIRect::MakeXYWH(bounds.left() + filter->fKernelOffset.fX,
+                                         bounds.top() + filter->fKernelOffset.fY,
+                                         bounds.width() - filter->fKernelSize.fWidth + 1,
+                                         bounds.height() - filter->fKernelSize.fHeight + 1);
+    SkIRect top = SkIRect::MakeLTRB(bounds.left(), bounds.top(), bounds.right(), interior.top());
+    SkIRect bottom = SkIRect::MakeLTRB(bounds.left(), interior.bottom(),
+                                       bounds.right(), bounds.bottom());
+    SkIRect left = SkIRect::MakeLTRB(bounds.left(), interior.top(),
+                                     interior.left(), interior.bottom());
+    SkIRect right = SkIRect::MakeLTRB(interior.right(), interior.top(),
+                                      bounds.right(), interior.bottom());
+    // An empty intersection leaves the rect alone, so only filter the ones that hit the band.
+    if (top.intersect(band)) {
+        filter->filterBorderPixels(*ctx.fSrc, ctx.fResult, top, bounds);
+    }
+    if (left.intersect(band)) {
+        filter->filterBorderPixels(*ctx.fSrc, ctx.fResult, left, bounds);
+    }
+    if (interior.intersect(band)) {
+        if (NULL != ctx.fProc) {
+            const SkMatrixConvolutionKernel kernel = {
+                filter->fKernel, filter->fKernelSize.width(), filter->fKernelSize.height(),
+                filter->fGain, filter->fBias
+            };
+            convolve_interior(ctx.fProc, kernel, filter->fConvolveAlpha, filter->fKernelOffset,
+                              *ctx.fSrc, ctx.fResult, interior, bounds);
+        } else {
+            filter->filterInteriorPixels(*ctx.fSrc, ctx.fResult, interior, bounds);
+        }
+    }
+    if (right.intersect(band)) {
+        filter->filterBorderPixels(*ctx.fSrc, ctx.fResult, right, bounds);
+    }
+    if (bottom.intersect(band)) {
+        filter->filterBorderPixels(*ctx.fSrc, ctx.fResult, bottom, bounds);
+    }
+}
+
 bool SkMatrixConvolutionImageFilter::onFilterImage(Proxy* proxy,
                                                    const SkBitmap& source,
                                                    const Context& ctx,
@@ -289,22 +361,11 @@ bool SkMatrixConvolutionImageFilter::onFilterImage(Proxy* proxy,
     offset->fX = bounds.fLeft;
     offset->fY = bounds.fTop;
     bounds.offset(-srcOffset);
-    SkIRect interior = SkIRect::MakeXYWH(bounds.left() + fKernelOffset.fX,
-                                         bounds.top() + fKernelOffset.fY,
-                                         bounds.width() - fKernelSize.fWidth + 1,
-                                         bounds.height() - fKernelSize.fHeight + 1);
-    SkIRect top = SkIRect::MakeLTRB(bounds.left(), bounds.top(), bounds.right(), interior.top());
-    SkIRect bottom = SkIRect::MakeLTRB(bounds.left(), interior.bottom(),
-                                       bounds.right(), bounds.bottom());
-    SkIRect left = SkIRect::MakeLTRB(bounds.left(), interior.top(),
-                                     interior.left(), interior.bottom());
-    SkIRect right = SkIRect::MakeLTRB(interior.right(), interior.top(),
-                                      bounds.right(), interior.bottom());
-    filterBorderPixels(src, result, top, bounds);
-    filterBorderPixels(src, result, left, bounds);
-    filterInteriorPixels(src, result, interior, bounds);
-    filterBorderPixels(src, result, right, bounds);
-    filterBorderPixels(src, result, bottom, bounds);
+    FilterRowsContext context = {
+        this, &src, result, bounds, SkMatrixConvolutionGetPlatformProc()
+    };
+    SkImageFilter::RunInBands(FilterRows, &context, bounds.height(),
+                              kMinConvolutionPixelsPerThread / SkMax32(bounds.width(), 1));
     return true;
 }
 
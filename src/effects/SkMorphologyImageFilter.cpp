@@ -122,18 +122,57 @@ static void dilate(const SkPMColor* src, SkPMColor* dst,
     }
 }
 
-static void callProcX(SkMorphologyImageFilter::Proc procX, const SkBitmap& src, SkBitmap* dst, int radiusX, const SkIRect& bounds)
+// Below this many pixels, another thread costs more than it saves.
+#define kMinMorphologyPixelsPerThread   (64 * 1024)
+
+// One pass of a morphology proc.  It filters fLines independent lines of pixels, so bands of
+// lines can be done in parallel.
+struct MorphologyPass {
+    SkMorphologyImageFilter::Proc fProc;
+    const SkPMColor*              fSrc;
+    SkPMColor*                    fDst;
+    int                           fRadius;
+    int                           fLength;      // Of each line.
+    int                           fLines;
+    int                           fSrcStride;
+    int                           fDstStride;
+    int                           fSrcLineStep; // From one line to the next.
+    int                           fDstLineStep;
+
+    static void Run(void* context, int start, int stop) {
+        const MorphologyPass* pass = static_cast<const MorphologyPass*>(context);
+        pass->fProc(pass->fSrc + start * pass->fSrcLineStep,
+                    pass->fDst + start * pass->fDstLineStep,
+                    pass->fRadius, pass->fLength, stop - start,
+                    pass->fSrcStride, pass->fDstStride);
+    }
+};
+
+static MorphologyPass passX(SkMorphologyImageFilter::Proc procX, const SkBitmap& src, SkBitmap* dst, int radiusX, const SkIRect& bounds)
 {
-    procX(src.getAddr32(bounds.left(), bounds.top()), dst->getAddr32(0, 0),
-          radiusX, bounds.width(), bounds.height(),
-          src.rowBytesAsPixels(), dst->rowBytesAsPixels());
+    MorphologyPass pass = {
+        procX, src.getAddr32(bounds.left(), bounds.top()), dst->getAddr32(0, 0),
+        radiusX, bounds.width(), bounds.height(),
+        src.rowBytesAsPixels(), dst->rowBytesAsPixels(),
+        src.rowBytesAsPixels(), dst->rowBytesAsPixels(),
+    };
+    return pass;
 }
 
-static void callProcY(SkMorphologyImageFilter::Proc procY, const SkBitmap& src, SkBitmap* dst, int radiusY, const SkIRect& bounds)
+static MorphologyPass passY(SkMorphologyImageFilter::Proc procY, const SkBitmap& src, SkBitmap* dst, int radiusY, const SkIRect& bounds)
 {
-    procY(src.getAddr32(bounds.left(), bounds.top()), dst->getAddr32(0, 0),
-          radiusY, bounds.height(), bounds.width(),
-          src.rowBytesAsPixels(), dst->rowBytesAsPixels());
+    MorphologyPass pass = {
+        procY, src.getAddr32(bounds.left(), bounds.top()), dst->getAddr32(0, 0),
+        radiusY, bounds.height(), bounds.width(),
+        src.rowBytesAsPixels(), dst->rowBytesAsPixels(),
+        1, 1,
+    };
+    return pass;
+}
+
+static void callProc(const MorphologyPass& pass) {
+    SkImageFilter::RunInBands(MorphologyPass::Run, const_cast<MorphologyPass*>(&pass), pass.fLines,
+               kMinMorphologyPixelsPerThread / SkMax32(pass.fLength, 1));
 }
 
 bool SkMorphologyImageFilter::filterImageGeneric(SkMorphologyImageFilter::Proc procX,
@@ -193,13 +232,13 @@ bool SkMorphologyImageFilter::filterImageGeneric(SkMorphologyImageFilter::Proc p
     }
 
     if (width > 0 && height > 0) {
-        callProcX(procX, src, &temp, width, srcBounds);
+        callProc(passX(procX, src, &temp, width, srcBounds));
         SkIRect tmpBounds = SkIRect::MakeWH(srcBounds.width(), srcBounds.height());
-        callProcY(procY, temp, dst, height, tmpBounds);
+        callProc(passY(procY, temp, dst, height, tmpBounds));
     } else if (width > 0) {
-        callProcX(procX, src, dst, width, srcBounds);
+        callProc(passX(procX, src, dst, width, srcBounds));
     } else if (height > 0) {
-        callProcY(procY, src, dst, height, srcBounds);
+        callProc(passY(procY, src, dst, height, srcBounds));
     }
     offset->fX = bounds.left();
     offset->fY = bounds.top();
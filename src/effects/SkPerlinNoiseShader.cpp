@@ -7,10 +7,15 @@
 
 #include "SkDither.h"
 #include "SkPerlinNoiseShader.h"
+#include "SkPerlinNoise_opts.h"
 #include "SkColorFilter.h"
+#include "SkLazyFnPtr.h"
+#include "SkOnce.h"
 #include "SkReadBuffer.h"
 #include "SkWriteBuffer.h"
 #include "SkShader.h"
+#include "SkTemplates.h"
+#include "SkThread.h"
 #include "SkUnPreMultiply.h"
 #include "SkString.h"
 
@@ -26,6 +31,13 @@ static const int kBlockSize = 256;
 static const int kBlockMask = kBlockSize - 1;
 static const int kPerlinNoise = 4096;
 static const int kRandMaximum = SK_MaxS32; // 2**31 - 1
+// Largest stitched tile, in pixels, whose colors are kept for reuse.
+static const int kMaxCachedTilePixels = 512 * 512;
+// Points mapped and shaded per batch.
+static const int kSpanBufferSize = 64;
+
+SK_COMPILE_ASSERT(SkPerlinNoiseParams::kBlockSize == kBlockSize, block_size_mismatch);
+SK_COMPILE_ASSERT(SkPerlinNoiseParams::kPerlinNoise == kPerlinNoise, perlin_noise_mismatch);
 
 namespace {
 
@@ -49,6 +61,12 @@ inline SkScalar smoothCurve(SkScalar t) {
     return SkScalarMul(SkScalarSquare(t), SK_Scalar3 - 2 * t);
 }
 
+// The gradient of the given channel at a lattice entry.
+inline SkPoint gradient(const SkPerlinNoiseParams& params, int channel, int index) {
+    return SkPoint::Make(params.fGradients[index][0][channel],
+                         params.fGradients[index][1][channel]);
+}
+
 bool perlin_noise_type_is_valid(SkPerlinNoiseShader::Type type) {
     return (SkPerlinNoiseShader::kFractalNoise_Type == type) ||
            (SkPerlinNoiseShader::kTurbulence_Type == type);
@@ -82,6 +100,7 @@ struct SkPerlinNoiseShader::PaintingData {
                  SkScalar baseFrequencyX, SkScalar baseFrequencyY)
       : fTileSize(tileSize)
       , fBaseFrequency(SkPoint::Make(baseFrequencyX, baseFrequencyY))
+      , fTileBuilt(false)
     {
         this->init(seed);
         if (!fTileSize.isEmpty()) {
@@ -104,6 +123,14 @@ struct SkPerlinNoiseShader::PaintingData {
     SkISize     fTileSize;
     SkVector    fBaseFrequency;
     StitchData  fStitchDataInit;
+    // fGradient regrouped so that each lattice entry's four channels are together.
+    float       fGradients[kBlockSize][2][4];
+
+    // When stitching, the colors at the integer points of the tile (only ever shaded with an
+    // opaque paint), filled in the first time they are needed.
+    SkBitmap    fTile;
+    bool        fTileBuilt;
+    SkMutex     fTileMutex;
 
 private:
 
@@ -192,6 +219,8 @@ private:
                     fGradient[channel][i].fX + SK_Scalar1, gHalfMax16bits));
                 fNoise[channel][i][1] = SkScalarRoundToInt(SkScalarMul(
                     fGradient[channel][i].fY + SK_Scalar1, gHalfMax16bits));
+                fGradients[i][0][channel] = fGradient[channel][i].fX;
+                fGradients[i][1][channel] = fGradient[channel][i].fY;
             }
         }
     }
@@ -312,9 +341,12 @@ void SkPerlinNoiseShader::flatten(SkWriteBuffer& buffer) const {
     buffer.writeInt(fTileSize.fHeight);
 }
 
-SkScalar SkPerlinNoiseShader::PerlinNoiseShaderContext::noise2D(
-        int channel, const PaintingData& paintingData,
-        const StitchData& stitchData, const SkPoint& noiseVector) const {
+namespace {
+
+typedef SkPerlinNoiseShader::StitchData StitchData;
+
+SkScalar noise2D(int channel, const SkPerlinNoiseParams& params,
+                 const StitchData& stitchData, const SkPoint& noiseVector) {
     struct Noise {
         int noisePositionIntegerValue;
         int nextNoisePositionIntegerValue;
@@ -330,9 +362,8 @@ SkScalar SkPerlinNoiseShader::PerlinNoiseShaderContext::noise2D(
     Noise noiseX(noiseVector.x());
     Noise noiseY(noiseVector.y());
     SkScalar u, v;
-    const SkPerlinNoiseShader& perlinNoiseShader = static_cast<const SkPerlinNoiseShader&>(fShader);
     // If stitching, adjust lattice points accordingly.
-    if (perlinNoiseShader.fStitchTiles) {
+    if (params.fStitchTiles) {
         noiseX.noisePositionIntegerValue =
             checkNoise(noiseX.noisePositionIntegerValue, stitchData.fWrapX, stitchData.fWidth);
         noiseY.noisePositionIntegerValue =
@@ -347,9 +378,9 @@ SkScalar SkPerlinNoiseShader::PerlinNoiseShaderContext::noise2D(
     noiseX.nextNoisePositionIntegerValue &= kBlockMask;
     noiseY.nextNoisePositionIntegerValue &= kBlockMask;
     int i =
-        paintingData.fLatticeSelector[noiseX.noisePositionIntegerValue];
+        params.fLatticeSelector[noiseX.noisePositionIntegerValue];
     int j =
-        paintingData.fLatticeSelector[noiseX.nextNoisePositionIntegerValue];
+        params.fLatticeSelector[noiseX.nextNoisePositionIntegerValue];
     int b00 = (i + noiseY.noisePositionIntegerValue) & kBlockMask;
     int b10 = (j + noiseY.noisePositionIntegerValue) & kBlockMask;
     int b01 = (i + noiseY.nextNoisePositionIntegerValue) & kBlockMask;
@@ -359,38 +390,40 @@ SkScalar SkPerlinNoiseShader::PerlinNoiseShaderContext::noise2D(
     // This is taken 1:1 from SVG spec: http://www.w3.org/TR/SVG11/filters.html#feTurbulenceElement
     SkPoint fractionValue = SkPoint::Make(noiseX.noisePositionFractionValue,
                                           noiseY.noisePositionFractionValue); // Offset (0,0)
-    u = paintingData.fGradient[channel][b00].dot(fractionValue);
+    u = gradient(params, channel, b00).dot(fractionValue);
     fractionValue.fX -= SK_Scalar1; // Offset (-1,0)
-    v = paintingData.fGradient[channel][b10].dot(fractionValue);
+    v = gradient(params, channel, b10).dot(fractionValue);
     SkScalar a = SkScalarInterp(u, v, sx);
     fractionValue.fY -= SK_Scalar1; // Offset (-1,-1)
-    v = paintingData.fGradient[channel][b11].dot(fractionValue);
+    v = gradient(params, channel, b11).dot(fractionValue);
     fractionValue.fX = noiseX.noisePositionFractionValue; // Offset (0,-1)
-    u = paintingData.fGradient[channel][b01].dot(fractionValue);
+    u = gradient(params, channel, b01).dot(fractionValue);
     SkScalar b = SkScalarInterp(u, v, sx);
     return SkScalarInterp(a, b, sy);
 }
 
-SkScalar SkPerlinNoiseShader::PerlinNoiseShaderContext::calculateTurbulenceValueForPoint(
-        int channel, const PaintingData& paintingData,
-        StitchData& stitchData, const SkPoint& point) const {
-    const SkPerlinNoiseShader& perlinNoiseShader = static_cast<const SkPerlinNoiseShader&>(fShader);
-    if (perlinNoiseShader.fStitchTiles) {
+SkScalar calculateTurbulenceValueForPoint(int channel, const SkPerlinNoiseParams& params,
+                                          const SkPoint& point) {
+    StitchData stitchData;
+    if (params.fStitchTiles) {
         // Set up TurbulenceInitial stitch values.
-        stitchData = paintingData.fStitchDataInit;
+        stitchData.fWidth  = params.fStitchWidth;
+        stitchData.fWrapX  = kPerlinNoise + stitchData.fWidth;
+        stitchData.fHeight = params.fStitchHeight;
+        stitchData.fWrapY  = kPerlinNoise + stitchData.fHeight;
     }
     SkScalar turbulenceFunctionResult = 0;
-    SkPoint noiseVector(SkPoint::Make(SkScalarMul(point.x(), paintingData.fBaseFrequency.fX),
-                                      SkScalarMul(point.y(), paintingData.fBaseFrequency.fY)));
+    SkPoint noiseVector(SkPoint::Make(SkScalarMul(point.x(), params.fBaseFrequencyX),
+                                      SkScalarMul(point.y(), params.fBaseFrequencyY)));
     SkScalar ratio = SK_Scalar1;
-    for (int octave = 0; octave < perlinNoiseShader.fNumOctaves; ++octave) {
-        SkScalar noise = noise2D(channel, paintingData, stitchData, noiseVector);
+    for (int octave = 0; octave < params.fNumOctaves; ++octave) {
+        SkScalar noise = noise2D(channel, params, stitchData, noiseVector);
         turbulenceFunctionResult += SkScalarDiv(
-            (perlinNoiseShader.fType == kFractalNoise_Type) ? noise : SkScalarAbs(noise), ratio);
+            params.fFractalNoise ? noise : SkScalarAbs(noise), ratio);
         noiseVector.fX *= 2;
         noiseVector.fY *= 2;
         ratio *= 2;
-        if (perlinNoiseShader.fStitchTiles) {
+        if (params.fStitchTiles) {
             // Update stitch values
             stitchData.fWidth  *= 2;
             stitchData.fWrapX   = stitchData.fWidth + kPerlinNoise;
@@ -401,35 +434,127 @@ SkScalar SkPerlinNoiseShader::PerlinNoiseShaderContext::calculateTurbulenceValue
 
     // The value of turbulenceFunctionResult comes from ((turbulenceFunctionResult) + 1) / 2
     // by fractalNoise and (turbulenceFunctionResult) by turbulence.
-    if (perlinNoiseShader.fType == kFractalNoise_Type) {
+    if (params.fFractalNoise) {
         turbulenceFunctionResult =
             SkScalarMul(turbulenceFunctionResult, SK_ScalarHalf) + SK_ScalarHalf;
     }
 
     if (channel == 3) { // Scale alpha by paint value
-        turbulenceFunctionResult = SkScalarMul(turbulenceFunctionResult,
-            SkScalarDiv(SkIntToScalar(getPaintAlpha()), SkIntToScalar(255)));
+        turbulenceFunctionResult = SkScalarMul(turbulenceFunctionResult, params.fAlphaScale);
     }
 
     // Clamp result
     return SkScalarPin(turbulenceFunctionResult, 0, SK_Scalar1);
 }
 
-SkPMColor SkPerlinNoiseShader::PerlinNoiseShaderContext::shade(
-        const SkPoint& point, StitchData& stitchData) const {
+void perlin_noise_span_portable(const SkPerlinNoiseParams& params, const SkPoint points[],
+                                int count, SkPMColor dst[]) {
+    for (int i = 0; i < count; ++i) {
+        U8CPU rgba[4];
+        for (int channel = 3; channel >= 0; --channel) {
+            rgba[channel] = SkScalarFloorToInt(255 *
+                calculateTurbulenceValueForPoint(channel, params, points[i]));
+        }
+        dst[i] = SkPreMultiplyARGB(rgba[3], rgba[0], rgba[1], rgba[2]);
+    }
+}
+
+SkPerlinNoiseSpanProc choose_span_proc() {
+    SkPerlinNoiseSpanProc proc = SkPerlinNoiseGetPlatformSpanProc();
+    return proc ? proc : perlin_noise_span_portable;
+}
+
+}  // namespace
+
+SkPerlinNoiseSpanProc SkPerlinNoiseGetPortableSpanProc() {
+    return perlin_noise_span_portable;
+}
+
+void SkPerlinNoiseShader::PerlinNoiseShaderContext::mapPoints(
+        int x, int y, SkPoint points[], int count) const {
+    for (int i = 0; i < count; ++i) {
+        points[i].set(SkIntToScalar(x + i), SkIntToScalar(y));
+    }
+    fMatrix.mapPoints(points, count);
+    for (int i = 0; i < count; ++i) {
+        points[i].set(SkScalarRoundToScalar(points[i].fX), SkScalarRoundToScalar(points[i].fY));
+    }
+}
+
+void SkPerlinNoiseShader::PerlinNoiseShaderContext::shadeNoisePoints(
+        const SkPoint points[], int count, SkPMColor result[]) const {
+    SK_DECLARE_STATIC_LAZY_FN_PTR(SkPerlinNoiseSpanProc, proc, choose_span_proc);
     const SkPerlinNoiseShader& perlinNoiseShader = static_cast<const SkPerlinNoiseShader&>(fShader);
-    SkPoint newPoint;
-    fMatrix.mapPoints(&newPoint, &point, 1);
-    newPoint.fX = SkScalarRoundToScalar(newPoint.fX);
-    newPoint.fY = SkScalarRoundToScalar(newPoint.fY);
-
-    U8CPU rgba[4];
-    for (int channel = 3; channel >= 0; --channel) {
-        rgba[channel] = SkScalarFloorToInt(255 *
-            calculateTurbulenceValueForPoint(channel, *perlinNoiseShader.fPaintingData,
-                                             stitchData, newPoint));
+    const PaintingData& paintingData = *perlinNoiseShader.fPaintingData;
+    SkPerlinNoiseParams params;
+    params.fLatticeSelector = paintingData.fLatticeSelector;
+    params.fGradients = paintingData.fGradients;
+    params.fBaseFrequencyX = paintingData.fBaseFrequency.fX;
+    params.fBaseFrequencyY = paintingData.fBaseFrequency.fY;
+    params.fNumOctaves = perlinNoiseShader.fNumOctaves;
+    params.fFractalNoise = perlinNoiseShader.fType == kFractalNoise_Type;
+    params.fStitchTiles = perlinNoiseShader.fStitchTiles;
+    params.fStitchWidth = paintingData.fStitchDataInit.fWidth;
+    params.fStitchHeight = paintingData.fStitchDataInit.fHeight;
+    params.fAlphaScale = SkScalarDiv(SkIntToScalar(getPaintAlpha()), SkIntToScalar(255));
+    proc.get()(params, points, count, result);
+}
+
+void SkPerlinNoiseShader::PerlinNoiseShaderContext::BuildTile(
+        const PerlinNoiseShaderContext* context) {
+    const SkPerlinNoiseShader& perlinNoiseShader =
+        static_cast<const SkPerlinNoiseShader&>(context->fShader);
+    SkBitmap& tile = perlinNoiseShader.fPaintingData->fTile;
+    // The (1, 1) translation in fMatrix puts a tile drawn at the origin at [1, size], so the
+    // tile covers [0, size] in both directions.
+    const int width = perlinNoiseShader.fTileSize.width() + 1;
+    const int height = perlinNoiseShader.fTileSize.height() + 1;
+    if (!tile.allocN32Pixels(width, height)) {
+        return;
+    }
+    SkAutoTMalloc<SkPoint> points(width);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            points[x].set(SkIntToScalar(x), SkIntToScalar(y));
+        }
+        context->shadeNoisePoints(points.get(), width, tile.getAddr32(0, y));
+    }
+}
+
+void SkPerlinNoiseShader::PerlinNoiseShaderContext::shadePoints(
+        const SkPoint points[], int count, SkPMColor result[]) const {
+    if (!fUseTile) {
+        this->shadeNoisePoints(points, count, result);
+        return;
+    }
+    PaintingData* paintingData = static_cast<const SkPerlinNoiseShader&>(fShader).fPaintingData;
+    SkOnce(&paintingData->fTileBuilt, &paintingData->fTileMutex, BuildTile, this);
+    const SkBitmap& tile = paintingData->fTile;
+    if (NULL == tile.getPixels()) {
+        this->shadeNoisePoints(points, count, result);
+        return;
+    }
+
+    // The color at a point depends only on the point, so points in the tile can be read back.
+    const SkScalar maxX = SkIntToScalar(tile.width() - 1);
+    const SkScalar maxY = SkIntToScalar(tile.height() - 1);
+    int i = 0;
+    while (i < count) {
+        const int start = i;
+        while (i < count && !(points[i].fX >= 0 && points[i].fX <= maxX &&
+                              points[i].fY >= 0 && points[i].fY <= maxY)) {
+            ++i;
+        }
+        if (i > start) {
+            this->shadeNoisePoints(points + start, i - start, result + start);
+        }
+        while (i < count && points[i].fX >= 0 && points[i].fX <= maxX &&
+                            points[i].fY >= 0 && points[i].fY <= maxY) {
+            result[i] = *tile.getAddr32(SkScalarTruncToInt(points[i].fX),
+                                        SkScalarTruncToInt(points[i].fY));
+            ++i;
+        }
     }
-    return SkPreMultiplyARGB(rgba[3], rgba[0], rgba[1], rgba[2]);
 }
 
 SkShader::Context* SkPerlinNoiseShader::onCreateContext(const ContextRec& rec,
@@ -460,28 +585,42 @@ SkPerlinNoiseShader::PerlinNoiseShaderContext::PerlinNoiseShaderContext(
     newMatrix.postConcat(invMatrix);
     newMatrix.postConcat(invMatrix);
     fMatrix = newMatrix;
+
+    // The tile is only shaded with an opaque paint, since the paint's alpha scales the noise.
+    const SkISize& tileSize = shader.fTileSize;
+    fUseTile = shader.fStitchTiles && 255 == this->getPaintAlpha() &&
+               (int64_t)(tileSize.width() + 1) * (tileSize.height() + 1) <= kMaxCachedTilePixels;
 }
 
 void SkPerlinNoiseShader::PerlinNoiseShaderContext::shadeSpan(
         int x, int y, SkPMColor result[], int count) {
-    SkPoint point = SkPoint::Make(SkIntToScalar(x), SkIntToScalar(y));
-    StitchData stitchData;
-    for (int i = 0; i < count; ++i) {
-        result[i] = shade(point, stitchData);
-        point.fX += SK_Scalar1;
+    SkPoint points[kSpanBufferSize];
+    while (count > 0) {
+        const int n = SkTMin(count, kSpanBufferSize);
+        this->mapPoints(x, y, points, n);
+        this->shadePoints(points, n, result);
+        x += n;
+        result += n;
+        count -= n;
     }
 }
 
 void SkPerlinNoiseShader::PerlinNoiseShaderContext::shadeSpan16(
         int x, int y, uint16_t result[], int count) {
-    SkPoint point = SkPoint::Make(SkIntToScalar(x), SkIntToScalar(y));
-    StitchData stitchData;
+    SkPoint points[kSpanBufferSize];
+    SkPMColor colors[kSpanBufferSize];
     DITHER_565_SCAN(y);
-    for (int i = 0; i < count; ++i) {
-        unsigned dither = DITHER_VALUE(x);
-        result[i] = SkDitherRGB32To565(shade(point, stitchData), dither);
-        DITHER_INC_X(x);
-        point.fX += SK_Scalar1;
+    while (count > 0) {
+        const int n = SkTMin(count, kSpanBufferSize);
+        this->mapPoints(x, y, points, n);
+        this->shadePoints(points, n, colors);
+        for (int i = 0; i < n; ++i) {
+            unsigned dither = DITHER_VALUE(x);
+            result[i] = SkDitherRGB32To565(colors[i], dither);
+            DITHER_INC_X(x);
+        }
+        result += n;
+        count -= n;
     }
 }
 
@@ -6,8 +6,11 @@
  */
 
 #include "SkGradientShaderPriv.h"
+#include "SkChecksum.h"
 #include "SkLinearGradient.h"
 #include "SkRadialGradient.h"
+#include "SkTDynamicHash.h"
+#include "SkTInternalLList.h"
 #include "SkTwoPointRadialGradient.h"
 #include "SkTwoPointConicalGradient.h"
 #include "SkSweepGradient.h"
@@ -251,6 +254,79 @@ bool SkGradientShaderBase::isOpaque() const {
     return fColorsAreOpaque;
 }
 
+// Portable versions of SkGradientLerpProcs.  The SSE2 versions are in src/opts.
+
+static inline float lerp_tile(SkShader::TileMode mode, float t) {
+    switch (mode) {
+        case SkShader::kClamp_TileMode:
+            return SkTMax(0.0f, SkTMin(t, 1.0f));
+        case SkShader::kRepeat_TileMode:
+            return t - sk_float_floor(t);
+        default: {  // kMirror_TileMode
+            // f = t mod 2, then fold [1, 2) back onto (0, 1].
+            const float f = t - 2 * sk_float_floor(t * 0.5f);
+            return 1 - sk_float_abs(f - 1);
+        }
+    }
+}
+
+static inline SkPMColor lerp_pixel(const SkGradientLerp& lerp, float t, float bias) {
+    if (t != t) {   // NaN
+        return 0;
+    }
+    t = lerp_tile(lerp.fTileMode, t);
+
+    float c[4];
+    for (int i = 0; i < 4; i++) {
+        c[i] = lerp.fColor0[i] + t * lerp.fDelta[i];
+    }
+    if (!lerp.fInterpInPremul) {
+        const float scale = c[0] * (1.0f / 255);   // As the SSE2 procs do it.
+        for (int i = 1; i < 4; i++) {
+            c[i] *= scale;
+        }
+    }
+    // Keep each color channel from dithering past alpha.
+    const unsigned a = (unsigned)(c[0] + bias);
+    const float maxColor = a + 0.5f;
+    return SkPackARGB32(a,
+                        (unsigned)SkTMin(c[1] + bias, maxColor),
+                        (unsigned)SkTMin(c[2] + bias, maxColor),
+                        (unsigned)SkTMin(c[3] + bias, maxColor));
+}
+
+static void lerp_span(const SkGradientLerp& lerp, const float t[],
+                      int x, int y, SkPMColor dst[], int count) {
+    const float bias[2] = { SkGradientDitherBias(x, y), SkGradientDitherBias(x + 1, y) };
+    for (int i = 0; i < count; i++) {
+        dst[i] = lerp_pixel(lerp, t[i], bias[i & 1]);
+    }
+}
+
+static void lerp_linear(const SkGradientLerp& lerp, float t0, float dt,
+                        int x, int y, SkPMColor dst[], int count) {
+    const float bias[2] = { SkGradientDitherBias(x, y), SkGradientDitherBias(x + 1, y) };
+    for (int i = 0; i < count; i++) {
+        dst[i] = lerp_pixel(lerp, t0 + i * dt, bias[i & 1]);
+    }
+}
+
+static void lerp_radial(const SkGradientLerp& lerp, float px, float py, float dx, float dy,
+                        int x, int y, SkPMColor dst[], int count) {
+    const float bias[2] = { SkGradientDitherBias(x, y), SkGradientDitherBias(x + 1, y) };
+    for (int i = 0; i < count; i++) {
+        const float fx = px + i * dx,
+                    fy = py + i * dy;
+        dst[i] = lerp_pixel(lerp, sk_float_sqrt(fx * fx + fy * fy), bias[i & 1]);
+    }
+}
+
+void SkGradientGetPortableLerpProcs(SkGradientLerpProcs* procs) {
+    procs->fSpan   = lerp_span;
+    procs->fLinear = lerp_linear;
+    procs->fRadial = lerp_radial;
+}
+
 SkGradientShaderBase::GradientShaderBaseContext::GradientShaderBaseContext(
         const SkGradientShaderBase& shader, const ContextRec& rec)
     : INHERITED(shader, rec)
@@ -275,15 +351,48 @@ SkGradientShaderBase::GradientShaderBaseContext::GradientShaderBaseContext(
     if (shader.fColorsAreOpaque) {
         fFlags |= kHasSpan16_Flag;
     }
+
+    fHasLerp = false;
+    if (2 == shader.fColorCount) {
+        fLerp.fTileMode = shader.fTileMode;
+        fLerp.fInterpInPremul = SkToBool(shader.fGradFlags &
+                                         SkGradientShader::kInterpolateColorsInPremul_Flag);
+        float colors[2][4];
+        for (int i = 0; i < 2; i++) {
+            const SkColor c = shader.fOrigColors[i];
+            const float a = SkColorGetA(c) * paintAlpha / 255.0f;
+            const float scale = fLerp.fInterpInPremul ? a / 255 : 1;
+            colors[i][0] = a;
+            colors[i][1] = SkColorGetR(c) * scale;
+            colors[i][2] = SkColorGetG(c) * scale;
+            colors[i][3] = SkColorGetB(c) * scale;
+        }
+        for (int i = 0; i < 4; i++) {
+            fLerp.fColor0[i] = colors[0][i];
+            fLerp.fDelta[i]  = colors[1][i] - colors[0][i];
+        }
+        if (!SkGradientGetPlatformLerpProcs(&fLerpProcs)) {
+            SkGradientGetPortableLerpProcs(&fLerpProcs);
+        }
+        fHasLerp = true;
+    }
 }
 
 SkGradientShaderBase::GradientShaderCache::GradientShaderCache(
         U8CPU alpha, const SkGradientShaderBase& shader)
     : fCacheAlpha(alpha)
-    , fShader(shader)
+    , fColorCount(shader.fColorCount)
+    , fGradFlags(shader.fGradFlags)
+    , fColors(shader.fColorCount)
+    , fPos(shader.fColorCount > 2 ? shader.fColorCount : 0)
     , fCache16Inited(false)
     , fCache32Inited(false)
 {
+    memcpy(fColors.get(), shader.fOrigColors, fColorCount * sizeof(SkColor));
+    for (int i = 0; i < fPos.count(); i++) {
+        fPos[i] = shader.fRecs[i].fPos;
+    }
+
     // Only initialize the cache in getCache16/32.
     fCache16 = NULL;
     fCache32 = NULL;
@@ -499,19 +608,19 @@ void SkGradientShaderBase::GradientShaderCache::initCache16(GradientShaderCache*
     SkASSERT(NULL == cache->fCache16Storage);
     cache->fCache16Storage = (uint16_t*)sk_malloc_throw(allocSize);
     cache->fCache16 = cache->fCache16Storage;
-    if (cache->fShader.fColorCount == 2) {
-        Build16bitCache(cache->fCache16, cache->fShader.fOrigColors[0],
-                        cache->fShader.fOrigColors[1], kCache16Count);
+    if (cache->fColorCount == 2) {
+        Build16bitCache(cache->fCache16, cache->fColors[0],
+                        cache->fColors[1], kCache16Count);
     } else {
-        Rec* rec = cache->fShader.fRecs;
+        const SkFixed* pos = cache->fPos.get();
         int prevIndex = 0;
-        for (int i = 1; i < cache->fShader.fColorCount; i++) {
-            int nextIndex = SkFixedToFFFF(rec[i].fPos) >> kCache16Shift;
+        for (int i = 1; i < cache->fColorCount; i++) {
+            int nextIndex = SkFixedToFFFF(pos[i]) >> kCache16Shift;
             SkASSERT(nextIndex < kCache16Count);
 
             if (nextIndex > prevIndex)
-                Build16bitCache(cache->fCache16 + prevIndex, cache->fShader.fOrigColors[i-1],
-                                cache->fShader.fOrigColors[i], nextIndex - prevIndex + 1);
+                Build16bitCache(cache->fCache16 + prevIndex, cache->fColors[i-1],
+                                cache->fColors[i], nextIndex - prevIndex + 1);
             prevIndex = nextIndex;
         }
     }
@@ -534,34 +643,170 @@ void SkGradientShaderBase::GradientShaderCache::initCache32(GradientShaderCache*
     SkASSERT(NULL == cache->fCache32PixelRef);
     cache->fCache32PixelRef = SkMallocPixelRef::NewAllocate(info, 0, NULL);
     cache->fCache32 = (SkPMColor*)cache->fCache32PixelRef->getAddr();
-    if (cache->fShader.fColorCount == 2) {
-        Build32bitCache(cache->fCache32, cache->fShader.fOrigColors[0],
-                        cache->fShader.fOrigColors[1], kCache32Count, cache->fCacheAlpha,
-                        cache->fShader.fGradFlags);
+    if (cache->fColorCount == 2) {
+        Build32bitCache(cache->fCache32, cache->fColors[0],
+                        cache->fColors[1], kCache32Count, cache->fCacheAlpha,
+                        cache->fGradFlags);
     } else {
-        Rec* rec = cache->fShader.fRecs;
+        const SkFixed* pos = cache->fPos.get();
         int prevIndex = 0;
-        for (int i = 1; i < cache->fShader.fColorCount; i++) {
-            int nextIndex = SkFixedToFFFF(rec[i].fPos) >> kCache32Shift;
+        for (int i = 1; i < cache->fColorCount; i++) {
+            int nextIndex = SkFixedToFFFF(pos[i]) >> kCache32Shift;
             SkASSERT(nextIndex < kCache32Count);
 
             if (nextIndex > prevIndex)
-                Build32bitCache(cache->fCache32 + prevIndex, cache->fShader.fOrigColors[i-1],
-                                cache->fShader.fOrigColors[i], nextIndex - prevIndex + 1,
-                                cache->fCacheAlpha, cache->fShader.fGradFlags);
+                Build32bitCache(cache->fCache32 + prevIndex, cache->fColors[i-1],
+                                cache->fColors[i], nextIndex - prevIndex + 1,
+                                cache->fCacheAlpha, cache->fGradFlags);
             prevIndex = nextIndex;
         }
     }
 }
 
+namespace {
+
+/*
+ *  A process-wide LRU of GradientShaderCaches, keyed by everything that goes
+ *  into their tables. Documents tend to create many identical, short-lived
+ *  gradients, and this way only the first of them has to build the tables.
+ */
+class SharedGradientCaches : SkNoncopyable {
+public:
+    typedef SkGradientShaderBase::GradientShaderCache GradientShaderCache;
+
+    SharedGradientCaches() : fCount(0) {}
+
+    ~SharedGradientCaches() {
+        while (Entry* entry = fLRU.tail()) {
+            this->remove(entry);
+        }
+    }
+
+    // Returns a ref on the cache for key, or NULL if there isn't one.
+    GradientShaderCache* find(const int32_t key[], int count) {
+        Entry* entry = fHash.find(Key(key, count));
+        if (NULL == entry) {
+            return NULL;
+        }
+        fLRU.remove(entry);
+        fLRU.addToHead(entry);
+        return SkRef(entry->fCache);
+    }
+
+    void add(const int32_t key[], int count, GradientShaderCache* cache) {
+        if (fCount == kMaxEntries) {
+            this->remove(fLRU.tail());
+        }
+        Entry* entry = SkNEW_ARGS(Entry, (key, count, cache));
+        fHash.add(entry);
+        fLRU.addToHead(entry);
+        fCount++;
+    }
+
+private:
+    enum {
+        // Each entry's tables are at most 5K (4 rows of 32-bit, 2 of 16-bit), so this is 640K.
+        kMaxEntries = 128
+    };
+
+    struct Key {
+        Key(const int32_t data[], int count)
+            : fData(data)
+            , fCount(count)
+            , fHash(SkChecksum::Murmur3(reinterpret_cast<const uint32_t*>(data),
+                                        count * sizeof(int32_t))) {}
+
+        bool operator==(const Key& other) const {
+            return fHash == other.fHash && fCount == other.fCount &&
+                   0 == memcmp(fData, other.fData, fCount * sizeof(int32_t));
+        }
+
+        const int32_t* fData;
+        int            fCount;
+        uint32_t       fHash;
+    };
+
+    struct Entry {
+        Entry(const int32_t key[], int count, GradientShaderCache* cache)
+            : fStorage(count)
+            , fKey((memcpy(fStorage.get(), key, count * sizeof(int32_t)), fStorage.get()), count)
+            , fCache(SkRef(cache)) {}
+        ~Entry() { fCache->unref(); }
+
+        static const Key& GetKey(const Entry& entry) { return entry.fKey; }
+        static uint32_t Hash(const Key& key) { return key.fHash; }
+
+        SkAutoTMalloc<int32_t> fStorage;
+        const Key              fKey;
+        GradientShaderCache*   fCache;
+
+        SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
+    };
+
+    void remove(Entry* entry) {
+        fHash.remove(entry->fKey);
+        fLRU.remove(entry);
+        SkDELETE(entry);
+        fCount--;
+    }
+
+    SkTDynamicHash<Entry, Key> fHash;
+    SkTInternalLList<Entry>    fLRU;
+    int                        fCount;
+};
+
+}  // namespace
+
+int SkGradientShaderBase::writeCacheKey(int32_t* key) const {
+    // [numColors + colors[] + {positions[]} + flags ]
+    int count = 1 + fColorCount + 1;
+    if (fColorCount > 2) {
+        count += fColorCount - 1;    // fRecs[].fPos
+    }
+    if (NULL == key) {
+        return count;
+    }
+
+    int32_t* buffer = key;
+    *buffer++ = fColorCount;
+    memcpy(buffer, fOrigColors, fColorCount * sizeof(SkColor));
+    buffer += fColorCount;
+    if (fColorCount > 2) {
+        for (int i = 1; i < fColorCount; i++) {
+            *buffer++ = fRecs[i].fPos;
+        }
+    }
+    *buffer++ = fGradFlags;
+    SkASSERT(buffer - key == count);
+    return count;
+}
+
 /*
  *  The gradient holds a cache for the most recent value of alpha. Successive
- *  callers with the same alpha value will share the same cache.
+ *  callers with the same alpha value will share the same cache. When that
+ *  misses, we look for one built by an identical gradient before building our
+ *  own.
  */
 SkGradientShaderBase::GradientShaderCache* SkGradientShaderBase::refCache(U8CPU alpha) const {
     SkAutoMutexAcquire ama(fCacheMutex);
     if (!fCache || fCache->getAlpha() != alpha) {
-        fCache.reset(SkNEW_ARGS(GradientShaderCache, (alpha, *this)));
+        // The shared key is our own key followed by alpha.
+        const int count = this->writeCacheKey(NULL) + 1;
+        SkAutoSTMalloc<16, int32_t> key(count);
+        this->writeCacheKey(key.get());
+        key[count - 1] = alpha;
+
+        SK_DECLARE_STATIC_MUTEX(gSharedMutex);
+        static SharedGradientCaches* gShared;
+        SkAutoMutexAcquire amaShared(gSharedMutex);
+        if (NULL == gShared) {
+            gShared = SkNEW(SharedGradientCaches);
+        }
+        fCache.reset(gShared->find(key.get(), count));
+        if (!fCache) {
+            fCache.reset(SkNEW_ARGS(GradientShaderCache, (alpha, *this)));
+            gShared->add(key.get(), count, fCache);
+        }
     }
     // Increment the ref counter inside the mutex to ensure the returned pointer is still valid.
     // Otherwise, the pointer may have been overwritten on a different thread before the object's
@@ -583,25 +828,9 @@ void SkGradientShaderBase::getGradientTableBitmap(SkBitmap* bitmap) const {
     // built with 0xFF
     SkAutoTUnref<GradientShaderCache> cache(this->refCache(0xFF));
 
-    // build our key: [numColors + colors[] + {positions[]} + flags ]
-    int count = 1 + fColorCount + 1;
-    if (fColorCount > 2) {
-        count += fColorCount - 1;    // fRecs[].fPos
-    }
-
+    const int count = this->writeCacheKey(NULL);
     SkAutoSTMalloc<16, int32_t> storage(count);
-    int32_t* buffer = storage.get();
-
-    *buffer++ = fColorCount;
-    memcpy(buffer, fOrigColors, fColorCount * sizeof(SkColor));
-    buffer += fColorCount;
-    if (fColorCount > 2) {
-        for (int i = 1; i < fColorCount; i++) {
-            *buffer++ = fRecs[i].fPos;
-        }
-    }
-    *buffer++ = fGradFlags;
-    SkASSERT(buffer - storage.get() == count);
+    this->writeCacheKey(storage.get());
 
     ///////////////////////////////////
 
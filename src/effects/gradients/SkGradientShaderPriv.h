@@ -9,6 +9,7 @@
 #define SkGradientShaderPriv_DEFINED
 
 #include "SkGradientShader.h"
+#include "SkGradient_opts.h"
 #include "SkClampRange.h"
 #include "SkColorPriv.h"
 #include "SkReadBuffer.h"
@@ -101,6 +102,8 @@ public:
     virtual ~SkGradientShaderBase();
 
     // The cache is initialized on-demand when getCache16/32 is called.
+    // It copies what it needs from the shader, so that identical shaders can
+    // share one (see refCache).
     class GradientShaderCache : public SkRefCnt {
     public:
         GradientShaderCache(U8CPU alpha, const SkGradientShaderBase& shader);
@@ -124,7 +127,11 @@ public:
                                               // Larger than 8bits so we can store uninitialized
                                               // value.
 
-        const SkGradientShaderBase& fShader;
+        // Copied from the shader.
+        const int               fColorCount;
+        const uint32_t          fGradFlags;
+        SkAutoSTArray<8, SkColor> fColors;
+        SkAutoSTArray<8, SkFixed> fPos;      // fRecs[].fPos, only if fColorCount > 2.
 
         // Make sure we only initialize the caches once.
         bool    fCache16Inited, fCache32Inited;
@@ -152,7 +159,17 @@ public:
 
         SkAutoTUnref<GradientShaderCache> fCache;
 
+        // Two-stop gradients can skip the color table and compute each pixel's color
+        // directly with fLerpProcs, which is more precise and, vectorized, about as fast.
+        bool canShadeTwoStop() const {
+            return fHasLerp && fDstToIndexClass != kPerspective_MatrixClass;
+        }
+        SkGradientLerp      fLerp;
+        SkGradientLerpProcs fLerpProcs;
+
     private:
+        bool                fHasLerp;   // Only if the gradient has two stops.
+
         typedef SkShader::Context INHERITED;
     };
 
@@ -240,6 +257,9 @@ private:
     bool        fColorsAreOpaque;
 
     GradientShaderCache* refCache(U8CPU alpha) const;
+    // Writes [fColorCount, colors[], {positions[]}, fGradFlags] to key (if not NULL) and
+    // returns its length in int32_ts.
+    int writeCacheKey(int32_t* key) const;
     mutable SkMutex                           fCacheMutex;
     mutable SkAutoTUnref<GradientShaderCache> fCache;
 
@@ -228,6 +228,18 @@ void SkLinearGradient::LinearGradientContext::shadeSpan(int x, int y, SkPMColor*
             dx = SkScalarToFixed(fDstToIndex.getScaleX());
         }
 
+        if (this->canShadeTwoStop()) {
+            // The same step as dx, but without rounding it to 16.16.
+            SkScalar dt = fDstToIndex.getScaleX();
+            if (fDstToIndexClass == kFixedStepInX_MatrixClass) {
+                dt /= SkIntToScalar(y) * fDstToIndex.getPerspY() +
+                      fDstToIndex.get(SkMatrix::kMPersp2);
+            }
+            fLerpProcs.fLinear(fLerp, SkScalarToFloat(srcPt.fX), SkScalarToFloat(dt),
+                               x, y, dstC, count);
+            return;
+        }
+
         LinearShadeProc shadeProc = shadeSpan_linear_repeat;
         if (0 == dx) {
             shadeProc = shadeSpan_linear_vertical_lerp;
@@ -431,6 +431,12 @@ void SkRadialGradient::RadialGradientContext::shadeSpan(int x, int y,
             SkASSERT(fDstToIndexClass == kLinear_MatrixClass);
         }
 
+        if (this->canShadeTwoStop()) {
+            fLerpProcs.fRadial(fLerp, SkScalarToFloat(srcPt.fX), SkScalarToFloat(srcPt.fY),
+                               SkScalarToFloat(sdx), SkScalarToFloat(sdy), x, y, dstC, count);
+            return;
+        }
+
         RadialShadeProc shadeProc = shadeSpan_radial_repeat;
         if (SkShader::kClamp_TileMode == radialGradient.fTileMode) {
             shadeProc = shadeSpan_radial_clamp;
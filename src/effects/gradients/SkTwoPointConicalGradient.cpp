@@ -280,6 +280,20 @@ void SkTwoPointConicalGradient::TwoPointConicalGradientContext::shadeSpan(
         }
 
         TwoPtRadialContext rec(twoPointConicalGradient.fRec, fx, fy, dx, dy);
+        if (this->canShadeTwoStop()) {
+            // We find t here a batch at a time, and let fLerpProcs do the rest.
+            static const int kBatch = 64;
+            float t[kBatch];
+            for (int done = 0; done < count; done += kBatch) {
+                const int n = SkTMin(kBatch, count - done);
+                for (int i = 0; i < n; i++) {
+                    const SkFixed fixedT = rec.nextT();
+                    t[i] = TwoPtRadial::DontDrawT(fixedT) ? SK_FloatNaN : SkFixedToFloat(fixedT);
+                }
+                fLerpProcs.fSpan(fLerp, t, x + done, y, dstC + done, n);
+            }
+            return;
+        }
         (*shadeProc)(&rec, dstC, cache, toggle, count);
     } else {    // perspective case
         SkScalar dstX = SkIntToScalar(x) + SK_ScalarHalf;
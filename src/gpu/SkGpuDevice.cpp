@@ -599,6 +599,28 @@ void SkGpuDevice::drawOval(const SkDraw& draw, const SkRect& oval,
     fContext->drawOval(grPaint, oval, strokeInfo);
 }
 
+// Batches skip SkBitmapDevice's raster path, and draw each shape as usual.
+void SkGpuDevice::drawRects(const SkDraw& draw, const SkRect rects[], const SkColor colors[],
+                            int count, const SkPaint& paint) {
+    this->SkBaseDevice::drawRects(draw, rects, colors, count, paint);
+}
+
+void SkGpuDevice::drawOvals(const SkDraw& draw, const SkRect ovals[], const SkColor colors[],
+                            int count, const SkPaint& paint) {
+    this->SkBaseDevice::drawOvals(draw, ovals, colors, count, paint);
+}
+
+void SkGpuDevice::drawRRects(const SkDraw& draw, const SkRRect rrects[], const SkColor colors[],
+                             int count, const SkPaint& paint) {
+    this->SkBaseDevice::drawRRects(draw, rrects, colors, count, paint);
+}
+
+void SkGpuDevice::drawAtlas(const SkDraw& draw, const SkBitmap& atlas, const SkMatrix xforms[],
+                            const SkIRect tex[], const SkColor colors[], int count,
+                            const SkPaint& paint) {
+    this->SkBaseDevice::drawAtlas(draw, atlas, xforms, tex, colors, count, paint);
+}
+
 #include "SkMaskFilter.h"
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,25 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkColorMatrix_opts_DEFINED
+#define SkColorMatrix_opts_DEFINED
+
+#include "SkColor.h"
+
+// Applies a 4x5 color matrix (rows r, g, b, a, with the last column a translate in [0, 255]
+// units) to count premultiplied colors: each is unpremultiplied, transformed, pinned to
+// [0, 255] and premultiplied again.  src and dst may be the same buffer.
+//
+// The matrix is in SkColorMatrixFilter's fixed point: shift fraction bits, with the translates
+// already rounded by 1 << (shift - 1).  Each channel is the row's sum of products, as int32_t,
+// shifted right, so these draw exactly what SkColorMatrixFilter's integer procs do.
+typedef void (*SkColorMatrixSpanProc)(const int32_t matrix[20], int shift,
+                                      const SkPMColor src[], int count, SkPMColor dst[]);
+
+SkColorMatrixSpanProc SkColorMatrixGetPlatformSpanProc();
+
+#endif
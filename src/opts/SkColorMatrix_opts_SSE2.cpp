@@ -0,0 +1,123 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <emmintrin.h>
+#include "SkColorMatrix_opts_SSE2.h"
+#include "SkColorPriv.h"
+#include "SkUnPreMultiply.h"
+
+namespace {
+
+// Two 16-bit values side by side in each lane, as _mm_madd_epi16() pairs them up.
+inline __m128i pair(int32_t lo, int32_t hi) {
+    return _mm_set1_epi32((hi << 16) | (lo & 0xFFFF));
+}
+
+// The matrix entries, each split into a signed high part and 15 low bits so that both fit in
+// 16 bits, and paired up for multiplying with (r, g) and (b, a).
+struct Matrix4 {
+    Matrix4(const int32_t matrix[20], int shift) : fShift(_mm_cvtsi32_si128(shift)) {
+        for (int i = 0; i < 4; ++i) {
+            const int32_t* row = matrix + 5 * i;
+            fHiRG[i] = pair(row[0] >> 15, row[1] >> 15);
+            fHiBA[i] = pair(row[2] >> 15, row[3] >> 15);
+            fLoRG[i] = pair(row[0] & 0x7FFF, row[1] & 0x7FFF);
+            fLoBA[i] = pair(row[2] & 0x7FFF, row[3] & 0x7FFF);
+            fAdd[i] = _mm_set1_epi32(row[4]);
+        }
+    }
+
+    // rowmul4() >> shift, as General() computes it, given (r, g) and (b, a) paired in each lane.
+    // The sums wrap around just as they do in int32_t.
+    __m128i row(int i, __m128i rg, __m128i ba) const {
+        const __m128i hi = _mm_add_epi32(_mm_madd_epi16(rg, fHiRG[i]),
+                                         _mm_madd_epi16(ba, fHiBA[i]));
+        const __m128i lo = _mm_add_epi32(_mm_madd_epi16(rg, fLoRG[i]),
+                                         _mm_madd_epi16(ba, fLoBA[i]));
+        const __m128i sum = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(hi, 15), lo), fAdd[i]);
+        return _mm_sra_epi32(sum, fShift);
+    }
+
+    __m128i fHiRG[4], fHiBA[4], fLoRG[4], fLoBA[4], fAdd[4];
+    __m128i fShift;
+};
+
+inline __m128i component(__m128i pixels, int shift) {
+    return _mm_and_si128(_mm_srli_epi32(pixels, shift), _mm_set1_epi32(0xFF));
+}
+
+// SkUnPreMultiply::ApplyScale() for each lane.
+inline __m128i unpremul(__m128i c, __m128i scale) {
+    const __m128i round = _mm_set_epi32(0, 1 << 23, 0, 1 << 23);
+    const __m128i even = _mm_srli_epi64(_mm_add_epi64(_mm_mul_epu32(c, scale), round), 24),
+                  odd  = _mm_srli_epi64(_mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(c, 32),
+                                                                    _mm_srli_epi64(scale, 32)),
+                                                      round), 24);
+    // Each result is at most 255, so it fits in the low half of its 64 bits.
+    return _mm_or_si128(even, _mm_slli_epi64(odd, 32));
+}
+
+// SkMulDiv255Round() for each 16-bit lane.  c * a + 128 fits in 16 bits for c, a <= 255.
+inline __m128i mul_div_255_round(__m128i c, __m128i a) {
+    const __m128i prod = _mm_add_epi16(_mm_mullo_epi16(c, a), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(prod, _mm_srli_epi16(prod, 8)), 8);
+}
+
+inline __m128i filter4(const Matrix4& m, const SkPMColor src[4]) {
+    const SkUnPreMultiply::Scale* table = SkUnPreMultiply::GetScaleTable();
+    const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const __m128i scale = _mm_setr_epi32(table[SkGetPackedA32(src[0])],
+                                         table[SkGetPackedA32(src[1])],
+                                         table[SkGetPackedA32(src[2])],
+                                         table[SkGetPackedA32(src[3])]);
+    const __m128i r = unpremul(component(pixels, SK_R32_SHIFT), scale),
+                  g = unpremul(component(pixels, SK_G32_SHIFT), scale),
+                  b = unpremul(component(pixels, SK_B32_SHIFT), scale),
+                  a = component(pixels, SK_A32_SHIFT);
+
+    const __m128i rgIn = _mm_or_si128(r, _mm_slli_epi32(g, 16)),
+                  baIn = _mm_or_si128(b, _mm_slli_epi32(a, 16));
+
+    // Saturating to 16 and then 8 bits pins each channel to [0, 255], like pin() does.
+    const __m128i pinned = _mm_packus_epi16(_mm_packs_epi32(m.row(0, rgIn, baIn),
+                                                            m.row(1, rgIn, baIn)),
+                                            _mm_packs_epi32(m.row(2, rgIn, baIn),
+                                                            m.row(3, rgIn, baIn)));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rg = _mm_unpacklo_epi8(pinned, zero),    // r0..r3 g0..g3
+                  ba = _mm_unpackhi_epi8(pinned, zero),    // b0..b3 a0..a3
+                  aa = _mm_unpackhi_epi64(ba, ba);         // a0..a3 a0..a3
+
+    // SkPremultiplyARGBInline().
+    const __m128i rg2 = mul_div_255_round(rg, aa),
+                  ba2 = mul_div_255_round(ba, aa);
+    __m128i result = _mm_slli_epi32(_mm_unpackhi_epi16(ba, zero), SK_A32_SHIFT);
+    result = _mm_or_si128(result, _mm_slli_epi32(_mm_unpacklo_epi16(rg2, zero), SK_R32_SHIFT));
+    result = _mm_or_si128(result, _mm_slli_epi32(_mm_unpackhi_epi16(rg2, zero), SK_G32_SHIFT));
+    return _mm_or_si128(result, _mm_slli_epi32(_mm_unpacklo_epi16(ba2, zero), SK_B32_SHIFT));
+}
+
+}  // namespace
+
+void SkColorMatrixFilterSpan_SSE2(const int32_t matrix[20], int shift, const SkPMColor src[],
+                                  int count, SkPMColor dst[]) {
+    const Matrix4 m(matrix, shift);
+
+    while (count >= 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), filter4(m, src));
+        src += 4;
+        dst += 4;
+        count -= 4;
+    }
+
+    if (count > 0) {
+        SkPMColor tmp[4] = { 0, 0, 0, 0 };
+        memcpy(tmp, src, count * sizeof(SkPMColor));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(tmp), filter4(m, tmp));
+        memcpy(dst, tmp, count * sizeof(SkPMColor));
+    }
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkColorMatrix_opts_SSE2_DEFINED
+#define SkColorMatrix_opts_SSE2_DEFINED
+
+#include "SkColorMatrix_opts.h"
+
+void SkColorMatrixFilterSpan_SSE2(const int32_t matrix[20], int shift, const SkPMColor src[],
+                                  int count, SkPMColor dst[]);
+
+#endif
@@ -0,0 +1,22 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGeometry_opts_DEFINED
+#define SkGeometry_opts_DEFINED
+
+#include "SkPoint.h"
+
+typedef void (*SkQuadFlattenProc)(const SkPoint src[3], int count, SkPoint dst[]);
+typedef void (*SkCubicFlattenProc)(const SkPoint src[4], int count, SkPoint dst[]);
+
+// Do what SkQuadFlatten() and SkCubicFlatten() do, for counts large enough to be worth the call.
+// The points may differ from the portable code's by float rounding, but the first and last must
+// be exactly the curve's end points.
+SkQuadFlattenProc SkGeometryGetPlatformQuadFlattenProc();
+SkCubicFlattenProc SkGeometryGetPlatformCubicFlattenProc();
+
+#endif
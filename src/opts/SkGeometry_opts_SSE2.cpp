@@ -0,0 +1,86 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <emmintrin.h>
+#include "SkGeometry_opts_SSE2.h"
+
+// Each register holds two consecutive points, x0 y0 x1 y1, so the differences are taken over two
+// steps: every lane pair runs its own forward difference, one on the even points and one on the
+// odd ones, and each add moves both along.
+
+namespace {
+
+// The same vector in both halves.
+inline __m128 set_both(float x, float y) {
+    return _mm_setr_ps(x, y, x, y);
+}
+
+// Writes the first count points, P being the first two, advancing P by E, E by F and F by G.
+inline void step(__m128 P, __m128 E, __m128 F, const __m128 G, int count, SkPoint dst[]) {
+    int i = 0;
+    for (; i + 1 < count; i += 2) {
+        _mm_storeu_ps(&dst[i].fX, P);
+        P = _mm_add_ps(P, E);
+        E = _mm_add_ps(E, F);
+        F = _mm_add_ps(F, G);
+    }
+    if (i < count) {
+        _mm_storel_pi(reinterpret_cast<__m64*>(&dst[i]), P);
+    }
+}
+
+}  // namespace
+
+void SkQuadFlatten_SSE2(const SkPoint src[3], int count, SkPoint dst[]) {
+    SkASSERT(count > 0);
+
+    // With D and DD the one step differences, the two step ones are 2D + DD (from an even point)
+    // and 2D + 3DD (from an odd one), both growing by 4DD.
+    const float h = 1.0f / count;
+    const float ddx = 2 * h * h * (src[0].fX - 2 * src[1].fX + src[2].fX);
+    const float ddy = 2 * h * h * (src[0].fY - 2 * src[1].fY + src[2].fY);
+    const float dx = 2 * h * (src[1].fX - src[0].fX) + ddx / 2;
+    const float dy = 2 * h * (src[1].fY - src[0].fY) + ddy / 2;
+
+    step(_mm_setr_ps(src[0].fX, src[0].fY, src[0].fX + dx, src[0].fY + dy),
+         _mm_setr_ps(2 * dx + ddx, 2 * dy + ddy, 2 * dx + 3 * ddx, 2 * dy + 3 * ddy),
+         set_both(4 * ddx, 4 * ddy), _mm_setzero_ps(), count, dst);
+    dst[count] = src[2];
+}
+
+void SkCubicFlatten_SSE2(const SkPoint src[4], int count, SkPoint dst[]) {
+    SkASSERT(count > 0);
+
+    // P(t) = a t^3 + b t^2 + c t + src[0], whose one step differences at 0 are d1, d2 and d3.
+    const float h = 1.0f / count;
+    const float h2 = h * h;
+    const float h3 = h2 * h;
+    const float ax = src[3].fX - src[0].fX + 3 * (src[1].fX - src[2].fX);
+    const float ay = src[3].fY - src[0].fY + 3 * (src[1].fY - src[2].fY);
+    const float bx = 3 * (src[0].fX - 2 * src[1].fX + src[2].fX);
+    const float by = 3 * (src[0].fY - 2 * src[1].fY + src[2].fY);
+    const float cx = 3 * (src[1].fX - src[0].fX);
+    const float cy = 3 * (src[1].fY - src[0].fY);
+    const float d1x = ax * h3 + bx * h2 + cx * h;
+    const float d1y = ay * h3 + by * h2 + cy * h;
+    const float d3x = 6 * ax * h3;
+    const float d3y = 6 * ay * h3;
+    const float d2x = d3x + 2 * bx * h2;
+    const float d2y = d3y + 2 * by * h2;
+
+    // From one step differences d1 d2 d3 at a point, the two step ones there are 2d1 + d2,
+    // 4d2 + 4d3 and 8d3.  The odd points start one step along, at d1 + d2, d2 + d3 and d3.
+    const float o1x = d1x + d2x;
+    const float o1y = d1y + d2y;
+    const float o2x = d2x + d3x;
+    const float o2y = d2y + d3y;
+    step(_mm_setr_ps(src[0].fX, src[0].fY, src[0].fX + d1x, src[0].fY + d1y),
+         _mm_setr_ps(2 * d1x + d2x, 2 * d1y + d2y, 2 * o1x + o2x, 2 * o1y + o2y),
+         _mm_setr_ps(4 * (d2x + d3x), 4 * (d2y + d3y), 4 * (o2x + d3x), 4 * (o2y + d3y)),
+         set_both(8 * d3x, 8 * d3y), count, dst);
+    dst[count] = src[3];
+}
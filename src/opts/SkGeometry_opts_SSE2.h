@@ -0,0 +1,16 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGeometry_opts_SSE2_DEFINED
+#define SkGeometry_opts_SSE2_DEFINED
+
+#include "SkGeometry_opts.h"
+
+void SkQuadFlatten_SSE2(const SkPoint src[3], int count, SkPoint dst[]);
+void SkCubicFlatten_SSE2(const SkPoint src[4], int count, SkPoint dst[]);
+
+#endif
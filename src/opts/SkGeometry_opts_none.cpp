@@ -0,0 +1,16 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkGeometry_opts.h"
+
+SkQuadFlattenProc SkGeometryGetPlatformQuadFlattenProc() {
+    return NULL;
+}
+
+SkCubicFlattenProc SkGeometryGetPlatformCubicFlattenProc() {
+    return NULL;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGradient_opts_DEFINED
+#define SkGradient_opts_DEFINED
+
+#include "SkColor.h"
+#include "SkShader.h"
+
+// The colors of a two-stop gradient as floats in [0, 255], in a, r, g, b order.
+// The color at t is fColor0 + t * fDelta, premultiplied afterwards unless
+// fInterpInPremul is set (in which case fColor0 and fDelta are already premultiplied).
+struct SkGradientLerp {
+    float              fColor0[4];
+    float              fDelta[4];
+    bool               fInterpInPremul;
+    SkShader::TileMode fTileMode;
+};
+
+// What to add to each channel before truncating it for the pixel at device (x, y).
+// This is the 2x2 ordered dither that the gradient color tables are built with.
+static inline float SkGradientDitherBias(int x, int y) {
+    static const float gBias[2][2] = {
+        { 0.125f, 0.625f },
+        { 0.875f, 0.375f },
+    };
+    return gBias[y & 1][x & 1];
+}
+
+// Each of these tiles t by fTileMode and writes the color there to dst[i], for the count
+// pixels of a span starting at device (x, y).  They differ in how they find t for pixel i.
+struct SkGradientLerpProcs {
+    // t = t[i].  If that's NaN, the pixel isn't drawn and dst[i] is 0.
+    void (*fSpan)(const SkGradientLerp&, const float t[],
+                  int x, int y, SkPMColor dst[], int count);
+    // t = t0 + i * dt.
+    void (*fLinear)(const SkGradientLerp&, float t0, float dt,
+                    int x, int y, SkPMColor dst[], int count);
+    // t = the length of (px + i * dx, py + i * dy).
+    void (*fRadial)(const SkGradientLerp&, float px, float py, float dx, float dy,
+                    int x, int y, SkPMColor dst[], int count);
+};
+
+bool SkGradientGetPlatformLerpProcs(SkGradientLerpProcs* procs);
+
+// The portable procs, in SkGradientShader.cpp.  The platform procs draw the same pixels,
+// except that SSE2's fLinear steps opaque clamped spans in 16.16, and may be off by one there.
+void SkGradientGetPortableLerpProcs(SkGradientLerpProcs* procs);
+
+#endif
@@ -0,0 +1,331 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <emmintrin.h>
+#include "SkColorPriv.h"
+#include "SkFloatingPoint.h"
+#include "SkGradient_opts_SSE2.h"
+
+/* SSE2 versions of the two-stop gradient procs, 8 pixels per iteration.
+ * The portable versions are in src/effects/gradients/SkGradientShader.cpp.
+ */
+
+namespace {
+
+struct LerpConstants {
+    LerpConstants(const SkGradientLerp& lerp, int x, int y) {
+        for (int i = 0; i < 4; i++) {
+            fColor0[i] = _mm_set1_ps(lerp.fColor0[i]);
+            fDelta[i]  = _mm_set1_ps(lerp.fDelta[i]);
+        }
+        const float even = SkGradientDitherBias(x, y),
+                    odd  = SkGradientDitherBias(x + 1, y);
+        fBias = _mm_setr_ps(even, odd, even, odd);
+        fInterpInPremul = lerp.fInterpInPremul;
+    }
+
+    __m128 fColor0[4];
+    __m128 fDelta[4];
+    __m128 fBias;       // For pixels x, x+1, x+2, x+3, and so x+4n too.
+    bool   fInterpInPremul;
+};
+
+// Good for |v| < 2^31.  Leaves NaN as NaN.
+static inline __m128 floor_SSE2(__m128 v) {
+    const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+    return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, v), _mm_set1_ps(1.0f)));
+}
+
+template <SkShader::TileMode tileMode>
+static inline __m128 tile(__m128 t) {
+    switch (tileMode) {
+        case SkShader::kClamp_TileMode:
+            return _mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        case SkShader::kRepeat_TileMode:
+            return _mm_sub_ps(t, floor_SSE2(t));
+        default: {  // kMirror_TileMode
+            // f = t mod 2, then fold [1, 2) back onto (0, 1].
+            const __m128 floorHalf = floor_SSE2(_mm_mul_ps(t, _mm_set1_ps(0.5f)));
+            const __m128 f = _mm_sub_ps(t, _mm_add_ps(floorHalf, floorHalf));
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+            return _mm_sub_ps(_mm_set1_ps(1.0f),
+                              _mm_and_ps(_mm_sub_ps(f, _mm_set1_ps(1.0f)), absMask));
+        }
+    }
+}
+
+// Shades the 4 pixels at t (not yet tiled) into dst, which need not be aligned.
+// If opaque, alpha is always 255, so we can skip premultiplying and keeping colors under alpha.
+template <SkShader::TileMode tileMode, bool opaque, typename T>
+static inline void shade4(const LerpConstants& k, __m128 t, SkPMColor* dst) {
+    // False for NaN, which means don't draw.
+    const __m128 draw = _mm_cmpeq_ps(t, t);
+    t = tile<tileMode>(t);
+
+    __m128 cr = _mm_add_ps(k.fColor0[1], _mm_mul_ps(t, k.fDelta[1])),
+           cg = _mm_add_ps(k.fColor0[2], _mm_mul_ps(t, k.fDelta[2])),
+           cb = _mm_add_ps(k.fColor0[3], _mm_mul_ps(t, k.fDelta[3]));
+    __m128i a, r, g, b;
+    if (opaque) {
+        a = _mm_set1_epi32(0xFF);
+        r = _mm_cvttps_epi32(_mm_add_ps(cr, k.fBias));
+        g = _mm_cvttps_epi32(_mm_add_ps(cg, k.fBias));
+        b = _mm_cvttps_epi32(_mm_add_ps(cb, k.fBias));
+    } else {
+        const __m128 ca = _mm_add_ps(k.fColor0[0], _mm_mul_ps(t, k.fDelta[0]));
+        if (!k.fInterpInPremul) {
+            const __m128 scale = _mm_mul_ps(ca, _mm_set1_ps(1.0f / 255));
+            cr = _mm_mul_ps(cr, scale);
+            cg = _mm_mul_ps(cg, scale);
+            cb = _mm_mul_ps(cb, scale);
+        }
+        // Keep each color channel from dithering past alpha, so the result is a valid SkPMColor.
+        a = _mm_cvttps_epi32(_mm_add_ps(ca, k.fBias));
+        const __m128 maxColor = _mm_add_ps(_mm_cvtepi32_ps(a), _mm_set1_ps(0.5f));
+        r = _mm_cvttps_epi32(_mm_min_ps(_mm_add_ps(cr, k.fBias), maxColor));
+        g = _mm_cvttps_epi32(_mm_min_ps(_mm_add_ps(cg, k.fBias), maxColor));
+        b = _mm_cvttps_epi32(_mm_min_ps(_mm_add_ps(cb, k.fBias), maxColor));
+    }
+
+    __m128i pixels = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(a, SK_A32_SHIFT),
+                                               _mm_slli_epi32(r, SK_R32_SHIFT)),
+                                  _mm_or_si128(_mm_slli_epi32(g, SK_G32_SHIFT),
+                                               _mm_slli_epi32(b, SK_B32_SHIFT)));
+    if (T::kMayBeNaN) {
+        pixels = _mm_and_si128(pixels, _mm_castps_si128(draw));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), pixels);
+}
+
+// Each of these finds t for pixels i, i+1, i+2, i+3 of the span.
+// tail() is used instead of at() when fewer than 4 pixels remain.
+
+class SpanT {
+public:
+    static const bool kMayBeNaN = true;
+
+    explicit SpanT(const float t[]) : fT(t) {}
+
+    __m128 at(int i) const { return _mm_loadu_ps(fT + i); }
+    __m128 tail(int i, int n) const {
+        float t[4] = { SK_FloatNaN, SK_FloatNaN, SK_FloatNaN, SK_FloatNaN };
+        memcpy(t, fT + i, n * sizeof(float));
+        return _mm_loadu_ps(t);
+    }
+
+private:
+    const float* fT;
+};
+
+static inline __m128 lane_steps(int i) {
+    return _mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(i), _mm_setr_epi32(0, 1, 2, 3)));
+}
+
+class LinearT {
+public:
+    static const bool kMayBeNaN = false;
+
+    LinearT(float t0, float dt) : fT0(_mm_set1_ps(t0)), fDT(_mm_set1_ps(dt)) {}
+
+    __m128 at(int i) const { return _mm_add_ps(fT0, _mm_mul_ps(lane_steps(i), fDT)); }
+    __m128 tail(int i, int) const { return this->at(i); }
+
+private:
+    const __m128 fT0, fDT;
+};
+
+class RadialT {
+public:
+    static const bool kMayBeNaN = false;
+
+    RadialT(float px, float py, float dx, float dy)
+        : fPX(_mm_set1_ps(px)), fPY(_mm_set1_ps(py))
+        , fDX(_mm_set1_ps(dx)), fDY(_mm_set1_ps(dy)) {}
+
+    __m128 at(int i) const {
+        const __m128 steps = lane_steps(i);
+        const __m128 x = _mm_add_ps(fPX, _mm_mul_ps(steps, fDX)),
+                     y = _mm_add_ps(fPY, _mm_mul_ps(steps, fDY));
+        return _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)));
+    }
+    __m128 tail(int i, int) const { return this->at(i); }
+
+private:
+    const __m128 fPX, fPY, fDX, fDY;
+};
+
+template <SkShader::TileMode tileMode, bool opaque, typename T>
+static void shade(const SkGradientLerp& lerp, const T& t, int x, int y,
+                  SkPMColor dst[], int count) {
+    const LerpConstants k(lerp, x, y);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        shade4<tileMode, opaque, T>(k, t.at(i + 0), dst + i + 0);
+        shade4<tileMode, opaque, T>(k, t.at(i + 4), dst + i + 4);
+    }
+    for (; i < count; i += 4) {
+        const int n = SkTMin(count - i, 4);
+        SkPMColor pixels[4];
+        shade4<tileMode, opaque, T>(k, t.tail(i, n), pixels);
+        memcpy(dst + i, pixels, n * sizeof(SkPMColor));
+    }
+}
+
+static inline bool is_opaque(const SkGradientLerp& lerp) {
+    return 255 == lerp.fColor0[0] && 0 == lerp.fDelta[0];
+}
+
+template <bool opaque, typename T>
+static void shade(const SkGradientLerp& lerp, const T& t, int x, int y,
+                  SkPMColor dst[], int count) {
+    switch (lerp.fTileMode) {
+        case SkShader::kClamp_TileMode:
+            shade<SkShader::kClamp_TileMode, opaque>(lerp, t, x, y, dst, count);
+            break;
+        case SkShader::kRepeat_TileMode:
+            shade<SkShader::kRepeat_TileMode, opaque>(lerp, t, x, y, dst, count);
+            break;
+        default:
+            shade<SkShader::kMirror_TileMode, opaque>(lerp, t, x, y, dst, count);
+            break;
+    }
+}
+
+template <typename T>
+static void shade(const SkGradientLerp& lerp, const T& t, int x, int y,
+                  SkPMColor dst[], int count) {
+    if (is_opaque(lerp)) {
+        shade<true>(lerp, t, x, y, dst, count);
+    } else {
+        shade<false>(lerp, t, x, y, dst, count);
+    }
+}
+
+// When the gradient is opaque, the color is linear in t, and a linear gradient's t is linear
+// in i, so we can step each pixel's channels along in 16.16 fixed point with integer adds.
+// Clamped pixels are just the end colors, dithered.
+//
+// This is the one proc that doesn't match the portable one exactly: the fixed point steps
+// don't round like t0 + i * dt does in floats, so a channel can be off by one.
+class OpaqueClampRamp {
+public:
+    static bool Applies(const SkGradientLerp& lerp) {
+        return SkShader::kClamp_TileMode == lerp.fTileMode && is_opaque(lerp);
+    }
+
+    OpaqueClampRamp(const SkGradientLerp& lerp, float t0, float dt, int x, int y)
+        : fLerp(lerp), fK(lerp, x, y), fT0(t0), fDT(dt), fX(x), fY(y) {}
+
+    void shade(SkPMColor dst[], int count) const {
+        if (0 == fDT) {
+            this->fill(fT0, dst, 0, count);
+            return;
+        }
+        // t is before the start of the ramp for [0, begin), and past its end for [end, count).
+        const float startT = fDT > 0 ? 0.0f : 1.0f,
+                    endT   = 1 - startT;
+        const int begin = this->firstIndexAt(startT, count),
+                  end   = this->firstIndexAt(endT, count);
+        this->fill(startT, dst, 0, begin);
+        this->ramp(dst, begin, end);
+        this->fill(endT, dst, end, count);
+    }
+
+private:
+    // The first index in [0, count] whose t has reached edge.  This needn't be exact:
+    // ramp() saturates any channel that steps a little out of range.
+    int firstIndexAt(float edge, int count) const {
+        const float i = sk_float_ceil((edge - fT0) / fDT);
+        if (!(i > 0)) {     // Also catches NaN.
+            return 0;
+        }
+        return i >= count ? count : (int)i;
+    }
+
+    void fill(float t, SkPMColor dst[], int begin, int end) const {
+        SkPMColor colors[4];
+        shade4<SkShader::kClamp_TileMode, true, LinearT>(fK, _mm_set1_ps(t), colors);
+        for (int i = begin; i < end; i++) {
+            dst[i] = colors[i & 1];
+        }
+    }
+
+    void ramp(SkPMColor dst[], int begin, int end) const {
+        if (begin >= end) {
+            return;
+        }
+        // Lane k of each accumulator holds the channel at bit 8k of an SkPMColor, so
+        // packing them down to bytes gives us SkPMColors.
+        static const int kLane[4] = {
+            SK_A32_SHIFT / 8, SK_R32_SHIFT / 8, SK_G32_SHIFT / 8, SK_B32_SHIFT / 8,
+        };
+        int32_t start[4][4], step[4];
+        for (int c = 0; c < 4; c++) {
+            const int lane = kLane[c];
+            for (int j = 0; j < 4; j++) {
+                const int i = begin + j;
+                const float value = fLerp.fColor0[c] + (fT0 + i * fDT) * fLerp.fDelta[c] +
+                                    SkGradientDitherBias(fX + i, fY);
+                start[j][lane] = (int32_t)(value * 65536);
+            }
+            // Rounded, so the error can't build up in one direction along a long span.
+            step[lane] = (int32_t)sk_float_floor(4 * fDT * fLerp.fDelta[c] * 65536 + 0.5f);
+        }
+        const __m128i stepv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(step));
+        __m128i acc0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(start[0])),
+                acc1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(start[1])),
+                acc2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(start[2])),
+                acc3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(start[3]));
+
+        int i = begin;
+        for (; i + 4 <= end; i += 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), pack4(acc0, acc1, acc2, acc3));
+            acc0 = _mm_add_epi32(acc0, stepv);
+            acc1 = _mm_add_epi32(acc1, stepv);
+            acc2 = _mm_add_epi32(acc2, stepv);
+            acc3 = _mm_add_epi32(acc3, stepv);
+        }
+        if (i < end) {
+            SkPMColor pixels[4];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), pack4(acc0, acc1, acc2, acc3));
+            memcpy(dst + i, pixels, (end - i) * sizeof(SkPMColor));
+        }
+    }
+
+    // Packs the 16.16 channels of 4 pixels down to 4 SkPMColors, saturating.
+    static inline __m128i pack4(__m128i p0, __m128i p1, __m128i p2, __m128i p3) {
+        return _mm_packus_epi16(
+                _mm_packs_epi32(_mm_srai_epi32(p0, 16), _mm_srai_epi32(p1, 16)),
+                _mm_packs_epi32(_mm_srai_epi32(p2, 16), _mm_srai_epi32(p3, 16)));
+    }
+
+    const SkGradientLerp& fLerp;
+    const LerpConstants   fK;
+    const float           fT0, fDT;
+    const int             fX, fY;
+};
+
+}  // namespace
+
+void SkGradientLerpSpan_SSE2(const SkGradientLerp& lerp, const float t[],
+                             int x, int y, SkPMColor dst[], int count) {
+    shade(lerp, SpanT(t), x, y, dst, count);
+}
+
+void SkGradientLerpLinear_SSE2(const SkGradientLerp& lerp, float t0, float dt,
+                               int x, int y, SkPMColor dst[], int count) {
+    if (OpaqueClampRamp::Applies(lerp)) {
+        OpaqueClampRamp(lerp, t0, dt, x, y).shade(dst, count);
+    } else {
+        shade(lerp, LinearT(t0, dt), x, y, dst, count);
+    }
+}
+
+void SkGradientLerpRadial_SSE2(const SkGradientLerp& lerp, float px, float py,
+                               float dx, float dy, int x, int y, SkPMColor dst[], int count) {
+    shade(lerp, RadialT(px, py, dx, dy), x, y, dst, count);
+}
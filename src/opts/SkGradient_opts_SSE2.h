@@ -0,0 +1,20 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGradient_opts_SSE2_DEFINED
+#define SkGradient_opts_SSE2_DEFINED
+
+#include "SkGradient_opts.h"
+
+void SkGradientLerpSpan_SSE2(const SkGradientLerp& lerp, const float t[],
+                             int x, int y, SkPMColor dst[], int count);
+void SkGradientLerpLinear_SSE2(const SkGradientLerp& lerp, float t0, float dt,
+                               int x, int y, SkPMColor dst[], int count);
+void SkGradientLerpRadial_SSE2(const SkGradientLerp& lerp, float px, float py,
+                               float dx, float dy, int x, int y, SkPMColor dst[], int count);
+
+#endif
@@ -0,0 +1,30 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkLighting_opts_DEFINED
+#define SkLighting_opts_DEFINED
+
+#include "SkColor.h"
+
+// Row procs for the interior of SkLightingImageFilter.  Each writes count unit vectors, one per
+// pixel, as separate x, y and z arrays, computed exactly as the portable code in
+// SkLightingImageFilter.cpp does, so either may be used for any pixel.
+struct SkLightingProcs {
+    // The surface normals from the Sobel filter of the alpha of pixels middle[0..count) and
+    // their eight neighbours.  top and bottom are the rows above and below middle, and the
+    // pixels just before and after each row must be readable.
+    void (*fNormals)(const SkPMColor* top, const SkPMColor* middle, const SkPMColor* bottom,
+                     int count, float surfaceScale, float nx[], float ny[], float nz[]);
+    // The directions to a light at location from the pixels row[0..count), which sit at
+    // (x + i, y) and are raised by surfaceScale times their alpha.
+    void (*fSurfaceToLight)(const float location[3], int x, int y, const SkPMColor* row,
+                            int count, float surfaceScale, float lx[], float ly[], float lz[]);
+};
+
+bool SkLightingGetPlatformProcs(SkLightingProcs* procs);
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <emmintrin.h>
+#include <math.h>
+#include "SkLighting_opts_SSE2.h"
+#include "SkColorPriv.h"
+#include "SkScalar.h"
+
+// The vector math here is done in the same order as SkPoint3::normalize() and friends, and every
+// step (including sqrt and the division) is exactly rounded in both, so the results match the
+// portable code bit for bit.
+
+namespace {
+
+inline int alpha(SkPMColor c) {
+    return SkGetPackedA32(c);
+}
+
+inline __m128i alpha4(const SkPMColor* p) {
+    __m128i a = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)),
+                               SK_A32_SHIFT);
+    return _mm_and_si128(a, _mm_set1_epi32(0xFF));
+}
+
+inline void normalize(float* x, float* y, float* z) {
+    float scale = 1.0f / (sqrtf(*x * *x + *y * *y + *z * *z) + SK_ScalarNearlyZero);
+    *x = *x * scale;
+    *y = *y * scale;
+    *z = *z * scale;
+}
+
+inline void normalize4(__m128* x, __m128* y, __m128* z) {
+    __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(*x, *x), _mm_mul_ps(*y, *y)),
+                            _mm_mul_ps(*z, *z));
+    __m128 scale = _mm_div_ps(_mm_set1_ps(1.0f),
+                              _mm_add_ps(_mm_sqrt_ps(dot), _mm_set1_ps(SK_ScalarNearlyZero)));
+    *x = _mm_mul_ps(*x, scale);
+    *y = _mm_mul_ps(*y, scale);
+    *z = _mm_mul_ps(*z, scale);
+}
+
+}  // namespace
+
+void SkLightingNormals_SSE2(const SkPMColor* top, const SkPMColor* middle,
+                            const SkPMColor* bottom, int count, float surfaceScale,
+                            float nx[], float ny[], float nz[]) {
+    const __m128 quarter = _mm_set1_ps(0.25f);
+    const __m128 scale = _mm_set1_ps(surfaceScale);
+    const __m128 sign = _mm_set1_ps(-0.0f);  // To negate, keeping the sign of 0 like -x does.
+    const __m128 one = _mm_set1_ps(1.0f);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i t0 = alpha4(top + i - 1),    t1 = alpha4(top + i),    t2 = alpha4(top + i + 1);
+        __m128i m0 = alpha4(middle + i - 1),                          m2 = alpha4(middle + i + 1);
+        __m128i b0 = alpha4(bottom + i - 1), b1 = alpha4(bottom + i), b2 = alpha4(bottom + i + 1);
+
+        // -t0 + t2 - 2 * m0 + 2 * m2 - b0 + b2
+        __m128i sx = _mm_sub_epi32(t2, t0);
+        sx = _mm_add_epi32(sx, _mm_slli_epi32(_mm_sub_epi32(m2, m0), 1));
+        sx = _mm_add_epi32(sx, _mm_sub_epi32(b2, b0));
+        // -t0 + b0 - 2 * t1 + 2 * b1 - t2 + b2
+        __m128i sy = _mm_sub_epi32(b0, t0);
+        sy = _mm_add_epi32(sy, _mm_slli_epi32(_mm_sub_epi32(b1, t1), 1));
+        sy = _mm_add_epi32(sy, _mm_sub_epi32(b2, t2));
+
+        __m128 x = _mm_mul_ps(_mm_xor_ps(_mm_mul_ps(_mm_cvtepi32_ps(sx), quarter), sign),
+                              scale);
+        __m128 y = _mm_mul_ps(_mm_xor_ps(_mm_mul_ps(_mm_cvtepi32_ps(sy), quarter), sign),
+                              scale);
+        __m128 z = one;
+        normalize4(&x, &y, &z);
+        _mm_storeu_ps(nx + i, x);
+        _mm_storeu_ps(ny + i, y);
+        _mm_storeu_ps(nz + i, z);
+    }
+    for (; i < count; ++i) {
+        int sx = -alpha(top[i - 1]) + alpha(top[i + 1])
+                 - 2 * alpha(middle[i - 1]) + 2 * alpha(middle[i + 1])
+                 - alpha(bottom[i - 1]) + alpha(bottom[i + 1]);
+        int sy = -alpha(top[i - 1]) + alpha(bottom[i - 1])
+                 - 2 * alpha(top[i]) + 2 * alpha(bottom[i])
+                 - alpha(top[i + 1]) + alpha(bottom[i + 1]);
+        float x = -(sx * 0.25f) * surfaceScale;
+        float y = -(sy * 0.25f) * surfaceScale;
+        float z = 1.0f;
+        normalize(&x, &y, &z);
+        nx[i] = x;
+        ny[i] = y;
+        nz[i] = z;
+    }
+}
+
+void SkLightingSurfaceToLight_SSE2(const float location[3], int x, int y, const SkPMColor* row,
+                                   int count, float surfaceScale,
+                                   float lx[], float ly[], float lz[]) {
+    const __m128 locX = _mm_set1_ps(location[0]);
+    const __m128 dy = _mm_set1_ps(location[1] - y);
+    const __m128 locZ = _mm_set1_ps(location[2]);
+    const __m128 scale = _mm_set1_ps(surfaceScale);
+    __m128 px = _mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(x), _mm_setr_epi32(0, 1, 2, 3)));
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 vx = _mm_sub_ps(locX, px);
+        __m128 vy = dy;
+        __m128 vz = _mm_sub_ps(locZ, _mm_mul_ps(_mm_cvtepi32_ps(alpha4(row + i)), scale));
+        normalize4(&vx, &vy, &vz);
+        _mm_storeu_ps(lx + i, vx);
+        _mm_storeu_ps(ly + i, vy);
+        _mm_storeu_ps(lz + i, vz);
+        px = _mm_add_ps(px, _mm_set1_ps(4.0f));
+    }
+    for (; i < count; ++i) {
+        float vx = location[0] - (x + i);
+        float vy = location[1] - y;
+        float vz = location[2] - alpha(row[i]) * surfaceScale;
+        normalize(&vx, &vy, &vz);
+        lx[i] = vx;
+        ly[i] = vy;
+        lz[i] = vz;
+    }
+}
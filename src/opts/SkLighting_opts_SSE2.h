@@ -0,0 +1,21 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkLighting_opts_SSE2_DEFINED
+#define SkLighting_opts_SSE2_DEFINED
+
+#include "SkColor.h"
+
+void SkLightingNormals_SSE2(const SkPMColor* top, const SkPMColor* middle,
+                            const SkPMColor* bottom, int count, float surfaceScale,
+                            float nx[], float ny[], float nz[]);
+
+void SkLightingSurfaceToLight_SSE2(const float location[3], int x, int y, const SkPMColor* row,
+                                   int count, float surfaceScale,
+                                   float lx[], float ly[], float lz[]);
+
+#endif
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMatrixConvolution_opts_DEFINED
+#define SkMatrixConvolution_opts_DEFINED
+
+#include "SkColor.h"
+
+struct SkMatrixConvolutionKernel {
+    const float* fKernel;   // fWidth * fHeight weights, in row order.
+    int          fWidth;
+    int          fHeight;
+    float        fGain;
+    float        fBias;
+};
+
+// Convolves width x height pixels that need no tiling.  src points at the first kernel tap of
+// dst[0], i.e. already offset by the kernel offset, and every tap must be inside the source.
+// If convolveAlpha is false, only the color channels are convolved, and they are premultiplied
+// by the alpha of alphaSrc, which lines up with dst.
+typedef void (*SkMatrixConvolutionProc)(const SkMatrixConvolutionKernel& kernel,
+                                        bool convolveAlpha,
+                                        const SkPMColor* src, const SkPMColor* alphaSrc,
+                                        int srcStride, SkPMColor* dst, int dstStride,
+                                        int width, int height);
+
+SkMatrixConvolutionProc SkMatrixConvolutionGetPlatformProc();
+
+#endif
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <emmintrin.h>
+#include "SkMatrixConvolution_opts_SSE2.h"
+#include "SkColorPriv.h"
+
+namespace {
+
+// Lane of the alpha channel once a pixel's bytes are widened in memory order.
+static const int kA = SK_A32_SHIFT / 8;
+
+inline __m128 load_pixel(const SkPMColor* p) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i v = _mm_cvtsi32_si128(*p);
+    v = _mm_unpacklo_epi8(v, zero);
+    v = _mm_unpacklo_epi16(v, zero);
+    return _mm_cvtepi32_ps(v);
+}
+
+// All four channels of one output pixel, in the same tap order as the portable code, so the
+// float sums (and so the results) are identical.
+inline __m128 convolve(const SkMatrixConvolutionKernel& kernel, const SkPMColor* src,
+                       int srcStride) {
+    const float* k = kernel.fKernel;
+    __m128 sum = _mm_setzero_ps();
+    for (int cy = 0; cy < kernel.fHeight; ++cy) {
+        for (int cx = 0; cx < kernel.fWidth; ++cx) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(load_pixel(src + cx), _mm_set1_ps(*k++)));
+        }
+        src += srcStride;
+    }
+    return sum;
+}
+
+}  // namespace
+
+void SkMatrixConvolve_SSE2(const SkMatrixConvolutionKernel& kernel, bool convolveAlpha,
+                           const SkPMColor* src, const SkPMColor* alphaSrc, int srcStride,
+                           SkPMColor* dst, int dstStride, int width, int height) {
+    const __m128 gain = _mm_set1_ps(kernel.fGain);
+    const __m128 bias = _mm_set1_ps(kernel.fBias);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 max = _mm_set1_ps(255.0f);
+    // Without convolveAlpha the color channels are clamped to 255 instead of to alpha.
+    const __m128 alphaLane = _mm_castsi128_ps(_mm_slli_si128(_mm_cvtsi32_si128(-1), 4 * kA));
+    const __m128 forceOpaque = convolveAlpha ? zero : alphaLane;
+    const SkPMColor colorMask = ~(SK_A32_MASK << SK_A32_SHIFT);
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            __m128 v = _mm_add_ps(_mm_mul_ps(convolve(kernel, src + x, srcStride), gain), bias);
+            // Clamping before flooring is the same as flooring then clamping, and since the
+            // value is then non-negative, truncation is floor.  _mm_max_ps maps NaN to 0.
+            v = _mm_min_ps(_mm_max_ps(v, zero), max);
+            v = _mm_or_ps(_mm_andnot_ps(forceOpaque, v), _mm_and_ps(forceOpaque, max));
+            v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(kA, kA, kA, kA)));
+
+            __m128i c = _mm_packs_epi32(_mm_cvttps_epi32(v), _mm_setzero_si128());
+            if (!convolveAlpha) {
+                // SkMulDiv255Round on each channel, which can't overflow 16 bits.
+                const unsigned a = SkGetPackedA32(alphaSrc[x]);
+                __m128i t = _mm_add_epi16(_mm_mullo_epi16(c, _mm_set1_epi16(a)),
+                                          _mm_set1_epi16(128));
+                c = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+                const SkPMColor pm = _mm_cvtsi128_si32(_mm_packus_epi16(c, c));
+                dst[x] = (pm & colorMask) | (a << SK_A32_SHIFT);
+            } else {
+                dst[x] = _mm_cvtsi128_si32(_mm_packus_epi16(c, c));
+            }
+        }
+        src += srcStride;
+        alphaSrc += srcStride;
+        dst += dstStride;
+    }
+}
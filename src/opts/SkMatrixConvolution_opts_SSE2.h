@@ -0,0 +1,17 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMatrixConvolution_opts_SSE2_DEFINED
+#define SkMatrixConvolution_opts_SSE2_DEFINED
+
+#include "SkMatrixConvolution_opts.h"
+
+void SkMatrixConvolve_SSE2(const SkMatrixConvolutionKernel& kernel, bool convolveAlpha,
+                           const SkPMColor* src, const SkPMColor* alphaSrc, int srcStride,
+                           SkPMColor* dst, int dstStride, int width, int height);
+
+#endif
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMatrix_opts_DEFINED
+#define SkMatrix_opts_DEFINED
+
+#include "SkMatrix.h"
+
+// In a few places, we performed the following
+//      a * b + c * d + e
+// as
+//      a * b + (c * d + e)
+//
+// sdot and scross are indended to capture these compound operations into a
+// function, with an eye toward considering upscaling the intermediates to
+// doubles for more precision (as we do in concat and invert).
+//
+// However, these few lines that performed the last add before the "dot", cause
+// tiny image differences, so we guard that change until we see the impact on
+// chrome's layouttests.
+//
+// This lives here so that the platform procs below round exactly as SkMatrix.cpp does.
+//
+#define SK_LEGACY_MATRIX_MATH_ORDER
+
+// Maps count points by any matrix, as its MapPtsProc would, for batches big enough to be worth
+// the call.  The results must be exactly those of the portable procs in SkMatrix.cpp (though
+// which NaN comes out of a NaN input may differ).
+// As with SkMatrix::mapPoints(), dst and src may be the same, but must not partially overlap.
+SkMatrix::MapPtsProc SkMatrixGetPlatformMapPtsProc();
+
+#endif
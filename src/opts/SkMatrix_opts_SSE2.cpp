@@ -0,0 +1,187 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <emmintrin.h>
+#include "SkMatrix_opts_SSE2.h"
+
+namespace {
+
+// Each register holds two points, as x0 y0 x1 y1.  Every product and sum is done in the same
+// order as the portable procs in SkMatrix.cpp, so the results are identical.
+
+inline __m128 load_one(const SkPoint* p) {
+    return _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p));
+}
+
+inline void store_one(SkPoint* p, __m128 v) {
+    _mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+}
+
+// x0 x0 x1 x1 and y0 y0 y1 y1, to multiply by a column of the matrix.
+inline __m128 splat_x(__m128 p) {
+    return _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+}
+
+inline __m128 splat_y(__m128 p) {
+    return _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+}
+
+inline __m128 set_pair(SkScalar x, SkScalar y) {
+    return _mm_setr_ps(x, y, x, y);
+}
+
+struct Trans {
+    explicit Trans(const SkMatrix& m)
+        : fTrans(set_pair(m[SkMatrix::kMTransX], m[SkMatrix::kMTransY])) {}
+
+    __m128 operator()(__m128 p) const {
+        return _mm_add_ps(p, fTrans);
+    }
+
+    __m128 fTrans;
+};
+
+struct Scale {
+    explicit Scale(const SkMatrix& m)
+        : fScale(set_pair(m[SkMatrix::kMScaleX], m[SkMatrix::kMScaleY])) {}
+
+    __m128 operator()(__m128 p) const {
+        return _mm_mul_ps(p, fScale);
+    }
+
+    __m128 fScale;
+};
+
+struct ScaleTrans {
+    explicit ScaleTrans(const SkMatrix& m)
+        : fScale(set_pair(m[SkMatrix::kMScaleX], m[SkMatrix::kMScaleY]))
+        , fTrans(set_pair(m[SkMatrix::kMTransX], m[SkMatrix::kMTransY])) {}
+
+    __m128 operator()(__m128 p) const {
+        return _mm_add_ps(_mm_mul_ps(p, fScale), fTrans);
+    }
+
+    __m128 fScale;
+    __m128 fTrans;
+};
+
+struct Rot {
+    explicit Rot(const SkMatrix& m)
+        : fColX(set_pair(m[SkMatrix::kMScaleX], m[SkMatrix::kMSkewY]))
+        , fColY(set_pair(m[SkMatrix::kMSkewX], m[SkMatrix::kMScaleY])) {}
+
+    __m128 operator()(__m128 p) const {
+        return _mm_add_ps(_mm_mul_ps(splat_x(p), fColX), _mm_mul_ps(splat_y(p), fColY));
+    }
+
+    __m128 fColX;
+    __m128 fColY;
+};
+
+struct RotTrans {
+    explicit RotTrans(const SkMatrix& m)
+        : fColX(set_pair(m[SkMatrix::kMScaleX], m[SkMatrix::kMSkewY]))
+        , fColY(set_pair(m[SkMatrix::kMSkewX], m[SkMatrix::kMScaleY]))
+        , fTrans(set_pair(m[SkMatrix::kMTransX], m[SkMatrix::kMTransY])) {}
+
+    __m128 operator()(__m128 p) const {
+        const __m128 x = _mm_mul_ps(splat_x(p), fColX);
+        const __m128 y = _mm_mul_ps(splat_y(p), fColY);
+#ifdef SK_LEGACY_MATRIX_MATH_ORDER
+        return _mm_add_ps(x, _mm_add_ps(y, fTrans));
+#else
+        return _mm_add_ps(_mm_add_ps(x, y), fTrans);
+#endif
+    }
+
+    __m128 fColX;
+    __m128 fColY;
+    __m128 fTrans;
+};
+
+struct Persp {
+    explicit Persp(const SkMatrix& m)
+        : fColX(set_pair(m[SkMatrix::kMScaleX], m[SkMatrix::kMSkewY]))
+        , fColY(set_pair(m[SkMatrix::kMSkewX], m[SkMatrix::kMScaleY]))
+        , fTrans(set_pair(m[SkMatrix::kMTransX], m[SkMatrix::kMTransY]))
+        , fPersp0(_mm_set1_ps(m[SkMatrix::kMPersp0]))
+        , fPersp1(_mm_set1_ps(m[SkMatrix::kMPersp1]))
+        , fPersp2(_mm_set1_ps(m[SkMatrix::kMPersp2])) {}
+
+    __m128 operator()(__m128 p) const {
+        const __m128 x = splat_x(p);
+        const __m128 y = splat_y(p);
+        const __m128 xy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, fColX), _mm_mul_ps(y, fColY)),
+                                     fTrans);
+#ifdef SK_LEGACY_MATRIX_MATH_ORDER
+        __m128 z = _mm_add_ps(_mm_mul_ps(x, fPersp0), _mm_add_ps(_mm_mul_ps(y, fPersp1), fPersp2));
+#else
+        __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, fPersp0), _mm_mul_ps(y, fPersp1)), fPersp2);
+#endif
+        // z = 1 / z, unless z is zero, in which case it's left alone.
+        const __m128 nonZero = _mm_cmpneq_ps(z, _mm_setzero_ps());
+        z = _mm_or_ps(_mm_and_ps(nonZero, _mm_div_ps(_mm_set1_ps(1), z)),
+                      _mm_andnot_ps(nonZero, z));
+        return _mm_mul_ps(xy, z);
+    }
+
+    __m128 fColX;
+    __m128 fColY;
+    __m128 fTrans;
+    __m128 fPersp0;
+    __m128 fPersp1;
+    __m128 fPersp2;
+};
+
+// Four points per iteration, then whatever is left.  Each pair is loaded before either is
+// stored, so dst may be src.
+template <typename Map>
+void map_points(const Map& map, SkPoint dst[], const SkPoint src[], int count) {
+    for (; count >= 4; count -= 4) {
+        const __m128 p01 = _mm_loadu_ps(&src[0].fX);
+        const __m128 p23 = _mm_loadu_ps(&src[2].fX);
+        _mm_storeu_ps(&dst[0].fX, map(p01));
+        _mm_storeu_ps(&dst[2].fX, map(p23));
+        src += 4;
+        dst += 4;
+    }
+    if (count >= 2) {
+        _mm_storeu_ps(&dst[0].fX, map(_mm_loadu_ps(&src[0].fX)));
+        src += 2;
+        dst += 2;
+        count -= 2;
+    }
+    if (count) {
+        store_one(dst, map(load_one(src)));
+    }
+}
+
+}  // namespace
+
+void SkMatrixMapPoints_SSE2(const SkMatrix& m, SkPoint dst[], const SkPoint src[], int count) {
+    // Pick the proc the same way SkMatrix::GetMapPtsProc() does.
+    const unsigned mask = m.getType();
+    if (mask & SkMatrix::kPerspective_Mask) {
+        map_points(Persp(m), dst, src, count);
+    } else if (mask & SkMatrix::kAffine_Mask) {
+        if (mask & SkMatrix::kTranslate_Mask) {
+            map_points(RotTrans(m), dst, src, count);
+        } else {
+            map_points(Rot(m), dst, src, count);
+        }
+    } else if (mask & SkMatrix::kScale_Mask) {
+        if (mask & SkMatrix::kTranslate_Mask) {
+            map_points(ScaleTrans(m), dst, src, count);
+        } else {
+            map_points(Scale(m), dst, src, count);
+        }
+    } else if (mask & SkMatrix::kTranslate_Mask) {
+        map_points(Trans(m), dst, src, count);
+    } else if (dst != src && count > 0) {
+        memcpy(dst, src, count * sizeof(SkPoint));
+    }
+}
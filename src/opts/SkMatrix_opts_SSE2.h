@@ -0,0 +1,15 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMatrix_opts_SSE2_DEFINED
+#define SkMatrix_opts_SSE2_DEFINED
+
+#include "SkMatrix_opts.h"
+
+void SkMatrixMapPoints_SSE2(const SkMatrix& m, SkPoint dst[], const SkPoint src[], int count);
+
+#endif
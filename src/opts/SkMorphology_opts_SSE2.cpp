@@ -8,9 +8,18 @@
 #include <emmintrin.h>
 #include "SkColorPriv.h"
 #include "SkMorphology_opts_SSE2.h"
+#include "SkTemplates.h"
 
 /* SSE2 version of dilateX, dilateY, erodeX, erodeY.
  * portable versions are in src/effects/SkMorphologyImageFilter.cpp.
+ *
+ * These use the van Herk/Gil-Werman algorithm, so the cost per pixel doesn't
+ * grow with the radius.  Each line is split into blocks of 2 * radius + 1
+ * pixels, and we find the running max (or min) from the start of each block
+ * forwards and from the end of each block backwards.  Every window then spans
+ * at most two blocks, so its result is the backward value at its first pixel
+ * combined with the forward value at its last.  Four lines are done at once,
+ * one per SSE lane.
  */
 
 enum MorphType {
@@ -21,25 +30,119 @@ enum MorphDirection {
     kX, kY
 };
 
+// Below this radius the direct loop is faster.
+#define kMinVanHerkRadius   4
+
+template<MorphType type>
+static inline __m128i morph(__m128i a, __m128i b) {
+    return type == kDilate ? _mm_max_epu8(a, b) : _mm_min_epu8(a, b);
+}
+
+template<MorphType type>
+static inline __m128i morph_identity() {
+    return type == kDilate ? _mm_setzero_si128() : _mm_set1_epi32(0xFFFFFFFF);
+}
+
+// Loads pixel i of lines lines, which are lineStride apart, one per lane.  Missing lines read
+// as the identity.
+template<MorphType type>
+static inline __m128i load_lines(const SkPMColor* src, int lineStride, int lines) {
+    if (4 == lines && 1 == lineStride) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    }
+    const SkPMColor identity = type == kDilate ? 0 : 0xFFFFFFFF;
+    return _mm_setr_epi32(src[0],
+                          lines > 1 ? src[lineStride] : identity,
+                          lines > 2 ? src[2 * lineStride] : identity,
+                          lines > 3 ? src[3 * lineStride] : identity);
+}
+
+static inline void store_lines(SkPMColor* dst, int lineStride, int lines, __m128i pixels) {
+    if (4 == lines && 1 == lineStride) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), pixels);
+        return;
+    }
+    for (int i = 0; i < lines; ++i) {
+        dst[i * lineStride] = _mm_cvtsi128_si32(pixels);
+        pixels = _mm_srli_si128(pixels, 4);
+    }
+}
+
+template<MorphType type, MorphDirection direction>
+static void SkMorphVanHerk_SSE2(const SkPMColor* src, SkPMColor* dst, int radius,
+                                int width, int height, int srcStride, int dstStride)
+{
+    const int srcStrideX = direction == kX ? 1 : srcStride;
+    const int dstStrideX = direction == kX ? 1 : dstStride;
+    const int srcStrideY = direction == kX ? srcStride : 1;
+    const int dstStrideY = direction == kX ? dstStride : 1;
+    const int window = 2 * radius + 1;
+    // Each line, with radius identity pixels of padding at either end.
+    const int padded = width + 2 * radius;
+    // malloc() need not align to 16 bytes on 32-bit platforms.
+    SkAutoTMalloc<char> storage(2 * padded * sizeof(__m128i) + 15);
+    __m128i* forward = reinterpret_cast<__m128i*>(
+            (reinterpret_cast<uintptr_t>(storage.get()) + 15) & ~static_cast<uintptr_t>(15));
+    __m128i* backward = forward + padded;
+
+    for (int y = 0; y < height; y += 4) {
+        const int lines = SkMin32(4, height - y);
+        for (int i = 0; i < radius; ++i) {
+            backward[i] = backward[radius + width + i] = morph_identity<type>();
+        }
+        const SkPMColor* sptr = src;
+        for (int i = radius; i < radius + width; ++i) {
+            backward[i] = load_lines<type>(sptr, srcStrideY, lines);
+            sptr += srcStrideX;
+        }
+
+        for (int start = 0; start < padded; start += window) {
+            const int stop = SkMin32(start + window, padded);
+            forward[start] = backward[start];
+            for (int i = start + 1; i < stop; ++i) {
+                forward[i] = morph<type>(forward[i - 1], backward[i]);
+            }
+            for (int i = stop - 2; i >= start; --i) {
+                backward[i] = morph<type>(backward[i + 1], backward[i]);
+            }
+        }
+
+        // The window for pixel x covers padded pixels x to x + 2 * radius.
+        SkPMColor* dptr = dst;
+        for (int x = 0; x < width; ++x) {
+            store_lines(dptr, dstStrideY, lines, morph<type>(backward[x], forward[x + 2 * radius]));
+            dptr += dstStrideX;
+        }
+
+        src += 4 * srcStrideY;
+        dst += 4 * dstStrideY;
+    }
+}
+
 template<MorphType type, MorphDirection direction>
 static void SkMorph_SSE2(const SkPMColor* src, SkPMColor* dst, int radius,
                          int width, int height, int srcStride, int dstStride)
 {
+    radius = SkMin32(radius, width - 1);
+    if (radius >= kMinVanHerkRadius) {
+        SkMorphVanHerk_SSE2<type, direction>(src, dst, radius, width, height,
+                                             srcStride, dstStride);
+        return;
+    }
+
     const int srcStrideX = direction == kX ? 1 : srcStride;
     const int dstStrideX = direction == kX ? 1 : dstStride;
     const int srcStrideY = direction == kX ? srcStride : 1;
     const int dstStrideY = direction == kX ? dstStride : 1;
-    radius = SkMin32(radius, width - 1);
     const SkPMColor* upperSrc = src + radius * srcStrideX;
     for (int x = 0; x < width; ++x) {
         const SkPMColor* lp = src;
         const SkPMColor* up = upperSrc;
         SkPMColor* dptr = dst;
         for (int y = 0; y < height; ++y) {
-            __m128i max = type == kDilate ? _mm_setzero_si128() : _mm_set1_epi32(0xFFFFFFFF);
+            __m128i max = morph_identity<type>();
             for (const SkPMColor* p = lp; p <= up; p += srcStrideX) {
-                __m128i src_pixel = _mm_cvtsi32_si128(*p);
-                max = type == kDilate ? _mm_max_epu8(src_pixel, max) : _mm_min_epu8(src_pixel, max);
+                max = morph<type>(_mm_cvtsi32_si128(*p), max);
             }
             *dptr = _mm_cvtsi128_si32(max);
             dptr += dstStrideY;
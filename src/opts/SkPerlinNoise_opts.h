@@ -0,0 +1,44 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPerlinNoise_opts_DEFINED
+#define SkPerlinNoise_opts_DEFINED
+
+#include "SkColor.h"
+#include "SkPoint.h"
+
+// Everything SkPerlinNoiseShader needs to find the color at a point in noise space.
+struct SkPerlinNoiseParams {
+    enum {
+        kBlockSize = 256,       // Entries in the lattice.
+        kPerlinNoise = 4096,    // Added to positions to keep them positive.
+    };
+
+    const uint8_t* fLatticeSelector;    // kBlockSize entries.
+    // For each lattice entry, the x of the red, green, blue and alpha gradients, then their y.
+    const float  (*fGradients)[2][4];
+    float          fBaseFrequencyX;
+    float          fBaseFrequencyY;
+    int            fNumOctaves;
+    bool           fFractalNoise;       // Otherwise turbulence.
+    bool           fStitchTiles;
+    int            fStitchWidth;        // The stitch width and height of the first octave.
+    int            fStitchHeight;
+    float          fAlphaScale;         // Paint alpha / 255.
+};
+
+// Writes the color at each of the count points, which must already be mapped to noise space
+// and rounded, to dst.  The results must match SkPerlinNoiseShader's portable code exactly.
+typedef void (*SkPerlinNoiseSpanProc)(const SkPerlinNoiseParams&, const SkPoint points[],
+                                      int count, SkPMColor dst[]);
+
+SkPerlinNoiseSpanProc SkPerlinNoiseGetPlatformSpanProc();
+
+// The portable span proc, in SkPerlinNoiseShader.cpp, which any platform proc must match.
+SkPerlinNoiseSpanProc SkPerlinNoiseGetPortableSpanProc();
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <emmintrin.h>
+#include "SkPerlinNoise_opts_SSE2.h"
+#include "SkColorPriv.h"
+#include "SkScalar.h"
+
+// The lattice lookups are the same for all four channels, so this does them once per pixel and
+// octave, and works on the red, green, blue and alpha lanes of one register from there on.
+// The float operations are done in the same order as in SkPerlinNoiseShader.cpp.
+
+namespace {
+
+static const int kBlockMask = SkPerlinNoiseParams::kBlockSize - 1;
+
+struct Lattice {
+    Lattice(float component, bool stitch, int wrap, int size) {
+        float position = component + SkPerlinNoiseParams::kPerlinNoise;
+        fInteger = SkScalarFloorToInt(position);
+        fFraction = position - SkIntToScalar(fInteger);
+        fNext = fInteger + 1;
+        if (stitch) {
+            if (fInteger >= wrap) {
+                fInteger -= size;
+            }
+            if (fNext >= wrap) {
+                fNext -= size;
+            }
+        }
+        fInteger &= kBlockMask;
+        fNext &= kBlockMask;
+    }
+
+    int   fInteger;
+    int   fNext;
+    float fFraction;
+};
+
+// gradient . (fx, fy), for each channel's gradient.
+inline __m128 dot(const float gradient[2][4], __m128 fx, __m128 fy) {
+    return _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(gradient[0]), fx),
+                      _mm_mul_ps(_mm_loadu_ps(gradient[1]), fy));
+}
+
+inline __m128 interp(__m128 a, __m128 b, __m128 t) {
+    return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+}
+
+inline float smooth_curve(float t) {
+    return (t * t) * (3.0f - 2 * t);
+}
+
+__m128 noise2D(const SkPerlinNoiseParams& params, float x, float y,
+               int stitchWidth, int stitchHeight) {
+    const int kPerlinNoise = SkPerlinNoiseParams::kPerlinNoise;
+    Lattice noiseX(x, params.fStitchTiles, stitchWidth + kPerlinNoise, stitchWidth);
+    Lattice noiseY(y, params.fStitchTiles, stitchHeight + kPerlinNoise, stitchHeight);
+    int i = params.fLatticeSelector[noiseX.fInteger];
+    int j = params.fLatticeSelector[noiseX.fNext];
+    int b00 = (i + noiseY.fInteger) & kBlockMask;
+    int b10 = (j + noiseY.fInteger) & kBlockMask;
+    int b01 = (i + noiseY.fNext) & kBlockMask;
+    int b11 = (j + noiseY.fNext) & kBlockMask;
+    __m128 sx = _mm_set1_ps(smooth_curve(noiseX.fFraction));
+    __m128 sy = _mm_set1_ps(smooth_curve(noiseY.fFraction));
+
+    __m128 fx = _mm_set1_ps(noiseX.fFraction);
+    __m128 fy = _mm_set1_ps(noiseY.fFraction);
+    __m128 fx1 = _mm_set1_ps(noiseX.fFraction - SK_Scalar1);
+    __m128 fy1 = _mm_set1_ps(noiseY.fFraction - SK_Scalar1);
+    __m128 a = interp(dot(params.fGradients[b00], fx, fy),
+                      dot(params.fGradients[b10], fx1, fy), sx);
+    __m128 b = interp(dot(params.fGradients[b01], fx, fy1),
+                      dot(params.fGradients[b11], fx1, fy1), sx);
+    return interp(a, b, sy);
+}
+
+}  // namespace
+
+void SkPerlinNoiseSpan_SSE2(const SkPerlinNoiseParams& params, const SkPoint points[], int count,
+                            SkPMColor dst[]) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 alphaScale = _mm_setr_ps(1, 1, 1, params.fAlphaScale);
+    for (int n = 0; n < count; ++n) {
+        float x = points[n].fX * params.fBaseFrequencyX;
+        float y = points[n].fY * params.fBaseFrequencyY;
+        int stitchWidth = params.fStitchWidth;
+        int stitchHeight = params.fStitchHeight;
+        float ratio = SK_Scalar1;
+        __m128 sum = _mm_setzero_ps();
+        for (int octave = 0; octave < params.fNumOctaves; ++octave) {
+            __m128 noise = noise2D(params, x, y, stitchWidth, stitchHeight);
+            if (!params.fFractalNoise) {
+                noise = _mm_and_ps(noise, absMask);
+            }
+            sum = _mm_add_ps(sum, _mm_div_ps(noise, _mm_set1_ps(ratio)));
+            x *= 2;
+            y *= 2;
+            ratio *= 2;
+            stitchWidth *= 2;
+            stitchHeight *= 2;
+        }
+        if (params.fFractalNoise) {
+            sum = _mm_add_ps(_mm_mul_ps(sum, _mm_set1_ps(SK_ScalarHalf)),
+                             _mm_set1_ps(SK_ScalarHalf));
+        }
+        // Only alpha is scaled; the other lanes are multiplied by exactly 1.
+        sum = _mm_mul_ps(sum, alphaScale);
+        sum = _mm_min_ps(_mm_max_ps(sum, _mm_setzero_ps()), _mm_set1_ps(SK_Scalar1));
+        // The values are now in [0, 255], so truncating is flooring.
+        __m128i rgba = _mm_cvttps_epi32(_mm_mul_ps(_mm_set1_ps(255), sum));
+        int32_t c[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(c), rgba);
+        dst[n] = SkPremultiplyARGBInline(c[3], c[0], c[1], c[2]);
+    }
+}
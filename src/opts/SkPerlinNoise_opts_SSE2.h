@@ -0,0 +1,16 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPerlinNoise_opts_SSE2_DEFINED
+#define SkPerlinNoise_opts_SSE2_DEFINED
+
+#include "SkPerlinNoise_opts.h"
+
+void SkPerlinNoiseSpan_SSE2(const SkPerlinNoiseParams&, const SkPoint points[], int count,
+                            SkPMColor dst[]);
+
+#endif
@@ -0,0 +1,23 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRect_opts_DEFINED
+#define SkRect_opts_DEFINED
+
+#include "SkRect.h"
+
+typedef bool (*SkRectBoundsCheckProc)(SkRect* bounds, const SkPoint pts[], int count);
+
+// Does what SkRect::setBoundsCheck() does, for arrays long enough to be worth the call.  The
+// bounds must be exactly those of the portable code (though where the points hold both 0 and -0,
+// which of them ends up in the bounds may differ).
+SkRectBoundsCheckProc SkRectGetPlatformBoundsCheckProc();
+
+// The portable proc, in SkRect.cpp.
+SkRectBoundsCheckProc SkRectGetPortableBoundsCheckProc();
+
+#endif
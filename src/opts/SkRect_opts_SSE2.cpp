@@ -0,0 +1,78 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <emmintrin.h>
+#include "SkRect_opts_SSE2.h"
+
+namespace {
+
+// x y x y, from a single point.
+inline __m128 load_one(const SkPoint* p) {
+    __m128 v = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p));
+    return _mm_movelh_ps(v, v);
+}
+
+// Two points, as x0 y0 x1 y1.
+inline __m128 load_two(const SkPoint* p) {
+    return _mm_loadu_ps(&p->fX);
+}
+
+}  // namespace
+
+bool SkRectSetBoundsCheck_SSE2(SkRect* bounds, const SkPoint pts[], int count) {
+    SkASSERT(pts && count > 0);
+
+    // Each register tracks two points' worth of x y.  Two sets of min/max are kept so that
+    // consecutive iterations don't wait on each other.
+    __m128 min0 = load_one(pts);
+    __m128 max0 = min0;
+    __m128 min1 = min0;
+    __m128 max1 = min0;
+
+    // Any finite value times 0 is 0 (or -0, which compares equal), but infinity or NaN times 0
+    // is NaN, which won't compare equal to 0.  These are or'ed together rather than multiplied
+    // into a running product, which would be one long dependency chain.
+    const __m128 zero = _mm_setzero_ps();
+    __m128 nonFinite = _mm_mul_ps(min0, zero);
+
+    int i = 1;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 a = load_two(pts + i);
+        const __m128 b = load_two(pts + i + 2);
+        min0 = _mm_min_ps(min0, a);
+        max0 = _mm_max_ps(max0, a);
+        min1 = _mm_min_ps(min1, b);
+        max1 = _mm_max_ps(max1, b);
+        nonFinite = _mm_or_ps(nonFinite, _mm_or_ps(_mm_mul_ps(a, zero), _mm_mul_ps(b, zero)));
+    }
+    if (i + 2 <= count) {
+        const __m128 a = load_two(pts + i);
+        min0 = _mm_min_ps(min0, a);
+        max0 = _mm_max_ps(max0, a);
+        nonFinite = _mm_or_ps(nonFinite, _mm_mul_ps(a, zero));
+        i += 2;
+    }
+    if (i < count) {
+        const __m128 a = load_one(pts + i);
+        min1 = _mm_min_ps(min1, a);
+        max1 = _mm_max_ps(max1, a);
+        nonFinite = _mm_or_ps(nonFinite, _mm_mul_ps(a, zero));
+    }
+
+    if (_mm_movemask_ps(_mm_cmpneq_ps(nonFinite, zero))) {
+        bounds->setEmpty();
+        return false;
+    }
+
+    __m128 min = _mm_min_ps(min0, min1);
+    __m128 max = _mm_max_ps(max0, max1);
+    min = _mm_min_ps(min, _mm_movehl_ps(min, min));
+    max = _mm_max_ps(max, _mm_movehl_ps(max, max));
+    // SkRect is left top right bottom, which is min's x y followed by max's x y.
+    _mm_storeu_ps(&bounds->fLeft, _mm_movelh_ps(min, max));
+    return true;
+}
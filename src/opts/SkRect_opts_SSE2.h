@@ -0,0 +1,15 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRect_opts_SSE2_DEFINED
+#define SkRect_opts_SSE2_DEFINED
+
+#include "SkRect_opts.h"
+
+bool SkRectSetBoundsCheck_SSE2(SkRect* bounds, const SkPoint pts[], int count);
+
+#endif
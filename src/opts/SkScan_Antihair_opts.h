@@ -0,0 +1,20 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkScan_Antihair_opts_DEFINED
+#define SkScan_Antihair_opts_DEFINED
+
+#include "SkFixed.h"
+
+typedef void (*SkAntiHairRampProc)(SkFixed f, SkFixed df, int count,
+                                   uint8_t alpha[], uint8_t invAlpha[]);
+
+// For i in [0, count), alpha[i] = (uint8_t)((f + i * df) >> 8) and invAlpha[i] = 255 - alpha[i]:
+// the coverage of the two pixels a hairline straddles, for count steps along it.
+SkAntiHairRampProc SkAntiHairGetPlatformRampProc();
+
+#endif
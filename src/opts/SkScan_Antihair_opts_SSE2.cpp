@@ -0,0 +1,48 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <emmintrin.h>
+#include "SkScan_Antihair_opts_SSE2.h"
+
+void SkAntiHairRamp_SSE2(SkFixed f, SkFixed df, int count,
+                         uint8_t alpha[], uint8_t invAlpha[]) {
+    SkASSERT(count > 0);
+
+    // Sixteen steps at a time, in four registers of four.
+    const __m128i step4 = _mm_set1_epi32(df << 2);
+    const __m128i step16 = _mm_set1_epi32(df << 4);
+    const __m128i lowByte = _mm_set1_epi32(0xFF);
+    const __m128i allOnes = _mm_set1_epi8(-1);
+    __m128i f0 = _mm_add_epi32(_mm_set1_epi32(f), _mm_setr_epi32(0, df, 2 * df, 3 * df));
+    __m128i f1 = _mm_add_epi32(f0, step4);
+    __m128i f2 = _mm_add_epi32(f1, step4);
+    __m128i f3 = _mm_add_epi32(f2, step4);
+
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i a0 = _mm_and_si128(_mm_srli_epi32(f0, 8), lowByte);
+        __m128i a1 = _mm_and_si128(_mm_srli_epi32(f1, 8), lowByte);
+        __m128i a2 = _mm_and_si128(_mm_srli_epi32(f2, 8), lowByte);
+        __m128i a3 = _mm_and_si128(_mm_srli_epi32(f3, 8), lowByte);
+        // Each lane is already in 0..255, so neither pack saturates.
+        __m128i a = _mm_packus_epi16(_mm_packs_epi32(a0, a1), _mm_packs_epi32(a2, a3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(alpha + i), a);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(invAlpha + i), _mm_xor_si128(a, allOnes));
+
+        f0 = _mm_add_epi32(f0, step16);
+        f1 = _mm_add_epi32(f1, step16);
+        f2 = _mm_add_epi32(f2, step16);
+        f3 = _mm_add_epi32(f3, step16);
+    }
+
+    f += i * df;
+    for (; i < count; ++i) {
+        alpha[i] = (uint8_t)(f >> 8);
+        invAlpha[i] = 255 - alpha[i];
+        f += df;
+    }
+}
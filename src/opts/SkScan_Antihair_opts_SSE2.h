@@ -0,0 +1,16 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkScan_Antihair_opts_SSE2_DEFINED
+#define SkScan_Antihair_opts_SSE2_DEFINED
+
+#include "SkScan_Antihair_opts.h"
+
+void SkAntiHairRamp_SSE2(SkFixed f, SkFixed df, int count,
+                         uint8_t alpha[], uint8_t invAlpha[]);
+
+#endif
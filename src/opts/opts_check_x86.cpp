@@ -13,9 +13,27 @@
 #include "SkBlitRow.h"
 #include "SkBlitRow_opts_SSE2.h"
 #include "SkBlurImage_opts_SSE2.h"
+#include "SkColorMatrix_opts.h"
+#include "SkColorMatrix_opts_SSE2.h"
+#include "SkGeometry_opts.h"
+#include "SkGeometry_opts_SSE2.h"
+#include "SkGradient_opts.h"
+#include "SkGradient_opts_SSE2.h"
+#include "SkLighting_opts.h"
+#include "SkLighting_opts_SSE2.h"
+#include "SkMatrixConvolution_opts.h"
+#include "SkMatrixConvolution_opts_SSE2.h"
+#include "SkMatrix_opts.h"
+#include "SkMatrix_opts_SSE2.h"
 #include "SkMorphology_opts.h"
 #include "SkMorphology_opts_SSE2.h"
+#include "SkPerlinNoise_opts.h"
+#include "SkPerlinNoise_opts_SSE2.h"
+#include "SkRect_opts.h"
+#include "SkRect_opts_SSE2.h"
 #include "SkRTConf.h"
+#include "SkScan_Antihair_opts.h"
+#include "SkScan_Antihair_opts_SSE2.h"
 #include "SkUtils.h"
 #include "SkUtils_opts_SSE2.h"
 #include "SkXfermode.h"
@@ -333,6 +351,99 @@ SkMorphologyImageFilter::Proc SkMorphologyGetPlatformProc(SkMorphologyProcType t
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool SkGradientGetPlatformLerpProcs(SkGradientLerpProcs* procs) {
+    if (!supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
+        return false;
+    }
+    procs->fSpan   = SkGradientLerpSpan_SSE2;
+    procs->fLinear = SkGradientLerpLinear_SSE2;
+    procs->fRadial = SkGradientLerpRadial_SSE2;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SkColorMatrixSpanProc SkColorMatrixGetPlatformSpanProc() {
+    if (!supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
+        return NULL;
+    }
+    return SkColorMatrixFilterSpan_SSE2;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SkMatrixConvolutionProc SkMatrixConvolutionGetPlatformProc() {
+    if (!supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
+        return NULL;
+    }
+    return SkMatrixConvolve_SSE2;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SkMatrix::MapPtsProc SkMatrixGetPlatformMapPtsProc() {
+    if (!supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
+        return NULL;
+    }
+    return SkMatrixMapPoints_SSE2;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SkQuadFlattenProc SkGeometryGetPlatformQuadFlattenProc() {
+    if (!supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
+        return NULL;
+    }
+    return SkQuadFlatten_SSE2;
+}
+
+SkCubicFlattenProc SkGeometryGetPlatformCubicFlattenProc() {
+    if (!supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
+        return NULL;
+    }
+    return SkCubicFlatten_SSE2;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SkRectBoundsCheckProc SkRectGetPlatformBoundsCheckProc() {
+    if (!supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
+        return NULL;
+    }
+    return SkRectSetBoundsCheck_SSE2;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SkAntiHairRampProc SkAntiHairGetPlatformRampProc() {
+    if (!supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
+        return NULL;
+    }
+    return SkAntiHairRamp_SSE2;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool SkLightingGetPlatformProcs(SkLightingProcs* procs) {
+    if (!supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
+        return false;
+    }
+    procs->fNormals        = SkLightingNormals_SSE2;
+    procs->fSurfaceToLight = SkLightingSurfaceToLight_SSE2;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SkPerlinNoiseSpanProc SkPerlinNoiseGetPlatformSpanProc() {
+    if (!supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
+        return NULL;
+    }
+    return SkPerlinNoiseSpan_SSE2;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool SkBoxBlurGetPlatformProcs(SkBoxBlurProc* boxBlurX,
                                SkBoxBlurProc* boxBlurY,
                                SkBoxBlurProc* boxBlurXY,
@@ -6,6 +6,7 @@
  */
 #include "SkAddIntersections.h"
 #include "SkPathOpsBounds.h"
+#include "SkThreadPool.h"
 
 #if DEBUG_ADD_INTERSECTING_TS
 
@@ -174,6 +175,223 @@ static void debugShowCubicIntersection(int , const SkIntersectionHelper& ,
 }
 #endif
 
+// Finds where the segments wt and wn cross, without changing either, so that it can be done on any
+// thread. Sets swap if ts holds wn's t values first.
+static int intersectSegments(const SkIntersectionHelper& wt, const SkIntersectionHelper& wn,
+        SkIntersections* ts, bool* swap) {
+    int pts = 0;
+    *swap = false;
+    switch (wt.segmentType()) {
+        case SkIntersectionHelper::kHorizontalLine_Segment:
+            *swap = true;
+            switch (wn.segmentType()) {
+                case SkIntersectionHelper::kHorizontalLine_Segment:
+                case SkIntersectionHelper::kVerticalLine_Segment:
+                case SkIntersectionHelper::kLine_Segment: {
+                    pts = ts->lineHorizontal(wn.pts(), wt.left(),
+                            wt.right(), wt.y(), wt.xFlipped());
+                    debugShowLineIntersection(pts, wn, wt, *ts);
+                    break;
+                }
+                case SkIntersectionHelper::kQuad_Segment: {
+                    pts = ts->quadHorizontal(wn.pts(), wt.left(),
+                            wt.right(), wt.y(), wt.xFlipped());
+                    debugShowQuadLineIntersection(pts, wn, wt, *ts);
+                    break;
+                }
+                case SkIntersectionHelper::kCubic_Segment: {
+                    pts = ts->cubicHorizontal(wn.pts(), wt.left(),
+                            wt.right(), wt.y(), wt.xFlipped());
+                    debugShowCubicLineIntersection(pts, wn, wt, *ts);
+                    break;
+                }
+                default:
+                    SkASSERT(0);
+            }
+            break;
+        case SkIntersectionHelper::kVerticalLine_Segment:
+            *swap = true;
+            switch (wn.segmentType()) {
+                case SkIntersectionHelper::kHorizontalLine_Segment:
+                case SkIntersectionHelper::kVerticalLine_Segment:
+                case SkIntersectionHelper::kLine_Segment: {
+                    pts = ts->lineVertical(wn.pts(), wt.top(),
+                            wt.bottom(), wt.x(), wt.yFlipped());
+                    debugShowLineIntersection(pts, wn, wt, *ts);
+                    break;
+                }
+                case SkIntersectionHelper::kQuad_Segment: {
+                    pts = ts->quadVertical(wn.pts(), wt.top(),
+                            wt.bottom(), wt.x(), wt.yFlipped());
+                    debugShowQuadLineIntersection(pts, wn, wt, *ts);
+                    break;
+                }
+                case SkIntersectionHelper::kCubic_Segment: {
+                    pts = ts->cubicVertical(wn.pts(), wt.top(),
+                            wt.bottom(), wt.x(), wt.yFlipped());
+                    debugShowCubicLineIntersection(pts, wn, wt, *ts);
+                    break;
+                }
+                default:
+                    SkASSERT(0);
+            }
+            break;
+        case SkIntersectionHelper::kLine_Segment:
+            switch (wn.segmentType()) {
+                case SkIntersectionHelper::kHorizontalLine_Segment:
+                    pts = ts->lineHorizontal(wt.pts(), wn.left(),
+                            wn.right(), wn.y(), wn.xFlipped());
+                    debugShowLineIntersection(pts, wt, wn, *ts);
+                    break;
+                case SkIntersectionHelper::kVerticalLine_Segment:
+                    pts = ts->lineVertical(wt.pts(), wn.top(),
+                            wn.bottom(), wn.x(), wn.yFlipped());
+                    debugShowLineIntersection(pts, wt, wn, *ts);
+                    break;
+                case SkIntersectionHelper::kLine_Segment: {
+                    pts = ts->lineLine(wt.pts(), wn.pts());
+                    debugShowLineIntersection(pts, wt, wn, *ts);
+                    break;
+                }
+                case SkIntersectionHelper::kQuad_Segment: {
+                    *swap = true;
+                    pts = ts->quadLine(wn.pts(), wt.pts());
+                    debugShowQuadLineIntersection(pts, wn, wt, *ts);
+                    break;
+                }
+                case SkIntersectionHelper::kCubic_Segment: {
+                    *swap = true;
+                    pts = ts->cubicLine(wn.pts(), wt.pts());
+                    debugShowCubicLineIntersection(pts, wn, wt, *ts);
+                    break;
+                }
+                default:
+                    SkASSERT(0);
+            }
+            break;
+        case SkIntersectionHelper::kQuad_Segment:
+            switch (wn.segmentType()) {
+                case SkIntersectionHelper::kHorizontalLine_Segment:
+                    pts = ts->quadHorizontal(wt.pts(), wn.left(),
+                            wn.right(), wn.y(), wn.xFlipped());
+                    debugShowQuadLineIntersection(pts, wt, wn, *ts);
+                    break;
+                case SkIntersectionHelper::kVerticalLine_Segment:
+                    pts = ts->quadVertical(wt.pts(), wn.top(),
+                            wn.bottom(), wn.x(), wn.yFlipped());
+                    debugShowQuadLineIntersection(pts, wt, wn, *ts);
+                    break;
+                case SkIntersectionHelper::kLine_Segment: {
+                    pts = ts->quadLine(wt.pts(), wn.pts());
+                    debugShowQuadLineIntersection(pts, wt, wn, *ts);
+                    break;
+                }
+                case SkIntersectionHelper::kQuad_Segment: {
+                    pts = ts->quadQuad(wt.pts(), wn.pts());
+                    debugShowQuadIntersection(pts, wt, wn, *ts);
+                    break;
+                }
+                case SkIntersectionHelper::kCubic_Segment: {
+                    *swap = true;
+                    pts = ts->cubicQuad(wn.pts(), wt.pts());
+                    debugShowCubicQuadIntersection(pts, wn, wt, *ts);
+                    break;
+                }
+                default:
+                    SkASSERT(0);
+            }
+            break;
+        case SkIntersectionHelper::kCubic_Segment:
+            switch (wn.segmentType()) {
+                case SkIntersectionHelper::kHorizontalLine_Segment:
+                    pts = ts->cubicHorizontal(wt.pts(), wn.left(),
+                            wn.right(), wn.y(), wn.xFlipped());
+                    debugShowCubicLineIntersection(pts, wt, wn, *ts);
+                    break;
+                case SkIntersectionHelper::kVerticalLine_Segment:
+                    pts = ts->cubicVertical(wt.pts(), wn.top(),
+                            wn.bottom(), wn.x(), wn.yFlipped());
+                    debugShowCubicLineIntersection(pts, wt, wn, *ts);
+                    break;
+                case SkIntersectionHelper::kLine_Segment: {
+                    pts = ts->cubicLine(wt.pts(), wn.pts());
+                    debugShowCubicLineIntersection(pts, wt, wn, *ts);
+                    break;
+                }
+                case SkIntersectionHelper::kQuad_Segment: {
+                    pts = ts->cubicQuad(wt.pts(), wn.pts());
+                    debugShowCubicQuadIntersection(pts, wt, wn, *ts);
+                    break;
+                }
+                case SkIntersectionHelper::kCubic_Segment: {
+                    pts = ts->cubicCubic(wt.pts(), wn.pts());
+                    debugShowCubicIntersection(pts, wt, wn, *ts);
+                    break;
+                }
+                default:
+                    SkASSERT(0);
+            }
+            break;
+        default:
+            SkASSERT(0);
+    }
+    return pts;
+}
+
+// Records the intersections intersectSegments() found in both segments. These must be added in
+// the same order as the segment pairs are visited, since each may adjust the t values of the next.
+static void addIntersections(SkIntersectionHelper& wt, SkIntersectionHelper& wn, int pts,
+        bool swap, SkIntersections* ts, bool* foundCommonContour) {
+    if (!*foundCommonContour && pts > 0) {
+        wt.addCross(wn);
+        *foundCommonContour = true;
+    }
+    // in addition to recording T values, record matching segment
+    if (pts == 2) {
+        if (wn.segmentType() <= SkIntersectionHelper::kLine_Segment
+                && wt.segmentType() <= SkIntersectionHelper::kLine_Segment) {
+            if (wt.addCoincident(wn, *ts, swap)) {
+                return;
+            }
+            ts->cleanUpCoincidence();  // prefer (t == 0 or t == 1)
+            pts = 1;
+        } else if (wn.segmentType() >= SkIntersectionHelper::kQuad_Segment
+                && wt.segmentType() >= SkIntersectionHelper::kQuad_Segment
+                && ts->isCoincident(0)) {
+            SkASSERT(ts->coincidentUsed() == 2);
+            if (wt.addCoincident(wn, *ts, swap)) {
+                return;
+            }
+            ts->cleanUpCoincidence();  // prefer (t == 0 or t == 1)
+            pts = 1;
+        }
+    }
+    if (pts >= 2) {
+        for (int pt = 0; pt < pts - 1; ++pt) {
+            const SkDPoint& point = ts->pt(pt);
+            const SkDPoint& next = ts->pt(pt + 1);
+            if (wt.isPartial((*ts)[swap][pt], (*ts)[swap][pt + 1], point, next)
+                    && wn.isPartial((*ts)[!swap][pt], (*ts)[!swap][pt + 1], point, next)) {
+                if (!wt.addPartialCoincident(wn, *ts, pt, swap)) {
+                    // remove extra point if two map to same float values
+                    ts->cleanUpCoincidence();  // prefer (t == 0 or t == 1)
+                    pts = 1;
+                }
+            }
+        }
+    }
+    for (int pt = 0; pt < pts; ++pt) {
+        SkASSERT((*ts)[0][pt] >= 0 && (*ts)[0][pt] <= 1);
+        SkASSERT((*ts)[1][pt] >= 0 && (*ts)[1][pt] <= 1);
+        SkPoint point = ts->pt(pt).asSkPoint();
+        wt.alignTPt(wn, swap, pt, ts, &point);
+        int testTAt = wt.addT(wn, point, (*ts)[swap][pt]);
+        int nextTAt = wn.addT(wt, point, (*ts)[!swap][pt]);
+        wt.addOtherT(testTAt, (*ts)[!swap][pt], nextTAt);
+        wn.addOtherT(nextTAt, (*ts)[swap][pt], testTAt);
+    }
+}
+
 bool AddIntersectTs(SkOpContour* test, SkOpContour* next) {
     if (test != next) {
         if (AlmostLessUlps(test->bounds().fBottom, next->bounds().fTop)) {
@@ -197,212 +415,10 @@ bool AddIntersectTs(SkOpContour* test, SkOpContour* next) {
             if (!SkPathOpsBounds::Intersects(wt.bounds(), wn.bounds())) {
                 continue;
             }
-            int pts = 0;
             SkIntersections ts;
-            bool swap = false;
-            switch (wt.segmentType()) {
-                case SkIntersectionHelper::kHorizontalLine_Segment:
-                    swap = true;
-                    switch (wn.segmentType()) {
-                        case SkIntersectionHelper::kHorizontalLine_Segment:
-                        case SkIntersectionHelper::kVerticalLine_Segment:
-                        case SkIntersectionHelper::kLine_Segment: {
-                            pts = ts.lineHorizontal(wn.pts(), wt.left(),
-                                    wt.right(), wt.y(), wt.xFlipped());
-                            debugShowLineIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kQuad_Segment: {
-                            pts = ts.quadHorizontal(wn.pts(), wt.left(),
-                                    wt.right(), wt.y(), wt.xFlipped());
-                            debugShowQuadLineIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kCubic_Segment: {
-                            pts = ts.cubicHorizontal(wn.pts(), wt.left(),
-                                    wt.right(), wt.y(), wt.xFlipped());
-                            debugShowCubicLineIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                        default:
-                            SkASSERT(0);
-                    }
-                    break;
-                case SkIntersectionHelper::kVerticalLine_Segment:
-                    swap = true;
-                    switch (wn.segmentType()) {
-                        case SkIntersectionHelper::kHorizontalLine_Segment:
-                        case SkIntersectionHelper::kVerticalLine_Segment:
-                        case SkIntersectionHelper::kLine_Segment: {
-                            pts = ts.lineVertical(wn.pts(), wt.top(),
-                                    wt.bottom(), wt.x(), wt.yFlipped());
-                            debugShowLineIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kQuad_Segment: {
-                            pts = ts.quadVertical(wn.pts(), wt.top(),
-                                    wt.bottom(), wt.x(), wt.yFlipped());
-                            debugShowQuadLineIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kCubic_Segment: {
-                            pts = ts.cubicVertical(wn.pts(), wt.top(),
-                                    wt.bottom(), wt.x(), wt.yFlipped());
-                            debugShowCubicLineIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                        default:
-                            SkASSERT(0);
-                    }
-                    break;
-                case SkIntersectionHelper::kLine_Segment:
-                    switch (wn.segmentType()) {
-                        case SkIntersectionHelper::kHorizontalLine_Segment:
-                            pts = ts.lineHorizontal(wt.pts(), wn.left(),
-                                    wn.right(), wn.y(), wn.xFlipped());
-                            debugShowLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kVerticalLine_Segment:
-                            pts = ts.lineVertical(wt.pts(), wn.top(),
-                                    wn.bottom(), wn.x(), wn.yFlipped());
-                            debugShowLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kLine_Segment: {
-                            pts = ts.lineLine(wt.pts(), wn.pts());
-                            debugShowLineIntersection(pts, wt, wn, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kQuad_Segment: {
-                            swap = true;
-                            pts = ts.quadLine(wn.pts(), wt.pts());
-                            debugShowQuadLineIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kCubic_Segment: {
-                            swap = true;
-                            pts = ts.cubicLine(wn.pts(), wt.pts());
-                            debugShowCubicLineIntersection(pts, wn, wt,  ts);
-                            break;
-                        }
-                        default:
-                            SkASSERT(0);
-                    }
-                    break;
-                case SkIntersectionHelper::kQuad_Segment:
-                    switch (wn.segmentType()) {
-                        case SkIntersectionHelper::kHorizontalLine_Segment:
-                            pts = ts.quadHorizontal(wt.pts(), wn.left(),
-                                    wn.right(), wn.y(), wn.xFlipped());
-                            debugShowQuadLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kVerticalLine_Segment:
-                            pts = ts.quadVertical(wt.pts(), wn.top(),
-                                    wn.bottom(), wn.x(), wn.yFlipped());
-                            debugShowQuadLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kLine_Segment: {
-                            pts = ts.quadLine(wt.pts(), wn.pts());
-                            debugShowQuadLineIntersection(pts, wt, wn, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kQuad_Segment: {
-                            pts = ts.quadQuad(wt.pts(), wn.pts());
-                            debugShowQuadIntersection(pts, wt, wn, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kCubic_Segment: {
-                            swap = true;
-                            pts = ts.cubicQuad(wn.pts(), wt.pts());
-                            debugShowCubicQuadIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                        default:
-                            SkASSERT(0);
-                    }
-                    break;
-                case SkIntersectionHelper::kCubic_Segment:
-                    switch (wn.segmentType()) {
-                        case SkIntersectionHelper::kHorizontalLine_Segment:
-                            pts = ts.cubicHorizontal(wt.pts(), wn.left(),
-                                    wn.right(), wn.y(), wn.xFlipped());
-                            debugShowCubicLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kVerticalLine_Segment:
-                            pts = ts.cubicVertical(wt.pts(), wn.top(),
-                                    wn.bottom(), wn.x(), wn.yFlipped());
-                            debugShowCubicLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kLine_Segment: {
-                            pts = ts.cubicLine(wt.pts(), wn.pts());
-                            debugShowCubicLineIntersection(pts, wt, wn, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kQuad_Segment: {
-                            pts = ts.cubicQuad(wt.pts(), wn.pts());
-                            debugShowCubicQuadIntersection(pts, wt, wn, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kCubic_Segment: {
-                            pts = ts.cubicCubic(wt.pts(), wn.pts());
-                            debugShowCubicIntersection(pts, wt, wn, ts);
-                            break;
-                        }
-                        default:
-                            SkASSERT(0);
-                    }
-                    break;
-                default:
-                    SkASSERT(0);
-            }
-            if (!foundCommonContour && pts > 0) {
-                test->addCross(next);
-                next->addCross(test);
-                foundCommonContour = true;
-            }
-            // in addition to recording T values, record matching segment
-            if (pts == 2) {
-                if (wn.segmentType() <= SkIntersectionHelper::kLine_Segment
-                        && wt.segmentType() <= SkIntersectionHelper::kLine_Segment) {
-                    if (wt.addCoincident(wn, ts, swap)) {
-                        continue;
-                    }
-                    ts.cleanUpCoincidence();  // prefer (t == 0 or t == 1)
-                    pts = 1;
-                } else if (wn.segmentType() >= SkIntersectionHelper::kQuad_Segment
-                        && wt.segmentType() >= SkIntersectionHelper::kQuad_Segment
-                        && ts.isCoincident(0)) {
-                    SkASSERT(ts.coincidentUsed() == 2);
-                    if (wt.addCoincident(wn, ts, swap)) {
-                        continue;
-                    }
-                    ts.cleanUpCoincidence();  // prefer (t == 0 or t == 1)
-                    pts = 1;
-                }
-            }
-            if (pts >= 2) {
-                for (int pt = 0; pt < pts - 1; ++pt) {
-                    const SkDPoint& point = ts.pt(pt);
-                    const SkDPoint& next = ts.pt(pt + 1);
-                    if (wt.isPartial(ts[swap][pt], ts[swap][pt + 1], point, next)
-                            && wn.isPartial(ts[!swap][pt], ts[!swap][pt + 1], point, next)) {
-                        if (!wt.addPartialCoincident(wn, ts, pt, swap)) {
-                            // remove extra point if two map to same float values
-                            ts.cleanUpCoincidence();  // prefer (t == 0 or t == 1)
-                            pts = 1;
-                        }
-                    }
-                }
-            }
-            for (int pt = 0; pt < pts; ++pt) {
-                SkASSERT(ts[0][pt] >= 0 && ts[0][pt] <= 1);
-                SkASSERT(ts[1][pt] >= 0 && ts[1][pt] <= 1);
-                SkPoint point = ts.pt(pt).asSkPoint();
-                wt.alignTPt(wn, swap, pt, &ts, &point);
-                int testTAt = wt.addT(wn, point, ts[swap][pt]);
-                int nextTAt = wn.addT(wt, point, ts[!swap][pt]);
-                wt.addOtherT(testTAt, ts[!swap][pt], nextTAt);
-                wn.addOtherT(nextTAt, ts[swap][pt], testTAt);
-            }
+            bool swap;
+            int pts = intersectSegments(wt, wn, &ts, &swap);
+            addIntersections(wt, wn, pts, swap, &ts, &foundCommonContour);
         } while (wn.advance());
     } while (wt.advance());
     return true;
@@ -432,6 +448,199 @@ void AddSelfIntersectTs(SkOpContour* test) {
     } while (wt.advance());
 }
 
+namespace {
+
+// The intersections of one pair of segments, found ahead of adding them to their contours.
+struct FoundIntersections {
+    SkIntersections fTs;
+    int fNextIndex;
+    int fPts;
+    bool fSwap;
+};
+
+// One segment of fTest, to be intersected with the segments of fNext from fFirstNext on.
+struct IntersectRow {
+    SkOpContour* fTest;
+    SkOpContour* fNext;
+    int fTestIndex;
+    int fFirstNext;
+    int fTask;  // the task whose fFound holds what this row found, from fFirstFound on
+    int fFirstFound;
+    int fFoundCount;
+};
+
+// Contours whose rows end at fRowEnd, in the order the single-threaded loop visits them.
+struct ContourPair {
+    SkOpContour* fTest;
+    SkOpContour* fNext;
+    int fRowEnd;
+};
+
+class IntersectTask : public SkRunnable {
+public:
+    void init(IntersectRow* rows, int count, int index) {
+        fRows = rows;
+        fCount = count;
+        fIndex = index;
+    }
+
+    FoundIntersections& found(int index) {
+        return fFound[index];
+    }
+
+    virtual void run() SK_OVERRIDE {
+        for (int index = 0; index < fCount; ++index) {
+            IntersectRow& row = fRows[index];
+            row.fTask = fIndex;
+            row.fFirstFound = fFound.count();
+            SkIntersectionHelper wt;
+            wt.init(row.fTest, row.fTestIndex);
+            SkIntersectionHelper wn;
+            wn.init(row.fNext, row.fFirstNext);
+            do {
+                if (!SkPathOpsBounds::Intersects(wt.bounds(), wn.bounds())) {
+                    continue;
+                }
+                FoundIntersections& found = fFound.push_back();
+                found.fPts = intersectSegments(wt, wn, &found.fTs, &found.fSwap);
+                if (!found.fPts) {
+                    fFound.pop_back();
+                    continue;
+                }
+                found.fNextIndex = wn.index();
+            } while (wn.advance());
+            row.fFoundCount = fFound.count() - row.fFirstFound;
+        }
+    }
+
+private:
+    IntersectRow* fRows;
+    int fCount;
+    int fIndex;
+    SkTArray<FoundIntersections> fFound;
+};
+
+}  // namespace
+
+static void addAllIntersectTs(const SkTArray<SkOpContour*, true>& contourList) {
+    SkOpContour* const* currentPtr = contourList.begin();
+    SkOpContour* const* listEnd = contourList.end();
+    do {
+        SkOpContour* const* nextPtr = currentPtr;
+        SkOpContour* current = *currentPtr++;
+        if (current->containsCubics()) {
+            AddSelfIntersectTs(current);
+        }
+        SkOpContour* next;
+        do {
+            next = *nextPtr++;
+        } while (AddIntersectTs(current, next) && nextPtr != listEnd);
+    } while (currentPtr != listEnd);
+}
+
+// Below this many segment pairs to check per thread, starting the threads costs more than it saves.
+#define kMinSegmentPairsPerThread  2048
+
+void AddAllIntersectTs(const SkTArray<SkOpContour*, true>& contourList, int threadCount) {
+    SkASSERT(contourList.count() > 0);
+    if (threadCount <= 1) {
+        addAllIntersectTs(contourList);
+        return;
+    }
+    // Visit the contour pairs as addAllIntersectTs() does, collecting the segment pairs to check.
+    SkTDArray<ContourPair> pairs;
+    SkTDArray<IntersectRow> rows;
+    int64_t segmentPairs = 0;
+    SkOpContour* const* currentPtr = contourList.begin();
+    SkOpContour* const* listEnd = contourList.end();
+    do {
+        SkOpContour* const* nextPtr = currentPtr;
+        SkOpContour* current = *currentPtr++;
+        do {
+            SkOpContour* next = *nextPtr++;
+            if (current != next) {
+                if (AlmostLessUlps(current->bounds().fBottom, next->bounds().fTop)) {
+                    break;
+                }
+                if (!SkPathOpsBounds::Intersects(current->bounds(), next->bounds())) {
+                    continue;
+                }
+            }
+            const int testCount = current->segments().count();
+            const int nextCount = next->segments().count();
+            for (int testIndex = 0; testIndex < testCount; ++testIndex) {
+                const int firstNext = current == next ? testIndex + 1 : 0;
+                if (firstNext >= nextCount) {
+                    continue;
+                }
+                IntersectRow* row = rows.append();
+                row->fTest = current;
+                row->fNext = next;
+                row->fTestIndex = testIndex;
+                row->fFirstNext = firstNext;
+                segmentPairs += nextCount - firstNext;
+            }
+            ContourPair* pair = pairs.append();
+            pair->fTest = current;
+            pair->fNext = next;
+            pair->fRowEnd = rows.count();
+        } while (nextPtr != listEnd);
+    } while (currentPtr != listEnd);
+
+    threadCount = (int) SkTMin<int64_t>(threadCount, segmentPairs / kMinSegmentPairsPerThread);
+    if (threadCount <= 1) {
+        addAllIntersectTs(contourList);
+        return;
+    }
+
+    // Give each thread a run of rows with about the same number of segment pairs to check.
+    // We do the first run ourselves.
+    SkAutoTArray<IntersectTask> tasks(threadCount);
+    int rowIndex = 0;
+    int64_t checked = 0;
+    for (int i = 0; i < threadCount; ++i) {
+        const int first = rowIndex;
+        const int64_t stop = segmentPairs * (i + 1) / threadCount;
+        while (rowIndex < rows.count() && checked < stop) {
+            const IntersectRow& row = rows[rowIndex++];
+            checked += row.fNext->segments().count() - row.fFirstNext;
+        }
+        tasks[i].init(rows.begin() + first, rowIndex - first, i);
+    }
+    {
+        SkThreadPool pool(threadCount - 1);
+        for (int i = 1; i < threadCount; ++i) {
+            pool.add(&tasks[i]);
+        }
+        tasks[0].run();
+        pool.wait();
+    }
+
+    // Add what was found in the order the single-threaded loop would have found it, so that the
+    // contours end up exactly the same.
+    rowIndex = 0;
+    for (int pIndex = 0; pIndex < pairs.count(); ++pIndex) {
+        const ContourPair& pair = pairs[pIndex];
+        if (pair.fTest == pair.fNext && pair.fTest->containsCubics()) {
+            AddSelfIntersectTs(pair.fTest);
+        }
+        bool foundCommonContour = pair.fTest == pair.fNext;
+        for (; rowIndex < pair.fRowEnd; ++rowIndex) {
+            const IntersectRow& row = rows[rowIndex];
+            IntersectTask& task = tasks[row.fTask];
+            SkIntersectionHelper wt;
+            wt.init(row.fTest, row.fTestIndex);
+            for (int index = 0; index < row.fFoundCount; ++index) {
+                FoundIntersections& found = task.found(row.fFirstFound + index);
+                SkIntersectionHelper wn;
+                wn.init(row.fNext, found.fNextIndex);
+                addIntersections(wt, wn, found.fPts, found.fSwap, &found.fTs,
+                        &foundCommonContour);
+            }
+        }
+    }
+}
+
 // resolve any coincident pairs found while intersecting, and
 // see if coincidence is formed by clipping non-concident segments
 void CoincidenceCheck(SkTArray<SkOpContour*, true>* contourList, int total) {
@@ -13,6 +13,10 @@
 
 bool AddIntersectTs(SkOpContour* test, SkOpContour* next);
 void AddSelfIntersectTs(SkOpContour* test);
+// Adds the intersections between every pair of contours in the list, and within each. If
+// threadCount > 1, large lists have their segment pairs checked on up to that many threads; the
+// contours end up the same either way.
+void AddAllIntersectTs(const SkTArray<SkOpContour*, true>& contourList, int threadCount);
 void CoincidenceCheck(SkTArray<SkOpContour*, true>* contourList, int total);
 
 #endif
@@ -25,6 +25,11 @@ public:
         return fContour->addCoincident(fIndex, other.fContour, other.fIndex, ts, swap);
     }
 
+    void addCross(SkIntersectionHelper& other) {
+        fContour->addCross(other.fContour);
+        other.fContour->addCross(fContour);
+    }
+
     // FIXME: does it make sense to write otherIndex now if we're going to
     // fix it up later?
     void addOtherT(int index, double otherT, int otherIndex) {
@@ -73,6 +78,15 @@ public:
         fLast = contour->segments().count();
     }
 
+    void init(SkOpContour* contour, int index) {
+        init(contour);
+        fIndex = index;
+    }
+
+    int index() const {
+        return fIndex;
+    }
+
     bool isAdjacent(const SkIntersectionHelper& next) {
         return fContour == next.fContour && fIndex + 1 == next.fIndex;
     }
@@ -1095,32 +1095,16 @@ bool SkOpAngle::tangentsDiverge(const SkOpAngle& rh, double s0xt0) const {
     return mFactor < 5000;  // empirically found limit
 }
 
-SkOpAngleSet::SkOpAngleSet() 
-    : fAngles(NULL)
+SkOpAngleSet::SkOpAngleSet() {
 #if DEBUG_ANGLE
-    , fCount(0)
+    fCount = 0;
 #endif
-{
 }
 
-SkOpAngleSet::~SkOpAngleSet() {
-    SkDELETE(fAngles);
-}
-
-SkOpAngle& SkOpAngleSet::push_back() {
-    if (!fAngles) {
-        fAngles = SkNEW_ARGS(SkChunkAlloc, (2));
-    }
-    void* ptr = fAngles->allocThrow(sizeof(SkOpAngle));
-    SkOpAngle* angle = (SkOpAngle*) ptr;
+SkOpAngle& SkOpAngleSet::push_back(SkChunkAlloc* allocator) {
+    SkOpAngle* angle = SkOpTAllocator<SkOpAngle>::Allocate(allocator);
 #if DEBUG_ANGLE
     angle->setID(++fCount);
 #endif
     return *angle;
 }
-
-void SkOpAngleSet::reset() {
-    if (fAngles) {
-        fAngles->reset();
-    }
-}
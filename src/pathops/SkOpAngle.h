@@ -7,7 +7,7 @@
 #ifndef SkOpAngle_DEFINED
 #define SkOpAngle_DEFINED
 
-#include "SkChunkAlloc.h"
+#include "SkOpTAllocator.h"
 #include "SkLineParameters.h"
 
 class SkOpSegment;
@@ -152,18 +152,17 @@ private:
     friend class PathOpsAngleTester;
 };
 
+// A segment's angles. They are allocated from the operation's allocator, so they stay put if the
+// segment is copied and are all freed together when the operation is done.
 class SkOpAngleSet {
 public:
     SkOpAngleSet();
-    ~SkOpAngleSet();
-    SkOpAngle& push_back();
-    void reset();
+    SkOpAngle& push_back(SkChunkAlloc* allocator);
 private:
     void dump() const;  // utility to be called by user from debugger
 #if DEBUG_ANGLE
     int fCount;
 #endif
-    SkChunkAlloc* fAngles;
 };
 
 #endif
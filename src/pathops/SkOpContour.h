@@ -28,7 +28,8 @@ struct SkCoincidence {
 
 class SkOpContour {
 public:
-    SkOpContour() {
+    SkOpContour()
+        : fAllocator(NULL) {
         reset();
 #if defined(SK_DEBUG) || !FORCE_RELEASE
         fID = sk_atomic_inc(&SkPathOpsDebug::gContourID);
@@ -55,12 +56,12 @@ public:
     }
 
     void addCubic(const SkPoint pts[4]) {
-        fSegments.push_back().addCubic(pts, fOperand, fXor);
+        fSegments.push_back(fAllocator).addCubic(pts, fOperand, fXor, fAllocator);
         fContainsCurves = fContainsCubics = true;
     }
 
     int addLine(const SkPoint pts[2]) {
-        fSegments.push_back().addLine(pts, fOperand, fXor);
+        fSegments.push_back(fAllocator).addLine(pts, fOperand, fXor, fAllocator);
         return fSegments.count();
     }
 
@@ -72,7 +73,7 @@ public:
                        const SkIntersections& ts, int ptIndex, bool swap);
 
     int addQuad(const SkPoint pts[3]) {
-        fSegments.push_back().addQuad(pts, fOperand, fXor);
+        fSegments.push_back(fAllocator).addQuad(pts, fOperand, fXor, fAllocator);
         fContainsCurves = true;
         return fSegments.count();
     }
@@ -229,6 +230,10 @@ public:
         return fOperand;
     }
 
+    void reserveSegments(int count) {
+        fSegments.setReserve(count, fAllocator);
+    }
+
     void reset() {
         fSegments.reset();
         fBounds.set(SK_ScalarMax, SK_ScalarMax, SK_ScalarMax, SK_ScalarMax);
@@ -237,10 +242,14 @@ public:
 
     void resolveNearCoincidence();
 
-    SkTArray<SkOpSegment>& segments() {
+    SkOpTArray<SkOpSegment>& segments() {
         return fSegments;
     }
 
+    void setAllocator(SkChunkAlloc* allocator) {
+        fAllocator = allocator;
+    }
+
     void setContainsIntercepts() {
         fContainsIntercepts = true;
     }
@@ -294,7 +303,7 @@ public:
     }
 
 #if DEBUG_TEST
-    SkTArray<SkOpSegment>& debugSegments() {
+    SkOpTArray<SkOpSegment>& debugSegments() {
         return fSegments;
     }
 #endif
@@ -331,7 +340,8 @@ private:
     void joinCoincidence(const SkTArray<SkCoincidence, true>& , bool partial);
     void setBounds();
 
-    SkTArray<SkOpSegment> fSegments;
+    SkChunkAlloc* fAllocator;  // owned by the operation; holds fSegments
+    SkOpTArray<SkOpSegment> fSegments;
     SkTArray<SkOpSegment*, true> fSortedSegments;
     int fFirstSorted;
     SkTArray<SkCoincidence, true> fCoincidences;
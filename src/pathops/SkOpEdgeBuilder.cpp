@@ -135,6 +135,23 @@ bool SkOpEdgeBuilder::close() {
     return true;
 }
 
+// Counts the segments in the contour whose verbs start at verbPtr. Unless open contours are
+// allowed, preFetch() has already added the line that closes the contour, if it needs one.
+static int countSegments(const uint8_t* verbPtr) {
+    int count = 0;
+    for (;;) {
+        switch (*verbPtr++) {
+            case SkPath::kLine_Verb:
+            case SkPath::kQuad_Verb:
+            case SkPath::kCubic_Verb:
+                ++count;
+                break;
+            default:
+                return count;
+        }
+    }
+}
+
 bool SkOpEdgeBuilder::walk() {
     uint8_t* verbPtr = fPathVerbs.begin();
     uint8_t* endOfFirstHalf = &verbPtr[fSecondHalf];
@@ -156,9 +173,12 @@ bool SkOpEdgeBuilder::walk() {
                 }
                 if (!fCurrentContour) {
                     fCurrentContour = fContours.push_back_n(1);
+                    fCurrentContour->setAllocator(fAllocator);
                     fCurrentContour->setOperand(fOperand);
                     fCurrentContour->setXor(fXorMask[fOperand] == kEvenOdd_PathOpsMask);
                 }
+                // A contour that was left empty is reused, so size it for this one.
+                fCurrentContour->reserveSegments(countSegments(verbPtr));
                 pointsPtr += 1;
                 continue;
             case SkPath::kLine_Verb:
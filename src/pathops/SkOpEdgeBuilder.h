@@ -13,16 +13,19 @@
 
 class SkOpEdgeBuilder {
 public:
-    SkOpEdgeBuilder(const SkPathWriter& path, SkTArray<SkOpContour>& contours)
+    SkOpEdgeBuilder(const SkPathWriter& path, SkTArray<SkOpContour>& contours,
+            SkChunkAlloc* allocator)
         : fPath(path.nativePath())
         , fContours(contours)
+        , fAllocator(allocator)
         , fAllowOpenContours(true) {
         init();
     }
 
-    SkOpEdgeBuilder(const SkPath& path, SkTArray<SkOpContour>& contours)
+    SkOpEdgeBuilder(const SkPath& path, SkTArray<SkOpContour>& contours, SkChunkAlloc* allocator)
         : fPath(&path)
         , fContours(contours)
+        , fAllocator(allocator)
         , fAllowOpenContours(false) {
         init();
     }
@@ -53,6 +56,7 @@ private:
     SkTArray<uint8_t, true> fPathVerbs;
     SkOpContour* fCurrentContour;
     SkTArray<SkOpContour>& fContours;
+    SkChunkAlloc* fAllocator;
     SkPathOpsMask fXorMask[2];
     int fSecondHalf;
     bool fOperand;
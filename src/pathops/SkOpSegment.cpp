@@ -350,8 +350,9 @@ void SkOpSegment::addCoinOutsides(const SkPoint& startPt, const SkPoint& endPt,
     } while (endPt != nextPt);
 }
 
-void SkOpSegment::addCubic(const SkPoint pts[4], bool operand, bool evenOdd) {
-    init(pts, SkPath::kCubic_Verb, operand, evenOdd);
+void SkOpSegment::addCubic(const SkPoint pts[4], bool operand, bool evenOdd,
+        SkChunkAlloc* allocator) {
+    init(pts, SkPath::kCubic_Verb, operand, evenOdd, allocator);
     fBounds.setCubicBounds(pts);
 }
 
@@ -412,7 +413,7 @@ void SkOpSegment::addEndSpan(int endIndex) {
         SkASSERT(startIndex < spanCount - 1);
         ++endIndex;
     }
-    SkOpAngle& angle = fAngles.push_back();
+    SkOpAngle& angle = fAngles.push_back(fAllocator);
     angle.set(this, spanCount - 1, startIndex);
 #if DEBUG_ANGLE
     debugCheckPointsEqualish(endIndex, spanCount);
@@ -427,8 +428,9 @@ void SkOpSegment::setFromAngle(int endIndex, SkOpAngle* angle) {
     } while (++endIndex < spanCount);
 }
 
-void SkOpSegment::addLine(const SkPoint pts[2], bool operand, bool evenOdd) {
-    init(pts, SkPath::kLine_Verb, operand, evenOdd);
+void SkOpSegment::addLine(const SkPoint pts[2], bool operand, bool evenOdd,
+        SkChunkAlloc* allocator) {
+    init(pts, SkPath::kLine_Verb, operand, evenOdd, allocator);
     fBounds.set(pts, 2);
 }
 
@@ -444,8 +446,9 @@ void SkOpSegment::addOtherT(int index, double otherT, int otherIndex) {
     span.fOtherIndex = otherIndex;
 }
 
-void SkOpSegment::addQuad(const SkPoint pts[3], bool operand, bool evenOdd) {
-    init(pts, SkPath::kQuad_Verb, operand, evenOdd);
+void SkOpSegment::addQuad(const SkPoint pts[3], bool operand, bool evenOdd,
+        SkChunkAlloc* allocator) {
+    init(pts, SkPath::kQuad_Verb, operand, evenOdd, allocator);
     fBounds.setQuadBounds(pts);
 }
 
@@ -453,7 +456,7 @@ SkOpAngle* SkOpSegment::addSingletonAngleDown(SkOpSegment** otherPtr, SkOpAngle*
     int spanIndex = count() - 1;
     int startIndex = nextExactSpan(spanIndex, -1);
     SkASSERT(startIndex >= 0);
-    SkOpAngle& angle = fAngles.push_back();
+    SkOpAngle& angle = fAngles.push_back(fAllocator);
     *anglePtr = &angle;
     angle.set(this, spanIndex, startIndex);
     setFromAngle(spanIndex, &angle);
@@ -472,7 +475,7 @@ SkOpAngle* SkOpSegment::addSingletonAngleDown(SkOpSegment** otherPtr, SkOpAngle*
         oStartIndex = other->nextExactSpan(oEndIndex, -1);
         --spanIndex;
     } while (oStartIndex < 0 || !other->span(oStartIndex).fWindSum);
-    SkOpAngle& oAngle = other->fAngles.push_back();
+    SkOpAngle& oAngle = other->fAngles.push_back(other->fAllocator);
     oAngle.set(other, oStartIndex, oEndIndex);
     other->setToAngle(oEndIndex, &oAngle);
     *otherPtr = other;
@@ -482,7 +485,7 @@ SkOpAngle* SkOpSegment::addSingletonAngleDown(SkOpSegment** otherPtr, SkOpAngle*
 SkOpAngle* SkOpSegment::addSingletonAngleUp(SkOpSegment** otherPtr, SkOpAngle** anglePtr) {
     int endIndex = nextExactSpan(0, 1);
     SkASSERT(endIndex > 0);
-    SkOpAngle& angle = fAngles.push_back();
+    SkOpAngle& angle = fAngles.push_back(fAllocator);
     *anglePtr = &angle;
     angle.set(this, 0, endIndex);
     setToAngle(endIndex, &angle);
@@ -502,7 +505,7 @@ SkOpAngle* SkOpSegment::addSingletonAngleUp(SkOpSegment** otherPtr, SkOpAngle**
         oEndIndex = other->nextExactSpan(oStartIndex, 1);
         ++spanIndex;
     } while (oEndIndex < 0 || !other->span(oStartIndex).fWindValue);
-    SkOpAngle& oAngle = other->fAngles.push_back();
+    SkOpAngle& oAngle = other->fAngles.push_back(other->fAllocator);
     oAngle.set(other, oEndIndex, oStartIndex);
     other->setFromAngle(oEndIndex, &oAngle);
     *otherPtr = other;
@@ -523,7 +526,7 @@ SkOpAngle* SkOpSegment::addSingletonAngles(int step) {
 
 void SkOpSegment::addStartSpan(int endIndex) {
     int index = 0;
-    SkOpAngle& angle = fAngles.push_back();
+    SkOpAngle& angle = fAngles.push_back(fAllocator);
     angle.set(this, index, endIndex);
 #if DEBUG_ANGLE
     debugCheckPointsEqualish(index, endIndex);
@@ -583,10 +586,10 @@ int SkOpSegment::addT(SkOpSegment* other, const SkPoint& pt, double newT) {
     }
     SkOpSpan* span;
     if (insertedAt >= 0) {
-        span = fTs.insert(insertedAt);
+        span = fTs.insert(insertedAt, fAllocator);
     } else {
         insertedAt = tCount;
-        span = fTs.append();
+        span = fTs.append(fAllocator);
     }
     span->fT = newT;
     span->fOtherT = -1;
@@ -1032,22 +1035,22 @@ void SkOpSegment::blindCancel(const SkCoincidence& coincidence, SkOpSegment* oth
     bool binary = fOperand != other->fOperand;
     int index = 0;
     int last = this->count();
-    do {
-        SkOpSpan& span = this->fTs[--last];
+    while (--last >= 0) {
+        SkOpSpan& span = this->fTs[last];
         if (span.fT != 1 && !span.fSmall) {
             break;
         }
         span.fCoincident = true;
-    } while (true);
+    }
     int oIndex = other->count();
-    do {
-        SkOpSpan& oSpan = other->fTs[--oIndex];
+    while (--oIndex >= 0) {
+        SkOpSpan& oSpan = other->fTs[oIndex];
         if (oSpan.fT != 1 && !oSpan.fSmall) {
             break;
         }
         oSpan.fCoincident = true;
-    } while (true);
-    do {
+    }
+    while (index <= last && oIndex >= 0) {
         SkOpSpan* test = &this->fTs[index];
         int baseWind = test->fWindValue;
         int baseOpp = test->fOppValue;
@@ -1097,7 +1100,7 @@ void SkOpSegment::blindCancel(const SkCoincidence& coincidence, SkOpSegment* oth
             oTest->fCoincident = true;
             oTest = &other->fTs[--oIndex];
         } while (oIndex > oStartIndex);
-    } while (index <= last && oIndex >= 0);
+    }
     SkASSERT(index > last);
     SkASSERT(oIndex < 0);
 }
@@ -1106,23 +1109,23 @@ void SkOpSegment::blindCoincident(const SkCoincidence& coincidence, SkOpSegment*
     bool binary = fOperand != other->fOperand;
     int index = 0;
     int last = this->count();
-    do {
-        SkOpSpan& span = this->fTs[--last];
+    while (--last >= 0) {
+        SkOpSpan& span = this->fTs[last];
         if (span.fT != 1 && !span.fSmall) {
             break;
         }
         span.fCoincident = true;
-    } while (true);
+    }
     int oIndex = 0;
     int oLast = other->count();
-    do {
-        SkOpSpan& oSpan = other->fTs[--oLast];
+    while (--oLast >= 0) {
+        SkOpSpan& oSpan = other->fTs[oLast];
         if (oSpan.fT != 1 && !oSpan.fSmall) {
             break;
         }
         oSpan.fCoincident = true;
-    } while (true);
-    do {
+    }
+    while (index <= last && oIndex <= oLast) {
         SkOpSpan* test = &this->fTs[index];
         int baseWind = test->fWindValue;
         int baseOpp = test->fOppValue;
@@ -1161,7 +1164,7 @@ void SkOpSegment::blindCoincident(const SkCoincidence& coincidence, SkOpSegment*
         }
         index = endIndex;
         oIndex = oEndIndex;
-    } while (index <= last && oIndex <= oLast);
+    }
     SkASSERT(index > last);
     SkASSERT(oIndex > oLast);
 }
@@ -1483,13 +1486,13 @@ bool SkOpSegment::calcAngles() {
         if (activePrior >= 0) {
             int pActive = firstActive(prior);
             SkASSERT(pActive < start);
-            priorAngle = &fAngles.push_back();
+            priorAngle = &fAngles.push_back(fAllocator);
             priorAngle->set(this, start, pActive);
         }
         int active = checkSetAngle(start);
         if (active >= 0) {
             SkASSERT(active < index);
-            angle = &fAngles.push_back();
+            angle = &fAngles.push_back(fAllocator);
             angle->set(this, active, index);
         }
     #if DEBUG_ANGLE
@@ -3207,7 +3210,9 @@ bool SkOpSegment::inCoincidentSpan(double t, const SkOpSegment* other) const {
     return foundEnds == 0x3 || foundEnds == 0x5 || foundEnds == 0x6;  // two bits set
 }
 
-void SkOpSegment::init(const SkPoint pts[], SkPath::Verb verb, bool operand, bool evenOdd) {
+void SkOpSegment::init(const SkPoint pts[], SkPath::Verb verb, bool operand, bool evenOdd,
+        SkChunkAlloc* allocator) {
+    fAllocator = allocator;
     fDoneSpans = 0;
     fOperand = operand;
     fXor = evenOdd;
@@ -9,6 +9,7 @@
 
 #include "SkOpAngle.h"
 #include "SkOpSpan.h"
+#include "SkOpTAllocator.h"
 #include "SkPathOpsBounds.h"
 #include "SkPathOpsCurve.h"
 #include "SkTArray.h"
@@ -172,7 +173,7 @@ public:
     }
 
     void reset() {
-        init(NULL, (SkPath::Verb) -1, false, false);
+        init(NULL, (SkPath::Verb) -1, false, false, NULL);
         fBounds.set(SK_ScalarMax, SK_ScalarMax, SK_ScalarMax, SK_ScalarMax);
         fTs.reset();
     }
@@ -271,12 +272,12 @@ public:
     SkPoint activeLeftTop(int* firstT) const;
     bool activeOp(int index, int endIndex, int xorMiMask, int xorSuMask, SkPathOp op);
     bool activeWinding(int index, int endIndex);
-    void addCubic(const SkPoint pts[4], bool operand, bool evenOdd);
+    void addCubic(const SkPoint pts[4], bool operand, bool evenOdd, SkChunkAlloc* );
     void addCurveTo(int start, int end, SkPathWriter* path, bool active) const;
     void addEndSpan(int endIndex);
-    void addLine(const SkPoint pts[2], bool operand, bool evenOdd);
+    void addLine(const SkPoint pts[2], bool operand, bool evenOdd, SkChunkAlloc* );
     void addOtherT(int index, double otherT, int otherIndex);
-    void addQuad(const SkPoint pts[3], bool operand, bool evenOdd);
+    void addQuad(const SkPoint pts[3], bool operand, bool evenOdd, SkChunkAlloc* );
     void addSimpleAngle(int endIndex);
     int addSelfT(const SkPoint& pt, double newT);
     void addStartSpan(int endIndex);
@@ -370,7 +371,7 @@ public:
 #if DEBUG_SHOW_WINDING
     int debugShowWindingValues(int slotCount, int ofInterest) const;
 #endif
-    const SkTDArray<SkOpSpan>& debugSpans() const;
+    const SkOpTArray<SkOpSpan>& debugSpans() const;
     void debugValidate() const;
     // available to testing only
     const SkOpAngle* debugLastAngle() const;
@@ -434,7 +435,8 @@ private:
     int findStartSpan(int startIndex) const;
     int firstActive(int tIndex) const;
     const SkOpSpan& firstSpan(const SkOpSpan& thisSpan) const;
-    void init(const SkPoint pts[], SkPath::Verb verb, bool operand, bool evenOdd);
+    void init(const SkPoint pts[], SkPath::Verb verb, bool operand, bool evenOdd,
+              SkChunkAlloc* );
     bool inCoincidentSpan(double t, const SkOpSegment* other) const;
     bool inLoop(const SkOpAngle* baseAngle, int spanCount, int* indexPtr) const;
 #if OLD_CHASE
@@ -520,17 +522,17 @@ private:
 #endif
     // available to testing only
     void debugConstruct();
-    void debugConstructCubic(SkPoint shortQuad[4]);
-    void debugConstructLine(SkPoint shortQuad[2]);
-    void debugConstructQuad(SkPoint shortQuad[3]);
+    void debugConstructCubic(SkPoint shortQuad[4], SkChunkAlloc* );
+    void debugConstructLine(SkPoint shortQuad[2], SkChunkAlloc* );
+    void debugConstructQuad(SkPoint shortQuad[3], SkChunkAlloc* );
     void debugReset();
     void dumpDPts() const;
     void dumpSpan(int index) const;
 
     const SkPoint* fPts;
     SkPathOpsBounds fBounds;
-    // FIXME: can't convert to SkTArray because it uses insert
-    SkTDArray<SkOpSpan> fTs;  // 2+ (always includes t=0 t=1) -- at least (number of spans) + 1
+    SkChunkAlloc* fAllocator;  // owned by the operation; holds fTs and fAngles
+    SkOpTArray<SkOpSpan> fTs;  // 2+ (always includes t=0 t=1) -- at least (number of spans) + 1
     SkOpAngleSet fAngles;  // empty or 2+ -- (number of non-zero spans) * 2
     // OPTIMIZATION: could pack donespans, verb, operand, xor into 1 int-sized value
     int fDoneSpans;  // quick check that segment is finished
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#ifndef SkOpTAllocator_DEFINED
+#define SkOpTAllocator_DEFINED
+
+#include "SkChunkAlloc.h"
+
+// All of the working state of one Op() or Simplify() call (segments, spans and angles) comes from
+// a single SkChunkAlloc owned by that call, and is freed in one shot when the call returns.
+// Nothing allocated here has its destructor run, so T must not need one.
+template<typename T>
+class SkOpTAllocator {
+public:
+    static T* Allocate(SkChunkAlloc* allocator) {
+        return AllocateArray(allocator, 1);
+    }
+
+    static T* AllocateArray(SkChunkAlloc* allocator, int count) {
+        SkASSERT(count > 0);
+        void* ptr = allocator->allocThrow(sizeof(T) * count);
+        return (T*) ptr;
+    }
+};
+
+// An array whose storage comes from the operation's allocator. Growing it abandons the old
+// storage instead of freeing it, and elements are moved with memcpy, so T must be plain data
+// (though it may have a constructor, which push_back() runs).
+template<typename T>
+class SkOpTArray {
+public:
+    SkOpTArray()
+        : fArray(NULL)
+        , fCount(0)
+        , fReserve(0) {
+    }
+
+    T& back() {
+        SkASSERT(fCount > 0);
+        return fArray[fCount - 1];
+    }
+
+    const T& back() const {
+        SkASSERT(fCount > 0);
+        return fArray[fCount - 1];
+    }
+
+    T* begin() {
+        return fArray;
+    }
+
+    const T* begin() const {
+        return fArray;
+    }
+
+    int count() const {
+        return fCount;
+    }
+
+    T* end() {
+        return fArray + fCount;
+    }
+
+    const T* end() const {
+        return fArray + fCount;
+    }
+
+    T& front() {
+        SkASSERT(fCount > 0);
+        return fArray[0];
+    }
+
+    const T& front() const {
+        SkASSERT(fCount > 0);
+        return fArray[0];
+    }
+
+    // Makes room for an element at index and returns it, uninitialized.
+    T* insert(int index, SkChunkAlloc* allocator) {
+        SkASSERT(index >= 0 && index <= fCount);
+        if (fCount == fReserve) {
+            int reserve = fCount + 4;
+            reserve += reserve >> 2;
+            T* array = SkOpTAllocator<T>::AllocateArray(allocator, reserve);
+            if (fCount) {
+                memcpy(array, fArray, index * sizeof(T));
+                memcpy(array + index + 1, fArray + index, (fCount - index) * sizeof(T));
+            }
+            fArray = array;
+            fReserve = reserve;
+        } else {
+            memmove(fArray + index + 1, fArray + index, (fCount - index) * sizeof(T));
+        }
+        ++fCount;
+        return fArray + index;
+    }
+
+    // Returns a new, uninitialized element at the end.
+    T* append(SkChunkAlloc* allocator) {
+        return insert(fCount, allocator);
+    }
+
+    // Returns a new, default constructed element at the end.
+    T& push_back(SkChunkAlloc* allocator) {
+        return *SkNEW_PLACEMENT(append(allocator), T);
+    }
+
+    // Sizes an empty array for count elements, so that filling it never copies.
+    void setReserve(int count, SkChunkAlloc* allocator) {
+        SkASSERT(!fCount);
+        if (count > fReserve) {
+            fArray = SkOpTAllocator<T>::AllocateArray(allocator, count);
+            fReserve = count;
+        }
+    }
+
+    T& operator[](int index) {
+        SkASSERT(index < fCount);
+        return fArray[index];
+    }
+
+    const T& operator[](int index) const {
+        SkASSERT(index < fCount);
+        return fArray[index];
+    }
+
+    void reset() {
+        fArray = NULL;
+        fCount = fReserve = 0;
+    }
+
+private:
+    T* fArray;
+    int fCount;
+    int fReserve;
+};
+
+#endif
@@ -510,8 +510,9 @@ void Assemble(const SkPathWriter& path, SkPathWriter* simple) {
 #if DEBUG_PATH_CONSTRUCTION
     SkDebugf("%s\n", __FUNCTION__);
 #endif
+    SkChunkAlloc allocator(4096);  // holds the angles and spans of every segment
     SkTArray<SkOpContour> contours;
-    SkOpEdgeBuilder builder(path, contours);
+    SkOpEdgeBuilder builder(path, contours, &allocator);
     builder.finish();
     int count = contours.count();
     int outer;
@@ -347,7 +347,6 @@ const SkOpAngle* SkOpSegment::debugLastAngle() const {
 
 void SkOpSegment::debugReset() {
     fTs.reset();
-    fAngles.reset();
 }
 
 #if DEBUG_CONCIDENT
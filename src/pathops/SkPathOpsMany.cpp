@@ -0,0 +1,218 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#include "SkPathOps.h"
+#include "SkPath.h"
+#include "SkTArray.h"
+#include "SkTDArray.h"
+#include "SkTSort.h"
+
+namespace {
+
+// Touching bounds count as overlapping, so that paths sharing an edge are merged.
+inline bool bounds_overlap(const SkRect& a, const SkRect& b) {
+    return a.fLeft <= b.fRight && b.fLeft <= a.fRight && a.fTop <= b.fBottom && b.fTop <= a.fBottom;
+}
+
+class LeftLessThan {
+public:
+    LeftLessThan(const SkRect* bounds) : fBounds(bounds) { }
+    bool operator()(int one, int two) const {
+        return fBounds[one].fLeft < fBounds[two].fLeft;
+    }
+private:
+    const SkRect* fBounds;
+};
+
+int find_root(SkTDArray<int>& parents, int index) {
+    while (parents[index] != index) {
+        parents[index] = parents[parents[index]];
+        index = parents[index];
+    }
+    return index;
+}
+
+// Combines paths[indices[0..count)] with op. Neighbors are combined in pairs, then pairs of
+// those results, and so on, so each level of the reduction handles every contour once rather
+// than carrying an ever larger result through count - 1 operations.
+bool reduce(const SkPath paths[], const int indices[], int count, SkPathOp op, SkPath* result) {
+    SkASSERT(count > 0);
+    if (1 == count) {
+        return Simplify(paths[indices[0]], result);
+    }
+    SkTArray<SkPath> level;
+    level.push_back_n((count + 1) / 2);
+    for (int i = 0; i + 1 < count; i += 2) {
+        if (!Op(paths[indices[i]], paths[indices[i + 1]], op, &level[i / 2])) {
+            return false;
+        }
+    }
+    if (count & 1) {
+        if (!Simplify(paths[indices[count - 1]], &level.back())) {
+            return false;
+        }
+    }
+    while (level.count() > 1) {
+        const int levelCount = level.count();
+        for (int i = 0; i + 1 < levelCount; i += 2) {
+            // level[i / 2] has already been consumed, unless it's level[i] itself.
+            if (!Op(level[i], level[i + 1], op, &level[i / 2])) {
+                return false;
+            }
+        }
+        if (levelCount & 1) {
+            level[levelCount / 2] = level[levelCount - 1];
+        }
+        level.pop_back_n(levelCount / 2);
+    }
+    *result = level[0];
+    return true;
+}
+
+// Union or XOR of paths with non-inverse fills: paths whose bounds don't touch can't affect
+// each other, so the clusters of overlapping paths are found with a sweep from left to right,
+// combined separately and appended to one another.
+bool combine_clusters(const SkPath paths[], int count, SkPathOp op, SkPath* result) {
+    SkTDArray<SkRect> bounds;
+    SkTDArray<int> parents;
+    SkTDArray<int> sorted;
+    bounds.setCount(count);
+    parents.setCount(count);
+    for (int index = 0; index < count; ++index) {
+        bounds[index] = paths[index].getBounds();
+        parents[index] = index;
+        // Empty operands add nothing to a union or XOR.
+        if (!paths[index].isEmpty()) {
+            *sorted.append() = index;
+        }
+    }
+    if (sorted.count() > 1) {
+        SkTQSort<int>(sorted.begin(), sorted.end() - 1, LeftLessThan(bounds.begin()));
+    }
+
+    // The active paths are those whose right edge is not yet left of the sweep.
+    SkTDArray<int> active;
+    for (int i = 0; i < sorted.count(); ++i) {
+        const int index = sorted[i];
+        const SkRect& current = bounds[index];
+        int kept = 0;
+        for (int a = 0; a < active.count(); ++a) {
+            const int other = active[a];
+            if (bounds[other].fRight < current.fLeft) {
+                continue;
+            }
+            active[kept++] = other;
+            if (bounds_overlap(bounds[other], current)) {
+                parents[find_root(parents, other)] = find_root(parents, index);
+            }
+        }
+        active.setCount(kept);
+        *active.append() = index;
+    }
+
+    // Gather each cluster's paths, keeping them in sweep order so paired paths are close.
+    SkTDArray<int> clusterOfRoot;
+    clusterOfRoot.setCount(count);
+    for (int index = 0; index < count; ++index) {
+        clusterOfRoot[index] = -1;
+    }
+    SkTArray<SkTDArray<int> > clusters;
+    for (int i = 0; i < sorted.count(); ++i) {
+        const int root = find_root(parents, sorted[i]);
+        if (clusterOfRoot[root] < 0) {
+            clusterOfRoot[root] = clusters.count();
+            clusters.push_back();
+        }
+        *clusters[clusterOfRoot[root]].append() = sorted[i];
+    }
+
+    SkPath combined;
+    combined.setFillType(SkPath::kEvenOdd_FillType);
+    SkPath clusterResult;
+    for (int c = 0; c < clusters.count(); ++c) {
+        if (!reduce(paths, clusters[c].begin(), clusters[c].count(), op, &clusterResult)) {
+            return false;
+        }
+        combined.addPath(clusterResult);
+    }
+    *result = combined;
+    return true;
+}
+
+}  // namespace
+
+bool OpMany(const SkPath paths[], int count, SkPathOp op, SkPath* result) {
+    if (count <= 0) {
+        result->reset();
+        return true;
+    }
+    bool inverse = false;
+    for (int index = 0; index < count; ++index) {
+        inverse |= paths[index].isInverseFillType();
+    }
+
+    if (kReverseDifference_PathOp == op || (inverse && kDifference_PathOp == op)) {
+        // These depend on the order, so they're applied as written.
+        SkPath accumulated = paths[0];
+        if (1 == count && !Simplify(accumulated, &accumulated)) {
+            return false;
+        }
+        for (int index = 1; index < count; ++index) {
+            if (!Op(accumulated, paths[index], op, &accumulated)) {
+                return false;
+            }
+        }
+        *result = accumulated;
+        return true;
+    }
+
+    if (kDifference_PathOp == op) {
+        // Only the operands overlapping the minuend can take anything away from it.
+        const SkRect& minuendBounds = paths[0].getBounds();
+        SkTArray<SkPath> subtrahends;
+        for (int index = 1; index < count; ++index) {
+            if (!paths[index].isEmpty() &&
+                    bounds_overlap(paths[index].getBounds(), minuendBounds)) {
+                subtrahends.push_back(paths[index]);
+            }
+        }
+        if (0 == subtrahends.count()) {
+            return Simplify(paths[0], result);
+        }
+        SkPath subtrahend;
+        if (!OpMany(subtrahends.begin(), subtrahends.count(), kUnion_PathOp, &subtrahend)) {
+            return false;
+        }
+        return Op(paths[0], subtrahend, kDifference_PathOp, result);
+    }
+
+    if (!inverse && (kUnion_PathOp == op || kXOR_PathOp == op)) {
+        return combine_clusters(paths, count, op, result);
+    }
+
+    SkTDArray<int> indices;
+    indices.setCount(count);
+    for (int index = 0; index < count; ++index) {
+        indices[index] = index;
+    }
+    if (!inverse && kIntersect_PathOp == op) {
+        // Operands that don't all overlap have an empty intersection.
+        SkRect common = paths[0].getBounds();
+        for (int index = 1; index < count; ++index) {
+            const SkRect& bounds = paths[index].getBounds();
+            common.set(SkTMax(common.fLeft, bounds.fLeft), SkTMax(common.fTop, bounds.fTop),
+                       SkTMin(common.fRight, bounds.fRight),
+                       SkTMin(common.fBottom, bounds.fBottom));
+            if (paths[index].isEmpty() || common.fLeft > common.fRight ||
+                    common.fTop > common.fBottom) {
+                result->reset();
+                result->setFillType(SkPath::kEvenOdd_FillType);
+                return true;
+            }
+        }
+    }
+    return reduce(paths, indices.begin(), count, op, result);
+}
@@ -155,7 +155,7 @@ static bool bridgeXor(SkTArray<SkOpContour*, true>& contourList, SkPathWriter* s
 }
 
 // FIXME : add this as a member of SkPath
-bool Simplify(const SkPath& path, SkPath* result) {
+bool Simplify(const SkPath& path, SkPath* result, int threadCount) {
 #if DEBUG_SORT || DEBUG_SWAP_TOP
     SkPathOpsDebug::gSortCount = SkPathOpsDebug::gSortCountDefault;
 #endif
@@ -164,32 +164,21 @@ bool Simplify(const SkPath& path, SkPath* result) {
             : SkPath::kEvenOdd_FillType;
 
     // turn path into list of segments
+    SkChunkAlloc allocator(4096);  // holds the angles and spans of every segment
     SkTArray<SkOpContour> contours;
-    SkOpEdgeBuilder builder(path, contours);
+    SkOpEdgeBuilder builder(path, contours, &allocator);
     if (!builder.finish()) {
         return false;
     }
     SkTArray<SkOpContour*, true> contourList;
     MakeContourList(contours, contourList, false, false);
-    SkOpContour** currentPtr = contourList.begin();
     result->reset();
     result->setFillType(fillType);
-    if (!currentPtr) {
+    if (!contourList.count()) {
         return true;
     }
-    SkOpContour** listEnd = contourList.end();
     // find all intersections between segments
-    do {
-        SkOpContour** nextPtr = currentPtr;
-        SkOpContour* current = *currentPtr++;
-        if (current->containsCubics()) {
-            AddSelfIntersectTs(current);
-        }
-        SkOpContour* next;
-        do {
-            next = *nextPtr++;
-        } while (AddIntersectTs(current, next) && nextPtr != listEnd);
-    } while (currentPtr != listEnd);
+    AddAllIntersectTs(contourList, threadCount);
     if (!HandleCoincidence(&contourList, 0)) {
         return false;
     }
@@ -207,3 +196,7 @@ bool Simplify(const SkPath& path, SkPath* result) {
     }
     return true;
 }
+
+bool Simplify(const SkPath& path, SkPath* result) {
+    return Simplify(path, result, 1);
+}
@@ -968,6 +968,28 @@ void SkPDFDevice::drawRRect(const SkDraw& draw, const SkRRect& rrect,
     this->drawPath(draw, path, paint, NULL, true);
 }
 
+// Batches skip SkBitmapDevice's raster path, and draw each shape as usual.
+void SkPDFDevice::drawRects(const SkDraw& draw, const SkRect rects[], const SkColor colors[],
+                            int count, const SkPaint& paint) {
+    this->SkBaseDevice::drawRects(draw, rects, colors, count, paint);
+}
+
+void SkPDFDevice::drawOvals(const SkDraw& draw, const SkRect ovals[], const SkColor colors[],
+                            int count, const SkPaint& paint) {
+    this->SkBaseDevice::drawOvals(draw, ovals, colors, count, paint);
+}
+
+void SkPDFDevice::drawRRects(const SkDraw& draw, const SkRRect rrects[], const SkColor colors[],
+                             int count, const SkPaint& paint) {
+    this->SkBaseDevice::drawRRects(draw, rrects, colors, count, paint);
+}
+
+void SkPDFDevice::drawAtlas(const SkDraw& draw, const SkBitmap& atlas, const SkMatrix xforms[],
+                            const SkIRect tex[], const SkColor colors[], int count,
+                            const SkPaint& paint) {
+    this->SkBaseDevice::drawAtlas(draw, atlas, xforms, tex, colors, count, paint);
+}
+
 void SkPDFDevice::drawPath(const SkDraw& d, const SkPath& origPath,
                            const SkPaint& paint, const SkMatrix* prePathMatrix,
                            bool pathIsMutable) {
@@ -94,6 +94,18 @@ public:
         return !fSilent;
     }
 
+    /**
+     *  Forget all the resources defined so far. Each writer session starts
+     *  with empty dictionaries, so this is called when a new one begins.
+     */
+    void resetResources() {
+        fPaint.reset();
+        fTypefaces.safeUnrefAll();
+        fFlatArray.safeUnrefAll();
+        fFactoryArray.reset();
+        fBitmaps.deleteAll();
+    }
+
     void setFlags(unsigned flags) {
         if (fFlags != flags) {
             fFlags = flags;
@@ -746,6 +758,10 @@ static void skip_rp(SkCanvas*, SkReader32* reader, uint32_t op32, SkGPipeState*)
 
 static void reportFlags_rp(SkCanvas*, SkReader32*, uint32_t op32,
                            SkGPipeState* state) {
+    // This is the first thing a new writer sends. With
+    // SkGPipeWriter::kPersistentResources_Flag it's only sent once, and later
+    // frames refer back to the resources we've kept since then.
+    state->resetResources();
     unsigned flags = DrawOp_unpackFlags(op32);
     state->setFlags(flags);
 }
@@ -37,6 +37,10 @@ static bool isCrossProcess(uint32_t flags) {
     return SkToBool(flags & SkGPipeWriter::kCrossProcess_Flag);
 }
 
+static bool persistsResources(uint32_t flags) {
+    return SkToBool(flags & SkGPipeWriter::kPersistentResources_Flag);
+}
+
 static SkFlattenable* get_paintflat(const SkPaint& paint, unsigned paintFlat) {
     SkASSERT(paintFlat < kCount_PaintFlats);
     switch (paintFlat) {
@@ -72,6 +76,7 @@ class FlattenableHeap : public SkFlatController {
 public:
     FlattenableHeap(int numFlatsToKeep, SkNamedFactorySet* fset, bool isCrossProcess)
     : INHERITED(isCrossProcess ? SkWriteBuffer::kCrossProcess_Flag : 0)
+    , fUseCount(0)
     , fNumFlatsToKeep(numFlatsToKeep) {
         SkASSERT((isCrossProcess && fset != NULL) || (!isCrossProcess && NULL == fset));
         if (isCrossProcess) {
@@ -97,6 +102,11 @@ public:
     // Takes the result of SkFlatData::index() as its parameter.
     void markFlatForKeeping(int index) {
         *fFlatsThatMustBeKept.append() = index;
+        // This is also a use, which flatToReplace needs to find the LRU flat.
+        while (fLastUse.count() < index) {
+            *fLastUse.append() = 0;
+        }
+        fLastUse[index - 1] = ++fUseCount;
     }
 
     void markAllFlatsSafeToDelete() {
@@ -108,6 +118,9 @@ private:
     // flats that must be kept, since they are on the current paint.
     SkTDArray<int>   fFlatsThatMustBeKept;
     SkTDArray<void*> fPointers;
+    // When each flat was last put on a paint, indexed by SkFlatData::index() - 1.
+    SkTDArray<uint32_t> fLastUse;
+    uint32_t         fUseCount;
     const int        fNumFlatsToKeep;
 
     typedef SkFlatController INHERITED;
@@ -129,25 +142,26 @@ void* FlattenableHeap::allocThrow(size_t bytes) {
 
 const SkFlatData* FlattenableHeap::flatToReplace() const {
     // First, determine whether we should replace one.
-    if (fPointers.count() > fNumFlatsToKeep) {
-        // Look through the flattenable heap.
-        // TODO: Return the LRU flat.
-        for (int i = 0; i < fPointers.count(); i++) {
-            SkFlatData* potential = (SkFlatData*)fPointers[i];
-            // Make sure that it is not one that must be kept.
-            bool mustKeep = false;
-            for (int j = 0; j < fFlatsThatMustBeKept.count(); j++) {
-                if (potential->index() == fFlatsThatMustBeKept[j]) {
-                    mustKeep = true;
-                    break;
-                }
-            }
-            if (!mustKeep) {
-                return potential;
-            }
+    if (fPointers.count() <= fNumFlatsToKeep) {
+        return NULL;
+    }
+    // Look through the flattenable heap for the least recently used flat.
+    const SkFlatData* lru = NULL;
+    uint32_t lruUse = 0;
+    for (int i = 0; i < fPointers.count(); i++) {
+        const SkFlatData* potential = (const SkFlatData*)fPointers[i];
+        // Make sure that it is not one that must be kept.
+        if (fFlatsThatMustBeKept.find(potential->index()) >= 0) {
+            continue;
+        }
+        const int index = potential->index();
+        const uint32_t use = index <= fLastUse.count() ? fLastUse[index - 1] : 0;
+        if (NULL == lru || use < lruUse) {
+            lru = potential;
+            lruUse = use;
         }
     }
-    return NULL;
+    return lru;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -202,13 +216,7 @@ public:
      *      being sent.
      */
     void finish(bool notifyReaders) {
-        if (fDone) {
-            return;
-        }
-        if (notifyReaders && this->needOpBytes()) {
-            this->writeOp(kDone_DrawOp);
-            this->doNotify();
-        }
+        this->endFrame(notifyReaders);
         if (shouldFlattenBitmaps(fFlags)) {
             // The following circular references exist:
             // fFlattenableHeap -> fWriteBuffer -> fBitmapStorage -> fExternalStorage -> fCanvas
@@ -218,7 +226,56 @@ public:
             // Break them all by destroying the final link to this SkGPipeCanvas.
             fBitmapShuttle->removeCanvas();
         }
-        fDone = true;
+    }
+
+    /**
+     *  Ends the current frame, like finish(), but keeps our dictionaries so
+     *  that beginFrame() can carry on where this frame left off. Repeated
+     *  calls only undo any saves left behind.
+     *
+     *  notifyReaders is false only when we run out of space in the middle of
+     *  a draw, where it's not safe to restore; the next endFrame(true) does it.
+     */
+    void endFrame(bool notifyReaders) {
+        if (!fDone) {
+            if (notifyReaders) {
+                if (persistsResources(fFlags)) {
+                    // Undo beginFrame's save(), and any the client left behind.
+                    this->restoreToCount(1);
+                }
+                if (this->needOpBytes()) {
+                    this->writeOp(kDone_DrawOp);
+                    this->doNotify();
+                }
+            }
+            if (!notifyReaders) {
+                // Some of this frame, maybe a resource definition, never reached
+                // the reader, so our dictionaries no longer match its tables.
+                fResourcesLost = true;
+            }
+            fDone = true;
+            // The next frame may use a different controller, so get a new block from it.
+            fBlockSize = 0;
+        }
+        if (notifyReaders) {
+            // Nothing gets written once fDone is set, so this only resets our own state.
+            this->restoreToCount(1);
+        }
+    }
+
+    /**
+     *  Starts another frame after endFrame(), writing to controller. Only
+     *  valid with kPersistentResources_Flag.
+     */
+    void beginFrame(SkGPipeController* controller);
+
+    uint32_t flags() const { return fFlags; }
+    bool isFrameDone() const { return fDone; }
+
+    bool canContinue(uint32_t flags, uint32_t width, uint32_t height) const {
+        const SkISize size = this->getBaseLayerSize();
+        return !fResourcesLost && flags == fFlags &&
+               SkToU32(size.width()) == width && SkToU32(size.height()) == height;
     }
 
     void flushRecording(bool detachCurrentBlock);
@@ -274,6 +331,14 @@ protected:
     virtual void didSetMatrix(const SkMatrix&) SK_OVERRIDE;
 
     virtual void onDrawDRRect(const SkRRect&, const SkRRect&, const SkPaint&) SK_OVERRIDE;
+    virtual void onDrawRects(const SkRect[], const SkColor[], int count,
+                             const SkPaint&) SK_OVERRIDE;
+    virtual void onDrawOvals(const SkRect[], const SkColor[], int count,
+                             const SkPaint&) SK_OVERRIDE;
+    virtual void onDrawRRects(const SkRRect[], const SkColor[], int count,
+                              const SkPaint&) SK_OVERRIDE;
+    virtual void onDrawAtlas(const SkBitmap&, const SkMatrix[], const SkIRect[],
+                             const SkColor[], int count, const SkPaint*) SK_OVERRIDE;
     virtual void onDrawText(const void* text, size_t byteLength, SkScalar x, SkScalar y,
                             const SkPaint&) SK_OVERRIDE;
     virtual void onDrawPosText(const void* text, size_t byteLength, const SkPoint pos[],
@@ -306,6 +371,7 @@ private:
     size_t             fBlockSize; // amount allocated for writer
     size_t             fBytesNotified;
     bool               fDone;
+    bool               fResourcesLost; // a frame ended in error
     const uint32_t     fFlags;
 
     SkRefCntSet        fTypefaceSet;
@@ -425,6 +491,10 @@ int SkGPipeCanvas::flattenToIndex(SkFlattenable* obj, PaintFlats paintflat) {
 #define MIN_BLOCK_SIZE  (16 * 1024)
 #define BITMAPS_TO_KEEP 5
 #define FLATTENABLES_TO_KEEP 10
+// With kPersistentResources_Flag the dictionaries have to hold a whole frame's
+// worth of resources, or we'd resend some of them every frame.
+#define PERSISTENT_BITMAPS_TO_KEEP 32
+#define PERSISTENT_FLATTENABLES_TO_KEEP 256
 
 SkGPipeCanvas::SkGPipeCanvas(SkGPipeController* controller,
                              SkWriter32* writer, uint32_t flags,
@@ -433,11 +503,14 @@ SkGPipeCanvas::SkGPipeCanvas(SkGPipeController* controller,
     , fFactorySet(isCrossProcess(flags) ? SkNEW(SkNamedFactorySet) : NULL)
     , fWriter(*writer)
     , fFlags(flags)
-    , fFlattenableHeap(FLATTENABLES_TO_KEEP, fFactorySet, isCrossProcess(flags))
+    , fFlattenableHeap(persistsResources(flags) ? PERSISTENT_FLATTENABLES_TO_KEEP
+                                                : FLATTENABLES_TO_KEEP,
+                       fFactorySet, isCrossProcess(flags))
     , fFlatDictionary(&fFlattenableHeap)
 {
     fController = controller;
     fDone = false;
+    fResourcesLost = false;
     fBlockSize = 0; // need first block from controller
     fBytesNotified = 0;
     fFirstSaveLayerStackLevel = kNoSaveLayer;
@@ -448,18 +521,32 @@ SkGPipeCanvas::SkGPipeCanvas(SkGPipeController* controller,
         this->writeOp(kReportFlags_DrawOp, fFlags, 0);
     }
 
+    const int bitmapsToKeep = persistsResources(flags) ? PERSISTENT_BITMAPS_TO_KEEP
+                                                       : BITMAPS_TO_KEEP;
     if (shouldFlattenBitmaps(flags)) {
         fBitmapShuttle.reset(SkNEW_ARGS(BitmapShuttle, (this)));
-        fBitmapHeap = SkNEW_ARGS(SkBitmapHeap, (fBitmapShuttle.get(), BITMAPS_TO_KEEP));
+        fBitmapHeap = SkNEW_ARGS(SkBitmapHeap, (fBitmapShuttle.get(), bitmapsToKeep));
     } else {
         fBitmapHeap = SkNEW_ARGS(SkBitmapHeap,
-                                 (BITMAPS_TO_KEEP, controller->numberOfReaders()));
+                                 (bitmapsToKeep, controller->numberOfReaders()));
         if (this->needOpBytes(sizeof(void*))) {
             this->writeOp(kShareBitmapHeap_DrawOp);
             fWriter.writePtr(static_cast<void*>(fBitmapHeap));
         }
     }
     fFlattenableHeap.setBitmapStorage(fBitmapHeap);
+    if (persistsResources(flags)) {
+        this->save();
+    }
+    this->doNotify();
+}
+
+void SkGPipeCanvas::beginFrame(SkGPipeController* controller) {
+    SkASSERT(persistsResources(fFlags) && !fResourcesLost);
+    SkASSERT(1 == this->getSaveCount());
+    fController = controller;
+    fDone = false;
+    this->save();
     this->doNotify();
 }
 
@@ -750,6 +837,28 @@ void SkGPipeCanvas::onDrawDRRect(const SkRRect& outer, const SkRRect& inner,
     }
 }
 
+// Batches are written one shape at a time, so readers need no new ops.
+void SkGPipeCanvas::onDrawRects(const SkRect rects[], const SkColor colors[], int count,
+                                const SkPaint& paint) {
+    this->drawEachRect(rects, colors, count, paint);
+}
+
+void SkGPipeCanvas::onDrawOvals(const SkRect ovals[], const SkColor colors[], int count,
+                                const SkPaint& paint) {
+    this->drawEachOval(ovals, colors, count, paint);
+}
+
+void SkGPipeCanvas::onDrawRRects(const SkRRect rrects[], const SkColor colors[], int count,
+                                 const SkPaint& paint) {
+    this->drawEachRRect(rrects, colors, count, paint);
+}
+
+void SkGPipeCanvas::onDrawAtlas(const SkBitmap& atlas, const SkMatrix xforms[],
+                                const SkIRect tex[], const SkColor colors[], int count,
+                                const SkPaint* paint) {
+    this->drawEachSprite(atlas, xforms, tex, colors, count, paint);
+}
+
 void SkGPipeCanvas::drawPath(const SkPath& path, const SkPaint& paint) {
     NOTIFY_SETUP(this);
     this->writePaint(paint);
@@ -1203,11 +1312,19 @@ SkGPipeWriter::SkGPipeWriter()
 }
 
 SkGPipeWriter::~SkGPipeWriter() {
-    this->endRecording();
+    this->releaseCanvas();
 }
 
 SkCanvas* SkGPipeWriter::startRecording(SkGPipeController* controller, uint32_t flags,
                                         uint32_t width, uint32_t height) {
+    if (NULL != fCanvas && persistsResources(fCanvas->flags()) && fCanvas->isFrameDone()) {
+        // We're between frames.
+        if (fCanvas->canContinue(flags, width, height)) {
+            fCanvas->beginFrame(controller);
+        } else {
+            this->releaseCanvas();
+        }
+    }
     if (NULL == fCanvas) {
         fWriter.reset(NULL, 0);
         fCanvas = SkNEW_ARGS(SkGPipeCanvas, (controller, &fWriter, flags, width, height));
@@ -1217,6 +1334,14 @@ SkCanvas* SkGPipeWriter::startRecording(SkGPipeController* controller, uint32_t
 }
 
 void SkGPipeWriter::endRecording() {
+    if (fCanvas && persistsResources(fCanvas->flags())) {
+        fCanvas->endFrame(true);
+    } else {
+        this->releaseCanvas();
+    }
+}
+
+void SkGPipeWriter::releaseCanvas() {
     if (fCanvas) {
         fCanvas->finish(true);
         fCanvas->unref();
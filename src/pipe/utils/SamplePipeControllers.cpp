@@ -9,8 +9,11 @@
 
 #include "SkBitmapDevice.h"
 #include "SkCanvas.h"
+#include "SkCondVar.h"
 #include "SkGPipe.h"
 #include "SkMatrix.h"
+#include "SkThread.h"
+#include "SkThreadUtils.h"
 
 PipeController::PipeController(SkCanvas* target, SkPicture::InstallPixelRefProc proc)
 :fReader(target) {
@@ -116,3 +119,281 @@ void ThreadSafePipeController::draw(SkCanvas* target) {
         reader.playback(fBlock, fBytesWritten);
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Ring positions are free-running int32_t counters; only the low bits index fRing.
+// Differences between them are taken as uint32_t so that wrapping around 2^32 is harmless.
+static uint32_t ring_distance(int32_t from, int32_t to) {
+    return (uint32_t)to - (uint32_t)from;
+}
+
+// Whether block was pushed before the writer last stalled with kDropToFlush_Backpressure.
+static bool drops_block(int32_t block, int32_t dropUntil) {
+    return (int32_t)ring_distance(block, dropUntil) > 0;
+}
+
+static int ring_size(size_t ringBytes) {
+    return SkNextPow2(SkToS32(SkTMax<size_t>(ringBytes, 4)));
+}
+
+ThreadedPipeController::ThreadedPipeController(SkCanvas* target, size_t ringBytes,
+                                               Backpressure backpressure)
+: fTarget(target)
+, fRing(ring_size(ringBytes))
+, fRingMask(ring_size(ringBytes) - 1)
+, fBackpressure(backpressure)
+, fCondVar(SkNEW(SkCondVar))
+, fBlocksPushed(0)
+, fRingHead(0)
+, fDropUntil(0)
+, fQuit(0)
+, fBlocksPopped(0)
+, fRingTail(0)
+, fConsumed(0)
+, fReaderSleeping(0)
+, fWriterSleeping(0)
+, fBlockOpen(false)
+, fBlockStart(0)
+, fUnwokenBytes(0) {
+    fThread.reset(SkNEW_ARGS(SkThread, (&ThreadedPipeController::ReaderThread, this)));
+    SkAssertResult(fThread->start());
+}
+
+ThreadedPipeController::~ThreadedPipeController() {
+    this->closeBlock();
+    sk_release_store(&fQuit, 1);
+    this->wakeReader();
+    fThread->join();
+}
+
+void* ThreadedPipeController::requestBlock(size_t minRequest, size_t* actual) {
+    this->closeBlock();
+
+    const SkMSec start = SkTime::GetMSecs();
+    bool stalled = false;
+
+    // The reader frees block slots and ring space; wait for what we need.
+    // kGrow_Backpressure only waits for a slot, and we always spill requests larger than the ring.
+    const bool fitsInRing = minRequest <= (size_t)fRingMask + 1;
+    void* data = NULL;
+    bool heap = false;
+    fCondVar->lock();
+    for (;;) {
+        if (ring_distance(sk_acquire_load(&fBlocksPopped), fBlocksPushed) < kMaxBlocks) {
+            data = fitsInRing ? this->reserveRing(minRequest, actual) : NULL;
+            if (NULL != data) {
+                break;
+            }
+            if (kGrow_Backpressure == fBackpressure || !fitsInRing) {
+                *actual = SkAlign4(SkTMax<size_t>(minRequest, (fRingMask + 1) / 4));
+                data = sk_malloc_throw(*actual);
+                heap = true;
+                break;
+            }
+            if (kDropToFlush_Backpressure == fBackpressure) {
+                // Skip drawing everything written so far, but nothing written after.
+                sk_release_store(&fDropUntil, fBlocksPushed);
+            }
+        }
+        stalled = true;
+        if (sk_atomic_cas(&fWriterSleeping, 0, 1)) {
+            // Check once more now that the reader knows to wake us, in case it just made room.
+            continue;
+        }
+        fCondVar->wait();
+    }
+    sk_atomic_cas(&fWriterSleeping, 1, 0);
+    fCondVar->unlock();
+
+    if (stalled) {
+        fStats.fStalls++;
+        fStats.fStallMSecs += SkTime::GetMSecs() - start;
+    }
+    fStats.fBlocks++;
+    fStats.fHeapBlocks += heap;
+
+    Block& block = this->block(fBlocksPushed);
+    block.fData = (char*)data;
+    block.fCommitted = 0;
+    block.fClosed = 0;
+    block.fRingEnd = 0;
+    block.fHeap = heap;
+    block.fOpened = SkTime::GetMSecs();
+    fBlockOpen = true;
+    sk_release_store(&fBlocksPushed, fBlocksPushed + 1);
+    this->wakeReader();
+    return data;
+}
+
+void* ThreadedPipeController::reserveRing(size_t minRequest, size_t* actual) {
+    const uint32_t size = fRingMask + 1;
+    int32_t start = fRingHead;
+    uint32_t contiguous = size - (start & fRingMask);
+    if (contiguous < minRequest) {
+        // Skip the tail end of the ring.  The reader frees it along with this block.
+        start += contiguous;
+        contiguous = size;
+    }
+    const uint32_t used = ring_distance(sk_acquire_load(&fRingTail), start);
+    if (used > size) {
+        // The reader is still a lap behind the ring's start, so nothing there is free yet.
+        return NULL;
+    }
+    const uint32_t free = size - used;
+    const uint32_t available = SkTMin(contiguous, free);
+    if (available < minRequest) {
+        return NULL;
+    }
+    fBlockStart = start;
+    *actual = available;
+    return fRing.get() + (start & fRingMask);
+}
+
+void ThreadedPipeController::closeBlock() {
+    if (!fBlockOpen) {
+        return;
+    }
+    Block& block = this->block(fBlocksPushed - 1);
+    if (!block.fHeap) {
+        fRingHead = fBlockStart + block.fCommitted;
+        block.fRingEnd = fRingHead;
+    }
+    sk_release_store(&block.fClosed, 1);
+    fBlockOpen = false;
+    this->wakeReader();
+}
+
+void ThreadedPipeController::notifyWritten(size_t bytes) {
+    if (0 == bytes) {
+        this->closeBlock();
+        return;
+    }
+    SkASSERT(fBlockOpen);
+    Block& block = this->block(fBlocksPushed - 1);
+    sk_release_store(&block.fCommitted, block.fCommitted + SkToS32(bytes));
+    fUnwokenBytes += bytes;
+    if (fUnwokenBytes >= kWakeBytes) {
+        this->wakeReader();
+    }
+}
+
+void ThreadedPipeController::flush() {
+    this->wakeReader();
+}
+
+void ThreadedPipeController::wakeReader() {
+    fUnwokenBytes = 0;
+    // sk_atomic_cas is a full barrier, so either the reader sees what we just published when it
+    // re-checks before sleeping, or we see that it is about to sleep and wake it.
+    if (sk_atomic_cas(&fReaderSleeping, 1, 0)) {
+        fCondVar->lock();
+        fCondVar->broadcast();
+        fCondVar->unlock();
+    }
+}
+
+void ThreadedPipeController::wakeWriter() {
+    if (sk_atomic_cas(&fWriterSleeping, 1, 0)) {
+        fCondVar->lock();
+        fCondVar->broadcast();
+        fCondVar->unlock();
+    }
+}
+
+bool ThreadedPipeController::isDrained() {
+    const int32_t popped = sk_acquire_load(&fBlocksPopped);
+    if (popped == fBlocksPushed) {
+        return true;
+    }
+    // Everything but the open block has been read, and the reader is up to date with it.
+    const Block& block = this->block(popped);
+    return fBlockOpen && popped + 1 == fBlocksPushed &&
+           sk_acquire_load(&fConsumed) == block.fCommitted;
+}
+
+void ThreadedPipeController::drain() {
+    this->wakeReader();
+    fCondVar->lock();
+    while (!this->isDrained()) {
+        if (sk_atomic_cas(&fWriterSleeping, 0, 1) && this->isDrained()) {
+            break;
+        }
+        fCondVar->wait();
+    }
+    sk_atomic_cas(&fWriterSleeping, 1, 0);
+    fCondVar->unlock();
+}
+
+bool ThreadedPipeController::isDropping() {
+    return drops_block(sk_acquire_load(&fBlocksPopped), sk_acquire_load(&fDropUntil));
+}
+
+void ThreadedPipeController::ReaderThread(void* controller) {
+    static_cast<ThreadedPipeController*>(controller)->readLoop();
+}
+
+void ThreadedPipeController::readLoop() {
+    SkGPipeReader reader(fTarget);
+    for (;;) {
+        while (this->readSome(&reader)) {
+            this->wakeWriter();
+        }
+        fCondVar->lock();
+        sk_atomic_cas(&fReaderSleeping, 0, 1);
+        // Check once more now that the writer knows to wake us.
+        if (!this->canRead()) {
+            if (sk_acquire_load(&fQuit)) {
+                // The writer closed its last block before quitting, so there's nothing left.
+                fCondVar->unlock();
+                return;
+            }
+            fCondVar->wait();
+        }
+        sk_atomic_cas(&fReaderSleeping, 1, 0);
+        fCondVar->unlock();
+    }
+}
+
+bool ThreadedPipeController::canRead() {
+    if (fBlocksPopped == sk_acquire_load(&fBlocksPushed)) {
+        return false;
+    }
+    Block& block = this->block(fBlocksPopped);
+    return 0 != sk_acquire_load(&block.fClosed) || fConsumed < sk_acquire_load(&block.fCommitted);
+}
+
+bool ThreadedPipeController::readSome(SkGPipeReader* reader) {
+    if (fBlocksPopped == sk_acquire_load(&fBlocksPushed)) {
+        return false;
+    }
+    Block& block = this->block(fBlocksPopped);
+
+    // Read fClosed first: once it is set, fCommitted is final.
+    const bool closed = 0 != sk_acquire_load(&block.fClosed);
+    const int32_t committed = sk_acquire_load(&block.fCommitted);
+    if (fConsumed < committed) {
+        const bool drop = drops_block(fBlocksPopped, sk_acquire_load(&fDropUntil));
+        const size_t bytes = committed - fConsumed;
+        SkDEBUGCODE(SkGPipeReader::Status status =)
+            reader->playback(block.fData + fConsumed, bytes,
+                             drop ? SkGPipeReader::kSilent_PlaybackFlag : 0);
+        SkASSERT(SkGPipeReader::kError_Status != status);
+        (drop ? fStats.fBytesDropped : fStats.fBytesPlayed) += bytes;
+        sk_release_store(&fConsumed, committed);
+        return true;
+    }
+    if (!closed) {
+        return false;
+    }
+
+    fStats.fMaxLatencyMSecs = SkTMax(fStats.fMaxLatencyMSecs, SkTime::GetMSecs() - block.fOpened);
+    if (block.fHeap) {
+        sk_free(block.fData);
+    } else {
+        sk_release_store(&fRingTail, block.fRingEnd);
+    }
+    sk_release_store(&fConsumed, 0);
+    sk_release_store(&fBlocksPopped, fBlocksPopped + 1);
+    return true;
+}
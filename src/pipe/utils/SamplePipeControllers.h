@@ -10,9 +10,13 @@
 #include "SkGPipe.h"
 #include "SkPicture.h"
 #include "SkTDArray.h"
+#include "SkTemplates.h"
+#include "SkTime.h"
 
 class SkCanvas;
+class SkCondVar;
 class SkMatrix;
+class SkThread;
 
 class PipeController : public SkGPipeController {
 public:
@@ -85,3 +89,134 @@ private:
     SkTDArray<PipeBlock> fBlockList;
     int fNumberOfReaders;
 };
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Plays the stream back on its own reader thread, as it is written. Blocks are handed out from a
+ * fixed size single-producer, single-consumer ring buffer; the writer and reader only take a lock
+ * when one of them has to go to sleep.
+ *
+ * Only the reader thread touches the target canvas. The writer's bitmap heap is not thread safe,
+ * so start recording with SkGPipeWriter::kCrossProcess_Flag if you draw bitmaps.
+ */
+class ThreadedPipeController : public SkGPipeController {
+public:
+    /**
+     * What to do when the writer has filled the ring and the reader hasn't caught up.
+     */
+    enum Backpressure {
+        kBlock_Backpressure,       //!< wait for the reader to free up space
+        kGrow_Backpressure,        //!< spill into blocks allocated outside the ring
+        kDropToFlush_Backpressure, //!< have the reader skip drawing what it has fallen behind on
+    };
+
+    struct Stats {
+        Stats() { sk_bzero(this, sizeof(*this)); }
+
+        int    fBlocks;            //!< blocks handed to the writer
+        int    fHeapBlocks;        //!< blocks allocated outside the ring
+        int    fStalls;            //!< times the writer waited for space
+        SkMSec fStallMSecs;        //!< total time the writer spent waiting for space
+        size_t fBytesPlayed;       //!< bytes the reader drew
+        size_t fBytesDropped;      //!< bytes the reader played back without drawing
+        SkMSec fMaxLatencyMSecs;   //!< longest time from a block being handed out to it being read
+    };
+
+    /**
+     * Starts the reader thread. ringBytes is rounded up to a power of 2.
+     */
+    ThreadedPipeController(SkCanvas* target, size_t ringBytes = kDefaultRingBytes,
+                           Backpressure = kBlock_Backpressure);
+
+    /**
+     * Waits for the reader thread to play back everything written, then stops it.
+     */
+    virtual ~ThreadedPipeController();
+
+    virtual void* requestBlock(size_t minRequest, size_t* actual) SK_OVERRIDE;
+    virtual void notifyWritten(size_t bytes) SK_OVERRIDE;
+
+    /**
+     * The reader is only woken every kWakeBytes, or when a block fills up, so that it plays back
+     * in batches. This wakes it to play back everything written so far, without waiting for it.
+     */
+    void flush();
+
+    /**
+     * Waits until the reader thread has played back everything written so far. Call this after
+     * SkGPipeWriter::flushRecording() to know the target is up to date.
+     */
+    void drain();
+
+    /**
+     * Whether the reader is playing back without drawing, because the writer ran out of space
+     * before the reader got to the block it is on. Only ever true with kDropToFlush_Backpressure,
+     * and false once drain() has returned.
+     */
+    bool isDropping();
+
+    /**
+     * Only consistent once drain() has returned.
+     */
+    const Stats& stats() const { return fStats; }
+
+private:
+    enum {
+        kDefaultRingBytes = 1 << 20,
+        kMaxBlocks = 64,
+        kWakeBytes = 4096,
+    };
+
+    struct Block {
+        char*   fData;
+        int32_t fCommitted;     // Bytes written so far. Published by the writer.
+        int32_t fClosed;        // Set once the writer has moved on to another block.
+        int32_t fRingEnd;       // Where the ring is free up to once this block has been read.
+        bool    fHeap;          // fData is not part of the ring; the reader must free it.
+        SkMSec  fOpened;
+    };
+
+    Block& block(int32_t index) { return fBlocks[(uint32_t)index % kMaxBlocks]; }
+
+    static void ReaderThread(void*);
+    void readLoop();
+    bool readSome(SkGPipeReader*);
+    bool canRead();
+
+    void* reserveRing(size_t minRequest, size_t* actual);
+    void closeBlock();
+    void wakeReader();
+    void wakeWriter();
+    bool isDrained();
+
+    SkCanvas*                fTarget;
+    SkAutoTMalloc<char>      fRing;
+    const int32_t            fRingMask;
+    const Backpressure       fBackpressure;
+    Block                    fBlocks[kMaxBlocks];
+    SkAutoTDelete<SkCondVar> fCondVar;
+    SkAutoTDelete<SkThread>  fThread;
+
+    // Owned by the writer, read by the reader.
+    int32_t fBlocksPushed;
+    int32_t fRingHead;
+    int32_t fDropUntil;     // The reader doesn't draw blocks before this one.
+    int32_t fQuit;
+
+    // Owned by the reader, read by the writer.
+    int32_t fBlocksPopped;
+    int32_t fRingTail;
+    int32_t fConsumed;
+
+    // Each side sets its flag before going to sleep on fCondVar.
+    int32_t fReaderSleeping;
+    int32_t fWriterSleeping;
+
+    // Writer only.
+    bool    fBlockOpen;
+    int32_t fBlockStart;
+    size_t  fUnwokenBytes;
+
+    Stats   fStats;
+};
@@ -199,6 +199,7 @@ protected:
     virtual void generateAdvance(SkGlyph* glyph) SK_OVERRIDE;
     virtual void generateMetrics(SkGlyph* glyph) SK_OVERRIDE;
     virtual void generateImage(const SkGlyph& glyph) SK_OVERRIDE;
+    virtual void generateImages(const SkGlyph* const glyphs[], int count) SK_OVERRIDE;
     virtual void generatePath(const SkGlyph& glyph, SkPath* path) SK_OVERRIDE;
     virtual void generateFontMetrics(SkPaint::FontMetrics* mx,
                                      SkPaint::FontMetrics* my) SK_OVERRIDE;
@@ -1316,25 +1317,33 @@ void SkScalerContext_FreeType::generateMetrics(SkGlyph* glyph) {
 
 
 void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
+    const SkGlyph* glyphs[] = { &glyph };
+    this->generateImages(glyphs, 1);
+}
+
+void SkScalerContext_FreeType::generateImages(const SkGlyph* const glyphs[], int count) {
+    // Only lock and set up the size once for the whole batch.
     SkAutoMutexAcquire  ac(gFTMutex);
 
-    FT_Error    err;
+    const bool sizeFailed = this->setupSize() != 0;
+    for (int i = 0; i < count; i++) {
+        const SkGlyph& glyph = *glyphs[i];
+        if (sizeFailed) {
+            memset(glyph.fImage, 0, glyph.rowBytes() * glyph.fHeight);
+            continue;
+        }
 
-    if (this->setupSize()) {
-        goto ERROR;
-    }
+        FT_Error err = FT_Load_Glyph(fFace, glyph.getGlyphID(fBaseGlyphCount), fLoadGlyphFlags);
+        if (err != 0) {
+            SkDEBUGF(("SkScalerContext_FreeType::generateImage: FT_Load_Glyph(glyph:%d width:%d height:%d rb:%d flags:%d) returned 0x%x\n",
+                        glyph.getGlyphID(fBaseGlyphCount), glyph.fWidth, glyph.fHeight, glyph.rowBytes(), fLoadGlyphFlags, err));
+            memset(glyph.fImage, 0, glyph.rowBytes() * glyph.fHeight);
+            continue;
+        }
 
-    err = FT_Load_Glyph( fFace, glyph.getGlyphID(fBaseGlyphCount), fLoadGlyphFlags);
-    if (err != 0) {
-        SkDEBUGF(("SkScalerContext_FreeType::generateImage: FT_Load_Glyph(glyph:%d width:%d height:%d rb:%d flags:%d) returned 0x%x\n",
-                    glyph.getGlyphID(fBaseGlyphCount), glyph.fWidth, glyph.fHeight, glyph.rowBytes(), fLoadGlyphFlags, err));
-    ERROR:
-        memset(glyph.fImage, 0, glyph.rowBytes() * glyph.fHeight);
-        return;
+        emboldenIfNeeded(fFace, fFace->glyph);
+        generateGlyphImage(fFace, glyph);
     }
-
-    emboldenIfNeeded(fFace, fFace->glyph);
-    generateGlyphImage(fFace, glyph);
 }
 
 
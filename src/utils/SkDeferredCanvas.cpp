@@ -808,6 +808,35 @@ void SkDeferredCanvas::onDrawDRRect(const SkRRect& outer, const SkRRect& inner,
     this->recordedDrawCommand();
 }
 
+void SkDeferredCanvas::onDrawRects(const SkRect rects[], const SkColor colors[], int count,
+                                   const SkPaint& paint) {
+    AutoImmediateDrawIfNeeded autoDraw(*this, &paint);
+    this->drawingCanvas()->drawRects(rects, colors, count, paint);
+    this->recordedDrawCommand();
+}
+
+void SkDeferredCanvas::onDrawOvals(const SkRect ovals[], const SkColor colors[], int count,
+                                   const SkPaint& paint) {
+    AutoImmediateDrawIfNeeded autoDraw(*this, &paint);
+    this->drawingCanvas()->drawOvals(ovals, colors, count, paint);
+    this->recordedDrawCommand();
+}
+
+void SkDeferredCanvas::onDrawRRects(const SkRRect rrects[], const SkColor colors[], int count,
+                                    const SkPaint& paint) {
+    AutoImmediateDrawIfNeeded autoDraw(*this, &paint);
+    this->drawingCanvas()->drawRRects(rrects, colors, count, paint);
+    this->recordedDrawCommand();
+}
+
+void SkDeferredCanvas::onDrawAtlas(const SkBitmap& atlas, const SkMatrix xforms[],
+                                   const SkIRect tex[], const SkColor colors[], int count,
+                                   const SkPaint* paint) {
+    AutoImmediateDrawIfNeeded autoDraw(*this, &atlas, paint);
+    this->drawingCanvas()->drawAtlas(atlas, xforms, tex, colors, count, paint);
+    this->recordedDrawCommand();
+}
+
 void SkDeferredCanvas::drawPath(const SkPath& path, const SkPaint& paint) {
     AutoImmediateDrawIfNeeded autoDraw(*this, &paint);
     this->drawingCanvas()->drawPath(path, paint);
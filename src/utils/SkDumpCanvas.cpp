@@ -338,6 +338,27 @@ void SkDumpCanvas::onDrawDRRect(const SkRRect& outer, const SkRRect& inner,
                str0.c_str(), str1.c_str());
 }
 
+void SkDumpCanvas::onDrawRects(const SkRect rects[], const SkColor colors[], int count,
+                               const SkPaint& paint) {
+    this->drawEachRect(rects, colors, count, paint);
+}
+
+void SkDumpCanvas::onDrawOvals(const SkRect ovals[], const SkColor colors[], int count,
+                               const SkPaint& paint) {
+    this->drawEachOval(ovals, colors, count, paint);
+}
+
+void SkDumpCanvas::onDrawRRects(const SkRRect rrects[], const SkColor colors[], int count,
+                                const SkPaint& paint) {
+    this->drawEachRRect(rrects, colors, count, paint);
+}
+
+void SkDumpCanvas::onDrawAtlas(const SkBitmap& atlas, const SkMatrix xforms[],
+                               const SkIRect tex[], const SkColor colors[], int count,
+                               const SkPaint* paint) {
+    this->drawEachSprite(atlas, xforms, tex, colors, count, paint);
+}
+
 void SkDumpCanvas::drawPath(const SkPath& path, const SkPaint& paint) {
     SkString str;
     toString(path, &str);
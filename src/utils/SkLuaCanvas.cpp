@@ -200,6 +200,27 @@ void SkLuaCanvas::onDrawDRRect(const SkRRect& outer, const SkRRect& inner,
     lua.pushPaint(paint, "paint");
 }
 
+void SkLuaCanvas::onDrawRects(const SkRect rects[], const SkColor colors[], int count,
+                              const SkPaint& paint) {
+    this->drawEachRect(rects, colors, count, paint);
+}
+
+void SkLuaCanvas::onDrawOvals(const SkRect ovals[], const SkColor colors[], int count,
+                              const SkPaint& paint) {
+    this->drawEachOval(ovals, colors, count, paint);
+}
+
+void SkLuaCanvas::onDrawRRects(const SkRRect rrects[], const SkColor colors[], int count,
+                               const SkPaint& paint) {
+    this->drawEachRRect(rrects, colors, count, paint);
+}
+
+void SkLuaCanvas::onDrawAtlas(const SkBitmap& atlas, const SkMatrix xforms[],
+                              const SkIRect tex[], const SkColor colors[], int count,
+                              const SkPaint* paint) {
+    this->drawEachSprite(atlas, xforms, tex, colors, count, paint);
+}
+
 void SkLuaCanvas::drawPath(const SkPath& path, const SkPaint& paint) {
     AUTO_LUA("drawPath");
     lua.pushPath(path, "path");
@@ -185,6 +185,39 @@ void SkNWayCanvas::onDrawDRRect(const SkRRect& outer, const SkRRect& inner,
     }
 }
 
+void SkNWayCanvas::onDrawRects(const SkRect rects[], const SkColor colors[], int count,
+                               const SkPaint& paint) {
+    Iter iter(fList);
+    while (iter.next()) {
+        iter->drawRects(rects, colors, count, paint);
+    }
+}
+
+void SkNWayCanvas::onDrawOvals(const SkRect ovals[], const SkColor colors[], int count,
+                               const SkPaint& paint) {
+    Iter iter(fList);
+    while (iter.next()) {
+        iter->drawOvals(ovals, colors, count, paint);
+    }
+}
+
+void SkNWayCanvas::onDrawRRects(const SkRRect rrects[], const SkColor colors[], int count,
+                                const SkPaint& paint) {
+    Iter iter(fList);
+    while (iter.next()) {
+        iter->drawRRects(rrects, colors, count, paint);
+    }
+}
+
+void SkNWayCanvas::onDrawAtlas(const SkBitmap& atlas, const SkMatrix xforms[],
+                               const SkIRect tex[], const SkColor colors[], int count,
+                               const SkPaint* paint) {
+    Iter iter(fList);
+    while (iter.next()) {
+        iter->drawAtlas(atlas, xforms, tex, colors, count, paint);
+    }
+}
+
 void SkNWayCanvas::drawPath(const SkPath& path, const SkPaint& paint) {
     Iter iter(fList);
     while (iter.next()) {
@@ -91,6 +91,27 @@ void SkProxyCanvas::onDrawDRRect(const SkRRect& outer, const SkRRect& inner,
     fProxy->drawDRRect(outer, inner, paint);
 }
 
+void SkProxyCanvas::onDrawRects(const SkRect rects[], const SkColor colors[], int count,
+                                const SkPaint& paint) {
+    fProxy->drawRects(rects, colors, count, paint);
+}
+
+void SkProxyCanvas::onDrawOvals(const SkRect ovals[], const SkColor colors[], int count,
+                                const SkPaint& paint) {
+    fProxy->drawOvals(ovals, colors, count, paint);
+}
+
+void SkProxyCanvas::onDrawRRects(const SkRRect rrects[], const SkColor colors[], int count,
+                                 const SkPaint& paint) {
+    fProxy->drawRRects(rrects, colors, count, paint);
+}
+
+void SkProxyCanvas::onDrawAtlas(const SkBitmap& atlas, const SkMatrix xforms[],
+                                const SkIRect tex[], const SkColor colors[], int count,
+                                const SkPaint* paint) {
+    fProxy->drawAtlas(atlas, xforms, tex, colors, count, paint);
+}
+
 void SkProxyCanvas::drawPath(const SkPath& path, const SkPaint& paint) {
     fProxy->drawPath(path, paint);
 }
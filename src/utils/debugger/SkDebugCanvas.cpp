@@ -553,6 +553,27 @@ void SkDebugCanvas::onDrawDRRect(const SkRRect& outer, const SkRRect& inner,
     this->addDrawCommand(new SkDrawDRRectCommand(outer, inner, paint));
 }
 
+void SkDebugCanvas::onDrawRects(const SkRect rects[], const SkColor colors[], int count,
+                                const SkPaint& paint) {
+    this->drawEachRect(rects, colors, count, paint);
+}
+
+void SkDebugCanvas::onDrawOvals(const SkRect ovals[], const SkColor colors[], int count,
+                                const SkPaint& paint) {
+    this->drawEachOval(ovals, colors, count, paint);
+}
+
+void SkDebugCanvas::onDrawRRects(const SkRRect rrects[], const SkColor colors[], int count,
+                                 const SkPaint& paint) {
+    this->drawEachRRect(rrects, colors, count, paint);
+}
+
+void SkDebugCanvas::onDrawAtlas(const SkBitmap& atlas, const SkMatrix xforms[],
+                                const SkIRect tex[], const SkColor colors[], int count,
+                                const SkPaint* paint) {
+    this->drawEachSprite(atlas, xforms, tex, colors, count, paint);
+}
+
 void SkDebugCanvas::drawSprite(const SkBitmap& bitmap, int left, int top,
                                const SkPaint* paint = NULL) {
     this->addDrawCommand(new SkDrawSpriteCommand(bitmap, left, top, paint));
@@ -37,6 +37,7 @@ LOCAL_SRC_FILES := \
 	PathOpsLineIntersectionTest.cpp \
 	PathOpsLineParametetersTest.cpp \
 	PathOpsOpCubicThreadedTest.cpp \
+	PathOpsOpManyTest.cpp \
 	PathOpsOpRectThreadedTest.cpp \
 	PathOpsOpTest.cpp \
 	PathOpsQuadIntersectionTest.cpp \
@@ -54,12 +55,14 @@ LOCAL_SRC_FILES := \
 	PathOpsSimplifyTrianglesThreadedTest.cpp \
 	PathOpsSkpTest.cpp \
 	PathOpsTestCommon.cpp \
+	PathOpsThreadCountTest.cpp \
 	PathOpsThreadedCommon.cpp \
 	Test.cpp \
 	AAClipTest.cpp \
 	ARGBImageEncoderTest.cpp \
 	AndroidPaintTest.cpp \
 	AnnotationTest.cpp \
+	AntiHairTest.cpp \
 	AsADashTest.cpp \
 	AtomicTest.cpp \
 	BBoxHierarchyTest.cpp \
@@ -92,8 +95,10 @@ LOCAL_SRC_FILES := \
 	DiscardableMemoryPoolTest.cpp \
 	DiscardableMemoryTest.cpp \
 	DocumentTest.cpp \
+	DrawAtlasTest.cpp \
 	DrawBitmapRectTest.cpp \
 	DrawPathTest.cpp \
+	DrawShapesTest.cpp \
 	DrawTextTest.cpp \
 	DynamicHashTest.cpp \
 	EmptyPathTest.cpp \
@@ -112,6 +117,7 @@ LOCAL_SRC_FILES := \
 	GLProgramsTest.cpp \
 	GeometryTest.cpp \
 	GifTest.cpp \
+	GlyphCacheTest.cpp \
 	GpuColorFilterTest.cpp \
 	GpuDrawPathTest.cpp \
 	GpuRectanizerTest.cpp \
@@ -157,6 +163,7 @@ LOCAL_SRC_FILES := \
 	PathMeasureTest.cpp \
 	PathTest.cpp \
 	PathUtilsTest.cpp \
+	PerlinNoiseTest.cpp \
 	PictureTest.cpp \
 	PictureShaderTest.cpp \
 	PictureStateTreeTest.cpp \
@@ -169,6 +176,7 @@ LOCAL_SRC_FILES := \
 	ReadPixelsTest.cpp \
 	ReadWriteAlphaTest.cpp \
 	Reader32Test.cpp \
+	RecordCompactTest.cpp \
 	RecordDrawTest.cpp \
 	RecordOptsTest.cpp \
 	RecordPatternTest.cpp \
@@ -251,6 +259,7 @@ LOCAL_C_INCLUDES := \
 	$(LOCAL_PATH)/../src/image \
 	$(LOCAL_PATH)/../src/lazy \
 	$(LOCAL_PATH)/../src/images \
+	$(LOCAL_PATH)/../src/opts \
 	$(LOCAL_PATH)/../src/pathops \
 	$(LOCAL_PATH)/../src/pdf \
 	$(LOCAL_PATH)/../src/pipe/utils \
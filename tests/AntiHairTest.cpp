@@ -0,0 +1,158 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmap.h"
+#include "SkBitmapProcShader.h"
+#include "SkBlitter.h"
+#include "SkColorPriv.h"
+#include "SkPaint.h"
+#include "SkPath.h"
+#include "SkRandom.h"
+#include "SkRasterClip.h"
+#include "SkScan.h"
+#include "Test.h"
+
+// Passes everything on to another blitter, but hides that it just draws an opaque color, so
+// hairlines are drawn through blitAntiH() and blitV() rather than straight into the pixels.
+class HideColorBlitter : public SkBlitter {
+public:
+    HideColorBlitter(SkBlitter* blitter) : fBlitter(blitter) {}
+
+    virtual void blitH(int x, int y, int width) SK_OVERRIDE {
+        fBlitter->blitH(x, y, width);
+    }
+    virtual void blitAntiH(int x, int y, const SkAlpha antialias[],
+                           const int16_t runs[]) SK_OVERRIDE {
+        fBlitter->blitAntiH(x, y, antialias, runs);
+    }
+    virtual void blitV(int x, int y, int height, SkAlpha alpha) SK_OVERRIDE {
+        fBlitter->blitV(x, y, height, alpha);
+    }
+    virtual void blitRect(int x, int y, int width, int height) SK_OVERRIDE {
+        fBlitter->blitRect(x, y, width, height);
+    }
+    virtual void blitMask(const SkMask& mask, const SkIRect& clip) SK_OVERRIDE {
+        fBlitter->blitMask(mask, clip);
+    }
+
+private:
+    SkBlitter* fBlitter;
+};
+
+// Draws nothing, but notes whether it was asked to draw outside of a rect.
+class BoundsCheckBlitter : public SkBlitter {
+public:
+    BoundsCheckBlitter(const SkIRect& bounds) : fBounds(bounds), fOutside(false) {}
+
+    virtual void blitH(int x, int y, int width) SK_OVERRIDE {
+        this->check(x, y, width, 1);
+    }
+    virtual void blitAntiH(int x, int y, const SkAlpha antialias[],
+                           const int16_t runs[]) SK_OVERRIDE {
+        int width = 0;
+        while (runs[width] > 0) {
+            width += runs[width];
+        }
+        this->check(x, y, width, 1);
+    }
+    virtual void blitV(int x, int y, int height, SkAlpha alpha) SK_OVERRIDE {
+        this->check(x, y, 1, height);
+    }
+    virtual void blitRect(int x, int y, int width, int height) SK_OVERRIDE {
+        this->check(x, y, width, height);
+    }
+    virtual void blitMask(const SkMask& mask, const SkIRect& clip) SK_OVERRIDE {
+        this->check(clip.fLeft, clip.fTop, clip.width(), clip.height());
+    }
+
+    bool drewOutside() const { return fOutside; }
+
+private:
+    void check(int x, int y, int width, int height) {
+        if (!fBounds.contains(SkIRect::MakeXYWH(x, y, width, height))) {
+            fOutside = true;
+        }
+    }
+
+    SkIRect fBounds;
+    bool    fOutside;
+};
+
+static void test_polylines(skiatest::Reporter* reporter, SkColor color, SkRandom* rand) {
+    const int W = 200, H = 150;
+    SkBitmap direct, hidden;
+    direct.allocN32Pixels(W, H);
+    hidden.allocN32Pixels(W, H);
+
+    SkPaint paint;
+    paint.setColor(color);
+    SkTBlitterAllocator directAlloc, hiddenAlloc;
+    SkBlitter* directBlitter = SkBlitter::Choose(direct, SkMatrix::I(), paint, &directAlloc);
+    HideColorBlitter hiddenBlitter(SkBlitter::Choose(hidden, SkMatrix::I(), paint, &hiddenAlloc));
+    uint32_t value;
+    REPORTER_ASSERT(reporter, directBlitter->justAnOpaqueColor(&value));
+
+    // Lines clipped to the device, and lines clipped to a smaller rect.
+    const SkIRect clips[] = {
+        SkIRect::MakeWH(W, H),
+        SkIRect::MakeLTRB(W / 4, H / 4, W * 3 / 4, H * 3 / 4),
+    };
+    for (size_t c = 0; c < SK_ARRAY_COUNT(clips); ++c) {
+        SkRasterClip clip(clips[c]);
+        for (int i = 0; i < 20; ++i) {
+            // Over a translucent background, so every pixel drawn is blended.
+            direct.eraseColor(SkColorSetARGB(0x80, 0x40, 0x80, 0xC0));
+            hidden.eraseColor(SkColorSetARGB(0x80, 0x40, 0x80, 0xC0));
+
+            // Like a chart: x always moves on, and the lines are shallow, steep or in-between,
+            // some long and some short.
+            SkPoint pts[32];
+            const int count = 2 + rand->nextULessThan(SK_ARRAY_COUNT(pts) - 1);
+            const SkScalar scale = SkIntToScalar(1 << rand->nextULessThan(10)) / 8;
+            pts[0].set(rand->nextRangeScalar(-10, W / 2), rand->nextRangeScalar(-10, H + 10));
+            for (int j = 1; j < count; ++j) {
+                SkScalar dx = 3 + rand->nextUScalar1() * scale;
+                SkScalar dy = rand->nextSScalar1() * scale * 4;
+                if (rand->nextBool()) {
+                    dy /= 16;
+                }
+                pts[j].set(pts[j - 1].fX + dx, SkScalarPin(pts[j - 1].fY + dy, -10, H + 10));
+            }
+
+            SkScan::AntiHairLine(pts, count, clip, directBlitter);
+            SkScan::AntiHairLine(pts, count, clip, &hiddenBlitter);
+            REPORTER_ASSERT(reporter, 0 == memcmp(direct.getPixels(), hidden.getPixels(),
+                                                  direct.getSize()));
+        }
+    }
+}
+
+// A NaN point leaves the polyline without bounds, which must not let its other lines skip the AA
+// clip, even when the clip contains the empty rect it leaves.
+static void test_nan_point_aa_clip(skiatest::Reporter* reporter) {
+    SkPath rrect;
+    rrect.addRoundRect(SkRect::MakeLTRB(-20, -20, 20, 20), 8, 8);
+    SkRasterClip clip;
+    clip.setPath(rrect, SkIRect::MakeLTRB(-20, -20, 20, 20), true);
+    REPORTER_ASSERT(reporter, !clip.isBW());
+    REPORTER_ASSERT(reporter, clip.quickContains(-1, -1, 1, 1));
+
+    SkPoint pts[3];
+    pts[0].set(SK_ScalarNaN, SK_ScalarNaN);
+    pts[1].set(-50, -5);
+    pts[2].set(50, 10);
+    BoundsCheckBlitter blitter(clip.getBounds());
+    SkScan::AntiHairLine(pts, SK_ARRAY_COUNT(pts), clip, &blitter);
+    REPORTER_ASSERT(reporter, !blitter.drewOutside());
+}
+
+DEF_TEST(AntiHair, reporter) {
+    SkRandom rand;
+    test_polylines(reporter, 0xFF336699, &rand);
+    test_polylines(reporter, SK_ColorBLACK, &rand);
+    test_nan_point_aa_clip(reporter);
+}
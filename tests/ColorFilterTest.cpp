@@ -7,6 +7,7 @@
 
 #include "SkColor.h"
 #include "SkColorFilter.h"
+#include "SkColorMatrix_opts.h"
 #include "SkColorPriv.h"
 #include "SkLumaColorFilter.h"
 #include "SkReadBuffer.h"
@@ -125,3 +126,201 @@ DEF_TEST(LumaColorFilter, reporter) {
         REPORTER_ASSERT(reporter, SkGetPackedB32(out) == 0);
     }
 }
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SkColorMatrixFilter.h"
+#include "SkTableColorFilter.h"
+#include "SkUnPreMultiply.h"
+
+static bool components_within(SkPMColor a, SkPMColor b, int tolerance) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        if (SkAbs32(((a >> shift) & 0xFF) - ((b >> shift) & 0xFF)) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks that composed matches running inner and then outer, on opaque and translucent colors.
+static void test_composed(skiatest::Reporter* reporter, SkColorFilter* composed,
+                          SkColorFilter* outer, SkColorFilter* inner, int tolerance) {
+    SkRandom rand;
+    for (int i = 0; i < 64; ++i) {
+        SkColor c = rand.nextU();
+        if (i & 1) {
+            c |= 0xFF000000;
+        }
+        SkPMColor src = SkPreMultiplyColor(c), expected, actual;
+        inner->filterSpan(&src, 1, &expected);
+        outer->filterSpan(&expected, 1, &expected);
+        composed->filterSpan(&src, 1, &actual);
+        REPORTER_ASSERT(reporter, components_within(expected, actual, tolerance));
+    }
+}
+
+DEF_TEST(ComposeColorFilter, reporter) {
+    SkColorMatrix gray, half, twice;
+    gray.setSaturation(0);
+    half.setScale(0.5f, 0.5f, 0.5f);
+    twice.setScale(2, 2, 2);
+    SkAutoTUnref<SkColorFilter> grayCF(SkColorMatrixFilter::Create(gray));
+    SkAutoTUnref<SkColorFilter> halfCF(SkColorMatrixFilter::Create(half));
+    SkAutoTUnref<SkColorFilter> twiceCF(SkColorMatrixFilter::Create(twice));
+
+    REPORTER_ASSERT(reporter, NULL == SkColorFilter::CreateComposeFilter(NULL, NULL));
+    SkAutoTUnref<SkColorFilter> justGray(SkColorFilter::CreateComposeFilter(NULL, grayCF));
+    REPORTER_ASSERT(reporter, justGray.get() == grayCF.get());
+
+    // Matrices fold into one, as long as the inner one never has to be pinned.
+    SkAutoTUnref<SkColorFilter> grayHalf(SkColorFilter::CreateComposeFilter(grayCF, halfCF));
+    REPORTER_ASSERT(reporter, grayHalf->asColorMatrix(NULL));
+    test_composed(reporter, grayHalf, grayCF, halfCF, 1);
+
+    SkAutoTUnref<SkColorFilter> halfTwice(SkColorFilter::CreateComposeFilter(halfCF, twiceCF));
+    REPORTER_ASSERT(reporter, !halfTwice->asColorMatrix(NULL));
+    test_composed(reporter, halfTwice, halfCF, twiceCF, 0);
+
+    // Unfused compositions survive serialization.
+    SkAutoTUnref<SkColorFilter> halfTwice2(reincarnate_colorfilter(halfTwice));
+    REPORTER_ASSERT(reporter, NULL != halfTwice2.get());
+    if (NULL != halfTwice2.get()) {
+        test_composed(reporter, halfTwice2, halfCF, twiceCF, 0);
+    }
+
+    // Modulate is a matrix too.
+    SkAutoTUnref<SkColorFilter> modulateCF(
+            SkColorFilter::CreateModeFilter(0xC0FF8040, SkXfermode::kModulate_Mode));
+    SkAutoTUnref<SkColorFilter> grayModulate(
+            SkColorFilter::CreateComposeFilter(grayCF, modulateCF));
+    REPORTER_ASSERT(reporter, grayModulate->asColorMatrix(NULL));
+    test_composed(reporter, grayModulate, grayCF, modulateCF, 1);
+
+    // And tables fold into one table.
+    uint8_t invert[256], gamma[256];
+    for (int i = 0; i < 256; ++i) {
+        invert[i] = 255 - i;
+        gamma[i] = SkToU8(i * i / 255);
+    }
+    SkAutoTUnref<SkColorFilter> invertCF(SkTableColorFilter::CreateARGB(NULL, invert,
+                                                                        invert, invert));
+    SkAutoTUnref<SkColorFilter> gammaCF(SkTableColorFilter::Create(gamma));
+    SkAutoTUnref<SkColorFilter> gammaInvert(SkColorFilter::CreateComposeFilter(gammaCF,
+                                                                              invertCF));
+    REPORTER_ASSERT(reporter, gammaInvert->asComponentTable(NULL));
+    test_composed(reporter, gammaInvert, gammaCF, invertCF, 1);
+}
+
+// c unpremultiplied by SkUnPreMultiply, then transformed by m exactly, pinned, rounded and
+// premultiplied again.
+static SkPMColor color_matrix_reference(const SkScalar m[20], SkPMColor c) {
+    const SkUnPreMultiply::Scale scale = SkUnPreMultiply::GetScale(SkGetPackedA32(c));
+    const double in[4] = {
+        (double)SkUnPreMultiply::ApplyScale(scale, SkGetPackedR32(c)),
+        (double)SkUnPreMultiply::ApplyScale(scale, SkGetPackedG32(c)),
+        (double)SkUnPreMultiply::ApplyScale(scale, SkGetPackedB32(c)),
+        (double)SkGetPackedA32(c),
+    };
+    unsigned out[4];
+    for (int i = 0; i < 4; ++i) {
+        const SkScalar* row = m + 5 * i;
+        const double v = row[0] * in[0] + row[1] * in[1] + row[2] * in[2] + row[3] * in[3] +
+                         row[4];
+        out[i] = (unsigned)(SkTMax(0.0, SkTMin(v, 255.0)) + 0.5);
+    }
+    return SkPremultiplyARGBInline(out[3], out[0], out[1], out[2]);
+}
+
+// SkColorMatrixFilter unpremultiplies like SkUnPreMultiply, and only rounds the transformed
+// colors a little differently, in fixed point.
+DEF_TEST(ColorMatrixFilterSpan, reporter) {
+    SkRandom rand;
+    SkColorMatrix gray, saturate, random;
+    gray.setSaturation(0);
+    saturate.setSaturation(2.5f);
+    for (int i = 0; i < 20; ++i) {
+        random.fMat[i] = (i % 5 == 4) ? rand.nextRangeScalar(-64, 64)
+                                      : rand.nextRangeScalar(-1.5f, 1.5f);
+    }
+    const SkColorMatrix* matrices[] = { &gray, &saturate, &random };
+
+    static const int kCount = 131;
+    SkPMColor src[kCount], dst[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        SkColor c = rand.nextU();
+        if (i % 3 == 0) {
+            c = SkColorSetA(c, (i % 2) ? 0xFF : 0);
+        }
+        src[i] = SkPreMultiplyColor(c);
+    }
+    for (size_t j = 0; j < SK_ARRAY_COUNT(matrices); ++j) {
+        SkAutoTUnref<SkColorFilter> cf(SkColorMatrixFilter::Create(*matrices[j]));
+        cf->filterSpan(src, kCount, dst);
+        for (int i = 0; i < kCount; ++i) {
+            const SkPMColor expected = color_matrix_reference(matrices[j]->fMat, src[i]);
+            if (!components_within(expected, dst[i], 1)) {
+                ERRORF(reporter, "matrix %d, %08x -> %08x, expected %08x",
+                       (int)j, src[i], dst[i], expected);
+            }
+        }
+    }
+}
+
+// What SkColorMatrixFilter's integer procs make of c, given its fixed point matrix.
+static SkPMColor fixed_color_matrix_reference(const int32_t m[20], int shift, SkPMColor c) {
+    const SkUnPreMultiply::Scale scale = SkUnPreMultiply::GetScale(SkGetPackedA32(c));
+    const unsigned in[4] = {
+        SkUnPreMultiply::ApplyScale(scale, SkGetPackedR32(c)),
+        SkUnPreMultiply::ApplyScale(scale, SkGetPackedG32(c)),
+        SkUnPreMultiply::ApplyScale(scale, SkGetPackedB32(c)),
+        SkGetPackedA32(c),
+    };
+    unsigned out[4];
+    for (int i = 0; i < 4; ++i) {
+        const int32_t* row = m + 5 * i;
+        // Sum as rowmul4() does, then shift the signed result.
+        const int32_t sum = row[0] * in[0] + row[1] * in[1] + row[2] * in[2] + row[3] * in[3] +
+                            row[4];
+        out[i] = SkPin32(sum >> shift, 0, 255);
+    }
+    return SkPremultiplyARGBInline(out[3], out[0], out[1], out[2]);
+}
+
+// The platform span proc draws exactly what the integer procs do.
+DEF_TEST(ColorMatrixPlatformSpanProc, reporter) {
+    const SkColorMatrixSpanProc proc = SkColorMatrixGetPlatformSpanProc();
+    if (NULL == proc) {
+        return;
+    }
+
+    SkRandom rand;
+    static const int kCount = 131;
+    SkPMColor src[kCount], dst[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        SkColor c = rand.nextU();
+        if (i % 3 == 0) {
+            c = SkColorSetA(c, (i % 2) ? 0xFF : 0);
+        }
+        src[i] = SkPreMultiplyColor(c);
+    }
+    for (int trial = 0; trial < 100; ++trial) {
+        // Small enough that no row's sum overflows, as initState() arranges.
+        const int shift = rand.nextRangeU(9, 16);
+        int32_t m[20];
+        for (int i = 0; i < 20; ++i) {
+            m[i] = rand.nextRangeU(0, 1 << 21) - (1 << 20);
+            if (i % 5 == 4) {
+                m[i] += 1 << (shift - 1);
+            }
+        }
+        proc(m, shift, src, kCount, dst);
+        for (int i = 0; i < kCount; ++i) {
+            const SkPMColor expected = fixed_color_matrix_reference(m, shift, src[i]);
+            if (expected != dst[i]) {
+                ERRORF(reporter, "trial %d, %08x -> %08x, expected %08x",
+                       trial, src[i], dst[i], expected);
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,257 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkColorPriv.h"
+#include "SkColorShader.h"
+#include "SkDrawFilter.h"
+#include "SkRandom.h"
+#include "SkRecord.h"
+#include "SkRecordDraw.h"
+#include "SkRecorder.h"
+#include "Test.h"
+
+static const int kW = 200;
+static const int kH = 150;
+static const int kCount = 60;
+static const int kCell = 16;    // the atlas is a 4x4 grid of cells
+static const int kAtlasSize = 4 * kCell;
+
+enum XformType {
+    kIntTranslate_XformType,
+    kFracTranslate_XformType,
+    kScale_XformType,
+    kRotate_XformType,
+};
+
+static void make_atlas(SkBitmap* atlas, SkColorType colorType) {
+    SkRandom rand;
+    if (kAlpha_8_SkColorType == colorType) {
+        atlas->allocPixels(SkImageInfo::MakeA8(kAtlasSize, kAtlasSize));
+        for (int y = 0; y < kAtlasSize; ++y) {
+            for (int x = 0; x < kAtlasSize; ++x) {
+                *atlas->getAddr8(x, y) = rand.nextU() & 0xFF;
+            }
+        }
+    } else {
+        atlas->allocN32Pixels(kAtlasSize, kAtlasSize);
+        for (int y = 0; y < kAtlasSize; ++y) {
+            for (int x = 0; x < kAtlasSize; ++x) {
+                // half the cells opaque, half not
+                U8CPU a = ((x / kCell + y / kCell) & 1) ? 0xFF : rand.nextU() & 0xFF;
+                *atlas->getAddr32(x, y) = SkPreMultiplyColor(SkColorSetA(rand.nextU(), a));
+            }
+        }
+    }
+}
+
+struct Sprites {
+    SkMatrix fXforms[kCount];
+    SkIRect  fTex[kCount];
+    SkColor  fColors[kCount];
+
+    explicit Sprites(XformType type) {
+        SkRandom rand;
+        for (int i = 0; i < kCount; ++i) {
+            int cell = i % 16;
+            // a one pixel gutter around each sprite, like most atlases
+            fTex[i].setXYWH((cell % 4) * kCell + 1, (cell / 4) * kCell + 1,
+                            kCell - 2 - (i % 5), kCell - 2 - (i % 3));
+            if (0 == i) {
+                // at the atlas's corner, so drawn as a whole bitmap one by one
+                fTex[i].offsetTo(0, 0);
+            } else if (15 == cell) {
+                // runs off the atlas, so is clamped to it
+                fTex[i].offset(4, 4);
+            } else if (14 == cell) {
+                // starts off the atlas, so is clamped to its corner but still offset
+                fTex[i].offsetTo(-3, -2);
+            }
+
+            SkScalar x = SkIntToScalar(rand.nextRangeU(0, kW)) - kCell;
+            SkScalar y = SkIntToScalar(rand.nextRangeU(0, kH)) - kCell;
+            switch (type) {
+                case kIntTranslate_XformType:
+                    fXforms[i].setTranslate(x, y);
+                    break;
+                case kFracTranslate_XformType:
+                    fXforms[i].setTranslate(x + rand.nextUScalar1(), y + rand.nextUScalar1());
+                    break;
+                case kScale_XformType:
+                    fXforms[i].setScale(rand.nextRangeScalar(0.5f, 2),
+                                        rand.nextRangeScalar(0.5f, 2));
+                    fXforms[i].postTranslate(x, y);
+                    break;
+                case kRotate_XformType:
+                    fXforms[i].setRotate(rand.nextRangeScalar(0, 360));
+                    fXforms[i].postTranslate(x, y);
+                    break;
+            }
+            // runs of the same alpha, so the sprite blitter is both kept and chosen again
+            fColors[i] = (i % 3) ? fColors[i - 1] : SkColorSetA(rand.nextU(), rand.nextU());
+        }
+    }
+
+    void drawEach(SkCanvas* canvas, const SkBitmap& atlas, bool useColors,
+                  const SkPaint& paint) const {
+        SkPaint p(paint);
+        for (int i = 0; i < kCount; ++i) {
+            if (useColors) {
+                p.setColor(fColors[i]);
+            }
+            SkRect src;
+            src.set(fTex[i]);
+            canvas->save();
+            canvas->concat(fXforms[i]);
+            canvas->drawBitmapRectToRect(atlas, &src,
+                                         SkRect::MakeWH(SkIntToScalar(fTex[i].width()),
+                                                        SkIntToScalar(fTex[i].height())), &p);
+            canvas->restore();
+        }
+    }
+};
+
+static void setup_canvas(SkCanvas* canvas, int clipType) {
+    canvas->clear(SK_ColorWHITE);
+    canvas->translate(SkIntToScalar(3), SkIntToScalar(2));
+    switch (clipType) {
+        case 1:
+            canvas->clipRect(SkRect::MakeLTRB(15, 10, 150, 120));
+            break;
+        case 2:
+            // an AA clip, so sprites on its edges can't use the sprite blitter
+            canvas->clipRect(SkRect::MakeLTRB(15.5f, 10.25f, 150.5f, 120.75f),
+                             SkRegion::kIntersect_Op, true);
+            break;
+        default:
+            break;
+    }
+}
+
+static bool equal(const SkBitmap& a, const SkBitmap& b) {
+    SkAutoLockPixels alpa(a), alpb(b);
+    for (int y = 0; y < a.height(); ++y) {
+        if (memcmp(a.getAddr32(0, y), b.getAddr32(0, y), a.width() * sizeof(SkPMColor))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// An atlas draws the same pixels as drawing its sprites one at a time.
+DEF_TEST(DrawAtlas_MatchesOneByOne, reporter) {
+    SkBitmap batch, each;
+    batch.allocN32Pixels(kW, kH);
+    each.allocN32Pixels(kW, kH);
+
+    const SkColorType colorTypes[] = { kN32_SkColorType, kAlpha_8_SkColorType };
+    for (size_t ct = 0; ct < SK_ARRAY_COUNT(colorTypes); ++ct) {
+        SkBitmap atlas;
+        make_atlas(&atlas, colorTypes[ct]);
+        for (int type = kIntTranslate_XformType; type <= kRotate_XformType; ++type) {
+            const Sprites sprites((XformType)type);
+            for (int filter = 0; filter < 2; ++filter) {
+                for (int useColors = 0; useColors < 2; ++useColors) {
+                    for (int shader = 0; shader < 2; ++shader) {
+                        for (int clipType = 0; clipType < 3; ++clipType) {
+                            SkPaint paint;
+                            paint.setColor(0xC0204080);
+                            paint.setFilterLevel(filter ? SkPaint::kLow_FilterLevel
+                                                        : SkPaint::kNone_FilterLevel);
+                            if (shader) {
+                                // colors sprite 0 of an A8 atlas; the atlas replaces it elsewhere
+                                paint.setShader(SkNEW_ARGS(SkColorShader,
+                                                           (SK_ColorGREEN)))->unref();
+                            }
+
+                            SkCanvas batchCanvas(batch), eachCanvas(each);
+                            setup_canvas(&batchCanvas, clipType);
+                            setup_canvas(&eachCanvas, clipType);
+                            batchCanvas.drawAtlas(atlas, sprites.fXforms, sprites.fTex,
+                                                  useColors ? sprites.fColors : NULL, kCount,
+                                                  &paint);
+                            sprites.drawEach(&eachCanvas, atlas, SkToBool(useColors), paint);
+
+                            if (!equal(batch, each)) {
+                                ERRORF(reporter,
+                                       "atlas %d xform %d filter %d colors %d shader %d clip %d",
+                                       colorTypes[ct], type, filter, useColors, shader,
+                                       clipType);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Skips every third sprite it sees and fades the rest.
+class FadeDrawFilter : public SkDrawFilter {
+public:
+    FadeDrawFilter() : fCount(0) {}
+
+    virtual bool filter(SkPaint* paint, Type) SK_OVERRIDE {
+        paint->setAlpha(paint->getAlpha() / 2);
+        return 0 != fCount++ % 3;
+    }
+
+    int fCount;
+};
+
+// A draw filter sees each sprite of an atlas, with its own color, even without a paint.
+DEF_TEST(DrawAtlas_DrawFilter, reporter) {
+    SkBitmap atlas;
+    make_atlas(&atlas, kN32_SkColorType);
+    const Sprites sprites(kFracTranslate_XformType);
+
+    SkBitmap batch, each;
+    batch.allocN32Pixels(kW, kH);
+    each.allocN32Pixels(kW, kH);
+    for (int usePaint = 0; usePaint < 2; ++usePaint) {
+        SkPaint paint;
+        paint.setColor(0xC0204080);
+
+        SkAutoTUnref<FadeDrawFilter> batchFilter(SkNEW(FadeDrawFilter)),
+                                     eachFilter(SkNEW(FadeDrawFilter));
+        SkCanvas batchCanvas(batch), eachCanvas(each);
+        setup_canvas(&batchCanvas, 0);
+        setup_canvas(&eachCanvas, 0);
+        batchCanvas.setDrawFilter(batchFilter);
+        eachCanvas.setDrawFilter(eachFilter);
+        batchCanvas.drawAtlas(atlas, sprites.fXforms, sprites.fTex, sprites.fColors, kCount,
+                              usePaint ? &paint : NULL);
+        sprites.drawEach(&eachCanvas, atlas, true, usePaint ? paint : SkPaint());
+
+        REPORTER_ASSERT(reporter, batchFilter->fCount == eachFilter->fCount);
+        REPORTER_ASSERT(reporter, equal(batch, each));
+    }
+}
+
+// Recorded as one command, an atlas plays back to the same pixels.
+DEF_TEST(DrawAtlas_Record, reporter) {
+    SkBitmap atlas;
+    make_atlas(&atlas, kN32_SkColorType);
+    const Sprites sprites(kIntTranslate_XformType);
+
+    SkRecord record;
+    SkRecorder recorder(&record, kW, kH);
+    recorder.drawAtlas(atlas, sprites.fXforms, sprites.fTex, sprites.fColors, kCount);
+    REPORTER_ASSERT(reporter, 1 == record.count());
+
+    SkBitmap played, direct;
+    played.allocN32Pixels(kW, kH);
+    direct.allocN32Pixels(kW, kH);
+
+    SkCanvas playedCanvas(played), directCanvas(direct);
+    setup_canvas(&playedCanvas, 0);
+    setup_canvas(&directCanvas, 0);
+    SkRecordDraw(record, &playedCanvas);
+    sprites.drawEach(&directCanvas, atlas, true, SkPaint());
+    REPORTER_ASSERT(reporter, equal(played, direct));
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkDrawFilter.h"
+#include "SkRRect.h"
+#include "SkRandom.h"
+#include "SkRecord.h"
+#include "SkRecordDraw.h"
+#include "SkRecorder.h"
+#include "Test.h"
+
+static const int kW = 200;
+static const int kH = 150;
+static const int kCount = 100;
+
+enum Shape {
+    kRect_Shape,
+    kOval_Shape,
+    kRRect_Shape,
+};
+
+struct Shapes {
+    SkRect  fRects[kCount];
+    SkRRect fRRects[kCount];
+    SkColor fColors[kCount];
+
+    Shapes() {
+        SkRandom rand;
+        for (int i = 0; i < kCount; ++i) {
+            SkScalar x = rand.nextRangeScalar(-10, kW);
+            SkScalar y = rand.nextRangeScalar(-10, kH);
+            // small, like the points of a chart, with a few big ones
+            SkScalar size = (i % 10) ? rand.nextRangeScalar(1, 8) : rand.nextRangeScalar(20, 60);
+            fRects[i].setXYWH(x, y, size, rand.nextRangeScalar(1, 8));
+            fRRects[i].setRectXY(fRects[i], size / 4, size / 4);
+            // runs of the same color, so the blitter is both kept and chosen again
+            fColors[i] = (i % 3) ? fColors[i - 1] : (rand.nextU() | 0x80000000);
+        }
+    }
+
+    void drawBatch(SkCanvas* canvas, Shape shape, bool useColors, const SkPaint& paint) const {
+        const SkColor* colors = useColors ? fColors : NULL;
+        switch (shape) {
+            case kRect_Shape:
+                canvas->drawRects(fRects, colors, kCount, paint);
+                break;
+            case kOval_Shape:
+                canvas->drawOvals(fRects, colors, kCount, paint);
+                break;
+            case kRRect_Shape:
+                canvas->drawRRects(fRRects, colors, kCount, paint);
+                break;
+        }
+    }
+
+    void drawEach(SkCanvas* canvas, Shape shape, bool useColors, const SkPaint& paint) const {
+        SkPaint p(paint);
+        for (int i = 0; i < kCount; ++i) {
+            if (useColors) {
+                p.setColor(fColors[i]);
+            }
+            switch (shape) {
+                case kRect_Shape:
+                    canvas->drawRect(fRects[i], p);
+                    break;
+                case kOval_Shape:
+                    canvas->drawOval(fRects[i], p);
+                    break;
+                case kRRect_Shape:
+                    canvas->drawRRect(fRRects[i], p);
+                    break;
+            }
+        }
+    }
+};
+
+static void setup_canvas(SkCanvas* canvas, int clipType) {
+    canvas->clear(SK_ColorWHITE);
+    canvas->translate(SK_Scalar1 / 3, SK_Scalar1 / 2);
+    switch (clipType) {
+        case 1:
+            canvas->clipRect(SkRect::MakeLTRB(15, 10, 150, 120));
+            break;
+        case 2:
+            // an AA clip, so the shapes are drawn through an SkAAClip
+            canvas->clipRect(SkRect::MakeLTRB(15.5f, 10.25f, 150.5f, 120.75f),
+                             SkRegion::kIntersect_Op, true);
+            break;
+        default:
+            break;
+    }
+}
+
+static bool equal(const SkBitmap& a, const SkBitmap& b) {
+    SkAutoLockPixels alpa(a), alpb(b);
+    for (int y = 0; y < a.height(); ++y) {
+        if (memcmp(a.getAddr32(0, y), b.getAddr32(0, y), a.width() * sizeof(SkPMColor))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A batch draws the same pixels as drawing its shapes one at a time.
+DEF_TEST(DrawShapes_MatchesOneByOne, reporter) {
+    const Shapes shapes;
+    SkBitmap batch, each;
+    batch.allocN32Pixels(kW, kH);
+    each.allocN32Pixels(kW, kH);
+
+    for (int shape = kRect_Shape; shape <= kRRect_Shape; ++shape) {
+        for (int style = 0; style < 3; ++style) {
+            for (int aa = 0; aa < 2; ++aa) {
+                for (int useColors = 0; useColors < 2; ++useColors) {
+                    for (int clipType = 0; clipType < 3; ++clipType) {
+                        SkPaint paint;
+                        paint.setAntiAlias(SkToBool(aa));
+                        paint.setColor(0xC0204080);
+                        if (style > 0) {
+                            paint.setStyle(SkPaint::kStroke_Style);
+                            // a hairline, and then a real stroke
+                            paint.setStrokeWidth(SkIntToScalar(style - 1) * 2);
+                        }
+
+                        SkCanvas batchCanvas(batch), eachCanvas(each);
+                        setup_canvas(&batchCanvas, clipType);
+                        setup_canvas(&eachCanvas, clipType);
+                        shapes.drawBatch(&batchCanvas, (Shape)shape, SkToBool(useColors), paint);
+                        shapes.drawEach(&eachCanvas, (Shape)shape, SkToBool(useColors), paint);
+
+                        if (!equal(batch, each)) {
+                            ERRORF(reporter, "shape %d style %d aa %d colors %d clip %d",
+                                   shape, style, aa, useColors, clipType);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Skips every third shape it sees and fades the rest.
+class FadeDrawFilter : public SkDrawFilter {
+public:
+    FadeDrawFilter() : fCount(0) {}
+
+    virtual bool filter(SkPaint* paint, Type) SK_OVERRIDE {
+        paint->setAlpha(paint->getAlpha() / 2);
+        return 0 != fCount++ % 3;
+    }
+
+    int fCount;
+};
+
+// A draw filter sees each shape of a batch, with its own color.
+DEF_TEST(DrawShapes_DrawFilter, reporter) {
+    const Shapes shapes;
+    SkBitmap batch, each;
+    batch.allocN32Pixels(kW, kH);
+    each.allocN32Pixels(kW, kH);
+
+    for (int shape = kRect_Shape; shape <= kRRect_Shape; ++shape) {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+
+        SkAutoTUnref<FadeDrawFilter> batchFilter(SkNEW(FadeDrawFilter)),
+                                     eachFilter(SkNEW(FadeDrawFilter));
+        SkCanvas batchCanvas(batch), eachCanvas(each);
+        setup_canvas(&batchCanvas, 0);
+        setup_canvas(&eachCanvas, 0);
+        batchCanvas.setDrawFilter(batchFilter);
+        eachCanvas.setDrawFilter(eachFilter);
+        shapes.drawBatch(&batchCanvas, (Shape)shape, true, paint);
+        shapes.drawEach(&eachCanvas, (Shape)shape, true, paint);
+
+        REPORTER_ASSERT(reporter, batchFilter->fCount == eachFilter->fCount);
+        REPORTER_ASSERT(reporter, equal(batch, each));
+    }
+}
+
+// Recorded as one command each, batches play back to the same pixels.
+DEF_TEST(DrawShapes_Record, reporter) {
+    const Shapes shapes;
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    SkRecord record;
+    SkRecorder recorder(&record, kW, kH);
+    for (int shape = kRect_Shape; shape <= kRRect_Shape; ++shape) {
+        shapes.drawBatch(&recorder, (Shape)shape, true, paint);
+    }
+    REPORTER_ASSERT(reporter, 3 == record.count());
+
+    SkBitmap played, direct;
+    played.allocN32Pixels(kW, kH);
+    direct.allocN32Pixels(kW, kH);
+
+    SkCanvas playedCanvas(played), directCanvas(direct);
+    setup_canvas(&playedCanvas, 0);
+    setup_canvas(&directCanvas, 0);
+    SkRecordDraw(record, &playedCanvas);
+    for (int shape = kRect_Shape; shape <= kRRect_Shape; ++shape) {
+        shapes.drawEach(&directCanvas, (Shape)shape, true, paint);
+    }
+    REPORTER_ASSERT(reporter, equal(played, direct));
+}
@@ -6,6 +6,7 @@
  */
 
 #include "SkGeometry.h"
+#include "SkRandom.h"
 #include "Test.h"
 
 static bool nearly_equal(const SkPoint& a, const SkPoint& b) {
@@ -33,6 +34,59 @@ static void testChopCubic(skiatest::Reporter* reporter) {
     }
 }
 
+static void eval_at(const SkPoint pts[], int n, SkScalar t, SkPoint* pt) {
+    if (3 == n) {
+        SkEvalQuadAt(pts, t, pt);
+    } else {
+        SkEvalCubicAt(pts, t, pt, NULL, NULL);
+    }
+}
+
+static void testFlatten(skiatest::Reporter* reporter) {
+    SkRandom rand;
+    for (int i = 0; i < 1000; ++i) {
+        SkPoint pts[4];
+        for (int j = 0; j < 4; ++j) {
+            pts[j].set(rand.nextRangeScalar(-100, 100), rand.nextRangeScalar(-100, 100));
+        }
+        const int n = 3 + (i & 1);
+        const SkScalar tol = SK_Scalar1 / (1 + rand.nextULessThan(8));
+        const int count = 3 == n ? SkQuadFlattenCount(pts, tol, 1000)
+                                 : SkCubicFlattenCount(pts, tol, 1000);
+        REPORTER_ASSERT(reporter, count >= 1 && count < 1000);
+        if (count > 64) {
+            continue;
+        }
+
+        SkPoint flat[65];
+        if (3 == n) {
+            SkQuadFlatten(pts, count, flat);
+        } else {
+            SkCubicFlatten(pts, count, flat);
+        }
+        REPORTER_ASSERT(reporter, flat[0] == pts[0]);
+        REPORTER_ASSERT(reporter, flat[count] == pts[n - 1]);
+        for (int j = 0; j <= count; ++j) {
+            // The points are where they should be, up to the rounding from the differencing ...
+            SkPoint pt;
+            eval_at(pts, n, SkIntToScalar(j) / count, &pt);
+            REPORTER_ASSERT(reporter, SkPoint::Distance(pt, flat[j]) < SK_Scalar1 / 64);
+            // ... and each line is within tol of the curve between its ends.
+            if (j < count) {
+                eval_at(pts, n, (j + SK_ScalarHalf) / count, &pt);
+                SkPoint mid = { SkScalarAve(flat[j].fX, flat[j + 1].fX),
+                                SkScalarAve(flat[j].fY, flat[j + 1].fY) };
+                REPORTER_ASSERT(reporter, SkPoint::Distance(pt, mid) <= tol + SK_Scalar1 / 64);
+            }
+        }
+    }
+
+    // Non-finite points don't make for a huge (or negative) count.
+    const SkPoint bad[] = { { 0, 0 }, { SK_ScalarNaN, 0 }, { 1, 1 }, { 2, 2 } };
+    REPORTER_ASSERT(reporter, SkQuadFlattenCount(bad, SK_Scalar1, 64) == 64);
+    REPORTER_ASSERT(reporter, SkCubicFlattenCount(bad, SK_Scalar1, 64) == 64);
+}
+
 DEF_TEST(Geometry, reporter) {
     SkPoint pts[3], dst[5];
 
@@ -58,4 +112,5 @@ DEF_TEST(Geometry, reporter) {
     }
 
     testChopCubic(reporter);
+    testFlatten(reporter);
 }
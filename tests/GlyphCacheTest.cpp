@@ -0,0 +1,57 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkGlyphCache.h"
+#include "SkGraphics.h"
+#include "SkPaint.h"
+#include "SkTDArray.h"
+#include "Test.h"
+
+// Returns the concatenated images of the glyphs, preloaded by threadCount threads
+// if threadCount > 0, or generated lazily by findImage otherwise.
+static void glyph_images(const SkPaint& paint, const uint16_t glyphs[], int count,
+                         int threadCount, SkTDArray<uint8_t>* images) {
+    SkGraphics::PurgeFontCache();
+    SkAutoGlyphCache autoCache(paint, NULL, NULL);
+    SkGlyphCache* cache = autoCache.getCache();
+    if (threadCount > 0) {
+        cache->preloadImages(glyphs, count, threadCount);
+    }
+    for (int i = 0; i < count; i++) {
+        const SkGlyph& glyph = cache->getGlyphIDMetrics(glyphs[i]);
+        const void* image = cache->findImage(glyph);
+        if (NULL != image) {
+            images->append(SkToInt(glyph.computeImageSize()), (const uint8_t*)image);
+        }
+    }
+}
+
+DEF_TEST(GlyphCache_PreloadImages, reporter) {
+    char text[94];
+    for (size_t i = 0; i < sizeof(text); i++) {
+        text[i] = '!' + i;
+    }
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setTextSize(24);
+    const int count = paint.textToGlyphs(text, sizeof(text), NULL);
+    SkAutoTMalloc<uint16_t> glyphs(count);
+    paint.textToGlyphs(text, sizeof(text), glyphs.get());
+
+    SkTDArray<uint8_t> lazy;
+    glyph_images(paint, glyphs.get(), count, 0, &lazy);
+    REPORTER_ASSERT(reporter, lazy.count() > 0);
+
+    const int kThreadCounts[] = { 1, 3 };
+    for (size_t i = 0; i < SK_ARRAY_COUNT(kThreadCounts); i++) {
+        SkTDArray<uint8_t> preloaded;
+        glyph_images(paint, glyphs.get(), count, kThreadCounts[i], &preloaded);
+        REPORTER_ASSERT(reporter, lazy.count() == preloaded.count());
+        REPORTER_ASSERT(reporter, 0 == memcmp(lazy.begin(), preloaded.begin(),
+                                              SkTMin(lazy.count(), preloaded.count())));
+    }
+}
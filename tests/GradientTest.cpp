@@ -9,6 +9,8 @@
 #include "SkColorShader.h"
 #include "SkEmptyShader.h"
 #include "SkGradientShader.h"
+#include "SkGradient_opts.h"
+#include "SkRandom.h"
 #include "SkShader.h"
 #include "SkTemplates.h"
 #include "Test.h"
@@ -156,6 +158,47 @@ static void TestConstantGradient(skiatest::Reporter*) {
     }
 }
 
+// Gradient shaders with the same colors share their color tables, so make sure
+// that nothing which affects the tables is left out when we look them up.
+static void draw_gradient(SkBitmap* bm, const SkScalar pos[], uint32_t flags, U8CPU alpha) {
+    const SkPoint pts[] = { { 0, 0 }, { SkIntToScalar(16), 0 } };
+    const SkColor colors[] = { SK_ColorRED, 0x8000FF00, SK_ColorBLUE };
+    SkAutoTUnref<SkShader> s(SkGradientShader::CreateLinear(pts, colors, pos,
+                                                            SK_ARRAY_COUNT(colors),
+                                                            SkShader::kClamp_TileMode,
+                                                            flags, NULL));
+    bm->allocN32Pixels(16, 1);
+    bm->eraseColor(SK_ColorTRANSPARENT);
+    SkPaint paint;
+    paint.setShader(s);
+    paint.setAlpha(alpha);
+    SkCanvas canvas(*bm);
+    canvas.drawPaint(paint);
+}
+
+static bool same_pixels(const SkBitmap& a, const SkBitmap& b) {
+    SkAutoLockPixels alpa(a), alpb(b);
+    return 0 == memcmp(a.getPixels(), b.getPixels(), a.getSize());
+}
+
+static void TestSharedGradientCaches(skiatest::Reporter* reporter) {
+    const SkScalar pos[] = { 0, 0.25f, SK_Scalar1 };
+    const SkScalar otherPos[] = { 0, 0.75f, SK_Scalar1 };
+    const uint32_t premul = SkGradientShader::kInterpolateColorsInPremul_Flag;
+
+    SkBitmap base, same, other;
+    draw_gradient(&base, pos, 0, 0xFF);
+    draw_gradient(&same, pos, 0, 0xFF);
+    REPORTER_ASSERT(reporter, same_pixels(base, same));
+
+    draw_gradient(&other, otherPos, 0, 0xFF);
+    REPORTER_ASSERT(reporter, !same_pixels(base, other));
+    draw_gradient(&other, pos, premul, 0xFF);
+    REPORTER_ASSERT(reporter, !same_pixels(base, other));
+    draw_gradient(&other, pos, 0, 0x80);
+    REPORTER_ASSERT(reporter, !same_pixels(base, other));
+}
+
 typedef void (*GradProc)(skiatest::Reporter* reporter, const GradRec&);
 
 static void TestGradientShaders(skiatest::Reporter* reporter) {
@@ -190,7 +233,90 @@ static void TestGradientShaders(skiatest::Reporter* reporter) {
     }
 }
 
+static void random_lerp(SkRandom* rand, bool opaque, SkGradientLerp* lerp) {
+    float colors[2][4];
+    for (int i = 0; i < 2; i++) {
+        colors[i][0] = opaque ? 255.0f : (float)rand->nextULessThan(256);
+        for (int c = 1; c < 4; c++) {
+            colors[i][c] = (float)rand->nextULessThan(256);
+        }
+    }
+    lerp->fInterpInPremul = rand->nextBool();
+    if (lerp->fInterpInPremul) {
+        for (int i = 0; i < 2; i++) {
+            for (int c = 1; c < 4; c++) {
+                colors[i][c] *= colors[i][0] / 255;
+            }
+        }
+    }
+    for (int c = 0; c < 4; c++) {
+        lerp->fColor0[c] = colors[0][c];
+        lerp->fDelta[c]  = colors[1][c] - colors[0][c];
+    }
+    lerp->fTileMode = (SkShader::TileMode)rand->nextULessThan(SkShader::kTileModeCount);
+}
+
+// Whether each channel of a and b are within tolerance of each other.
+static bool near_pixels(const SkPMColor a[], const SkPMColor b[], int count, int tolerance) {
+    for (int i = 0; i < count; i++) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            const int da = (a[i] >> shift) & 0xFF,
+                      db = (b[i] >> shift) & 0xFF;
+            if (SkAbs32(da - db) > tolerance) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// The platform procs, if any, draw the same pixels as the portable ones.  The SSE2 linear
+// proc steps opaque clamped spans in fixed point, which may be off by one.
+static void TestPlatformLerpProcs(skiatest::Reporter* reporter) {
+    SkGradientLerpProcs platform, portable;
+    if (!SkGradientGetPlatformLerpProcs(&platform)) {
+        return;
+    }
+    SkGradientGetPortableLerpProcs(&portable);
+
+    static const int kMaxCount = 1029;
+    SkPMColor expected[kMaxCount], actual[kMaxCount];
+    float t[kMaxCount];
+    SkRandom rand;
+    for (int trial = 0; trial < 1000; trial++) {
+        SkGradientLerp lerp;
+        random_lerp(&rand, rand.nextBool(), &lerp);
+        const int count = rand.nextRangeU(1, kMaxCount);
+        const int x = rand.nextULessThan(100),
+                  y = rand.nextULessThan(100);
+
+        // Spans that start, end or stay clamped, and ones that ramp slowly over many pixels.
+        const float t0 = rand.nextRangeF(-1.5f, 2.5f),
+                    dt = (trial & 15) ? rand.nextRangeF(-4, 4) / count * rand.nextF() : 0;
+        const bool opaqueClamp = SkShader::kClamp_TileMode == lerp.fTileMode &&
+                                 255 == lerp.fColor0[0] && 0 == lerp.fDelta[0];
+        portable.fLinear(lerp, t0, dt, x, y, expected, count);
+        platform.fLinear(lerp, t0, dt, x, y, actual, count);
+        REPORTER_ASSERT(reporter, near_pixels(expected, actual, count, opaqueClamp ? 1 : 0));
+
+        const float px = rand.nextRangeF(-2, 2), py = rand.nextRangeF(-2, 2),
+                    dx = rand.nextRangeF(-0.1f, 0.1f), dy = rand.nextRangeF(-0.1f, 0.1f);
+        portable.fRadial(lerp, px, py, dx, dy, x, y, expected, count);
+        platform.fRadial(lerp, px, py, dx, dy, x, y, actual, count);
+        REPORTER_ASSERT(reporter, 0 == memcmp(expected, actual, count * sizeof(SkPMColor)));
+
+        for (int i = 0; i < count; i++) {
+            t[i] = rand.nextULessThan(8) ? rand.nextRangeF(-1.5f, 2.5f) : SK_FloatNaN;
+        }
+        portable.fSpan(lerp, t, x, y, expected, count);
+        platform.fSpan(lerp, t, x, y, actual, count);
+        REPORTER_ASSERT(reporter, 0 == memcmp(expected, actual, count * sizeof(SkPMColor)));
+    }
+}
+
 DEF_TEST(Gradient, reporter) {
     TestGradientShaders(reporter);
     TestConstantGradient(reporter);
+    TestSharedGradientCaches(reporter);
+    TestPlatformLerpProcs(reporter);
 }
@@ -13,6 +13,7 @@
 #include "SkCanvas.h"
 #include "SkColorFilterImageFilter.h"
 #include "SkColorMatrixFilter.h"
+#include "SkColorPriv.h"
 #include "SkDeviceImageFilterProxy.h"
 #include "SkDisplacementMapEffect.h"
 #include "SkDropShadowImageFilter.h"
@@ -28,8 +29,10 @@
 #include "SkPicture.h"
 #include "SkPictureImageFilter.h"
 #include "SkPictureRecorder.h"
+#include "SkRandom.h"
 #include "SkRect.h"
 #include "SkTileImageFilter.h"
+#include "SkUnPreMultiply.h"
 #include "SkXfermodeImageFilter.h"
 #include "Test.h"
 
@@ -426,6 +429,132 @@ DEF_TEST(ImageFilterDrawTiled, reporter) {
     }
 }
 
+class BitmapTileSink : public SkImageFilter::TileSink {
+public:
+    explicit BitmapTileSink(SkCanvas* canvas) : fCanvas(canvas) {}
+    virtual void drawTile(const SkBitmap& tile, int x, int y) SK_OVERRIDE {
+        fCanvas->drawSprite(tile, x, y);
+    }
+private:
+    SkCanvas* fCanvas;
+};
+
+DEF_TEST(ImageFilterTiledEvaluation, reporter) {
+    // Check that filterImageTiled() finds exactly what filterImage() does.
+    SkAutoTUnref<SkColorFilter> cf(SkColorFilter::CreateModeFilter(SK_ColorRED, SkXfermode::kSrcIn_Mode));
+    SkAutoTUnref<SkImageFilter> blur(SkBlurImageFilter::Create(SkIntToScalar(3), SkIntToScalar(3)));
+    SkAutoTUnref<SkImageFilter> offset(SkOffsetImageFilter::Create(SkIntToScalar(-7), SkIntToScalar(5), blur));
+    SkAutoTUnref<SkImageFilter> dilate(SkDilateImageFilter::Create(2, 3, offset));
+    SkAutoTUnref<SkImageFilter> color(SkColorFilterImageFilter::Create(cf.get(), blur));
+    // Lighting reads a pixel's neighbors without saying so in onFilterBounds(), so it isn't tiled.
+    SkPoint3 location(SkIntToScalar(32), SkIntToScalar(32), SkIntToScalar(20));
+    SkAutoTUnref<SkImageFilter> lighting(SkLightingImageFilter::CreatePointLitDiffuse(
+        location, SK_ColorWHITE, SkIntToScalar(8), SK_Scalar1));
+
+    const int width = 64, height = 64, tileSize = 10;
+    SkBitmap src = make_gradient_circle(width, height);
+    // A source filter, drawing a scaled bitmap only where the tile's clip asks for it.
+    SkAutoTUnref<SkImageFilter> scaled(SkBitmapSource::Create(
+        src, SkRect::MakeWH(SkIntToScalar(width), SkIntToScalar(height)),
+        SkRect::MakeLTRB(4, 6, 57, 60)));
+
+    SkImageFilter* filters[] = {
+        SkBlurImageFilter::Create(SkIntToScalar(5), SkIntToScalar(2)),
+        SkDropShadowImageFilter::Create(SK_Scalar1, SK_Scalar1, SK_Scalar1, SK_Scalar1, SK_ColorGREEN),
+        SkErodeImageFilter::Create(2, 3, blur),
+        SkMergeImageFilter::Create(dilate, color, SkXfermode::kSrcOver_Mode),
+        SkRef(lighting.get()),
+        SkMergeImageFilter::Create(lighting, blur, SkXfermode::kSrcOver_Mode),
+        SkBlurImageFilter::Create(SkIntToScalar(2), SkIntToScalar(1), scaled),
+    };
+    const bool canTile[] = { true, true, true, true, false, false, true };
+
+    SkBitmap untiledResult, tiledResult;
+    untiledResult.allocN32Pixels(width, height);
+    tiledResult.allocN32Pixels(width, height);
+    SkCanvas untiledCanvas(untiledResult), tiledCanvas(tiledResult);
+    SkBitmapDevice device(untiledResult);
+    SkDeviceImageFilterProxy proxy(&device);
+
+    for (size_t i = 0; i < SK_ARRAY_COUNT(filters); ++i) {
+        SkString str;
+        str.printf("filter %d", static_cast<int>(i));
+        REPORTER_ASSERT_MESSAGE(reporter, canTile[i] == filters[i]->canFilterTiled(), str.c_str());
+        untiledCanvas.clear(0);
+        tiledCanvas.clear(0);
+        SkAutoTUnref<SkImageFilter::Cache> cache(SkImageFilter::Cache::Create());
+        SkImageFilter::Context ctx(SkMatrix::I(), SkIRect::MakeWH(width, height), cache.get());
+
+        SkBitmap result;
+        SkIPoint offset = SkIPoint::Make(0, 0);
+        REPORTER_ASSERT_MESSAGE(reporter,
+                                filters[i]->filterImage(&proxy, src, ctx, &result, &offset),
+                                str.c_str());
+        untiledCanvas.drawSprite(result, offset.fX, offset.fY);
+
+        BitmapTileSink sink(&tiledCanvas);
+        REPORTER_ASSERT_MESSAGE(reporter,
+                                filters[i]->filterImageTiled(&proxy, src, ctx, tileSize, &sink),
+                                str.c_str());
+
+        for (int y = 0; y < height; y++) {
+            int diffs = memcmp(untiledResult.getAddr32(0, y), tiledResult.getAddr32(0, y), untiledResult.rowBytes());
+            REPORTER_ASSERT_MESSAGE(reporter, !diffs, str.c_str());
+            if (diffs) {
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < SK_ARRAY_COUNT(filters); ++i) {
+        filters[i]->unref();
+    }
+}
+
+// Remembers the largest device any filter asked for.
+class SizeRecordingProxy : public SkDeviceImageFilterProxy {
+public:
+    explicit SizeRecordingProxy(SkBaseDevice* device)
+        : INHERITED(device), fMaxWidth(0), fMaxHeight(0) {}
+
+    virtual SkBaseDevice* createDevice(int width, int height) SK_OVERRIDE {
+        fMaxWidth = SkTMax(fMaxWidth, width);
+        fMaxHeight = SkTMax(fMaxHeight, height);
+        return this->INHERITED::createDevice(width, height);
+    }
+
+    int fMaxWidth, fMaxHeight;
+
+private:
+    typedef SkDeviceImageFilterProxy INHERITED;
+};
+
+DEF_TEST(ImageFilterTiledDeviceSize, reporter) {
+    // Each tile only needs devices the size of the tile and the blur's margin, even for a source
+    // filter that draws all over the image.
+    const int size = 400, tileSize = 50;
+    SkBitmap src = make_gradient_circle(100, 100);
+    SkAutoTUnref<SkImageFilter> scaled(SkBitmapSource::Create(
+        src, SkRect::MakeWH(100, 100), SkRect::MakeWH(SkIntToScalar(size), SkIntToScalar(size))));
+    SkAutoTUnref<SkImageFilter> blur(SkBlurImageFilter::Create(SkIntToScalar(2), SkIntToScalar(2),
+                                                               scaled));
+
+    SkBitmap canvasBitmap, empty;
+    canvasBitmap.allocN32Pixels(size, size);
+    empty.allocN32Pixels(size, size);
+    SkCanvas canvas(canvasBitmap);
+    SkBitmapDevice device(canvasBitmap);
+    SizeRecordingProxy proxy(&device);
+    SkAutoTUnref<SkImageFilter::Cache> cache(SkImageFilter::Cache::Create());
+    SkImageFilter::Context ctx(SkMatrix::I(), SkIRect::MakeWH(size, size), cache.get());
+    BitmapTileSink sink(&canvas);
+    REPORTER_ASSERT(reporter, blur->filterImageTiled(&proxy, empty, ctx, tileSize, &sink));
+
+    // The blur reads 3 sigma, 6 pixels, on each side of the tile.
+    REPORTER_ASSERT(reporter, proxy.fMaxWidth <= tileSize + 2 * 6);
+    REPORTER_ASSERT(reporter, proxy.fMaxHeight <= tileSize + 2 * 6);
+}
+
 DEF_TEST(ImageFilterMatrixConvolution, reporter) {
     // Check that a 1x3 filter does not cause a spurious assert.
     SkScalar kernel[3] = {
@@ -762,6 +891,402 @@ DEF_TEST(XfermodeImageFilterCroppedInput, reporter) {
     test_xfermode_cropped_input(&device, reporter);
 }
 
+// Filters src as a canvas would, with a new per-draw cache.
+static void filter_once(SkImageFilter* filter, SkBaseDevice* device, const SkBitmap& src,
+                        const SkMatrix& ctm, SkBitmap* result) {
+    SkDeviceImageFilterProxy proxy(device);
+    SkAutoTUnref<SkImageFilter::Cache> cache(SkImageFilter::Cache::Create());
+    SkImageFilter::Context ctx(ctm, SkIRect::MakeWH(src.width(), src.height()), cache.get());
+    SkIPoint offset;
+    SkAssertResult(filter->filterImage(&proxy, src, ctx, result, &offset));
+}
+
+DEF_TEST(ImageFilterPersistentCache, reporter) {
+    SkBitmap temp;
+    temp.allocN32Pixels(100, 100);
+    SkBitmapDevice device(temp);
+
+    SkBitmap src;
+    src.allocN32Pixels(100, 100);
+    src.eraseColor(SK_ColorBLUE);
+    SkAutoTUnref<SkImageFilter> blur(SkBlurImageFilter::Create(SK_Scalar1, SK_Scalar1));
+
+    // The cache is off until given a limit.
+    const size_t oldLimit = SkImageFilter::Cache::SetTotalByteLimit(1024 * 1024);
+
+    // Filtering the same pixels the same way again should reuse the first result.
+    SkBitmap first, second;
+    filter_once(blur, &device, src, SkMatrix::I(), &first);
+    filter_once(blur, &device, src, SkMatrix::I(), &second);
+    REPORTER_ASSERT(reporter, first.pixelRef() == second.pixelRef());
+
+    // Tiles filter subsets of the source, and their results are no good to the next draw.
+    SkBitmap tiles;
+    tiles.allocN32Pixels(100, 100);
+    SkCanvas tileCanvas(tiles);
+    BitmapTileSink sink(&tileCanvas);
+    SkDeviceImageFilterProxy proxy(&device);
+    SkAutoTUnref<SkImageFilter::Cache> cache(SkImageFilter::Cache::Create());
+    SkImageFilter::Context ctx(SkMatrix::I(), SkIRect::MakeWH(100, 100), cache.get());
+    REPORTER_ASSERT(reporter, blur->filterImageTiled(&proxy, src, ctx, 50, &sink));
+    // The first tile needs a 3 pixel margin for the blur.
+    const SkImageFilter::Cache::Key firstTile(blur->uniqueID(), SkMatrix::I(),
+                                              SkIRect::MakeWH(53, 53), src.getGenerationID(),
+                                              SkIRect::MakeWH(53, 53));
+    SkBitmap found;
+    SkIPoint foundOffset;
+    REPORTER_ASSERT(reporter, !cache->getPersistent(firstTile, &found, &foundOffset));
+
+    // But not if the matrix or the source's pixels change.
+    SkMatrix scale;
+    scale.setScale(2, 2);
+    SkBitmap scaled, erased;
+    filter_once(blur, &device, src, scale, &scaled);
+    REPORTER_ASSERT(reporter, first.pixelRef() != scaled.pixelRef());
+    src.eraseColor(SK_ColorRED);
+    filter_once(blur, &device, src, SkMatrix::I(), &erased);
+    REPORTER_ASSERT(reporter, first.pixelRef() != erased.pixelRef());
+
+    // A limit of 0 empties the cache and turns it off.
+    SkImageFilter::Cache::SetTotalByteLimit(0);
+    REPORTER_ASSERT(reporter, 0 == SkImageFilter::Cache::GetTotalBytesUsed());
+    SkBitmap uncached;
+    filter_once(blur, &device, src, SkMatrix::I(), &uncached);
+    REPORTER_ASSERT(reporter, erased.pixelRef() != uncached.pixelRef());
+    REPORTER_ASSERT(reporter, 0 == SkImageFilter::Cache::GetTotalBytesUsed());
+    SkImageFilter::Cache::SetTotalByteLimit(oldLimit);
+}
+
+static void make_noise(int width, int height, SkBitmap* bitmap) {
+    SkRandom rand;
+    bitmap->allocN32Pixels(width, height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            *bitmap->getAddr32(x, y) = SkPreMultiplyColor(rand.nextU());
+        }
+    }
+}
+
+static bool bitmaps_equal(const SkBitmap& a, const SkBitmap& b) {
+    if (a.width() != b.width() || a.height() != b.height()) {
+        return false;
+    }
+    SkAutoLockPixels alpA(a), alpB(b);
+    for (int y = 0; y < a.height(); ++y) {
+        if (memcmp(a.getAddr32(0, y), b.getAddr32(0, y), a.width() * sizeof(SkPMColor))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Each channel of the max (or min) of the pixels within radius of (x, y).
+static SkPMColor morphology_reference(const SkBitmap& src, int x, int y, const SkISize& radius,
+                                      bool dilate) {
+    uint8_t result[4];
+    memset(result, dilate ? 0 : 0xFF, sizeof(result));
+    for (int sy = SkMax32(y - radius.height(), 0);
+         sy <= SkMin32(y + radius.height(), src.height() - 1); ++sy) {
+        for (int sx = SkMax32(x - radius.width(), 0);
+             sx <= SkMin32(x + radius.width(), src.width() - 1); ++sx) {
+            const uint8_t* s = reinterpret_cast<const uint8_t*>(src.getAddr32(sx, sy));
+            for (int i = 0; i < 4; ++i) {
+                result[i] = dilate ? SkTMax(result[i], s[i]) : SkTMin(result[i], s[i]);
+            }
+        }
+    }
+    SkPMColor c;
+    memcpy(&c, result, sizeof(c));
+    return c;
+}
+
+DEF_TEST(ImageFilterMorphologyLargeRadius, reporter) {
+    // Radii past a few pixels take a different path; check them against the definition.
+    SkBitmap temp;
+    temp.allocN32Pixels(100, 100);
+    SkBitmapDevice device(temp);
+
+    SkBitmap src;
+    make_noise(61, 47, &src);
+    const SkISize radii[] = {
+        SkISize::Make(1, 2), SkISize::Make(7, 4), SkISize::Make(20, 9), SkISize::Make(70, 33),
+    };
+    for (size_t i = 0; i < SK_ARRAY_COUNT(radii); ++i) {
+        for (int dilate = 0; dilate < 2; ++dilate) {
+            const SkISize& r = radii[i];
+            SkAutoTUnref<SkImageFilter> filter(dilate
+                ? (SkImageFilter*)SkDilateImageFilter::Create(r.width(), r.height())
+                : (SkImageFilter*)SkErodeImageFilter::Create(r.width(), r.height()));
+            SkBitmap result;
+            filter_once(filter, &device, src, SkMatrix::I(), &result);
+
+            SkBitmap expected;
+            expected.allocN32Pixels(src.width(), src.height());
+            for (int y = 0; y < src.height(); ++y) {
+                for (int x = 0; x < src.width(); ++x) {
+                    *expected.getAddr32(x, y) = morphology_reference(src, x, y, r, dilate);
+                }
+            }
+            REPORTER_ASSERT(reporter, bitmaps_equal(expected, result));
+        }
+    }
+}
+
+// Matrix convolution with clamped edges, per the SkMatrixConvolutionImageFilter docs.
+static SkPMColor convolution_reference(const SkBitmap& src, int x, int y,
+                                       const SkISize& kernelSize, const SkScalar* kernel,
+                                       SkScalar gain, SkScalar bias, const SkIPoint& kernelOffset,
+                                       bool convolveAlpha) {
+    SkScalar sumA = 0, sumR = 0, sumG = 0, sumB = 0;
+    for (int cy = 0; cy < kernelSize.height(); ++cy) {
+        for (int cx = 0; cx < kernelSize.width(); ++cx) {
+            int sx = SkPin32(x + cx - kernelOffset.fX, 0, src.width() - 1);
+            int sy = SkPin32(y + cy - kernelOffset.fY, 0, src.height() - 1);
+            SkPMColor s = *src.getAddr32(sx, sy);
+            if (!convolveAlpha) {
+                s = SkUnPreMultiply::PMColorToColor(s);
+            }
+            SkScalar k = kernel[cy * kernelSize.width() + cx];
+            sumA += SkIntToScalar(SkGetPackedA32(s)) * k;
+            sumR += SkIntToScalar(SkGetPackedR32(s)) * k;
+            sumG += SkIntToScalar(SkGetPackedG32(s)) * k;
+            sumB += SkIntToScalar(SkGetPackedB32(s)) * k;
+        }
+    }
+    int a = convolveAlpha ? SkClampMax(SkScalarFloorToInt(sumA * gain + bias), 255) : 255;
+    int r = SkClampMax(SkScalarFloorToInt(sumR * gain + bias), a);
+    int g = SkClampMax(SkScalarFloorToInt(sumG * gain + bias), a);
+    int b = SkClampMax(SkScalarFloorToInt(sumB * gain + bias), a);
+    if (!convolveAlpha) {
+        return SkPreMultiplyARGB(SkGetPackedA32(*src.getAddr32(x, y)), r, g, b);
+    }
+    return SkPackARGB32(a, r, g, b);
+}
+
+DEF_TEST(ImageFilterMatrixConvolutionInterior, reporter) {
+    SkBitmap temp;
+    temp.allocN32Pixels(100, 100);
+    SkBitmapDevice device(temp);
+
+    SkBitmap src;
+    make_noise(37, 29, &src);
+    const SkScalar kernel[15] = {
+        0.1f, -0.3f, 0.2f,
+        0.5f,  1.1f, -0.7f,
+        0.3f,  0.2f, 0.0f,
+        -0.4f, 0.6f, 0.1f,
+        0.05f, 0.2f, 0.25f,
+    };
+    const SkISize kernelSize = SkISize::Make(3, 5);
+    const SkIPoint kernelOffset = SkIPoint::Make(1, 3);
+    const SkScalar gain = 1.3f, bias = -20.5f;
+    for (int convolveAlpha = 0; convolveAlpha < 2; ++convolveAlpha) {
+        SkAutoTUnref<SkImageFilter> filter(SkMatrixConvolutionImageFilter::Create(
+            kernelSize, kernel, gain, bias, kernelOffset,
+            SkMatrixConvolutionImageFilter::kClamp_TileMode, SkToBool(convolveAlpha)));
+        SkBitmap result;
+        filter_once(filter, &device, src, SkMatrix::I(), &result);
+
+        SkBitmap expected;
+        expected.allocN32Pixels(src.width(), src.height());
+        for (int y = 0; y < src.height(); ++y) {
+            for (int x = 0; x < src.width(); ++x) {
+                *expected.getAddr32(x, y) = convolution_reference(
+                    src, x, y, kernelSize, kernel, gain, bias, kernelOffset,
+                    SkToBool(convolveAlpha));
+            }
+        }
+        REPORTER_ASSERT(reporter, bitmaps_equal(expected, result));
+    }
+}
+
+// The pixel of color that displ's pixel at (x, y) picks, per the SkDisplacementMapEffect docs.
+static SkPMColor displacement_reference(const SkBitmap& displ, const SkBitmap& color, int x, int y,
+                                        SkDisplacementMapEffect::ChannelSelectorType xSelector,
+                                        SkDisplacementMapEffect::ChannelSelectorType ySelector,
+                                        SkScalar scale) {
+    const SkPMColor d = *displ.getAddr32(x, y);
+    const SkColor unpremul = SkUnPreMultiply::PMColorToColor(d);
+    SkScalar channel[2];
+    const SkDisplacementMapEffect::ChannelSelectorType selectors[2] = { xSelector, ySelector };
+    for (int i = 0; i < 2; ++i) {
+        switch (selectors[i]) {
+            case SkDisplacementMapEffect::kR_ChannelSelectorType:
+                channel[i] = SkIntToScalar(SkColorGetR(unpremul));
+                break;
+            case SkDisplacementMapEffect::kG_ChannelSelectorType:
+                channel[i] = SkIntToScalar(SkColorGetG(unpremul));
+                break;
+            case SkDisplacementMapEffect::kB_ChannelSelectorType:
+                channel[i] = SkIntToScalar(SkColorGetB(unpremul));
+                break;
+            default:
+                channel[i] = SkIntToScalar(SkGetPackedA32(d));
+                break;
+        }
+    }
+    const SkScalar scaleForColor = SkScalarMul(scale, SkScalarDiv(SK_Scalar1, 255.0f));
+    const SkScalar scaleAdj = SK_ScalarHalf - SkScalarMul(scale, SK_ScalarHalf);
+    const int srcX = x + SkScalarTruncToInt(SkScalarMul(scaleForColor, channel[0]) + scaleAdj);
+    const int srcY = y + SkScalarTruncToInt(SkScalarMul(scaleForColor, channel[1]) + scaleAdj);
+    if (srcX < 0 || srcX >= color.width() || srcY < 0 || srcY >= color.height()) {
+        return 0;
+    }
+    return *color.getAddr32(srcX, srcY);
+}
+
+DEF_TEST(ImageFilterDisplacementMap, reporter) {
+    SkBitmap temp;
+    temp.allocN32Pixels(100, 100);
+    SkBitmapDevice device(temp);
+    SkDeviceImageFilterProxy proxy(&device);
+
+    SkBitmap displ, color;
+    make_noise(37, 29, &displ);
+    make_noise(37, 29, &color);
+    // make_noise() always starts from the same seed, so scramble color.
+    for (int y = 0; y < color.height(); ++y) {
+        for (int x = 0; x < color.width(); ++x) {
+            *color.getAddr32(x, y) = *displ.getAddr32(color.width() - 1 - x,
+                                                      color.height() - 1 - y);
+        }
+    }
+    SkAutoTUnref<SkImageFilter> displSource(SkBitmapSource::Create(displ));
+
+    // Small scales leave an interior whose pixels can't be displaced out of color; large ones
+    // leave none.  The crop rects cut into that interior from each side, or miss it.
+    const SkScalar scales[] = { 6, -6, 17.5f, 40, -300 };
+    const SkRect crops[] = {
+        SkRect::MakeWH(37, 29),
+        SkRect::MakeLTRB(5, 4, 30, 20),
+        SkRect::MakeLTRB(-10, 2, 8, 40),
+        SkRect::MakeLTRB(33, 0, 37, 29),
+    };
+    const SkDisplacementMapEffect::ChannelSelectorType selectors[] = {
+        SkDisplacementMapEffect::kR_ChannelSelectorType,
+        SkDisplacementMapEffect::kG_ChannelSelectorType,
+        SkDisplacementMapEffect::kB_ChannelSelectorType,
+        SkDisplacementMapEffect::kA_ChannelSelectorType,
+    };
+    for (size_t s = 0; s < SK_ARRAY_COUNT(scales); ++s) {
+        for (size_t c = 0; c < SK_ARRAY_COUNT(crops); ++c) {
+            for (size_t i = 0; i < SK_ARRAY_COUNT(selectors); ++i) {
+                for (size_t j = 0; j < SK_ARRAY_COUNT(selectors); ++j) {
+                    SkImageFilter::CropRect cropRect(crops[c]);
+                    SkAutoTUnref<SkImageFilter> filter(SkDisplacementMapEffect::Create(
+                        selectors[i], selectors[j], scales[s], displSource, NULL, &cropRect));
+                    SkAutoTUnref<SkImageFilter::Cache> cache(SkImageFilter::Cache::Create());
+                    SkImageFilter::Context ctx(SkMatrix::I(),
+                                               SkIRect::MakeWH(color.width(), color.height()),
+                                               cache.get());
+                    SkBitmap result;
+                    SkIPoint offset;
+                    REPORTER_ASSERT(reporter,
+                                    filter->filterImage(&proxy, color, ctx, &result, &offset));
+
+                    SkIRect bounds;
+                    crops[c].roundOut(&bounds);
+                    REPORTER_ASSERT(reporter, bounds.intersect(0, 0, color.width(),
+                                                               color.height()));
+                    REPORTER_ASSERT(reporter, offset.fX == bounds.left() &&
+                                              offset.fY == bounds.top());
+                    SkBitmap expected;
+                    expected.allocN32Pixels(bounds.width(), bounds.height());
+                    for (int y = bounds.top(); y < bounds.bottom(); ++y) {
+                        for (int x = bounds.left(); x < bounds.right(); ++x) {
+                            *expected.getAddr32(x - bounds.left(), y - bounds.top()) =
+                                displacement_reference(displ, color, x, y, selectors[i],
+                                                       selectors[j], scales[s]);
+                        }
+                    }
+                    REPORTER_ASSERT(reporter, bitmaps_equal(expected, result));
+                }
+            }
+        }
+    }
+}
+
+// A point-lit diffuse pixel away from the edges, from the definitions in the SVG spec.  Like
+// the filter, this takes surfaceScale per unit of alpha, not per 255.
+static SkPMColor point_lit_diffuse_reference(const SkBitmap& src, int x, int y,
+                                             const SkPoint3& location, SkScalar surfaceScale,
+                                             SkScalar kd) {
+    int a[3][3];
+    for (int j = 0; j < 3; ++j) {
+        for (int i = 0; i < 3; ++i) {
+            a[j][i] = SkGetPackedA32(*src.getAddr32(x + i - 1, y + j - 1));
+        }
+    }
+    const int sobelX = -a[0][0] + a[0][2] - 2 * a[1][0] + 2 * a[1][2] - a[2][0] + a[2][2];
+    const int sobelY = -a[0][0] + a[2][0] - 2 * a[0][1] + 2 * a[2][1] - a[0][2] + a[2][2];
+    SkPoint3 normal(-(sobelX * 0.25f) * surfaceScale, -(sobelY * 0.25f) * surfaceScale, 1);
+    normal.normalize();
+    SkPoint3 surfaceToLight = location - SkPoint3(SkIntToScalar(x), SkIntToScalar(y),
+                                                  SkIntToScalar(a[1][1]) * surfaceScale);
+    surfaceToLight.normalize();
+    const SkScalar scale = SkScalarClampMax(kd * normal.dot(surfaceToLight), SK_Scalar1);
+    const int c = SkClampMax(SkScalarRoundToInt(255 * scale), 255);
+    return SkPackARGB32(255, c, c, c);
+}
+
+DEF_TEST(ImageFilterLightingInterior, reporter) {
+    SkBitmap temp;
+    temp.allocN32Pixels(100, 100);
+    SkBitmapDevice device(temp);
+
+    SkBitmap src;
+    make_noise(43, 17, &src);
+    const SkPoint3 location(SkIntToScalar(20), SkIntToScalar(-5), SkIntToScalar(30));
+    const SkScalar surfaceScale = 12.5f, kd = 1.5f;
+    SkAutoTUnref<SkImageFilter> filter(SkLightingImageFilter::CreatePointLitDiffuse(
+        location, SK_ColorWHITE, surfaceScale, kd));
+    SkBitmap result;
+    filter_once(filter, &device, src, SkMatrix::I(), &result);
+
+    SkAutoLockPixels alp(result);
+    REPORTER_ASSERT(reporter, result.width() == src.width() && result.height() == src.height());
+    for (int y = 1; y < src.height() - 1; ++y) {
+        for (int x = 1; x < src.width() - 1; ++x) {
+            const SkPMColor expected =
+                point_lit_diffuse_reference(src, x, y, location, surfaceScale / 255, kd);
+            if (expected != *result.getAddr32(x, y)) {
+                ERRORF(reporter, "lighting mismatch at (%d, %d)", x, y);
+                return;
+            }
+        }
+    }
+}
+
+DEF_TEST(ImageFilterThreadCount, reporter) {
+    // Banding the work across threads must not change the results.
+    SkBitmap temp;
+    temp.allocN32Pixels(100, 100);
+    SkBitmapDevice device(temp);
+
+    SkBitmap src;
+    make_noise(600, 500, &src);
+    const SkScalar kernel[9] = { 1, 2, 1, 2, 4, 2, 1, 2, 1 };
+    SkImageFilter* filters[] = {
+        SkDilateImageFilter::Create(3, 11),
+        SkErodeImageFilter::Create(17, 2),
+        SkMatrixConvolutionImageFilter::Create(
+            SkISize::Make(3, 3), kernel, 1.0f / 16, 0, SkIPoint::Make(1, 1),
+            SkMatrixConvolutionImageFilter::kRepeat_TileMode, true),
+    };
+
+    const int oldThreadCount = SkImageFilter::GetThreadCount();
+    for (size_t i = 0; i < SK_ARRAY_COUNT(filters); ++i) {
+        SkBitmap single, threaded;
+        SkImageFilter::SetThreadCount(1);
+        filter_once(filters[i], &device, src, SkMatrix::I(), &single);
+        SkImageFilter::SetThreadCount(4);
+        filter_once(filters[i], &device, src, SkMatrix::I(), &threaded);
+        REPORTER_ASSERT(reporter, bitmaps_equal(single, threaded));
+        filters[i]->unref();
+    }
+    SkImageFilter::SetThreadCount(oldThreadCount);
+}
+
 #if SK_SUPPORT_GPU
 DEF_GPUTEST(ImageFilterCropRectGPU, reporter, factory) {
     GrContext* context = factory->get(static_cast<GrContextFactory::GLContextType>(0));
@@ -702,6 +702,47 @@ static void test_matrix_homogeneous(skiatest::Reporter* reporter) {
 
 }
 
+// Mapping many points (or rects) at once may take a faster path than mapping them one at a time,
+// but must give exactly the same results.
+static void test_matrix_map_batch(skiatest::Reporter* reporter) {
+    SkMatrix mats[6];
+    mats[0].setTranslate(10.5f, -3.25f);
+    mats[1].setScale(1.5f, -2.5f);
+    mats[2].setScale(1.5f, -2.5f, 7, 9);
+    mats[3].setRotate(30);
+    mats[4].setRotate(-75, 12, 34);
+    mats[5].setRotate(20);
+    mats[5].setPerspX(0.002f);
+    mats[5].setPerspY(-0.001f);
+
+    const int kCount = 19;
+    SkRandom rand;
+    SkRect rects[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        rects[i].setXYWH(rand.nextRangeScalar(-100, 100), rand.nextRangeScalar(-100, 100),
+                         rand.nextRangeScalar(0, 50), rand.nextRangeScalar(0, 50));
+    }
+    const SkPoint* src = (const SkPoint*)rects;
+    for (size_t i = 0; i < SK_ARRAY_COUNT(mats); ++i) {
+        const SkMatrix& mat = mats[i];
+        SkPoint dst[kCount * 2];
+        mat.mapPoints(dst, src, kCount * 2);
+        for (int j = 0; j < kCount * 2; ++j) {
+            SkPoint one;
+            mat.mapPoints(&one, &src[j], 1);
+            REPORTER_ASSERT(reporter, one == dst[j]);
+        }
+
+        SkRect dstRects[kCount];
+        REPORTER_ASSERT(reporter, mat.mapRects(dstRects, rects, kCount) == mat.rectStaysRect());
+        for (int j = 0; j < kCount; ++j) {
+            SkRect one;
+            mat.mapRect(&one, rects[j]);
+            REPORTER_ASSERT(reporter, one == dstRects[j]);
+        }
+    }
+}
+
 DEF_TEST(Matrix, reporter) {
     SkMatrix    mat, inverse, iden1, iden2;
 
@@ -819,6 +860,7 @@ DEF_TEST(Matrix, reporter) {
     test_matrix_recttorect(reporter);
     test_matrix_decomposition(reporter);
     test_matrix_homogeneous(reporter);
+    test_matrix_map_batch(reporter);
 }
 
 DEF_TEST(Matrix_Concat, r) {
@@ -73,6 +73,86 @@ static void test_small_segment() {
     meas.getLength();
 }
 
+// getPosTanBatch(), and getPosTan() through the index, must give exactly what getPosTan() does.
+static void test_batch_and_index(skiatest::Reporter* reporter) {
+    SkPath path;
+    path.moveTo(0, 0);
+    path.lineTo(10, 0);
+    path.quadTo(20, 0, 20, 10);
+    path.cubicTo(20, 30, -10, 30, 0, 10);
+    path.moveTo(50, 50);
+    path.cubicTo(60, 40, 70, 60, 80, 50);
+    path.lineTo(80, 80);
+
+    SkPathMeasure meas(path, false);
+    SkPathMeasure indexed(path, false);
+    indexed.setUseIndex(true);
+    do {
+        REPORTER_ASSERT(reporter, indexed.getLength() == meas.getLength());
+        const SkScalar length = meas.getLength();
+
+        // sorted, with a few out of range, then some out of order
+        SkScalar distances[40];
+        const int count = SK_ARRAY_COUNT(distances);
+        for (int i = 0; i < 30; i++) {
+            distances[i] = (i - 2) * length / 25;
+        }
+        for (int i = 30; i < count; i++) {
+            distances[i] = (count - i) * length / 11;
+        }
+
+        SkPoint pos[count];
+        SkVector tan[count];
+        REPORTER_ASSERT(reporter, meas.getPosTanBatch(distances, count, pos, tan));
+        for (int i = 0; i < count; i++) {
+            SkPoint p, q;
+            SkVector v, w;
+            REPORTER_ASSERT(reporter, meas.getPosTan(distances[i], &p, &v));
+            REPORTER_ASSERT(reporter, indexed.getPosTan(distances[i], &q, &w));
+            REPORTER_ASSERT(reporter, p == pos[i] && v == tan[i]);
+            REPORTER_ASSERT(reporter, q == pos[i] && w == tan[i]);
+        }
+        // a batch may start partway along the contour
+        REPORTER_ASSERT(reporter, meas.getPosTanBatch(distances + 12, 15, pos, tan));
+        for (int i = 0; i < 15; i++) {
+            SkPoint p;
+            SkVector v;
+            REPORTER_ASSERT(reporter, meas.getPosTan(distances[12 + i], &p, &v));
+            REPORTER_ASSERT(reporter, p == pos[i] && v == tan[i]);
+        }
+        // either output may be skipped
+        REPORTER_ASSERT(reporter, meas.getPosTanBatch(distances, count, NULL, tan));
+        REPORTER_ASSERT(reporter, indexed.getPosTanBatch(distances, count, pos, NULL));
+    } while (meas.nextContour() && indexed.nextContour());
+
+    SkPathMeasure empty;
+    SkScalar d = 0;
+    REPORTER_ASSERT(reporter, !empty.getPosTanBatch(&d, 1, NULL, NULL));
+}
+
+// Resetting with the same, unchanged path keeps the first contour; an edit is noticed.
+static void test_set_same_path(skiatest::Reporter* reporter) {
+    SkPath path;
+    path.moveTo(0, 0);
+    path.lineTo(3, 4);
+
+    SkPathMeasure meas(path, false);
+    REPORTER_ASSERT(reporter, meas.getLength() == 5);
+    meas.setPath(&path, false);
+    REPORTER_ASSERT(reporter, meas.getLength() == 5);
+    REPORTER_ASSERT(reporter, !meas.nextContour());
+
+    // past the first contour, the same path has to start over
+    meas.setPath(&path, false);
+    REPORTER_ASSERT(reporter, meas.getLength() == 5);
+
+    path.lineTo(3, 0);
+    meas.setPath(&path, false);
+    REPORTER_ASSERT(reporter, meas.getLength() == 9);
+    meas.setPath(&path, true);
+    REPORTER_ASSERT(reporter, meas.getLength() == 12);
+}
+
 DEF_TEST(PathMeasure, reporter) {
     SkPath  path;
 
@@ -198,6 +278,8 @@ DEF_TEST(PathMeasure, reporter) {
     REPORTER_ASSERT(reporter, tangent.fY == 0);
 
     test_small_segment();
+    test_batch_and_index(reporter);
+    test_set_same_path(reporter);
     test_small_segment2();
     test_small_segment3();
 }
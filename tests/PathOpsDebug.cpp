@@ -308,7 +308,7 @@ void SkIntersectionHelper::dump() const {
     }
 }
 
-const SkTDArray<SkOpSpan>& SkOpSegment::debugSpans() const {
+const SkOpTArray<SkOpSpan>& SkOpSegment::debugSpans() const {
     return fTs;
 }
 
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#include "PathOpsExtendedTest.h"
+#include "SkCanvas.h"
+#include "SkRandom.h"
+
+static const int kSize = 128;
+
+// Returns the number of 2x2 blocks that are drawn differently by the two paths, ignoring the
+// single pixel differences that come from intersections being computed in another order.
+static int count_block_errors(const SkPath& one, const SkPath& two) {
+    SkBitmap bits[2];
+    const SkPath* paths[2] = { &one, &two };
+    for (int i = 0; i < 2; ++i) {
+        bits[i].allocN32Pixels(kSize, kSize);
+        bits[i].eraseColor(SK_ColorWHITE);
+        SkCanvas canvas(bits[i]);
+        canvas.drawPath(*paths[i], SkPaint());
+    }
+    SkAutoLockPixels lockOne(bits[0]), lockTwo(bits[1]);
+    int errors = 0;
+    for (int y = 0; y < kSize - 1; ++y) {
+        for (int x = 0; x < kSize - 1; ++x) {
+            errors += *bits[0].getAddr32(x, y) != *bits[1].getAddr32(x, y)
+                    && *bits[0].getAddr32(x + 1, y) != *bits[1].getAddr32(x + 1, y)
+                    && *bits[0].getAddr32(x, y + 1) != *bits[1].getAddr32(x, y + 1)
+                    && *bits[0].getAddr32(x + 1, y + 1) != *bits[1].getAddr32(x + 1, y + 1);
+        }
+    }
+    return errors;
+}
+
+static void make_shapes(SkRandom* rand, SkPath paths[], int count) {
+    for (int i = 0; i < count; ++i) {
+        const SkScalar x = rand->nextRangeScalar(0, 100);
+        const SkScalar y = rand->nextRangeScalar(0, 100);
+        const SkScalar size = rand->nextRangeScalar(4, 24);
+        paths[i].reset();
+        switch (rand->nextULessThan(3)) {
+            case 0:
+                paths[i].addRect(x, y, x + size, y + size);
+                break;
+            case 1:
+                paths[i].addCircle(x, y, size / 2, SkPath::kCCW_Direction);
+                break;
+            default:
+                paths[i].moveTo(x, y);
+                paths[i].lineTo(x + size, y + size / 3);
+                paths[i].lineTo(x + size / 4, y + size);
+                paths[i].close();
+                break;
+        }
+    }
+}
+
+DEF_TEST(PathOpsOpMany, reporter) {
+    SkRandom rand;
+    static const int kCount = 12;
+    SkPath paths[kCount];
+    for (int trial = 0; trial < 8; ++trial) {
+        make_shapes(&rand, paths, kCount);
+        for (int op = kDifference_PathOp; op <= kReverseDifference_PathOp; ++op) {
+            SkPath folded = paths[0];
+            bool foldedOk = true;
+            for (int i = 1; i < kCount && foldedOk; ++i) {
+                foldedOk = Op(folded, paths[i], (SkPathOp) op, &folded);
+            }
+            SkPath combined;
+            const bool combinedOk = OpMany(paths, kCount, (SkPathOp) op, &combined);
+            REPORTER_ASSERT(reporter, combinedOk || !foldedOk);
+            if (foldedOk && combinedOk) {
+                REPORTER_ASSERT(reporter, count_block_errors(folded, combined) <= 8);
+            }
+        }
+    }
+
+    // Separate shapes are simply gathered, and never-overlapping ones intersect to nothing.
+    SkPath apart[2];
+    apart[0].addRect(0, 0, 10, 10);
+    apart[1].addRect(20, 0, 30, 10);
+    SkPath result;
+    REPORTER_ASSERT(reporter, OpMany(apart, 2, kUnion_PathOp, &result));
+    REPORTER_ASSERT(reporter, SkRect::MakeLTRB(0, 0, 30, 10) == result.getBounds());
+    REPORTER_ASSERT(reporter, OpMany(apart, 2, kIntersect_PathOp, &result));
+    REPORTER_ASSERT(reporter, result.isEmpty());
+    REPORTER_ASSERT(reporter, OpMany(NULL, 0, kUnion_PathOp, &result));
+    REPORTER_ASSERT(reporter, result.isEmpty());
+}
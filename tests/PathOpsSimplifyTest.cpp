@@ -4669,9 +4669,31 @@ static void testQuadralateral10(skiatest::Reporter* reporter, const char* filena
     testSimplify(reporter, path, filename);
 }
 
+// The empty contours leave their SkOpContour to be reused by the next one.
+static void testEmptyContours(skiatest::Reporter* reporter, const char* filename) {
+    SkPath path;
+    path.setFillType(SkPath::kWinding_FillType);
+    path.moveTo(0, 0);
+    path.lineTo(0, 0);
+    path.moveTo(1, 1);
+    path.close();
+    path.moveTo(0, 0);
+    path.lineTo(3, 0);
+    path.lineTo(3, 3);
+    path.quadTo(0, 3, 1, 1);
+    path.close();
+    path.moveTo(2, 2);
+    path.moveTo(1, 0);
+    path.lineTo(4, 2);
+    path.lineTo(1, 4);
+    path.close();
+    testSimplify(reporter, path, filename);
+}
+
 static void (*firstTest)(skiatest::Reporter* , const char* filename) = 0;
 
 static TestDesc tests[] = {
+    TEST(testEmptyContours),
     TEST(testQuadralateral10),
     TEST(testQuads61),
     TEST(testQuads60),
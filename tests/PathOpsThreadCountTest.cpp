@@ -0,0 +1,53 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#include "PathOpsExtendedTest.h"
+#include "SkPaint.h"
+#include "SkRandom.h"
+
+// Finding the intersections on several threads must not change the result at all, so the
+// paths are compared point for point rather than by drawing them.
+static void make_shapes(SkRandom* rand, SkPath* path, int count) {
+    for (int i = 0; i < count; ++i) {
+        const SkScalar x = SkIntToScalar(rand->nextULessThan(200));
+        const SkScalar y = SkIntToScalar(rand->nextULessThan(200));
+        const SkScalar size = SkIntToScalar(10 + rand->nextULessThan(40));
+        if (rand->nextBool()) {
+            path->addCircle(x, y, size / 2);
+        } else {
+            path->addRoundRect(SkRect::MakeXYWH(x, y, size, size), size / 4, size / 4);
+        }
+    }
+}
+
+DEF_TEST(PathOpsThreadCount, reporter) {
+    SkRandom rand;
+    SkPath one, two;
+    // Enough segments that the intersections are found on more than one thread.
+    make_shapes(&rand, &one, 64);
+    make_shapes(&rand, &two, 64);
+    for (int op = kDifference_PathOp; op <= kIntersect_PathOp; ++op) {
+        SkPath single, threaded;
+        REPORTER_ASSERT(reporter, Op(one, two, (SkPathOp) op, &single));
+        REPORTER_ASSERT(reporter, Op(one, two, (SkPathOp) op, &threaded, 4));
+        REPORTER_ASSERT(reporter, single == threaded);
+    }
+    // Overlapping glyphs, as in PathOpsBench.
+    SkPaint paint;
+    paint.setTextSize(SkIntToScalar(48));
+    const char text[] = "WWMMWWMMWWMMWWMM";
+    const size_t len = strlen(text);
+    SkTDArray<SkPoint> pos;
+    for (size_t i = 0; i < len; ++i) {
+        pos.append()->set(SkIntToScalar(20 * i), SkIntToScalar(48 + (i & 1) * 5));
+    }
+    SkPath glyphs;
+    paint.getPosTextPath(text, len, pos.begin(), &glyphs);
+    SkPath single, threaded;
+    REPORTER_ASSERT(reporter, Simplify(glyphs, &single));
+    REPORTER_ASSERT(reporter, Simplify(glyphs, &threaded, 4));
+    REPORTER_ASSERT(reporter, single == threaded);
+}
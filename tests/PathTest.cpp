@@ -14,6 +14,7 @@
 #include "SkRRect.h"
 #include "SkRandom.h"
 #include "SkReader32.h"
+#include "SkRect_opts.h"
 #include "SkSize.h"
 #include "SkSurface.h"
 #include "SkTypes.h"
@@ -918,6 +919,187 @@ static void test_bounds(skiatest::Reporter* reporter) {
     REPORTER_ASSERT(reporter, path0.getBounds() == path1.getBounds());
 }
 
+// Bounds of the path's points, found the slow way, as getBounds() should report them.
+static bool slow_bounds(const SkPath& path, SkRect* bounds) {
+    const int count = path.countPoints();
+    bounds->setEmpty();
+    for (int i = 0; i < count; ++i) {
+        if (!path.getPoint(i).isFinite()) {
+            return false;
+        }
+    }
+    if (count > 1) {
+        SkScalar l, t, r, b;
+        l = r = path.getPoint(0).fX;
+        t = b = path.getPoint(0).fY;
+        for (int i = 1; i < count; ++i) {
+            const SkPoint pt = path.getPoint(i);
+            l = SkMinScalar(l, pt.fX);
+            t = SkMinScalar(t, pt.fY);
+            r = SkMaxScalar(r, pt.fX);
+            b = SkMaxScalar(b, pt.fY);
+        }
+        bounds->set(l, t, r, b);
+    }
+    return true;
+}
+
+static void check_bounds(skiatest::Reporter* reporter, const SkPath& path) {
+    SkRect expected;
+    const bool isFinite = slow_bounds(path, &expected);
+    REPORTER_ASSERT(reporter, path.isFinite() == isFinite);
+    REPORTER_ASSERT(reporter, path.getBounds() == expected);
+}
+
+// The bounds are extended as segments are appended, rather than recomputed.
+static void test_bounds_after_append(skiatest::Reporter* reporter) {
+    SkRandom rand;
+    SkPath path;
+    for (int i = 0; i < 200; ++i) {
+        const SkScalar x = rand.nextRangeScalar(-100, 100);
+        const SkScalar y = rand.nextRangeScalar(-100, 100);
+        switch (rand.nextULessThan(6)) {
+            case 0:
+                path.moveTo(x, y);
+                break;
+            case 1:
+                path.close();
+                break;
+            case 2:
+                path.quadTo(y, x, x, y);
+                break;
+            case 3:
+                path.cubicTo(x, x, y, y, x * 2, y / 2);
+                break;
+            default:
+                path.lineTo(x, y);
+                break;
+        }
+        check_bounds(reporter, path);
+
+        // A copy shares the points until one of them is changed.
+        if (i % 50 == 0) {
+            SkPath copy(path);
+            copy.lineTo(1000, -1000);
+            check_bounds(reporter, copy);
+            check_bounds(reporter, path);
+        }
+    }
+
+    // Growing a lone moveTo, and changing a point in place.
+    path.reset();
+    path.moveTo(5, 5);
+    check_bounds(reporter, path);
+    path.lineTo(10, 10);
+    check_bounds(reporter, path);
+    path.setLastPt(20, 0);
+    check_bounds(reporter, path);
+    path.lineTo(-5, 30);
+    check_bounds(reporter, path);
+
+    // Once a point isn't finite, no appended point makes the bounds finite again.
+    path.lineTo(SK_ScalarNaN, 0);
+    check_bounds(reporter, path);
+    path.lineTo(1, 1);
+    check_bounds(reporter, path);
+    path.rewind();
+    path.moveTo(1, 1);
+    path.lineTo(2, 3);
+    check_bounds(reporter, path);
+
+    // The computed bounds of a lone moveTo leave it out, so addRect() can't start from them.
+    path.reset();
+    path.moveTo(100, 100);
+    path.getBounds();
+    path.addRect(0, 0, 10, 10);
+    check_bounds(reporter, path);
+    path.lineTo(5, 5);
+    REPORTER_ASSERT(reporter, path.getBounds() == SkRect::MakeLTRB(0, 0, 100, 100));
+}
+
+// The platform bounds proc finds the same bounds as the portable one, and the same points
+// not finite.
+static void test_platform_bounds_check(skiatest::Reporter* reporter) {
+    const SkRectBoundsCheckProc platform = SkRectGetPlatformBoundsCheckProc();
+    if (NULL == platform) {
+        return;
+    }
+    const SkRectBoundsCheckProc portable = SkRectGetPortableBoundsCheckProc();
+    const SkScalar nonFinite[] = { SK_ScalarNaN, SK_ScalarInfinity, SK_ScalarNegativeInfinity };
+
+    SkRandom rand;
+    SkPoint pts[41];
+    for (int count = 1; count <= (int)SK_ARRAY_COUNT(pts); ++count) {
+        for (int trial = 0; trial < 20; ++trial) {
+            for (int i = 0; i < count; ++i) {
+                pts[i].set(rand.nextRangeScalar(-100, 100), rand.nextRangeScalar(-100, 100));
+            }
+            if (trial & 1) {
+                SkScalar* bad = &pts[rand.nextULessThan(count)].fX + rand.nextULessThan(2);
+                *bad = nonFinite[rand.nextULessThan(SK_ARRAY_COUNT(nonFinite))];
+            }
+            SkRect expected, actual;
+            const bool expectedFinite = portable(&expected, pts, count);
+            const bool actualFinite = platform(&actual, pts, count);
+            REPORTER_ASSERT(reporter, expectedFinite == actualFinite);
+            REPORTER_ASSERT(reporter, expected == actual);
+        }
+    }
+}
+
+// Appending to a path that is already known to be concave keeps it concave, without having to
+// scan it again; the answer must be the same as scanning it again.
+static void test_convexity_after_append(skiatest::Reporter* reporter) {
+    SkRandom rand;
+    for (int trial = 0; trial < 100; ++trial) {
+        SkPath path;
+        path.moveTo(rand.nextRangeScalar(-10, 10), rand.nextRangeScalar(-10, 10));
+        for (int i = 0; i < 20; ++i) {
+            const SkScalar x = rand.nextRangeScalar(-10, 10);
+            const SkScalar y = rand.nextRangeScalar(-10, 10);
+            switch (rand.nextULessThan(8)) {
+                case 0:
+                    path.close();
+                    break;
+                case 1:
+                    path.moveTo(x, y);
+                    break;
+                case 2:
+                    path.quadTo(x, y, y, x);
+                    break;
+                default:
+                    path.lineTo(x, y);
+                    break;
+            }
+            const SkPath::Convexity convexity = path.getConvexity();
+            SkPath rescanned(path);
+            rescanned.setConvexity(SkPath::kUnknown_Convexity);
+            REPORTER_ASSERT(reporter, rescanned.getConvexity() == convexity);
+        }
+    }
+
+    // The concave turn comes before the appended points.
+    SkPath path;
+    path.moveTo(0, 0);
+    path.lineTo(10, 0);
+    path.lineTo(10, 10);
+    path.lineTo(5, 2);
+    path.lineTo(0, 10);
+    REPORTER_ASSERT(reporter, SkPath::kConcave_Convexity == path.getConvexity());
+    path.lineTo(-1, 5);
+    REPORTER_ASSERT(reporter, SkPath::kConcave_Convexity == path.getConvexityOrUnknown());
+
+    // Only the closing edge is concave, and appending a point changes that edge.
+    path.reset();
+    path.moveTo(-9, 6);
+    path.lineTo(-10, 2);
+    path.lineTo(-10, 1);
+    path.lineTo(-10, 5);
+    REPORTER_ASSERT(reporter, SkPath::kConcave_Convexity == path.getConvexity());
+    path.lineTo(-3, 10);
+    REPORTER_ASSERT(reporter, SkPath::kConvex_Convexity == path.getConvexity());
+}
+
 static void stroke_cubic(const SkPoint pts[4]) {
     SkPath path;
     path.moveTo(pts[0]);
@@ -3476,6 +3658,9 @@ DEF_TEST(Paths, reporter) {
     test_flattening(reporter);
     test_transform(reporter);
     test_bounds(reporter);
+    test_bounds_after_append(reporter);
+    test_platform_bounds_check(reporter);
+    test_convexity_after_append(reporter);
     test_iter(reporter);
     test_raw_iter(reporter);
     test_circle(reporter);
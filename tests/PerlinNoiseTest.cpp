@@ -0,0 +1,123 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkPerlinNoiseShader.h"
+#include "SkPerlinNoise_opts.h"
+#include "SkRandom.h"
+#include "Test.h"
+
+// Whatever the lattice, stitching and paint alpha, the platform span proc shades exactly the
+// same colors as the portable one.
+DEF_TEST(PerlinNoise_PlatformSpanProc, reporter) {
+    const SkPerlinNoiseSpanProc platform = SkPerlinNoiseGetPlatformSpanProc();
+    if (NULL == platform) {
+        return;
+    }
+    const SkPerlinNoiseSpanProc portable = SkPerlinNoiseGetPortableSpanProc();
+
+    const int kBlockSize = SkPerlinNoiseParams::kBlockSize;
+    uint8_t latticeSelector[kBlockSize];
+    float gradients[kBlockSize][2][4];
+    SkRandom rand;
+    for (int i = 0; i < kBlockSize; ++i) {
+        latticeSelector[i] = i;
+        for (int channel = 0; channel < 4; ++channel) {
+            SkPoint g = SkPoint::Make(rand.nextSScalar1(), rand.nextSScalar1());
+            g.normalize();
+            gradients[i][0][channel] = g.fX;
+            gradients[i][1][channel] = g.fY;
+        }
+    }
+    for (int i = kBlockSize - 1; i > 0; --i) {
+        SkTSwap(latticeSelector[i], latticeSelector[rand.nextULessThan(i + 1)]);
+    }
+
+    static const int kCount = 67;
+    SkPoint points[kCount];
+    SkPMColor expected[kCount], actual[kCount];
+    for (int trial = 0; trial < 200; ++trial) {
+        SkPerlinNoiseParams params;
+        params.fLatticeSelector = latticeSelector;
+        params.fGradients = gradients;
+        params.fBaseFrequencyX = rand.nextRangeScalar(0.005f, 0.2f);
+        params.fBaseFrequencyY = rand.nextRangeScalar(0.005f, 0.2f);
+        params.fNumOctaves = rand.nextRangeU(1, 5);
+        params.fFractalNoise = rand.nextBool();
+        params.fStitchTiles = rand.nextBool();
+        params.fStitchWidth = SkScalarRoundToInt(rand.nextRangeU(16, 200) *
+                                                 params.fBaseFrequencyX);
+        params.fStitchHeight = SkScalarRoundToInt(rand.nextRangeU(16, 200) *
+                                                  params.fBaseFrequencyY);
+        params.fAlphaScale = rand.nextBool() ? SK_Scalar1 : rand.nextUScalar1();
+
+        // Mapped points are always whole numbers, sometimes negative.
+        for (int i = 0; i < kCount; ++i) {
+            points[i].set(SkIntToScalar(rand.nextRangeU(0, 600)) - 300,
+                          SkIntToScalar(rand.nextRangeU(0, 600)) - 300);
+        }
+        portable(params, points, kCount, expected);
+        platform(params, points, kCount, actual);
+        for (int i = 0; i < kCount; ++i) {
+            if (expected[i] != actual[i]) {
+                ERRORF(reporter, "trial %d point (%g, %g): expected %08x, got %08x",
+                       trial, points[i].fX, points[i].fY, expected[i], actual[i]);
+                break;
+            }
+        }
+    }
+}
+
+static void draw_noise(SkShader* shader, SkBitmap* bitmap) {
+    bitmap->allocN32Pixels(47, 47);
+    bitmap->eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(*bitmap);
+    SkPaint paint;
+    paint.setShader(shader);
+    canvas.drawPaint(paint);
+}
+
+static bool equal(const SkBitmap& a, const SkBitmap& b) {
+    SkAutoLockPixels alpa(a), alpb(b);
+    for (int y = 0; y < a.height(); ++y) {
+        if (memcmp(a.getAddr32(0, y), b.getAddr32(0, y), a.width() * sizeof(SkPMColor))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// An opaque stitched shader reads the colors inside its tile back from a cache.  Away from
+// the right and bottom edges, where stitching wraps the lattice, a tile of 64 and one of 1024
+// (too big to cache) share the same noise at a frequency of 1/16, so they must draw the same.
+DEF_TEST(PerlinNoise_StitchedTileCache, reporter) {
+    const SkScalar kFrequency = SK_Scalar1 / 16;
+    const SkISize cachedSize = SkISize::Make(64, 64);
+    const SkISize uncachedSize = SkISize::Make(1024, 1024);
+    for (int fractal = 0; fractal < 2; ++fractal) {
+        SkAutoTUnref<SkShader> cached, uncached;
+        if (fractal) {
+            cached.reset(SkPerlinNoiseShader::CreateFractalNoise(kFrequency, kFrequency, 3,
+                                                                 5, &cachedSize));
+            uncached.reset(SkPerlinNoiseShader::CreateFractalNoise(kFrequency, kFrequency, 3,
+                                                                   5, &uncachedSize));
+        } else {
+            cached.reset(SkPerlinNoiseShader::CreateTurbulence(kFrequency, kFrequency, 3,
+                                                               5, &cachedSize));
+            uncached.reset(SkPerlinNoiseShader::CreateTurbulence(kFrequency, kFrequency, 3,
+                                                                 5, &uncachedSize));
+        }
+
+        SkBitmap expected, first, second;
+        draw_noise(uncached, &expected);
+        draw_noise(cached, &first);     // builds the tile
+        draw_noise(cached, &second);    // reuses it
+        REPORTER_ASSERT(reporter, equal(expected, first));
+        REPORTER_ASSERT(reporter, equal(expected, second));
+    }
+}
@@ -5,8 +5,10 @@
  * found in the LICENSE file.
  */
 
+#include "SkCanvas.h"
 #include "SkPicture.h"
 #include "SkPictureRecorder.h"
+#include "SkPictureShader.h"
 #include "SkShader.h"
 #include "Test.h"
 
@@ -24,3 +26,48 @@ DEF_TEST(PictureShader_empty, reporter) {
             SkShader::kClamp_TileMode, SkShader::kClamp_TileMode);
     REPORTER_ASSERT(reporter, NULL == shader);
 }
+
+static void draw_with_new_shader(SkPicture* picture, SkScalar scale, SkBitmap* bitmap) {
+    SkMatrix localMatrix;
+    localMatrix.setScale(scale, scale);
+    SkPaint paint;
+    paint.setShader(SkShader::CreatePictureShader(picture, SkShader::kRepeat_TileMode,
+                                                  SkShader::kRepeat_TileMode,
+                                                  &localMatrix))->unref();
+    bitmap->allocN32Pixels(50, 50);
+    bitmap->eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(*bitmap);
+    canvas.drawPaint(paint);
+}
+
+// Test that picture shaders drawing the same picture at the same scale share its tile.
+DEF_TEST(PictureShader_sharedTile, reporter) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(20, 20, NULL, 0);
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    canvas->drawCircle(10, 10, 7, paint);
+    SkAutoTUnref<SkPicture> picture(recorder.endRecording());
+
+    int32_t hits, misses, newHits, newMisses;
+    SkPictureShader::GetTileCacheStats(&hits, &misses);
+
+    SkBitmap first, second, scaled;
+    draw_with_new_shader(picture, 2, &first);
+    SkPictureShader::GetTileCacheStats(&newHits, &newMisses);
+    REPORTER_ASSERT(reporter, newMisses == misses + 1);
+
+    draw_with_new_shader(picture, 2, &second);
+    SkPictureShader::GetTileCacheStats(&hits, &misses);
+    REPORTER_ASSERT(reporter, hits == newHits + 1);
+    REPORTER_ASSERT(reporter, misses == newMisses);
+
+    SkAutoLockPixels lockFirst(first), lockSecond(second);
+    REPORTER_ASSERT(reporter, 0 == memcmp(first.getPixels(), second.getPixels(),
+                                          first.getSize()));
+
+    // A different scale needs a tile of its own.
+    draw_with_new_shader(picture, 3, &scaled);
+    SkPictureShader::GetTileCacheStats(&newHits, &newMisses);
+    REPORTER_ASSERT(reporter, newMisses == misses + 1);
+}
@@ -1643,3 +1643,41 @@ DEF_TEST(Canvas_EmptyBitmap, r) {
 
     test_draw_bitmaps(&canvas);
 }
+
+DEF_TEST(Picture_CreateFromData, r) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(10, 10);
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeWH(5, 5), paint);
+    SkAutoTUnref<SkPicture> picture(recorder.endRecording());
+
+    SkDynamicMemoryWStream wStream;
+    picture->serialize(&wStream);
+    SkAutoDataUnref data(wStream.copyToData());
+
+    SkAutoTUnref<SkPicture> loaded(SkPicture::CreateFromData(data));
+    REPORTER_ASSERT(r, NULL != loaded.get());
+    if (NULL == loaded.get()) {
+        return;
+    }
+
+    // The loaded picture may reference the serialized bytes in place, so it must keep
+    // them alive on its own.
+    data.reset(NULL);
+
+    SkDynamicMemoryWStream wStream2;
+    loaded->serialize(&wStream2);
+    SkAutoDataUnref data2(wStream2.copyToData());
+    SkMemoryStream stream(data2);
+    SkAutoTUnref<SkPicture> fromStream(SkPicture::CreateFromStream(&stream));
+    REPORTER_ASSERT(r, NULL != fromStream.get());
+
+    SkBitmap bm;
+    bm.allocN32Pixels(10, 10);
+    bm.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas bmCanvas(bm);
+    loaded->draw(&bmCanvas);
+    REPORTER_ASSERT(r, SK_ColorRED == bm.getColor(2, 2));
+    REPORTER_ASSERT(r, SK_ColorTRANSPARENT == bm.getColor(7, 7));
+}
@@ -8,9 +8,13 @@
 #include "SamplePipeControllers.h"
 #include "SkBitmap.h"
 #include "SkCanvas.h"
+#include "SkCondVar.h"
+#include "SkDashPathEffect.h"
 #include "SkGPipe.h"
+#include "SkGradientShader.h"
 #include "SkPaint.h"
 #include "SkShader.h"
+#include "SkTypeface.h"
 #include "Test.h"
 
 // Ensures that the pipe gracefully handles drawing an invalid bitmap.
@@ -54,3 +58,397 @@ DEF_TEST(Pipe, reporter) {
 
     testDrawingAfterEndRecording(&canvas);
 }
+
+static void draw_many_rects(SkCanvas* canvas) {
+    SkPaint paint;
+    for (int i = 0; i < 2000; i++) {
+        paint.setColor(0xFF000000 | ((i & 0xFF) * 0x10101));
+        canvas->drawRect(SkRect::MakeXYWH(SkIntToScalar(i % 60), SkIntToScalar(i % 50), 4, 4),
+                         paint);
+    }
+}
+
+static void threaded_pipe(SkBitmap* bitmap, ThreadedPipeController::Backpressure backpressure,
+                          ThreadedPipeController::Stats* stats) {
+    bitmap->allocN32Pixels(64, 64);
+    bitmap->eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(*bitmap);
+
+    // Small enough that the writer runs out of ring space.
+    ThreadedPipeController controller(&canvas, 32 * 1024, backpressure);
+    SkGPipeWriter writer;
+    draw_many_rects(writer.startRecording(&controller, SkGPipeWriter::kCrossProcess_Flag));
+    writer.flushRecording(false);
+    controller.drain();
+    writer.endRecording();
+    *stats = controller.stats();
+}
+
+DEF_TEST(Pipe_Threaded, reporter) {
+    SkBitmap expected;
+    expected.allocN32Pixels(64, 64);
+    expected.eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(expected);
+    draw_many_rects(&canvas);
+    SkAutoLockPixels lockExpected(expected);
+
+    const ThreadedPipeController::Backpressure kLossless[] = {
+        ThreadedPipeController::kBlock_Backpressure,
+        ThreadedPipeController::kGrow_Backpressure,
+    };
+    for (size_t i = 0; i < SK_ARRAY_COUNT(kLossless); i++) {
+        SkBitmap bitmap;
+        ThreadedPipeController::Stats stats;
+        threaded_pipe(&bitmap, kLossless[i], &stats);
+
+        SkAutoLockPixels lock(bitmap);
+        REPORTER_ASSERT(reporter, 0 == memcmp(expected.getPixels(), bitmap.getPixels(),
+                                              expected.getSize()));
+        REPORTER_ASSERT(reporter, stats.fBlocks > 1);
+        REPORTER_ASSERT(reporter, 0 == stats.fBytesDropped);
+        REPORTER_ASSERT(reporter, stats.fBytesPlayed > 0);
+    }
+
+    // Dropping may skip some of the draws, but never spills out of the ring.
+    SkBitmap bitmap;
+    ThreadedPipeController::Stats stats;
+    threaded_pipe(&bitmap, ThreadedPipeController::kDropToFlush_Backpressure, &stats);
+    REPORTER_ASSERT(reporter, 0 == stats.fHeapBlocks);
+}
+
+namespace {
+
+// Holds the reader thread inside drawPoints() calls of kGateCount points until open() is called.
+class GateCanvas : public SkCanvas {
+public:
+    static const size_t kGateCount = 200;
+
+    explicit GateCanvas(const SkBitmap& bitmap) : INHERITED(bitmap), fOpen(false) {}
+
+    void open() {
+        fCondVar.lock();
+        fOpen = true;
+        fCondVar.broadcast();
+        fCondVar.unlock();
+    }
+
+    virtual void drawPoints(PointMode mode, size_t count, const SkPoint pts[],
+                            const SkPaint& paint) SK_OVERRIDE {
+        if (kGateCount == count) {
+            fCondVar.lock();
+            while (!fOpen) {
+                fCondVar.wait();
+            }
+            fCondVar.unlock();
+        }
+        this->INHERITED::drawPoints(mode, count, pts, paint);
+    }
+
+private:
+    SkCondVar fCondVar;
+    bool      fOpen;
+
+    typedef SkCanvas INHERITED;
+};
+
+}  // namespace
+
+static void draw_points(SkCanvas* canvas, size_t count, SkColor color) {
+    SkTDArray<SkPoint> pts;
+    for (size_t i = 0; i < count; i++) {
+        pts.append()->set(SkIntToScalar((i * 7 + color) % 64), SkIntToScalar((i * 3) % 64));
+    }
+    SkPaint paint;
+    paint.setColor(color);
+    canvas->drawPoints(SkCanvas::kPoints_PointMode, count, pts.begin(), paint);
+}
+
+namespace {
+
+// Holds the reader thread inside drawPoints() calls of GateCanvas::kGateCount points until the
+// writer has filled the ring and told the reader to drop what it has fallen behind on.
+class DropGateCanvas : public SkCanvas {
+public:
+    explicit DropGateCanvas(const SkBitmap& bitmap)
+        : INHERITED(bitmap), fController(NULL), fEntered(false) {}
+
+    void setController(ThreadedPipeController* controller) { fController = controller; }
+
+    void waitUntilEntered() {
+        fCondVar.lock();
+        while (!fEntered) {
+            fCondVar.wait();
+        }
+        fCondVar.unlock();
+    }
+
+    virtual void drawPoints(PointMode mode, size_t count, const SkPoint pts[],
+                            const SkPaint& paint) SK_OVERRIDE {
+        if (GateCanvas::kGateCount == count) {
+            fCondVar.lock();
+            fEntered = true;
+            fCondVar.broadcast();
+            fCondVar.unlock();
+            // The writer is asleep once it is dropping, so there is nobody to wake us.
+            while (!fController->isDropping()) {
+            }
+        }
+        this->INHERITED::drawPoints(mode, count, pts, paint);
+    }
+
+private:
+    ThreadedPipeController* fController;
+    SkCondVar               fCondVar;
+    bool                    fEntered;
+
+    typedef SkCanvas INHERITED;
+};
+
+}  // namespace
+
+DEF_TEST(Pipe_ThreadedDrop, reporter) {
+    SkBitmap expected;
+    expected.allocN32Pixels(64, 64);
+    SkCanvas expectedCanvas(expected);
+    expectedCanvas.clear(SK_ColorWHITE);
+    draw_points(&expectedCanvas, 100, SK_ColorBLUE);
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(64, 64);
+    bitmap.eraseColor(SK_ColorWHITE);
+    DropGateCanvas canvas(bitmap);
+    {
+        ThreadedPipeController controller(&canvas, 32 * 1024,
+                                          ThreadedPipeController::kDropToFlush_Backpressure);
+        canvas.setController(&controller);
+        SkGPipeWriter writer;
+        SkCanvas* pipeCanvas = writer.startRecording(&controller,
+                                                     SkGPipeWriter::kCrossProcess_Flag);
+        draw_points(pipeCanvas, GateCanvas::kGateCount, SK_ColorGREEN);
+        writer.flushRecording(true);
+        controller.flush();
+        canvas.waitUntilEntered();
+
+        // With the reader held at the gate, these fill the ring, and the reader drops whatever
+        // it finds after the gate until it catches up.
+        draw_many_rects(pipeCanvas);
+        writer.flushRecording(true);
+        controller.drain();
+        REPORTER_ASSERT(reporter, controller.stats().fBytesDropped > 0);
+        REPORTER_ASSERT(reporter, !controller.isDropping());
+
+        // Having caught up, the reader draws all of the next frame.
+        const size_t dropped = controller.stats().fBytesDropped;
+        pipeCanvas->clear(SK_ColorWHITE);
+        draw_points(pipeCanvas, 100, SK_ColorBLUE);
+        writer.flushRecording(true);
+        controller.drain();
+        writer.endRecording();
+        REPORTER_ASSERT(reporter, dropped == controller.stats().fBytesDropped);
+    }
+
+    SkAutoLockPixels lockExpected(expected), lock(bitmap);
+    REPORTER_ASSERT(reporter, 0 == memcmp(expected.getPixels(), bitmap.getPixels(),
+                                          expected.getSize()));
+}
+
+// The three draws, sized for a 32K ring:
+//  - 2500 points leave the reader's tail about 20K into the first lap.
+//  - The gate starts the second lap, and the reader is held inside it.
+//  - 3950 points need more than what is left of the second lap, but the ring at the start of
+//    the third still holds the unread gate.  That has to spill to the heap.
+static const size_t kLapCounts[] = { 2500, GateCanvas::kGateCount, 3950 };
+static const SkColor kLapColors[] = { SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE };
+
+DEF_TEST(Pipe_ThreadedWrapWithLaggingReader, reporter) {
+    SkBitmap expected;
+    expected.allocN32Pixels(64, 64);
+    expected.eraseColor(SK_ColorWHITE);
+    SkCanvas expectedCanvas(expected);
+    for (size_t i = 0; i < SK_ARRAY_COUNT(kLapCounts); i++) {
+        draw_points(&expectedCanvas, kLapCounts[i], kLapColors[i]);
+    }
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(64, 64);
+    bitmap.eraseColor(SK_ColorWHITE);
+    GateCanvas canvas(bitmap);
+    {
+        ThreadedPipeController controller(&canvas, 32 * 1024,
+                                          ThreadedPipeController::kGrow_Backpressure);
+        SkGPipeWriter writer;
+        SkCanvas* pipeCanvas = writer.startRecording(&controller,
+                                                     SkGPipeWriter::kCrossProcess_Flag);
+        draw_points(pipeCanvas, kLapCounts[0], kLapColors[0]);
+        writer.flushRecording(true);
+        controller.drain();
+
+        draw_points(pipeCanvas, kLapCounts[1], kLapColors[1]);
+        writer.flushRecording(true);
+        draw_points(pipeCanvas, kLapCounts[2], kLapColors[2]);
+        writer.flushRecording(true);
+
+        canvas.open();
+        controller.drain();
+        writer.endRecording();
+        REPORTER_ASSERT(reporter, controller.stats().fHeapBlocks > 0);
+    }
+
+    SkAutoLockPixels lockExpected(expected), lock(bitmap);
+    REPORTER_ASSERT(reporter, 0 == memcmp(expected.getPixels(), bitmap.getPixels(),
+                                          expected.getSize()));
+}
+
+namespace {
+
+class CountingPipeController : public PipeController {
+public:
+    CountingPipeController(SkCanvas* target) : INHERITED(target), fBytes(0) {}
+
+    virtual void notifyWritten(size_t bytes) SK_OVERRIDE {
+        fBytes += bytes;
+        this->INHERITED::notifyWritten(bytes);
+    }
+
+    size_t fBytes;
+
+private:
+    typedef PipeController INHERITED;
+};
+
+}  // namespace
+
+// Each frame uses the same flattenables, bitmap and typeface.
+static void draw_frame(SkCanvas* canvas, const SkBitmap& sprite, int frame) {
+    const SkPoint pts[] = { { 0, 0 }, { 64, 64 } };
+    const SkColor colors[] = { SK_ColorRED, SK_ColorBLUE };
+    SkPaint paint;
+    paint.setShader(SkGradientShader::CreateLinear(pts, colors, NULL, 2,
+                                                   SkShader::kClamp_TileMode))->unref();
+    canvas->translate(SkIntToScalar(frame), 0);
+    canvas->clipRect(SkRect::MakeWH(48, 48));
+    canvas->drawRect(SkRect::MakeWH(32, 32), paint);
+
+    const SkScalar intervals[] = { 4, 2 };
+    SkPaint dashed;
+    dashed.setStyle(SkPaint::kStroke_Style);
+    dashed.setPathEffect(SkDashPathEffect::Create(intervals, 2, 0))->unref();
+    canvas->drawCircle(32, 32, 20, dashed);
+
+    canvas->drawBitmap(sprite, 40, 40);
+
+    SkPaint text;
+    text.setTypeface(SkTypeface::RefDefault(SkTypeface::kBold))->unref();
+    canvas->drawText("frame", 5, 0, 60, text);
+}
+
+DEF_TEST(Pipe_PersistentResources, reporter) {
+    SkBitmap sprite;
+    sprite.allocN32Pixels(8, 8);
+    sprite.eraseColor(SK_ColorGREEN);
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(64, 64);
+    SkCanvas canvas(bitmap);
+    CountingPipeController controller(&canvas);
+
+    static const uint32_t kFlags =
+        SkGPipeWriter::kCrossProcess_Flag | SkGPipeWriter::kPersistentResources_Flag;
+    SkGPipeWriter writer;
+    size_t frameBytes[3];
+    for (int frame = 0; frame < 3; frame++) {
+        bitmap.eraseColor(SK_ColorWHITE);
+        controller.fBytes = 0;
+        draw_frame(writer.startRecording(&controller, kFlags, 64, 64), sprite, frame);
+        writer.endRecording();
+        frameBytes[frame] = controller.fBytes;
+
+        // The reader still has everything sent in earlier frames, so it draws the same thing.
+        SkBitmap expected;
+        expected.allocN32Pixels(64, 64);
+        expected.eraseColor(SK_ColorWHITE);
+        SkCanvas expectedCanvas(expected);
+        draw_frame(&expectedCanvas, sprite, frame);
+
+        SkAutoLockPixels lock(bitmap), lockExpected(expected);
+        REPORTER_ASSERT(reporter, 0 == memcmp(expected.getPixels(), bitmap.getPixels(),
+                                              expected.getSize()));
+    }
+    // Only the first frame defines the shader, path effect, bitmap and typeface.
+    REPORTER_ASSERT(reporter, frameBytes[1] < frameBytes[0] / 2);
+    REPORTER_ASSERT(reporter, frameBytes[2] == frameBytes[1]);
+
+    // A writer without the flag resends everything, and the reader starts over for it.
+    SkGPipeWriter oneShot;
+    controller.fBytes = 0;
+    draw_frame(oneShot.startRecording(&controller, SkGPipeWriter::kCrossProcess_Flag, 64, 64),
+               sprite, 0);
+    oneShot.endRecording();
+    REPORTER_ASSERT(reporter, controller.fBytes > frameBytes[1]);
+}
+
+namespace {
+
+class FailingPipeController : public PipeController {
+public:
+    FailingPipeController(SkCanvas* target) : INHERITED(target), fFail(false) {}
+
+    virtual void* requestBlock(size_t minRequest, size_t* actual) SK_OVERRIDE {
+        return fFail ? NULL : this->INHERITED::requestBlock(minRequest, actual);
+    }
+
+    bool fFail;
+
+private:
+    typedef PipeController INHERITED;
+};
+
+}  // namespace
+
+static void draw_gradient(SkCanvas* canvas, SkColor color) {
+    const SkPoint pts[] = { { 0, 0 }, { 64, 64 } };
+    const SkColor colors[] = { color, SK_ColorWHITE };
+    SkPaint paint;
+    paint.setShader(SkGradientShader::CreateLinear(pts, colors, NULL, 2,
+                                                   SkShader::kClamp_TileMode))->unref();
+    canvas->drawRect(SkRect::MakeWH(64, 64), paint);
+}
+
+// A frame that runs out of space never reaches the reader, so the next frame can't rely on
+// anything it defined, or on the saves it left behind.
+DEF_TEST(Pipe_PersistentResourcesAfterError, reporter) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(64, 64);
+    bitmap.eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(bitmap);
+    FailingPipeController controller(&canvas);
+
+    static const uint32_t kFlags =
+        SkGPipeWriter::kCrossProcess_Flag | SkGPipeWriter::kPersistentResources_Flag;
+    SkGPipeWriter writer;
+    draw_gradient(writer.startRecording(&controller, kFlags, 64, 64), SK_ColorRED);
+    writer.endRecording();
+
+    controller.fFail = true;
+    SkCanvas* pipeCanvas = writer.startRecording(&controller, kFlags, 64, 64);
+    pipeCanvas->save();
+    pipeCanvas->translate(SkIntToScalar(16), 0);
+    draw_gradient(pipeCanvas, SK_ColorBLUE);
+    writer.endRecording();
+    REPORTER_ASSERT(reporter, 1 == pipeCanvas->getSaveCount());
+
+    controller.fFail = false;
+    bitmap.eraseColor(SK_ColorWHITE);
+    draw_gradient(writer.startRecording(&controller, kFlags, 64, 64), SK_ColorBLUE);
+    writer.endRecording();
+
+    SkBitmap expected;
+    expected.allocN32Pixels(64, 64);
+    expected.eraseColor(SK_ColorWHITE);
+    SkCanvas expectedCanvas(expected);
+    draw_gradient(&expectedCanvas, SK_ColorBLUE);
+
+    SkAutoLockPixels lock(bitmap), lockExpected(expected);
+    REPORTER_ASSERT(reporter, 0 == memcmp(expected.getPixels(), bitmap.getPixels(),
+                                          expected.getSize()));
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Test.h"
+#include "RecordTestUtils.h"
+
+#include "SkRecord.h"
+#include "SkRecordCompact.h"
+#include "SkRecordDraw.h"
+#include "SkRecordOpts.h"
+#include "SkRecorder.h"
+#include "SkRecords.h"
+
+static const int W = 64, H = 64;
+
+static void draw_both(skiatest::Reporter* r, const SkRecord& a, const SkRecord& b) {
+    SkBitmap bmA, bmB;
+    bmA.allocN32Pixels(W, H);
+    bmB.allocN32Pixels(W, H);
+    bmA.eraseColor(SK_ColorWHITE);
+    bmB.eraseColor(SK_ColorWHITE);
+
+    SkCanvas canvasA(bmA), canvasB(bmB);
+    SkRecordDraw(a, &canvasA);
+    SkRecordDraw(b, &canvasB);
+
+    SkAutoLockPixels lockA(bmA), lockB(bmB);
+    REPORTER_ASSERT(r, 0 == memcmp(bmA.getPixels(), bmB.getPixels(), bmA.getSize()));
+}
+
+DEF_TEST(RecordCompact_SharesPaints, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    SkPaint red, blue;
+    red.setColor(SK_ColorRED);
+    blue.setColor(SK_ColorBLUE);
+    for (int i = 0; i < 20; i++) {
+        const SkRect rect = SkRect::MakeXYWH(SkIntToScalar(i), SkIntToScalar(i), 10, 10);
+        recorder.drawRect(rect, red);
+        recorder.drawOval(rect, blue);
+    }
+
+    SkRecord compacted;
+    const size_t saved = SkRecordCompact(record, &compacted);
+    REPORTER_ASSERT(r, saved > 0);
+    REPORTER_ASSERT(r, saved == record.bytesUsed() - compacted.bytesUsed());
+
+    REPORTER_ASSERT(r, record.count() + 1 == compacted.count());
+    const SkRecords::PaintTable* table =
+        assert_type<SkRecords::PaintTable>(r, compacted, 0);
+    REPORTER_ASSERT(r, 2 == table->count);
+
+    const SkRecords::CompactDrawRect* rect =
+        assert_type<SkRecords::CompactDrawRect>(r, compacted, 1);
+    const SkRecords::CompactDrawOval* oval =
+        assert_type<SkRecords::CompactDrawOval>(r, compacted, 2);
+    REPORTER_ASSERT(r, red == rect->paint);
+    REPORTER_ASSERT(r, blue == oval->paint);
+    REPORTER_ASSERT(r, rect->paint.get() ==
+                       assert_type<SkRecords::CompactDrawRect>(r, compacted, 3)->paint.get());
+
+    draw_both(r, record, compacted);
+}
+
+DEF_TEST(RecordCompact_PackedPoints, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    // These sit exactly on a 1/64 pixel grid, so they should be delta-coded.
+    const SkPoint exact[] = { {1, 2}, {3.5f, 4.25f}, {60, 0.015625f} };
+    // These don't, so they should be stored as-is.
+    const SkPoint inexact[] = { {1, 2}, {3.1f, 4.2f} };
+    // And this step doesn't fit in 16 bits of 1/64 pixels.
+    const SkPoint far[] = { {0, 0}, {1000, 0} };
+    // -0 is on the grid, but must come back with its sign.
+    const SkPoint negZero[] = { {1, 2}, {-0.0f, 4} };
+
+    SkPaint paint;
+    paint.setStrokeWidth(2);
+    recorder.drawPoints(SkCanvas::kPolygon_PointMode, SK_ARRAY_COUNT(exact), exact, paint);
+    recorder.drawPoints(SkCanvas::kLines_PointMode, SK_ARRAY_COUNT(inexact), inexact, paint);
+    recorder.drawPoints(SkCanvas::kLines_PointMode, SK_ARRAY_COUNT(far), far, paint);
+    recorder.drawPoints(SkCanvas::kLines_PointMode, SK_ARRAY_COUNT(negZero), negZero, paint);
+
+    SkRecord compacted;
+    SkRecordCompact(record, &compacted);
+
+    const SkRecords::PackedPoints& packed =
+        assert_type<SkRecords::CompactDrawPoints>(r, compacted, 1)->pts;
+    REPORTER_ASSERT(r, packed.isPacked());
+    SkPoint unpacked[SK_ARRAY_COUNT(exact)];
+    packed.unpack(SK_ARRAY_COUNT(exact), unpacked);
+    REPORTER_ASSERT(r, 0 == memcmp(exact, unpacked, sizeof(exact)));
+
+    REPORTER_ASSERT(r, !assert_type<SkRecords::CompactDrawPoints>(r, compacted, 2)->pts.isPacked());
+    REPORTER_ASSERT(r, !assert_type<SkRecords::CompactDrawPoints>(r, compacted, 3)->pts.isPacked());
+    const SkRecords::PackedPoints& signedZero =
+        assert_type<SkRecords::CompactDrawPoints>(r, compacted, 4)->pts;
+    REPORTER_ASSERT(r, !signedZero.isPacked());
+    REPORTER_ASSERT(r, 0 == memcmp(negZero, signedZero.raw(), sizeof(negZero)));
+
+    draw_both(r, record, compacted);
+}
+
+DEF_TEST(RecordCompact_KeepsAnnotations, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    recorder.pushCull(SkRect::MakeWH(10, 10));
+        recorder.save();
+            recorder.clipRect(SkRect::MakeWH(5, 5));
+            recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+        recorder.restore();
+    recorder.popCull();
+    SkRecordAnnotateCullingPairs(&record);
+
+    SkRecord compacted;
+    SkRecordCompact(record, &compacted);
+
+    REPORTER_ASSERT(r, 7 == compacted.count());
+    REPORTER_ASSERT(r, 5 == assert_type<SkRecords::PairedPushCull>(r, compacted, 1)->skip);
+    assert_type<SkRecords::Save>(r, compacted, 2);
+    assert_type<SkRecords::ClipRect>(r, compacted, 3);
+    assert_type<SkRecords::CompactDrawRect>(r, compacted, 4);
+    assert_type<SkRecords::Restore>(r, compacted, 5);
+    assert_type<SkRecords::PopCull>(r, compacted, 6);
+
+    draw_both(r, record, compacted);
+}
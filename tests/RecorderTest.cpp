@@ -49,6 +49,33 @@ DEF_TEST(Recorder, r) {
     REPORTER_ASSERT(r, 1 == tally.count<SkRecords::DrawRect>());
 }
 
+// Each batch is recorded as one command, not one per shape.
+DEF_TEST(Recorder_Batches, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, 1920, 1080);
+
+    const SkRect rects[] = {
+        SkRect::MakeWH(10, 10), SkRect::MakeXYWH(20, 20, 5, 5), SkRect::MakeXYWH(40, 0, 8, 30),
+    };
+    const SkColor colors[] = { SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE };
+    SkRRect rrects[3];
+    for (int i = 0; i < 3; i++) {
+        rrects[i].setRectXY(rects[i], 2, 2);
+    }
+
+    recorder.drawRects(rects, colors, 3, SkPaint());
+    recorder.drawOvals(rects, NULL, 3, SkPaint());
+    recorder.drawRRects(rrects, colors, 3, SkPaint());
+
+    Tally tally;
+    tally.apply(record);
+    REPORTER_ASSERT(r, 3 == record.count());
+    REPORTER_ASSERT(r, 1 == tally.count<SkRecords::DrawRects>());
+    REPORTER_ASSERT(r, 1 == tally.count<SkRecords::DrawOvals>());
+    REPORTER_ASSERT(r, 1 == tally.count<SkRecords::DrawRRects>());
+    REPORTER_ASSERT(r, 0 == tally.count<SkRecords::DrawRect>());
+}
+
 // Regression test for leaking refs held by optional arguments.
 DEF_TEST(Recorder_RefLeaking, r) {
     // We use SaveLayer to test:
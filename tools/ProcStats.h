@@ -0,0 +1,21 @@
+/*
+ * Copyright 2014 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef ProcStats_DEFINED
+#define ProcStats_DEFINED
+
+namespace sk_tools {
+
+/**
+ *  If not implemented for this platform, returns -1.  Otherwise, returns the peak
+ *  resident set size of this process so far, in megabytes.
+ */
+int getMaxResidentSetSizeMB();
+
+}  // namespace sk_tools
+
+#endif  // ProcStats_DEFINED
@@ -6,6 +6,7 @@
  */
 
 #include "SkCommandLineFlags.h"
+#include "SkData.h"
 #include "SkForceLinking.h"
 #include "SkGraphics.h"
 #include "SkOSFile.h"
@@ -16,6 +17,7 @@
 
 #include "../include/record/SkRecording.h"
 
+#include "ProcStats.h"
 #include "Stats.h"
 #include "Timer.h"
 
@@ -123,18 +125,25 @@ int tool_main(int argc, char** argv) {
 
         const SkString path = SkOSPath::SkPathJoin(FLAGS_skps[0], filename.c_str());
 
-        SkAutoTUnref<SkStream> stream(SkStream::NewFromFile(path.c_str()));
-        if (!stream) {
+        WallTimer loadTimer;
+        loadTimer.start();
+        SkAutoTUnref<SkData> data(SkData::NewFromFileName(path.c_str()));
+        if (!data) {
             SkDebugf("Could not read %s.\n", path.c_str());
             failed = true;
             continue;
         }
-        SkAutoTUnref<SkPicture> src(SkPicture::CreateFromStream(stream));
+        SkAutoTUnref<SkPicture> src(SkPicture::CreateFromData(data));
         if (!src) {
             SkDebugf("Could not read %s as an SkPicture.\n", path.c_str());
             failed = true;
             continue;
         }
+        loadTimer.end();
+        if (FLAGS_verbose > 0) {
+            SkDebugf("%s: loaded in %gms, max RSS %dMB\n",
+                     filename.c_str(), loadTimer.fWall, sk_tools::getMaxResidentSetSizeMB());
+        }
 
         if (src->width() * src->height() > kMaxArea) {
             SkDebugf("%s (%dx%d) is larger than hardcoded scratch bitmap (%dpx).\n",
@@ -10,6 +10,7 @@
 #include "SkCommandLineFlags.h"
 #include "SkGraphics.h"
 #include "SkPicture.h"
+#include "SkRecordCompact.h"
 #include "SkRecordOpts.h"
 #include "SkRecorder.h"
 #include "SkStream.h"
@@ -20,6 +21,7 @@
 DEFINE_string2(skps, r, "", ".SKPs to dump.");
 DEFINE_string(match, "", "The usual filters on file names to dump.");
 DEFINE_bool2(optimize, O, false, "Run SkRecordOptimize before dumping.");
+DEFINE_bool2(compact, c, false, "Run SkRecordCompact before dumping, and report bytes saved.");
 DEFINE_int32(tile, 1000000000, "Simulated tile size.");
 DEFINE_bool(timeWithCommand, false, "If true, print time next to command, else in first column.");
 
@@ -30,7 +32,9 @@ static void dump(const char* name, int w, int h, const SkRecord& record) {
     canvas.clipRect(SkRect::MakeWH(SkIntToScalar(FLAGS_tile),
                                    SkIntToScalar(FLAGS_tile)));
 
-    printf("%s %s\n", FLAGS_optimize ? "optimized" : "not-optimized", name);
+    printf("%s %s%s\n", FLAGS_optimize ? "optimized" : "not-optimized",
+                         FLAGS_compact ? "compacted " : "",
+                         name);
 
     DumpRecord(record, &canvas, FLAGS_timeWithCommand);
 }
@@ -67,6 +71,15 @@ int tool_main(int argc, char** argv) {
             SkRecordOptimize(&record);
         }
 
+        if (FLAGS_compact) {
+            SkRecord compacted;
+            const size_t saved = SkRecordCompact(record, &compacted);
+            printf("%s: %u bytes, %u bytes compacted, %u bytes saved\n", FLAGS_skps[i],
+                   SkToUInt(record.bytesUsed()), SkToUInt(compacted.bytesUsed()), SkToUInt(saved));
+            dump(FLAGS_skps[i], w, h, compacted);
+            continue;
+        }
+
         dump(FLAGS_skps[i], w, h, record);
     }
 
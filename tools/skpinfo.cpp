@@ -6,10 +6,17 @@
  */
 
 #include "SkCommandLineFlags.h"
+#include "SkData.h"
+#include "SkForceLinking.h"
 #include "SkPicture.h"
 #include "SkPicturePlayback.h"
 #include "SkStream.h"
 
+#include "ProcStats.h"
+#include "Timer.h"
+
+__SK_FORCE_IMAGE_DECODER_LINKING;
+
 DEFINE_string2(input, i, "", "skp on which to report");
 DEFINE_bool2(version, v, true, "version");
 DEFINE_bool2(width, w, true, "width");
@@ -17,6 +24,7 @@ DEFINE_bool2(height, h, true, "height");
 DEFINE_bool2(flags, f, true, "flags");
 DEFINE_bool2(tags, t, true, "tags");
 DEFINE_bool2(quiet, q, false, "quiet");
+DEFINE_bool2(load, l, false, "load the picture and report load time and resident memory");
 
 // This tool can print simple information about an SKP but its main use
 // is just to check if an SKP has been truncated during the recording
@@ -69,7 +77,26 @@ int tool_main(int argc, char** argv) {
         SkDebugf("Flags: 0x%x\n", info.fFlags);
     }
 
-    if (!stream.readBool()) {
+    if (FLAGS_load) {
+        // Load through SkData so the file is mmap'd and the op data read in place.
+        WallTimer timer;
+        timer.start();
+        SkAutoTUnref<SkData> data(SkData::NewFromFileName(FLAGS_input[0]));
+        SkAutoTUnref<SkPicture> picture(SkPicture::CreateFromData(data));
+        timer.end();
+        if (NULL == picture.get()) {
+            if (!FLAGS_quiet) {
+                SkDebugf("Couldn't load picture\n");
+            }
+            return kIOError;
+        }
+        if (!FLAGS_quiet) {
+            SkDebugf("Load time: %gms\n", timer.fWall);
+            SkDebugf("Max RSS: %dMB\n", sk_tools::getMaxResidentSetSizeMB());
+        }
+    }
+
+    if (!SkPicture::InternalOnly_StreamHasPlayback(&stream, info)) {
         // If we read true there's a picture playback object flattened
         // in the file; if false, there isn't a playback, so we're done
         // reading the file.